@@ -6,11 +6,13 @@
 #include <Bentley/Logging.h>
 #include <Bentley/ScopedArray.h>
 #include <map>
+#include "snappy/snappy.h"
 
 USING_NAMESPACE_BENTLEY_SQLITE
 
 #define CHANGESET_FORMAT_VERSION  0x10
 #define CHANGESET_LZMA_MARKER   "ChangeSetLzma"
+#define CHANGESET_SNAPPY_MARKER "ChangeSetSnappy"
 #define JSON_PROP_DDL                   "DDL"
 #define JSON_PROP_ContainsSchemaChanges "ContainsSchemaChanges"
 
@@ -77,12 +79,30 @@ public:
     }
 };
 
+//=======================================================================================
+// Writes LZMA output to a file and adds it to a SHA1 hash on the way
+// @bsiclass
+//=======================================================================================
+struct Sha1LzmaOutStream : BeFileLzmaOutStream {
+private:
+    SHA1& m_sha1;
+
+public:
+    explicit Sha1LzmaOutStream(SHA1& sha1) : m_sha1(sha1) {}
+    ZipErrors _Write(void const* data, uint32_t size, uint32_t& bytesWritten) override {
+        ZipErrors status = BeFileLzmaOutStream::_Write(data, size, bytesWritten);
+        m_sha1.Add(data, bytesWritten);
+        return status;
+    }
+};
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
 DbResult ChangesetFileWriter::StartOutput() {
     BeAssert(m_outLzmaFileStream == nullptr);
-    m_outLzmaFileStream = new BeFileLzmaOutStream();
+    m_sha1.Reset();
+    m_outLzmaFileStream = new Sha1LzmaOutStream(m_sha1);
 
     BeFileName::CreateNewDirectory(m_pathname.GetDirectoryName());
     BeFileStatus fileStatus = m_outLzmaFileStream->CreateOutputFile(m_pathname, true); // overwrites any existing file
@@ -122,6 +142,24 @@ void ChangesetFileWriter::FinishOutput() {
     m_outLzmaFileStream = nullptr;
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+DbResult ChangesetFileWriter::Finish(Byte* outChecksum) {
+    if (m_outLzmaFileStream == nullptr)
+        return BE_SQLITE_ERROR;
+
+    ZipErrors zipStatus = m_lzmaEncoder.FinishCompress();
+    delete m_outLzmaFileStream; // closes the file
+    m_outLzmaFileStream = nullptr;
+    if (zipStatus != ZIP_SUCCESS)
+        return BE_SQLITE_ERROR;
+
+    SHA1::HashVal hashVal = m_sha1.GetHashVal();
+    memcpy(outChecksum, hashVal.m_buffer, SHA1::HashBytes);
+    return BE_SQLITE_OK;
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -239,6 +277,17 @@ void ChangesetFileReaderBase::Reader::FinishInput() {
 // @bsimethod
 //---------------------------------------------------------------------------------------
 DbResult ChangesetFileReaderBase::Reader::_Read(Byte* pData, int* pnData) {
+    if (m_base.m_isPreloaded) {
+        const size_t remaining = m_base.m_preloadedData.size() - m_preloadedPos;
+        const size_t nRead = std::min(remaining, (size_t) *pnData);
+        if (nRead > 0)
+            memcpy(pData, m_base.m_preloadedData.data() + m_preloadedPos, nRead);
+
+        m_preloadedPos += nRead;
+        *pnData = (int) nRead;
+        return BE_SQLITE_OK;
+    }
+
     if (nullptr == m_inLzmaFileStream) {
         DbResult result = StartInput();
         if (result != BE_SQLITE_OK)
@@ -254,6 +303,9 @@ DbResult ChangesetFileReaderBase::Reader::_Read(Byte* pData, int* pnData) {
 //---------------------------------------------------------------------------------------
 Utf8StringCR ChangesetFileReaderBase::Reader::GetPrefix(DbResult& result) {
     result = BE_SQLITE_OK;
+    if (m_base.m_isPreloaded)
+        return m_base.m_preloadedPrefix;
+
     if (nullptr == m_inLzmaFileStream)
         result = StartInput();
 
@@ -265,17 +317,17 @@ Utf8StringCR ChangesetFileReaderBase::Reader::GetPrefix(DbResult& result) {
 //---------------------------------------------------------------------------------------
 DbResult ChangesetFileReaderBase::Reader::GetSchemaChanges(bool& containsSchemaChanges, DdlChangesR ddlChanges) {
     DbResult result;
-    GetPrefix(result);
+    Utf8StringCR prefix = GetPrefix(result);
     if (result != BE_SQLITE_OK)
         return result;
 
     containsSchemaChanges = false;
     ddlChanges.Clear();
 
-    if (m_prefix.empty())
+    if (prefix.empty())
         return BE_SQLITE_OK;
 
-    BeJsDocument prefixJson(m_prefix);
+    BeJsDocument prefixJson(prefix);
     if (prefixJson.isMember(JSON_PROP_ContainsSchemaChanges))
         containsSchemaChanges = prefixJson[JSON_PROP_ContainsSchemaChanges].asBool();
 
@@ -319,6 +371,51 @@ BeSQLite::DbResult ChangesetFileReaderBase::Reader::ReadPrefix() {
     return BE_SQLITE_OK;
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+DbResult ChangesetFileReaderBase::Preload(size_t maxBytes) {
+    if (m_isPreloaded)
+        return BE_SQLITE_OK;
+
+    auto reader = MakeReader();
+    DbResult result;
+    Utf8String prefix = reader->GetPrefix(result);
+    if (result != BE_SQLITE_OK)
+        return result;
+
+    if (prefix.size() > maxBytes)
+        return BE_SQLITE_OK;
+
+    const size_t pageSize = 256 * 1024;
+    bvector<Byte> data;
+    size_t used = 0;
+    for (;;) {
+        if (data.size() - used < pageSize)
+            data.resize(used + 4 * pageSize);
+
+        int nRead = (int) (data.size() - used);
+        result = reader->_Read(data.data() + used, &nRead);
+        if (result != BE_SQLITE_OK)
+            return result;
+
+        if (nRead == 0)
+            break;
+
+        used += nRead;
+        if (prefix.size() + used > maxBytes)
+            return BE_SQLITE_OK; // too big to hold in memory; stream it from the file instead
+    }
+    data.resize(used);
+    data.shrink_to_fit();
+    reader = nullptr;
+
+    m_preloadedPrefix = std::move(prefix);
+    m_preloadedData = std::move(data);
+    m_isPreloaded = true;
+    return BE_SQLITE_OK;
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -1062,3 +1159,274 @@ BentleyStatus RevisionUtility::DumpChangesetToDb(Utf8CP changesetFile, Utf8CP db
 
         return db.SaveChanges() == BE_SQLITE_OK? SUCCESS: ERROR;
     }
+
+//=======================================================================================
+// Header written to the beginning of a Snappy changeset file. The file continues with a
+// sequence of chunks, each a 4 byte compressed size followed by that many bytes of
+// Snappy-compressed data that expand to at most SNAPPY_CHUNK_SIZE bytes.
+// @bsiclass
+//=======================================================================================
+struct ChangesetSnappyHeader {
+private:
+    uint16_t m_sizeOfHeader;
+    char m_idString[16];
+    uint16_t m_formatVersionNumber;
+
+public:
+    static const int formatVersionNumber = 1;
+
+    ChangesetSnappyHeader() {
+        memset(this, 0, sizeof(*this));
+        m_sizeOfHeader = (uint16_t)sizeof(ChangesetSnappyHeader);
+        strcpy(m_idString, CHANGESET_SNAPPY_MARKER);
+        m_formatVersionNumber = formatVersionNumber;
+    }
+
+    bool IsValid() const {
+        return m_sizeOfHeader == sizeof(ChangesetSnappyHeader) && 0 == strncmp(m_idString, CHANGESET_SNAPPY_MARKER, sizeof(m_idString)) && formatVersionNumber == m_formatVersionNumber;
+    }
+};
+
+static constexpr size_t SNAPPY_CHUNK_SIZE = 64 * 1024;
+static constexpr size_t SNAPPY_OUTPUT_BUFFER_SIZE = 1024 * 1024;
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+SnappyChangesetFileWriter::SnappyChangesetFileWriter(BeFileNameCR pathname, Db const* db) : m_pathname(pathname), m_db(db) {
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+SnappyChangesetFileWriter::~SnappyChangesetFileWriter() {
+    if (m_isOpen)
+        m_file.Close();
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+DbResult SnappyChangesetFileWriter::Initialize() {
+    if (m_isOpen) {
+        BeAssert(false && "Call initialize only once");
+        return BE_SQLITE_ERROR;
+    }
+
+    BeFileName::CreateNewDirectory(m_pathname.GetDirectoryName());
+    if (BeFileStatus::Success != m_file.Create(m_pathname.c_str(), true)) {
+        LOG.errorv(L"%ls - SnappyChangesetFileWriter failed to create file", m_pathname.c_str());
+        return BE_SQLITE_ERROR;
+    }
+
+    m_isOpen = true;
+    m_sha1.Reset();
+    m_raw.resize(SNAPPY_CHUNK_SIZE);
+    m_rawUsed = 0;
+    m_out.clear();
+    m_out.reserve(SNAPPY_OUTPUT_BUFFER_SIZE + 4 + snappy::MaxCompressedLength(SNAPPY_CHUNK_SIZE));
+
+    ChangesetSnappyHeader header;
+    m_out.insert(m_out.end(), (Byte const*)&header, (Byte const*)&header + sizeof(header));
+    return BE_SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------------------
+// Compress the pending raw bytes into the output buffer, writing the buffer to the file when it is full.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+DbResult SnappyChangesetFileWriter::CompressChunk() {
+    if (0 == m_rawUsed)
+        return BE_SQLITE_OK;
+
+    size_t start = m_out.size();
+    m_out.resize(start + 4 + snappy::MaxCompressedLength(m_rawUsed));
+    size_t compressedBytes;
+    snappy::RawCompress((char const*)m_raw.data(), m_rawUsed, (char*)m_out.data() + start + 4, &compressedBytes);
+    UIntToByteArray(m_out.data() + start, (uint32_t)compressedBytes);
+    m_out.resize(start + 4 + compressedBytes);
+    m_rawUsed = 0;
+
+    return m_out.size() >= SNAPPY_OUTPUT_BUFFER_SIZE ? FlushOutput() : BE_SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+DbResult SnappyChangesetFileWriter::FlushOutput() {
+    if (m_out.empty())
+        return BE_SQLITE_OK;
+
+    m_sha1.Add(m_out.data(), m_out.size());
+    BeFileStatus status = m_file.WriteAll(m_out.data(), m_out.size());
+    m_out.clear();
+    if (BeFileStatus::Success != status) {
+        LOG.errorv(L"%ls - SnappyChangesetFileWriter failed to write file", m_pathname.c_str());
+        return BE_SQLITE_ERROR;
+    }
+    return BE_SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+DbResult SnappyChangesetFileWriter::_Append(Byte const* pData, int nData) {
+    if (!m_isOpen) {
+        BeAssert(false && "Call initialize before streaming the contents of a change set");
+        return BE_SQLITE_ERROR;
+    }
+
+    while (nData > 0) {
+        size_t thisSize = std::min((size_t)nData, SNAPPY_CHUNK_SIZE - m_rawUsed);
+        memcpy(m_raw.data() + m_rawUsed, pData, thisSize);
+        m_rawUsed += thisSize;
+        pData += thisSize;
+        nData -= (int)thisSize;
+
+        if (m_rawUsed == SNAPPY_CHUNK_SIZE) {
+            DbResult rc = CompressChunk();
+            if (BE_SQLITE_OK != rc)
+                return rc;
+        }
+    }
+    return BE_SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+DbResult SnappyChangesetFileWriter::Finish(Byte* outChecksum) {
+    if (!m_isOpen)
+        return BE_SQLITE_ERROR;
+
+    DbResult rc = CompressChunk();
+    if (BE_SQLITE_OK == rc)
+        rc = FlushOutput();
+
+    m_isOpen = false;
+    if (BeFileStatus::Success != m_file.Close() && BE_SQLITE_OK == rc)
+        rc = BE_SQLITE_ERROR;
+
+    if (BE_SQLITE_OK != rc)
+        return rc;
+
+    SHA1::HashVal hashVal = m_sha1.GetHashVal();
+    memcpy(outChecksum, hashVal.m_buffer, SHA1::HashBytes);
+    return BE_SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ChangeSet::ConflictResolution SnappyChangesetFileWriter::_OnConflict(ChangeSet::ConflictCause cause, Changes::Change iter) {
+    if (m_db) {
+        iter.Dump(*m_db, false, 1);
+    }
+    BeAssert(false);
+    return ChangeSet::ConflictResolution::Abort;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+bool SnappyChangesetFileWriter::IsSnappyChangesetFile(BeFileNameCR pathname) {
+    BeFile file;
+    if (BeFileStatus::Success != file.Open(pathname.c_str(), BeFileAccess::Read))
+        return false;
+
+    ChangesetSnappyHeader header;
+    uint32_t bytesRead = 0;
+    bool isSnappy = BeFileStatus::Success == file.Read(&header, &bytesRead, sizeof(header)) && sizeof(header) == bytesRead && header.IsValid();
+    file.Close();
+    return isSnappy;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+DbResult SnappyChangesetFileReader::Reader::StartInput() {
+    m_started = true;
+    if (BeFileStatus::Success != m_file.Open(m_base.m_pathname.c_str(), BeFileAccess::Read)) {
+        LOG.errorv(L"%ls - SnappyChangesetFileReader failed to open file", m_base.m_pathname.c_str());
+        return BE_SQLITE_ERROR;
+    }
+
+    ChangesetSnappyHeader header;
+    uint32_t bytesRead = 0;
+    if (BeFileStatus::Success != m_file.Read(&header, &bytesRead, sizeof(header)) || sizeof(header) != bytesRead || !header.IsValid()) {
+        BeAssert(false && "Attempt to read an invalid snappy changeset file");
+        return BE_SQLITE_ERROR_InvalidChangeSetVersion;
+    }
+
+    m_raw.reserve(SNAPPY_CHUNK_SIZE);
+    m_raw.clear();
+    m_rawPos = 0;
+    return BE_SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+DbResult SnappyChangesetFileReader::Reader::ReadNextChunk(bool& eof) {
+    eof = false;
+    Byte sizeBytes[4];
+    uint32_t bytesRead = 0;
+    if (BeFileStatus::Success != m_file.Read(sizeBytes, &bytesRead, 4))
+        return BE_SQLITE_ERROR;
+
+    if (0 == bytesRead) {
+        eof = true;
+        return BE_SQLITE_OK;
+    }
+
+    uint32_t compressedSize = ByteArrayToUInt(sizeBytes);
+    if (4 != bytesRead || compressedSize > snappy::MaxCompressedLength(SNAPPY_CHUNK_SIZE))
+        return BE_SQLITE_CORRUPT;
+
+    m_compressed.resize(compressedSize);
+    if (BeFileStatus::Success != m_file.Read(m_compressed.data(), &bytesRead, compressedSize) || bytesRead != compressedSize)
+        return BE_SQLITE_CORRUPT;
+
+    size_t rawSize;
+    if (!snappy::GetUncompressedLength((char const*)m_compressed.data(), compressedSize, &rawSize) || rawSize > SNAPPY_CHUNK_SIZE)
+        return BE_SQLITE_CORRUPT;
+
+    m_raw.resize(rawSize);
+    if (!snappy::RawUncompress((char const*)m_compressed.data(), compressedSize, (char*)m_raw.data()))
+        return BE_SQLITE_CORRUPT;
+
+    m_rawPos = 0;
+    return BE_SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+DbResult SnappyChangesetFileReader::Reader::_Read(Byte* pData, int* pnData) {
+    if (!m_started) {
+        DbResult rc = StartInput();
+        if (BE_SQLITE_OK != rc)
+            return rc;
+    }
+
+    int wanted = *pnData;
+    int copied = 0;
+    while (copied < wanted) {
+        if (m_rawPos == m_raw.size()) {
+            bool eof;
+            DbResult rc = ReadNextChunk(eof);
+            if (BE_SQLITE_OK != rc)
+                return rc;
+            if (eof)
+                break;
+        }
+
+        size_t thisSize = std::min((size_t)(wanted - copied), m_raw.size() - m_rawPos);
+        memcpy(pData + copied, m_raw.data() + m_rawPos, thisSize);
+        m_rawPos += thisSize;
+        copied += (int)thisSize;
+    }
+
+    *pnData = copied;
+    return BE_SQLITE_OK;
+}
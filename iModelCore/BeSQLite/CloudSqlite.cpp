@@ -8,7 +8,7 @@
 #include <BeSQLite/CloudSqlite.h>
 #include <Bentley/SHA1.h>
 
-// cspell:ignore bcvfs itwindb nrequest isdaemon ncleanup ifnot bcvconfig blockno npin
+// cspell:ignore bcvfs itwindb nrequest isdaemon ncleanup ifnot bcvconfig blockno npin dbstat pgoffset
 
 extern "C" {
 int besqlite_bcv_custom_init();
@@ -419,6 +419,64 @@ CloudPrefetch::PrefetchStatus CloudPrefetch::Run(int nRequest, int timeout) {
     return status;
 }
 
+/**
+ * Read the pages holding the hinted tables, indexes and rows through `db` and return the ids of the blocks that hold the hinted tables and indexes.
+ * When `db` is opened from a CloudContainer, every page read that misses the cache is a demand request, which the daemon serves ahead of
+ * outstanding prefetch requests. Calling this before `Run` therefore downloads the hinted blocks first, and the whole-database prefetch then
+ * fills in the rest. On a local file nothing is downloaded and this only maps the hints to block ids.
+ * @param blockSize the block size of the container (see CloudCache::GetBlockSize)
+ * @param isAborted if supplied, called before each hint and each step. Once it returns true the remaining hints are skipped.
+ * @note rows in the rowid ranges are read (including overflow pages) but their blocks are not included in the returned ids.
+ * @note a single step can take long when it waits for a download. To stop one, interrupt `db` (see Db::Interrupt); the remaining hints are then skipped too.
+ */
+bset<int64_t> CloudPrefetch::FetchHinted(Db& db, Hints const& hints, int blockSize, std::function<bool()> const& isAborted) {
+    bset<int64_t> blockIds;
+    if (blockSize <= 0)
+        return blockIds;
+
+    // dbstat visits every page of a b-tree, including overflow pages, and reports each page's offset within the file.
+    Statement stmt;
+    if (BE_SQLITE_OK != stmt.Prepare(db, "SELECT pgoffset FROM dbstat WHERE name=?"))
+        return blockIds;
+
+    bool stopped = false;
+    auto isStopped = [&]() {
+        if (!stopped && isAborted && isAborted())
+            stopped = true;
+        return stopped;
+    };
+    auto stepAll = [&](Statement& step, std::function<void()> onRow) {
+        DbResult rc = BE_SQLITE_DONE;
+        while (!isStopped() && BE_SQLITE_ROW == (rc = step.Step()))
+            onRow();
+        if (BE_SQLITE_INTERRUPT == rc)
+            stopped = true;
+    };
+    auto fetchBTree = [&](Utf8StringCR name) {
+        stmt.Reset();
+        stmt.BindText(1, name, Statement::MakeCopy::No);
+        stepAll(stmt, [&]() { blockIds.insert(stmt.GetValueInt64(0) / blockSize); });
+    };
+    for (auto const& table : hints.m_tables)
+        if (!isStopped())
+            fetchBTree(table);
+    for (auto const& index : hints.m_indexes)
+        if (!isStopped())
+            fetchBTree(index);
+
+    for (auto const& range : hints.m_rowIdRanges) {
+        if (isStopped())
+            break;
+        Statement rowStmt;
+        if (BE_SQLITE_OK != rowStmt.Prepare(db, SqlPrintfString("SELECT * FROM \"%w\" WHERE rowid BETWEEN ? AND ?", range.m_table.c_str())))
+            continue;
+        rowStmt.BindInt64(1, range.m_first);
+        rowStmt.BindInt64(2, range.m_last);
+        stepAll(rowStmt, []() {}); // stepping loads every column of the row, which is all that's needed to pull its pages into the cache
+    }
+    return blockIds;
+}
+
 /**
  * Initialize a CloudUtil object for a container. Opens a "handle" from SQLite to connect to the container.
  * @param container the container for the connection
@@ -12,6 +12,8 @@
 #include <unordered_map>
 #include <list>
 #include <regex>
+#include <algorithm>
+#include "SQLite/sqlite3.h"
 
 #define LOG (NativeLogging::CategoryLogger("BeSQLite"))
 
@@ -23,6 +25,7 @@ USING_NAMESPACE_BENTLEY_SQLITE
 BEGIN_BENTLEY_SQLITE_NAMESPACE
 
 static Db::AppData::Key s_key;
+static Db::AppData::Key s_monitorKey;
 
 //---------------------------------------------------------------------------------------
 // @bsimethod
@@ -567,4 +570,293 @@ BeJsDocument Profiler::Scope::GetDetailedSqlStats() const {
     return result;
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+Profiler::Monitor::Monitor(DbCR db) : m_db(db), m_slots(new Slot[SLOT_COUNT]), m_index(new std::atomic<int32_t>[INDEX_SIZE]) {
+    for (int i = 0; i < INDEX_SIZE; ++i)
+        m_index[i].store(0, std::memory_order_relaxed);
+    for (auto& bucket : m_histogram)
+        bucket.store(0, std::memory_order_relaxed);
+
+    m_cancelCb = m_db.GetTraceProfileEvent().AddListener(
+        [this](TraceContext const& ctx, int64_t nanoseconds) {
+            Record(ctx, nanoseconds);
+        });
+    m_db.ConfigTraceEvents(DbTrace::Profile, true);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+Profiler::Monitor::~Monitor() {
+    if (m_cancelCb)
+        m_cancelCb();
+}
+
+//---------------------------------------------------------------------------------------
+// Find the slot of the statement with the supplied hash without taking a lock.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+Profiler::Monitor::Slot* Profiler::Monitor::FindSlot(uint64_t hash) const {
+    for (int probe = 0; probe < MAX_PROBES; ++probe) {
+        int32_t slotNumber = m_index[(hash + probe) % INDEX_SIZE].load(std::memory_order_acquire);
+        if (slotNumber == 0)
+            continue;
+
+        Slot& slot = m_slots[slotNumber - 1];
+        if (slot.m_hash.load(std::memory_order_acquire) == hash)
+            return &slot;
+    }
+    return nullptr;
+}
+
+//---------------------------------------------------------------------------------------
+// Give a statement seen for the first time the next slot of the ring. Slots executed since the
+// cursor last passed them get a second chance, so the slot taken over is the oldest one that is
+// no longer in use. Returns nullptr if the statement's index entries are all taken.
+// An execution that found a slot just before it is taken over may be attributed to the new
+// statement; the counters are statistics and that is accepted to keep recording lock-free.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+Profiler::Monitor::Slot* Profiler::Monitor::ClaimSlot(uint64_t hash, Utf8CP sql) {
+    std::lock_guard<std::mutex> lock(m_claimMutex);
+    if (auto slot = FindSlot(hash))
+        return slot; // another thread claimed it for the same statement
+
+    int bucket = -1;
+    for (int probe = 0; probe < MAX_PROBES && bucket < 0; ++probe) {
+        int candidate = (int)((hash + probe) % INDEX_SIZE);
+        if (m_index[candidate].load(std::memory_order_relaxed) == 0)
+            bucket = candidate;
+    }
+    if (bucket < 0)
+        return nullptr;
+
+    // a full turn clears every second chance, so this finds a slot within two turns.
+    int slotNumber = 0;
+    for (int turn = 0; turn < 2 * SLOT_COUNT; ++turn) {
+        slotNumber = m_nextSlot;
+        m_nextSlot = (m_nextSlot + 1) % SLOT_COUNT;
+        Slot& candidate = m_slots[slotNumber];
+        if (candidate.m_hash.load(std::memory_order_relaxed) == 0 || !candidate.m_used.exchange(false, std::memory_order_relaxed))
+            break;
+    }
+
+    Slot& slot = m_slots[slotNumber];
+    if (slot.m_hash.load(std::memory_order_relaxed) != 0) {
+        m_index[slot.m_indexBucket].store(0, std::memory_order_release);
+        m_evicted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // unpublish the slot while it is rewritten, so lookups and snapshots skip it.
+    slot.m_hash.store(0, std::memory_order_release);
+    slot.m_count.store(0, std::memory_order_relaxed);
+    slot.m_elapsed.store(0, std::memory_order_relaxed);
+    slot.m_maxElapsed.store(0, std::memory_order_relaxed);
+    slot.m_rows.store(0, std::memory_order_relaxed);
+    slot.m_fullScanSteps.store(0, std::memory_order_relaxed);
+    slot.m_cacheMisses.store(0, std::memory_order_relaxed);
+    slot.m_used.store(true, std::memory_order_relaxed);
+    strncpy(slot.m_sql, sql, MAX_SQL_LENGTH);
+    slot.m_sql[MAX_SQL_LENGTH] = 0;
+    slot.m_indexBucket = bucket;
+    slot.m_hash.store(hash, std::memory_order_release);
+    m_index[bucket].store(slotNumber + 1, std::memory_order_release);
+    return &slot;
+}
+
+//---------------------------------------------------------------------------------------
+// sqlite3_changes64 only reports INSERT, UPDATE and DELETE; any other statement that is not
+// read-only (DDL, COMMIT, PRAGMA, ...) would see the count of an earlier statement.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+static bool isDmlStatement(sqlite3_stmt* stmt) {
+    if (sqlite3_stmt_readonly(stmt))
+        return false;
+
+    Utf8CP sql = sqlite3_sql(stmt);
+    if (sql == nullptr)
+        return false;
+
+    while (true) {
+        while (isspace((unsigned char)*sql) || *sql == '(')
+            ++sql;
+        if (sql[0] == '-' && sql[1] == '-') {
+            while (*sql && *sql != '\n')
+                ++sql;
+        } else if (sql[0] == '/' && sql[1] == '*') {
+            Utf8CP end = strstr(sql + 2, "*/");
+            sql = end ? end + 2 : sql + strlen(sql);
+        } else {
+            break;
+        }
+    }
+
+    // a non-read-only statement that starts with WITH is a DML statement with a common table expression.
+    for (Utf8CP keyword : {"INSERT", "UPDATE", "DELETE", "REPLACE", "WITH"}) {
+        size_t len = strlen(keyword);
+        if (0 == BeStringUtilities::Strnicmp(sql, keyword, len) && !isalnum((unsigned char)sql[len]) && sql[len] != '_')
+            return true;
+    }
+    return false;
+}
+
+//---------------------------------------------------------------------------------------
+// Invoked from the profile trace callback each time a statement finishes.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void Profiler::Monitor::Record(TraceContext const& ctx, int64_t nanoseconds) {
+    auto sql = ctx.GetSql();
+    if (sql == nullptr)
+        return;
+
+    // log2 of the latency in microseconds; bucket 0 holds everything under 1us.
+    int bucket = 0;
+    for (uint64_t micros = (uint64_t)nanoseconds / 1000; micros != 0 && bucket < HISTOGRAM_BUCKETS - 1; micros >>= 1)
+        ++bucket;
+    m_histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    // fnv 64bit hash of the full text, so statements that share a truncated prefix stay apart.
+    uint64_t hash = 14695981039346656037ull;
+    for (auto p = sql; *p; ++p) {
+        hash ^= (uint64_t)(uint8_t)*p;
+        hash *= 1099511628211ull;
+    }
+    if (hash == 0)
+        hash = 1; // 0 marks an unused slot
+
+    Slot* slot = FindSlot(hash);
+    if (slot == nullptr)
+        slot = ClaimSlot(hash, sql);
+    if (slot == nullptr) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (!slot->m_used.load(std::memory_order_relaxed))
+        slot->m_used.store(true, std::memory_order_relaxed);
+
+    // the profile callback runs as the statement completes, so sqlite3_changes64 is still this statement's count.
+    auto stmt = ctx.GetSqlStatementP();
+    auto sqlDb = sqlite3_db_handle(stmt);
+    int64_t rows = isDmlStatement(stmt) ? sqlite3_changes64(sqlDb) : 0;
+    int fullScanSteps = sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, 1);
+    // page cache misses on this connection since the previous statement finished.
+    int cacheMisses = 0, unused = 0;
+    sqlite3_db_status(sqlDb, SQLITE_DBSTATUS_CACHE_MISS, &cacheMisses, &unused, 1);
+
+    slot->m_count.fetch_add(1, std::memory_order_relaxed);
+    slot->m_elapsed.fetch_add(nanoseconds, std::memory_order_relaxed);
+    slot->m_rows.fetch_add(rows, std::memory_order_relaxed);
+    slot->m_fullScanSteps.fetch_add(fullScanSteps, std::memory_order_relaxed);
+    slot->m_cacheMisses.fetch_add(cacheMisses, std::memory_order_relaxed);
+    int64_t maxElapsed = slot->m_maxElapsed.load(std::memory_order_relaxed);
+    while (nanoseconds > maxElapsed && !slot->m_maxElapsed.compare_exchange_weak(maxElapsed, nanoseconds, std::memory_order_relaxed))
+        ;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void Profiler::Monitor::Reset() {
+    for (int i = 0; i < SLOT_COUNT; ++i) {
+        Slot& slot = m_slots[i];
+        slot.m_count.store(0, std::memory_order_relaxed);
+        slot.m_elapsed.store(0, std::memory_order_relaxed);
+        slot.m_maxElapsed.store(0, std::memory_order_relaxed);
+        slot.m_rows.store(0, std::memory_order_relaxed);
+        slot.m_fullScanSteps.store(0, std::memory_order_relaxed);
+        slot.m_cacheMisses.store(0, std::memory_order_relaxed);
+    }
+    for (auto& bucket : m_histogram)
+        bucket.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+    m_evicted.store(0, std::memory_order_relaxed);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+BeJsDocument Profiler::Monitor::GetSnapshot(int topN, SortBy sortBy) const {
+    struct SlotStats {
+        Utf8String m_sql;
+        int64_t m_count;
+        int64_t m_elapsed;
+        int64_t m_maxElapsed;
+        int64_t m_rows;
+        int64_t m_fullScanSteps;
+        int64_t m_cacheMisses;
+    };
+
+    std::vector<SlotStats> stats;
+    for (int i = 0; i < SLOT_COUNT; ++i) {
+        Slot const& slot = m_slots[i];
+        uint64_t hash = slot.m_hash.load(std::memory_order_acquire);
+        if (hash == 0)
+            continue;
+
+        SlotStats entry {slot.m_sql, slot.m_count.load(std::memory_order_relaxed), slot.m_elapsed.load(std::memory_order_relaxed), slot.m_maxElapsed.load(std::memory_order_relaxed),
+            slot.m_rows.load(std::memory_order_relaxed), slot.m_fullScanSteps.load(std::memory_order_relaxed), slot.m_cacheMisses.load(std::memory_order_relaxed)};
+        // skip a slot that was taken over by another statement while it was being read.
+        if (entry.m_count > 0 && slot.m_hash.load(std::memory_order_acquire) == hash)
+            stats.push_back(std::move(entry));
+    }
+
+    auto key = [sortBy](SlotStats const& entry) {
+        switch (sortBy) {
+            case SortBy::MaxTime: return entry.m_maxElapsed;
+            case SortBy::Count: return entry.m_count;
+            default: return entry.m_elapsed;
+        }
+    };
+    size_t count = std::min(stats.size(), (size_t)std::max(topN, 0));
+    std::partial_sort(stats.begin(), stats.begin() + count, stats.end(), [&](SlotStats const& lhs, SlotStats const& rhs) { return key(lhs) > key(rhs); });
+
+    BeJsDocument result;
+    auto statements = result["statements"];
+    statements.toArray();
+    for (size_t i = 0; i < count; ++i) {
+        auto& entry = stats[i];
+        auto stat = statements.appendObject();
+        stat["sql"] = entry.m_sql;
+        stat["count"] = entry.m_count;
+        stat["elapsed_ns"] = entry.m_elapsed;
+        stat["max_elapsed_ns"] = entry.m_maxElapsed;
+        stat["rows_changed"] = entry.m_rows;
+        stat["full_scan_steps"] = entry.m_fullScanSteps;
+        stat["cache_misses"] = entry.m_cacheMisses;
+    }
+
+    auto histogram = result["latency_histogram_us"];
+    histogram.toArray();
+    for (auto& bucket : m_histogram)
+        histogram.appendValue() = bucket.load(std::memory_order_relaxed);
+
+    result["dropped"] = GetDroppedCount();
+    result["evicted"] = GetEvictedCount();
+    return result;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+Profiler::Monitor& Profiler::EnableMonitor(DbCR db) {
+    auto monitor = db.ObtainAppData(s_monitorKey, [&]() { return new Monitor(db); });
+    return *monitor;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void Profiler::DisableMonitor(DbCR db) {
+    db.DropAppData(s_monitorKey);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+Profiler::Monitor* Profiler::GetMonitor(DbCR db) {
+    return static_cast<Monitor*>(db.FindAppData(s_monitorKey).get());
+}
+
 END_BENTLEY_SQLITE_NAMESPACE
@@ -7,6 +7,7 @@
 #include "BeLzma.h"
 #include "BeSQLite.h"
 #include "ChangeSet.h"
+#include <Bentley/SHA1.h>
 
 BEGIN_BENTLEY_SQLITE_NAMESPACE
 
@@ -18,12 +19,16 @@ struct EXPORT_VTABLE_ATTRIBUTE ChangesetFileReaderBase : ChangeStream {
 private:
     Db const* m_db; // Used only for debugging
     bvector<BeFileName> m_files;
+    bool m_isPreloaded = false;
+    Utf8String m_preloadedPrefix;
+    bvector<Byte> m_preloadedData;
 
     struct Reader : Changes::Reader {
         ChangesetFileReaderBase const& m_base;
         Utf8String m_prefix = "";
         LzmaDecoder m_lzmaDecoder;
         BlockFilesLzmaInStream* m_inLzmaFileStream = nullptr;
+        size_t m_preloadedPos = 0;
         DbResult StartInput();
         DbResult ReadPrefix();
         BE_SQLITE_EXPORT void FinishInput();
@@ -48,10 +53,20 @@ public:
     RefCountedPtr<Changes::Reader> _GetReader() const override { return MakeReader(); }
     ChangesetFileReaderBase(bvector<BeFileName> const& files, Db const* db = nullptr) : m_files(files), m_db(db) {}
     Db const* GetDb() const { return m_db; }
+
+    //! Decompress the whole changeset into memory so that readers made afterwards don't touch the file or the decoder.
+    //! This does not use the Db, so it may be called on a worker thread before the changeset is applied.
+    //! If the decompressed changeset would exceed maxBytes, nothing is kept and readers keep streaming from the file;
+    //! check IsPreloaded to tell.
+    BE_SQLITE_EXPORT DbResult Preload(size_t maxBytes = SIZE_MAX);
+    bool IsPreloaded() const { return m_isPreloaded; }
+    //! Get the number of uncompressed bytes held in memory by Preload
+    size_t GetPreloadedSize() const { return m_preloadedPrefix.size() + m_preloadedData.size(); }
 };
 
 //=======================================================================================
-//! Writes the contents of a change stream to a file
+//! Writes the contents of a change stream to a file. The SHA1 hash of the file is computed while the
+//! compressed bytes are written; call Finish to obtain it.
 // @bsiclass
 //=======================================================================================
 struct EXPORT_VTABLE_ATTRIBUTE ChangesetFileWriter : ChangeStream {
@@ -59,6 +74,7 @@ private:
     BeSQLite::LzmaEncoder m_lzmaEncoder;
     BeFileName m_pathname;
     BeFileLzmaOutStream* m_outLzmaFileStream;
+    SHA1 m_sha1;
     Utf8String m_prefix;
     Db const* m_db; // Only for debugging
 
@@ -75,9 +91,81 @@ public:
     BE_SQLITE_EXPORT ChangesetFileWriter(BeFileNameCR pathname, bool containsEcSchemaChanges, DdlChangesCR ddlChanges, Db const*,
                                          BeSQLite::LzmaEncoder::LzmaParams const& lzmaParams = BeSQLite::LzmaEncoder::LzmaParams());
     BE_SQLITE_EXPORT DbResult Initialize();
+    //! Finish compressing, close the file, and return the SHA1 hash of its contents in outChecksum, which must hold SHA1::HashBytes.
+    BE_SQLITE_EXPORT DbResult Finish(Byte* outChecksum);
     ~ChangesetFileWriter() { FinishOutput(); }
 };
 
+//=======================================================================================
+//! Writes the contents of a change stream to a file compressed with Snappy. It is much faster than
+//! ChangesetFileWriter but produces larger files, and is meant for files that stay on the local
+//! machine. The SHA1 hash of the file is computed while the bytes are written, so callers that need
+//! it don't have to read the file back.
+// @bsiclass
+//=======================================================================================
+struct EXPORT_VTABLE_ATTRIBUTE SnappyChangesetFileWriter : ChangeStream {
+private:
+    BeFile m_file;
+    BeFileName m_pathname;
+    SHA1 m_sha1;
+    bvector<Byte> m_raw;
+    bvector<Byte> m_out;
+    size_t m_rawUsed = 0;
+    bool m_isOpen = false;
+    Db const* m_db; // Only for debugging
+
+    DbResult CompressChunk();
+    DbResult FlushOutput();
+
+    RefCountedPtr<Changes::Reader> _GetReader() const override { return nullptr; }
+    BE_SQLITE_EXPORT DbResult _Append(Byte const* pData, int nData) override;
+    bool _IsEmpty() const override { return false; }
+    BE_SQLITE_EXPORT ChangeSet::ConflictResolution _OnConflict(ChangeSet::ConflictCause cause, Changes::Change iter) override;
+
+public:
+    BE_SQLITE_EXPORT SnappyChangesetFileWriter(BeFileNameCR pathname, Db const* db = nullptr);
+    BE_SQLITE_EXPORT ~SnappyChangesetFileWriter();
+    //! Create the file, overwriting any existing file.
+    BE_SQLITE_EXPORT DbResult Initialize();
+    //! Write any buffered data, close the file, and return the SHA1 hash of its contents in outChecksum, which must hold SHA1::HashBytes.
+    BE_SQLITE_EXPORT DbResult Finish(Byte* outChecksum);
+
+    //! Determine whether the supplied file was written by SnappyChangesetFileWriter.
+    BE_SQLITE_EXPORT static bool IsSnappyChangesetFile(BeFileNameCR pathname);
+};
+
+//=======================================================================================
+//! Streams the contents of a file written by SnappyChangesetFileWriter
+// @bsiclass
+//=======================================================================================
+struct EXPORT_VTABLE_ATTRIBUTE SnappyChangesetFileReader : ChangeStream {
+private:
+    BeFileName m_pathname;
+    Db const* m_db; // Used only for debugging
+
+    struct Reader : Changes::Reader {
+        SnappyChangesetFileReader const& m_base;
+        BeFile m_file;
+        bvector<Byte> m_compressed;
+        bvector<Byte> m_raw;
+        size_t m_rawPos = 0;
+        bool m_started = false;
+        DbResult StartInput();
+        DbResult ReadNextChunk(bool& eof);
+        Reader(SnappyChangesetFileReader const& base) : m_base(base) {}
+        BE_SQLITE_EXPORT DbResult _Read(Byte* data, int* pSize) override;
+    };
+
+    DbResult _Append(Byte const* pData, int nData) override { return BE_SQLITE_ERROR; }
+    ChangeSet::ConflictResolution _OnConflict(ChangeSet::ConflictCause cause, Changes::Change iter) override { return ChangeSet::ConflictResolution::Abort; }
+
+public:
+    bool _IsEmpty() const override { return false; }
+    RefCountedPtr<Changes::Reader> _GetReader() const override { return new Reader(*this); }
+    SnappyChangesetFileReader(BeFileNameCR pathname, Db const* db = nullptr) : m_pathname(pathname), m_db(db) {}
+    Db const* GetDb() const { return m_db; }
+};
+
 //=======================================================================================
 // @bsiclass
 //=======================================================================================
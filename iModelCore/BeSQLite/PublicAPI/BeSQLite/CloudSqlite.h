@@ -129,6 +129,20 @@ struct CloudPrefetch {
         int64_t m_nOutstanding = 0;
         int64_t m_nDemand = 0;
     };
+    /**
+     * The parts of a database that should be fetched before the rest, e.g. the ones needed to open an iModel and show its first view.
+     */
+    struct Hints {
+        struct RowIdRange {
+            Utf8String m_table;
+            int64_t m_first;
+            int64_t m_last;
+        };
+        bvector<Utf8String> m_tables; // names of tables whose entire b-tree should be fetched
+        bvector<Utf8String> m_indexes; // names of indexes whose entire b-tree should be fetched
+        bvector<RowIdRange> m_rowIdRanges; // ranges of rows (inclusive) within a table that should be fetched
+        bool IsEmpty() const { return m_tables.empty() && m_indexes.empty() && m_rowIdRanges.empty(); }
+    };
     PrefetchP m_prefetch = nullptr;
 
     ~CloudPrefetch() { Stop(); }
@@ -137,6 +151,7 @@ struct CloudPrefetch {
     BE_SQLITE_EXPORT DbResult Init(CloudContainer& container, Utf8StringCR dbName);
     BE_SQLITE_EXPORT void Stop();
     BE_SQLITE_EXPORT PrefetchStatus Run(int nRequests, int timeout);
+    BE_SQLITE_EXPORT static bset<int64_t> FetchHinted(Db& db, Hints const& hints, int blockSize, std::function<bool()> const& isAborted = nullptr);
 };
 
 /**
@@ -7,6 +7,9 @@
 
 #include "BeSQLite.h"
 #include <unordered_map>
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 BEGIN_BENTLEY_SQLITE_NAMESPACE
 //=======================================================================================
@@ -75,7 +78,66 @@ struct Profiler final {
             BE_SQLITE_EXPORT static RefCountedPtr<Scope> Create(DbCR db, Utf8CP scopeName, Utf8CP sessionName, Profiler::Params param);
             BE_SQLITE_EXPORT BeJsDocument GetDetailedSqlStats() const;
         };
-         
+
+    //=======================================================================================
+    // An always-on, in-memory alternative to Scope. It aggregates per-statement count, total
+    // and max latency, rows changed, full-scan steps and page cache misses. The aggregates go
+    // into a fixed-size ring of statement slots that is updated with atomics only, so recording
+    // a statement that already has a slot never allocates, takes a lock, or touches disk.
+    // A new statement claims the next slot of the ring under a mutex; once the ring is full that
+    // evicts the oldest statement that has not been executed since the ring last passed it, so
+    // hot statements keep their slots. A log2 histogram of latencies covers all statements.
+    // @bsiclass
+    //=======================================================================================
+    struct Monitor final: Db::AppData {
+        friend struct Profiler;
+        enum class SortBy { TotalTime, MaxTime, Count };
+        static constexpr int SLOT_COUNT = 1024;
+        static constexpr int INDEX_SIZE = 4 * SLOT_COUNT;
+        static constexpr int MAX_PROBES = 16;
+        static constexpr int MAX_SQL_LENGTH = 255;
+        static constexpr int HISTOGRAM_BUCKETS = 32;
+        private:
+            struct Slot {
+                std::atomic<uint64_t> m_hash {0};       // 0 while the slot is unused or being reassigned
+                std::atomic<bool> m_used {false};       // executed since the ring last passed this slot
+                std::atomic<int64_t> m_count {0};
+                std::atomic<int64_t> m_elapsed {0};
+                std::atomic<int64_t> m_maxElapsed {0};
+                std::atomic<int64_t> m_rows {0};
+                std::atomic<int64_t> m_fullScanSteps {0};
+                std::atomic<int64_t> m_cacheMisses {0};
+                int m_indexBucket = -1;                 // guarded by m_claimMutex
+                char m_sql[MAX_SQL_LENGTH + 1];
+            };
+
+            DbCR m_db;
+            cancel_callback_type m_cancelCb;
+            std::unique_ptr<Slot[]> m_slots;
+            std::unique_ptr<std::atomic<int32_t>[]> m_index;   // hash -> slot number + 1, open addressed; 0 is empty
+            std::mutex m_claimMutex;
+            int m_nextSlot = 0;                                 // ring cursor, guarded by m_claimMutex
+            std::atomic<int64_t> m_histogram[HISTOGRAM_BUCKETS];
+            std::atomic<int64_t> m_dropped {0};
+            std::atomic<int64_t> m_evicted {0};
+
+            Slot* FindSlot(uint64_t hash) const;
+            Slot* ClaimSlot(uint64_t hash, Utf8CP sql);
+            void Record(TraceContext const& ctx, int64_t nanoseconds);
+            explicit Monitor(DbCR db);
+        public:
+            BE_SQLITE_EXPORT ~Monitor();
+
+            //! Zero all counters. Statements keep their slots.
+            BE_SQLITE_EXPORT void Reset();
+            //! Number of statement executions that were not attributed to a statement because no index entry was free for it.
+            int64_t GetDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+            //! Number of statements whose slot was taken over by a newer statement.
+            int64_t GetEvictedCount() const { return m_evicted.load(std::memory_order_relaxed); }
+            //! Return the topN statements ordered by sortBy, together with the latency histogram, as JSON.
+            BE_SQLITE_EXPORT BeJsDocument GetSnapshot(int topN, SortBy sortBy = SortBy::TotalTime) const;
+    };
+
     private:
         Profiler (){}
     
@@ -83,6 +145,10 @@ struct Profiler final {
         
         BE_SQLITE_EXPORT static DbResult InitScope(DbCR db, Utf8CP scopeName, Utf8CP sessionName, Profiler::Params param);
         BE_SQLITE_EXPORT static Scope const* GetScope(DbCR db);
+        //! Start aggregating statement statistics for db in memory. Does nothing if the monitor is already enabled.
+        BE_SQLITE_EXPORT static Monitor& EnableMonitor(DbCR db);
+        BE_SQLITE_EXPORT static void DisableMonitor(DbCR db);
+        BE_SQLITE_EXPORT static Monitor* GetMonitor(DbCR db);
 };
 
 END_BENTLEY_SQLITE_NAMESPACE
@@ -4,6 +4,8 @@
 *--------------------------------------------------------------------------------------------*/
 #include "BeSQLiteNonPublishedTests.h"
 #include "BeSQLite/ChangeSet.h"
+#include "BeSQLite/ChangesetFile.h"
+#include "BeSQLite/CloudSqlite.h"
 #include <map>
 #include <vector>
 //---------------------------------------------------------------------------------------
@@ -1057,6 +1059,80 @@ TEST_F(BeSQLiteDbTests, VacuumInto)
 
     ASSERT_TRUE(vacuumedFile.DoesPathExist());
     }
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(BeSQLiteDbTests, CloudPrefetchHintsMapToBlocks)
+    {
+    Db db;
+    SetupDb(db, L"prefetchHints.db");
+    ASSERT_TRUE(db.IsDbOpen());
+    ASSERT_EQ(BE_SQLITE_OK, db.ExecuteSql("CREATE TABLE big(id INTEGER PRIMARY KEY, val TEXT)"));
+    ASSERT_EQ(BE_SQLITE_OK, db.ExecuteSql("CREATE TABLE small(id INTEGER PRIMARY KEY, val TEXT)"));
+    ASSERT_EQ(BE_SQLITE_OK, db.ExecuteSql("CREATE INDEX ix_big_val ON big(val)"));
+    ASSERT_EQ(BE_SQLITE_OK, db.ExecuteSql("WITH RECURSIVE cnt(x) AS (SELECT 1 UNION ALL SELECT x+1 FROM cnt WHERE x<2000) INSERT INTO big SELECT x, printf('%0500d', x) FROM cnt"));
+    ASSERT_EQ(BE_SQLITE_OK, db.ExecuteSql("INSERT INTO small VALUES(1, 'one')"));
+    db.SaveChanges();
+
+    const int blockSize = 64 * 1024;
+    auto expectedBlocks = [&](Utf8CP name)
+        {
+        bset<int64_t> blocks;
+        Statement stmt;
+        EXPECT_EQ(BE_SQLITE_OK, stmt.Prepare(db, "SELECT pageno FROM dbstat WHERE name=?"));
+        stmt.BindText(1, name, Statement::MakeCopy::No);
+        while (BE_SQLITE_ROW == stmt.Step())
+            blocks.insert((stmt.GetValueInt64(0) - 1) * (int)Db::PageSize::PAGESIZE_4K / blockSize);
+        return blocks;
+        };
+
+    CloudPrefetch::Hints hints;
+    EXPECT_TRUE(hints.IsEmpty());
+    EXPECT_TRUE(CloudPrefetch::FetchHinted(db, hints, blockSize).empty());
+
+    hints.m_tables.push_back("small");
+    auto smallBlocks = CloudPrefetch::FetchHinted(db, hints, blockSize);
+    EXPECT_EQ(1, smallBlocks.size());
+    EXPECT_EQ(expectedBlocks("small"), smallBlocks);
+
+    hints.m_tables.push_back("big");
+    hints.m_indexes.push_back("ix_big_val");
+    auto allBlocks = CloudPrefetch::FetchHinted(db, hints, blockSize);
+    EXPECT_GT(allBlocks.size(), 1);
+    for (auto name : {"small", "big", "ix_big_val"})
+        for (auto block : expectedBlocks(name))
+            EXPECT_TRUE(allBlocks.end() != allBlocks.find(block));
+
+    // rows are read but don't contribute block ids; unknown tables are skipped
+    CloudPrefetch::Hints rowHints;
+    rowHints.m_rowIdRanges.push_back({"big", 10, 20});
+    rowHints.m_rowIdRanges.push_back({"doesNotExist", 1, 2});
+    EXPECT_FALSE(rowHints.IsEmpty());
+    EXPECT_TRUE(CloudPrefetch::FetchHinted(db, rowHints, blockSize).empty());
+    EXPECT_TRUE(CloudPrefetch::FetchHinted(db, hints, 0).empty());
+
+    // the abort predicate is checked before each hint and each step, and not again once it has returned true
+    EXPECT_TRUE(CloudPrefetch::FetchHinted(db, hints, blockSize, []() { return true; }).empty());
+    int checks = 0;
+    auto partialBlocks = CloudPrefetch::FetchHinted(db, hints, blockSize, [&]() { return ++checks > 3; });
+    EXPECT_EQ(4, checks);
+    EXPECT_LE(partialBlocks.size(), 2);
+    for (auto block : partialBlocks)
+        EXPECT_TRUE(allBlocks.end() != allBlocks.find(block));
+
+    // table names in rowid ranges are quoted as identifiers
+    ASSERT_EQ(BE_SQLITE_OK, db.ExecuteSql("CREATE TABLE \"odd]\"\"name\"(id INTEGER PRIMARY KEY, val TEXT)"));
+    ASSERT_EQ(BE_SQLITE_OK, db.ExecuteSql("WITH RECURSIVE cnt(x) AS (SELECT 1 UNION ALL SELECT x+1 FROM cnt WHERE x<30) INSERT INTO \"odd]\"\"name\" SELECT x, 'row' FROM cnt"));
+    int rowsRead = 0;
+    auto cancelRow = db.GetTraceRowEvent().AddListener([&](TraceContext const&) { rowsRead++; });
+    db.ConfigTraceEvents(DbTrace::Row, true);
+    CloudPrefetch::Hints oddHints;
+    oddHints.m_rowIdRanges.push_back({"odd]\"name", 10, 20});
+    EXPECT_TRUE(CloudPrefetch::FetchHinted(db, oddHints, blockSize).empty());
+    db.ConfigTraceEvents(DbTrace::Row, false);
+    cancelRow();
+    EXPECT_EQ(11, rowsRead);
+    }
 //=======================================================================================
 // @bsiclass
 //=======================================================================================
@@ -2431,6 +2507,147 @@ TEST_F(BeSQLiteDbTests, ChangeSetApply_IgnoreNoopShouldNotSupressConflict)
     secondBriefcaseDb.CloseDb();
 }
 
+//---------------------------------------------------------------------------------------
+// Capture a changeset that inserts rowCount rows of blobSize bytes, half random and half zeros.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+static void CaptureBlobInserts(DbR db, MyChangeSet& changeSet, int rowCount, int blobSize)
+    {
+    ASSERT_EQ(BE_SQLITE_OK, db.ExecuteSql("CREATE TABLE IF NOT EXISTS blobs (id integer primary key, val blob)"));
+    MyChangeTracker changeTracker(db);
+    changeTracker.EnableTracking(true);
+    Statement stmt;
+    ASSERT_EQ(BE_SQLITE_OK, stmt.Prepare(db, "INSERT INTO blobs (val) values (randomblob(?1) || zeroblob(?1))"));
+    for (int i = 0; i < rowCount; ++i)
+        {
+        stmt.BindInt(1, blobSize / 2);
+        ASSERT_EQ(BE_SQLITE_DONE, stmt.Step());
+        stmt.Reset();
+        }
+    stmt.Finalize();
+    ASSERT_EQ(BE_SQLITE_OK, changeSet.FromChangeTrack(changeTracker));
+    changeTracker.EndTracking();
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+TEST_F(BeSQLiteDbTests, SnappyChangesetFile)
+{
+    SetupDb(L"snappyChangeset.db");
+    ASSERT_TRUE(m_db.IsDbOpen());
+
+    MyChangeSet changeSet;
+    CaptureBlobInserts(m_db, changeSet, 200, 2000); // spans several snappy chunks
+    m_db.SaveChanges();
+
+    BeFileName snappyFile(m_db.GetDbFileName(), true);
+    snappyFile.append(L".snappy");
+    Byte checksum[SHA1::HashBytes];
+    {
+        SnappyChangesetFileWriter writer(snappyFile, &m_db);
+        ASSERT_EQ(BE_SQLITE_OK, writer.Initialize());
+        ASSERT_EQ(BE_SQLITE_OK, writer.ReadFrom(*changeSet._GetReader()));
+        ASSERT_EQ(BE_SQLITE_OK, writer.Finish(checksum));
+    }
+    ASSERT_TRUE(SnappyChangesetFileWriter::IsSnappyChangesetFile(snappyFile));
+
+    // the checksum computed while writing matches the file's contents
+    BeFile file;
+    bvector<Byte> contents;
+    ASSERT_EQ(BeFileStatus::Success, file.Open(snappyFile.c_str(), BeFileAccess::Read));
+    ASSERT_EQ(BeFileStatus::Success, file.ReadEntireFile(contents));
+    file.Close();
+    SHA1 sha1;
+    sha1.Add(contents.data(), contents.size());
+    ASSERT_EQ(0, memcmp(sha1.GetHashVal().m_buffer, checksum, SHA1::HashBytes));
+
+    // the changeset reads back unchanged
+    SnappyChangesetFileReader reader(snappyFile, &m_db);
+    MyChangeSet readBack;
+    ASSERT_EQ(BE_SQLITE_OK, readBack.ReadFrom(*reader._GetReader()));
+    ASSERT_EQ(changeSet.GetSize(), readBack.GetSize());
+    int changeCount = 0;
+    for (auto change : readBack.GetChanges())
+        {
+        UNUSED_VARIABLE(change);
+        ++changeCount;
+        }
+    ASSERT_EQ(200, changeCount);
+
+    // LZMA files are hashed while they are written too, and are not mistaken for snappy files
+    BeFileName lzmaFile(m_db.GetDbFileName(), true);
+    lzmaFile.append(L".lzma");
+    {
+        DdlChanges emptyDdl;
+        ChangesetFileWriter writer(lzmaFile, false, emptyDdl, &m_db);
+        ASSERT_EQ(BE_SQLITE_OK, writer.Initialize());
+        ASSERT_EQ(BE_SQLITE_OK, writer.ReadFrom(*changeSet._GetReader()));
+        ASSERT_EQ(BE_SQLITE_OK, writer.Finish(checksum));
+    }
+    ASSERT_FALSE(SnappyChangesetFileWriter::IsSnappyChangesetFile(lzmaFile));
+
+    ASSERT_EQ(BeFileStatus::Success, file.Open(lzmaFile.c_str(), BeFileAccess::Read));
+    ASSERT_EQ(BeFileStatus::Success, file.ReadEntireFile(contents));
+    file.Close();
+    SHA1 lzmaSha1;
+    lzmaSha1.Add(contents.data(), contents.size());
+    ASSERT_EQ(0, memcmp(lzmaSha1.GetHashVal().m_buffer, checksum, SHA1::HashBytes));
+}
+
+#ifdef RUN_PERFORMANCE_TESTS
+//---------------------------------------------------------------------------------------
+// Time to write a txn-sized changeset to a local file and obtain its checksum, with LZMA
+// versus Snappy. Both writers hash the file while they write it.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+TEST_F(BeSQLiteDbTests, ChangesetFileCodecPerformance)
+{
+    SetupDb(L"changesetCodecPerf.db");
+    ASSERT_TRUE(m_db.IsDbOpen());
+
+    const int blobSize = 1024;
+    for (int megabytes : {1, 10, 100})
+        {
+        MyChangeSet changeSet;
+        CaptureBlobInserts(m_db, changeSet, megabytes * 1024, blobSize);
+        m_db.SaveChanges();
+
+        BeFileName outFile(m_db.GetDbFileName(), true);
+        outFile.append(L".txn");
+        Byte checksum[SHA1::HashBytes];
+
+        StopWatch lzmaTimer(true);
+        {
+            DdlChanges emptyDdl;
+            ChangesetFileWriter writer(outFile, false, emptyDdl, &m_db);
+            ASSERT_EQ(BE_SQLITE_OK, writer.Initialize());
+            ASSERT_EQ(BE_SQLITE_OK, writer.ReadFrom(*changeSet._GetReader()));
+            ASSERT_EQ(BE_SQLITE_OK, writer.Finish(checksum));
+        }
+        lzmaTimer.Stop();
+        uint64_t lzmaSize = 0;
+        outFile.GetFileSize(lzmaSize);
+
+        StopWatch snappyTimer(true);
+        {
+            SnappyChangesetFileWriter writer(outFile, &m_db);
+            ASSERT_EQ(BE_SQLITE_OK, writer.Initialize());
+            ASSERT_EQ(BE_SQLITE_OK, writer.ReadFrom(*changeSet._GetReader()));
+            ASSERT_EQ(BE_SQLITE_OK, writer.Finish(checksum));
+        }
+        snappyTimer.Stop();
+        uint64_t snappySize = 0;
+        outFile.GetFileSize(snappySize);
+
+        Utf8PrintfString desc("%d MB changeset (%" PRIu64 " bytes): LZMA %" PRIu64 " bytes, Snappy %" PRIu64 " bytes", megabytes, (uint64_t) changeSet.GetSize(), lzmaSize, snappySize);
+        LOGTODB(TEST_DETAILS, lzmaTimer.GetElapsedSeconds(), megabytes, Utf8PrintfString("LZMA: %s", desc.c_str()).c_str());
+        LOGTODB(TEST_DETAILS, snappyTimer.GetElapsedSeconds(), megabytes, Utf8PrintfString("Snappy: %s", desc.c_str()).c_str());
+        outFile.BeDeleteFile();
+        }
+}
+#endif
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
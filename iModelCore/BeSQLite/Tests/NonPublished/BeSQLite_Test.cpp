@@ -963,6 +963,110 @@ TEST_F(BeSQliteTestFixture, Profiler)
     ASSERT_STREQ( "COMMIT", stats->GetValueText(1));;
     }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+TEST_F(BeSQliteTestFixture, ProfilerMonitor)
+    {
+    auto db1 = Create("monitor.db");
+    db1->ExecuteSql("create table test(Id integer primary key, c0);");
+
+    auto& monitor = Profiler::EnableMonitor(*db1);
+    ASSERT_EQ(&monitor, Profiler::GetMonitor(*db1));
+    ASSERT_EQ(&monitor, &Profiler::EnableMonitor(*db1));
+
+    Statement insertStmt;
+    insertStmt.Prepare(*db1, "insert into test (id,c0) values(?,?)");
+    for (int i=0; i< 100; ++i) {
+        insertStmt.BindInt(1, i);
+        insertStmt.BindText(2, "Hello World", Statement::MakeCopy::No);
+        insertStmt.Step();
+        insertStmt.ClearBindings();
+        insertStmt.Reset();
+    }
+    insertStmt.Finalize();
+
+    Statement selectStmt;
+    selectStmt.Prepare(*db1, "select c0 from test");
+    for (int i=0; i< 10; ++i) {
+        while (BE_SQLITE_ROW == selectStmt.Step())
+            ;
+        selectStmt.Reset();
+    }
+    selectStmt.Finalize();
+
+    auto snapshot = monitor.GetSnapshot(10, Profiler::Monitor::SortBy::Count);
+    ASSERT_EQ(0, snapshot["dropped"].asInt64());
+    auto statements = snapshot["statements"];
+    ASSERT_GE(statements.size(), 2);
+    ASSERT_STREQ("insert into test (id,c0) values(?,?)", statements[0]["sql"].asCString());
+    ASSERT_EQ(100, statements[0]["count"].asInt64());
+    ASSERT_EQ(100, statements[0]["rows_changed"].asInt64());
+    ASSERT_GE(statements[0]["max_elapsed_ns"].asInt64() * 100, statements[0]["elapsed_ns"].asInt64());
+    bool foundSelect = false;
+    for (uint32_t i = 1; i < statements.size(); ++i) {
+        if (0 != strcmp("select c0 from test", statements[i]["sql"].asCString()))
+            continue;
+        foundSelect = true;
+        ASSERT_EQ(10, statements[i]["count"].asInt64());
+        ASSERT_EQ(0, statements[i]["rows_changed"].asInt64());
+        ASSERT_GT(statements[i]["full_scan_steps"].asInt64(), 0);
+    }
+    ASSERT_TRUE(foundSelect);
+
+    int64_t histogramTotal = 0;
+    for (uint32_t i = 0; i < snapshot["latency_histogram_us"].size(); ++i)
+        histogramTotal += snapshot["latency_histogram_us"][i].asInt64();
+    ASSERT_GE(histogramTotal, 110);
+
+    // topN limits the result
+    ASSERT_EQ(1, monitor.GetSnapshot(1)["statements"].size());
+
+    // statements that are not INSERT, UPDATE or DELETE must not report the row count of an earlier one.
+    monitor.Reset();
+    db1->ExecuteSql("update test set c0='x' where id < 7");
+    db1->ExecuteSql("create table other(a)");
+    db1->ExecuteSql("pragma user_version=3");
+    auto otherSnapshot = monitor.GetSnapshot(10, Profiler::Monitor::SortBy::Count);
+    auto otherStatements = otherSnapshot["statements"];
+    ASSERT_EQ(3, otherStatements.size());
+    for (uint32_t i = 0; i < otherStatements.size(); ++i) {
+        auto expected = (0 == strncmp("update", otherStatements[i]["sql"].asCString(), 6)) ? 7 : 0;
+        ASSERT_EQ(expected, otherStatements[i]["rows_changed"].asInt64()) << otherStatements[i]["sql"].asCString();
+    }
+
+    monitor.Reset();
+    ASSERT_EQ(0, monitor.GetSnapshot(10)["statements"].size());
+
+    // once every slot is taken, new statements take over the slots of statements that are no longer executed,
+    // while a statement that keeps being executed keeps its slot.
+    Statement hotStmt;
+    hotStmt.Prepare(*db1, "select count(*) from test");
+    for (int i = 0; i < 3 * Profiler::Monitor::SLOT_COUNT; ++i) {
+        hotStmt.Step();
+        hotStmt.Reset();
+        Statement coldStmt;
+        coldStmt.Prepare(*db1, SqlPrintfString("select %d", i).GetUtf8CP());
+        coldStmt.Step();
+    }
+    hotStmt.Finalize();
+    auto ringSnapshot = monitor.GetSnapshot(Profiler::Monitor::SLOT_COUNT, Profiler::Monitor::SortBy::Count);
+    ASSERT_EQ(0, ringSnapshot["dropped"].asInt64());
+    ASSERT_GE(ringSnapshot["evicted"].asInt64(), 2 * Profiler::Monitor::SLOT_COUNT - 1);
+    ASSERT_STREQ("select count(*) from test", ringSnapshot["statements"][0]["sql"].asCString());
+    ASSERT_EQ(3 * Profiler::Monitor::SLOT_COUNT, ringSnapshot["statements"][0]["count"].asInt64());
+    bool foundLast = false;
+    Utf8String lastSql(SqlPrintfString("select %d", 3 * Profiler::Monitor::SLOT_COUNT - 1).GetUtf8CP());
+    for (uint32_t i = 1; i < ringSnapshot["statements"].size(); ++i)
+        foundLast |= lastSql.Equals(ringSnapshot["statements"][i]["sql"].asCString());
+    ASSERT_TRUE(foundLast);
+    monitor.Reset();
+
+    Profiler::DisableMonitor(*db1);
+    ASSERT_TRUE(nullptr == Profiler::GetMonitor(*db1));
+    db1->ExecuteSql("delete from test");
+    }
+
 //=======================================================================================
 //! Virtual Table to generate series
 // @bsiclass
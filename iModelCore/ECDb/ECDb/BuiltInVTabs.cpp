@@ -153,6 +153,46 @@ DbResult ClassPropsModule::Connect(DbVirtualTable*& out, Config& conf, int argc,
 
 /*IdSet Virtual Table*/
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void IdSetModule::IdRuns::Append(uint64_t id) {
+    if (!m_runs.empty()) {
+        Run& last = m_runs.back();
+        BeAssert(id >= last.m_first + last.m_count);
+        if (id == last.m_first + last.m_count) {
+            ++last.m_count;
+            ++m_size;
+            return;
+        }
+    }
+    m_runs.push_back({id, 1});
+    ++m_size;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void IdSetModule::IdRuns::Assign(bvector<uint64_t>& ids) {
+    Clear();
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    for (uint64_t id : ids)
+        Append(id);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+bool IdSetModule::IdRuns::Contains(uint64_t id) const {
+    // find the last run starting at or before id
+    auto it = std::upper_bound(m_runs.begin(), m_runs.end(), id, [](uint64_t lhs, Run const& rhs) { return lhs < rhs.m_first; });
+    if (it == m_runs.begin())
+        return false;
+    --it;
+    return id - it->m_first < it->m_count;
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -161,8 +201,11 @@ DbResult IdSetModule::IdSetTable::IdSetCursor::Next() {
         ++m_matchedIndex;
     } else if (m_pointLookup) {
         m_lookupFound = false;
-    } else {
-        ++m_index;
+    } else if (m_runIndex < m_runs->GetRuns().size()) {
+        if (++m_runOffset >= m_runs->GetRuns()[m_runIndex].m_count) {
+            ++m_runIndex;
+            m_runOffset = 0;
+        }
     }
     return BE_SQLITE_OK;
 }
@@ -175,15 +218,7 @@ bool IdSetModule::IdSetTable::IdSetCursor::Eof() {
         return m_matchedIndex >= m_matchedIds.size();
     if (m_pointLookup)
         return !m_lookupFound;
-    return m_index >= m_ids.size();
-}
-
-//---------------------------------------------------------------------------------------
-// @bsimethod
-//---------------------------------------------------------------------------------------
-void IdSetModule::IdSetTable::IdSetCursor::SortAndDedupe() {
-    std::sort(m_ids.begin(), m_ids.end());
-    m_ids.erase(std::unique(m_ids.begin(), m_ids.end()), m_ids.end());
+    return m_runIndex >= m_runs->GetRuns().size();
 }
 
 //---------------------------------------------------------------------------------------
@@ -195,8 +230,8 @@ DbResult IdSetModule::IdSetTable::IdSetCursor::GetRowId(int64_t& rowId) {
             rowId = (int64_t)m_matchedIds[m_matchedIndex];
     } else if (m_pointLookup) {
         rowId = (int64_t)m_lookupId;
-    } else if (m_index < m_ids.size()) {
-        rowId = (int64_t)m_ids[m_index];
+    } else if (!Eof()) {
+        rowId = (int64_t)GetCurrentId();
     }
     return BE_SQLITE_OK;
 }
@@ -206,7 +241,8 @@ DbResult IdSetModule::IdSetTable::IdSetCursor::GetRowId(int64_t& rowId) {
 //---------------------------------------------------------------------------------------
 DbResult IdSetModule::IdSetTable::IdSetCursor::GetColumn(int i, Context& ctx) {
     if ((Columns)i == Columns::Json_array_ids) {
-        ctx.SetResultText(m_text.c_str(), (int)m_text.size(), Context::CopyData::No);
+        if (!IsRunsBound())
+            ctx.SetResultText(m_text.c_str(), (int)m_text.size(), Context::CopyData::No);
     } else if ((Columns)i == Columns::Id) {
         if (m_inMode) {
             if (m_matchedIndex < m_matchedIds.size())
@@ -214,8 +250,8 @@ DbResult IdSetModule::IdSetTable::IdSetCursor::GetColumn(int i, Context& ctx) {
         } else if (m_pointLookup) {
             if (m_lookupFound)
                 ctx.SetResultInt64((int64_t)m_lookupId);
-        } else if (m_index < m_ids.size()) {
-            ctx.SetResultInt64((int64_t)m_ids[m_index]);
+        } else if (!Eof()) {
+            ctx.SetResultInt64((int64_t)GetCurrentId());
         }
     }
     return BE_SQLITE_OK;
@@ -283,10 +319,15 @@ DbResult IdSetModule::IdSetTable::IdSetCursor::Filter(int idxNum, const char *id
     //   bit 0 (1): json_array_ids EQ constraint
     //   bit 1 (2): id EQ constraint (single point lookup)
     //   bit 2 (4): id IN constraint (all-at-once)
+    // json_array_ids either is a JSON array text or an IdRuns object bound via sqlite pointer binding.
+    // The latter is already sorted and compressed and is used as is.
     int argIdx = 0;
     bool recompute = false;
     if (idxNum & 1) {
-        if (argv[argIdx].GetValueType() == DbValueType::TextVal) {
+        m_runs = &m_ownedRuns;
+        if (auto boundRuns = (IdRuns const*) argv[argIdx].GetValuePointer(IdRuns::POINTER_TYPE)) {
+            m_runs = boundRuns;
+        } else if (argv[argIdx].GetValueType() == DbValueType::TextVal) {
             auto valueGiven = argv[argIdx].GetValueText();
             if (!m_text.EqualsIAscii(valueGiven)) {
                 m_text = valueGiven;
@@ -303,10 +344,10 @@ DbResult IdSetModule::IdSetTable::IdSetCursor::Filter(int idxNum, const char *id
 
         if (doc.hasParseError() || FilterJSONStringIntoArray(doc) != BE_SQLITE_OK) {
             Reset();
-            m_index = 0;
             return BE_SQLITE_ERROR;
         }
-        SortAndDedupe();
+        m_ownedRuns.Assign(m_ids);
+        m_ids.clear();
     }
 
     // Handle IN all-at-once: id IN (...)
@@ -319,7 +360,7 @@ DbResult IdSetModule::IdSetTable::IdSetCursor::Filter(int idxNum, const char *id
             int64_t rawId = current.GetValueInt64();
             if (rawId > 0) {
                 uint64_t id = (uint64_t)rawId;
-                if (std::binary_search(m_ids.begin(), m_ids.end(), id))
+                if (m_runs->Contains(id))
                     m_matchedIds.push_back(id);
             }
             DbModule::InNext(inVal, current);
@@ -334,10 +375,11 @@ DbResult IdSetModule::IdSetTable::IdSetCursor::Filter(int idxNum, const char *id
             m_lookupFound = false;
         } else {
             m_lookupId = (uint64_t)rawId;
-            m_lookupFound = std::binary_search(m_ids.begin(), m_ids.end(), m_lookupId);
+            m_lookupFound = m_runs->Contains(m_lookupId);
         }
     } else {
-        m_index = 0;
+        m_runIndex = 0;
+        m_runOffset = 0;
     }
 
     return BE_SQLITE_OK;
@@ -349,6 +391,10 @@ DbResult IdSetModule::IdSetTable::IdSetCursor::Filter(int idxNum, const char *id
 void IdSetModule::IdSetTable::IdSetCursor::Reset() {
     m_text = "[]";
     m_ids.clear();
+    m_ownedRuns.Clear();
+    m_runs = &m_ownedRuns;
+    m_runIndex = 0;
+    m_runOffset = 0;
     m_pointLookup = false;
     m_lookupFound = false;
     m_inMode = false;
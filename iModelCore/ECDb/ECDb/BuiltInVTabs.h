@@ -45,6 +45,38 @@ struct ClassPropsModule : BeSQLite::DbModule {
 
 struct IdSetModule : ECDbModule {
     constexpr static auto NAME = "IdSet";
+
+    //=======================================================================================
+    //! Sorted, de-duplicated set of ids stored as runs of consecutive ids. Element ids are
+    //! mostly allocated sequentially, so typical sets collapse into a handful of runs.
+    //! An instance can be bound to the json_array_ids argument via sqlite pointer binding
+    //! (see POINTER_TYPE), which lets the cursor skip JSON parsing entirely.
+    // @bsiclass
+    //=======================================================================================
+    struct IdRuns final {
+        constexpr static auto POINTER_TYPE = "ECDb_IdSet_IdRuns";
+        struct Run {
+            uint64_t m_first;
+            uint64_t m_count;
+        };
+        private:
+            bvector<Run> m_runs;
+            size_t m_size = 0;
+
+        public:
+            //! Append an id. Ids must be appended in strictly ascending order.
+            void Append(uint64_t id);
+            //! Replace the content with the given ids. The input is sorted and de-duplicated in place.
+            void Assign(bvector<uint64_t>& ids);
+            bool Contains(uint64_t id) const;
+            void Clear() { m_runs.clear(); m_size = 0; }
+            bool IsEmpty() const { return m_size == 0; }
+            size_t GetSize() const { return m_size; }
+            bvector<Run> const& GetRuns() const { return m_runs; }
+            //! Destructor callback for Statement::BindPointer
+            static void Destroy(void* runs) { delete (IdRuns*) runs; }
+    };
+
     struct IdSetTable : ECDbVirtualTable {
         struct IdSetCursor : ECDbCursor {
 
@@ -56,7 +88,10 @@ struct IdSetModule : ECDbModule {
             private:
                 Utf8String m_text;
                 bvector<uint64_t> m_ids;
-                size_t m_index;
+                IdRuns m_ownedRuns;
+                IdRuns const* m_runs;
+                size_t m_runIndex;
+                uint64_t m_runOffset;
                 // For point-lookup mode (id = ? or id IN (...))
                 bool m_pointLookup;
                 uint64_t m_lookupId;
@@ -66,9 +101,10 @@ struct IdSetModule : ECDbModule {
                 bvector<uint64_t> m_matchedIds;
                 size_t m_matchedIndex;
 
-                void SortAndDedupe();
+                bool IsRunsBound() const { return m_runs != &m_ownedRuns; }
+                uint64_t GetCurrentId() const { return m_runs->GetRuns()[m_runIndex].m_first + m_runOffset; }
             public:
-                IdSetCursor(IdSetTable& vt): ECDbCursor(vt), m_index(0), m_pointLookup(false), m_lookupId(0), m_lookupFound(false), m_inMode(false), m_matchedIndex(0){}
+                IdSetCursor(IdSetTable& vt): ECDbCursor(vt), m_runs(&m_ownedRuns), m_runIndex(0), m_runOffset(0), m_pointLookup(false), m_lookupId(0), m_lookupFound(false), m_inMode(false), m_matchedIndex(0){}
                 bool Eof() final;
                 DbResult Next() final;
                 DbResult GetColumn(int i, Context& ctx) final;
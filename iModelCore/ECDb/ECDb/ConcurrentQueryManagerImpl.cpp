@@ -78,9 +78,11 @@ std::shared_ptr<CachedQueryAdaptor> QueryAdaptorCache::TryGet(Utf8CP ecsql, bool
         }
         entry->GetStatement().Reset();
         entry->GetStatement().ClearBindings();
+        queue.RecordPlanCacheLookup(true);
         return entry;
     }
 
+    queue.RecordPlanCacheLookup(false);
     auto newCachedAdaptor = CachedQueryAdaptor::Make();
     newCachedAdaptor->SetWorkerConn(m_conn.GetDb());
     newCachedAdaptor->SetUsePrimaryConn(usePrimaryConn);
@@ -128,7 +130,9 @@ std::shared_ptr<CachedQueryAdaptor> QueryAdaptorCache::TryGet(Utf8CP ecsql, bool
         // table spaces, so queries that target one (or are otherwise invalid against it) fall back to
         // the worker's own connection below.
         bool preparedAgainstSchemaSource = false;
-        if (CachedConnection* schemaSource = m_conn.GetSchemaSourceConnection()) {
+        const bool requiresOwnConnection = m_conn.m_cache.RequiresOwnConnection(hashCode);
+        CachedConnection* schemaSource = requiresOwnConnection ? nullptr : m_conn.GetSchemaSourceConnection();
+        if (schemaSource != nullptr) {
             ECDb const& schemaDb = schemaSource->GetDb();
             // Serialize access to the shared schema cache on the schema-source connection's OWN ECDb
             // impl mutex (a std::recursive_mutex, so the dispatcher's inner locks on the same thread are
@@ -181,6 +185,9 @@ std::shared_ptr<CachedQueryAdaptor> QueryAdaptorCache::TryGet(Utf8CP ecsql, bool
                 ecsql_error = err_scope.GetLastError();
                 return nullptr;
             }
+            // remember that the schema-source attempt is pointless for this ECSql so no other worker pays for it.
+            if (schemaSource != nullptr)
+                m_conn.m_cache.SetRequiresOwnConnection(hashCode);
         }
     }
 
@@ -193,6 +200,15 @@ std::shared_ptr<CachedQueryAdaptor> QueryAdaptorCache::TryGet(Utf8CP ecsql, bool
 
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+bool QueryAdaptorCache::Contains(uint64_t hashCode) const {
+    return std::any_of(m_cache.begin(), m_cache.end(), [&hashCode] (std::shared_ptr<CachedQueryAdaptor> const& entry) {
+        return !entry->GetUsePrimaryConn() && entry->GetStatement().GetHashCode() == hashCode;
+    });
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -223,8 +239,8 @@ void CachedQueryAdaptor::CachedQueryAdaptor::ReleaseMemory() {
 //---------------------------------------------------------------------------------------
 void CachedConnection::SyncAttachDbs() {
     recursive_guard_t lock(m_mutexReq);
-    if (m_request != nullptr || !m_db.IsDbOpen()) {
-        // cannot sync attach dbs if request is pending.
+    if (m_request != nullptr || IsPinned() || !m_db.IsDbOpen()) {
+        // cannot sync attach dbs if request is pending or a stream is parked on this connection.
         return;
     }
 
@@ -286,10 +302,12 @@ void CachedConnection::SyncAttachDbs() {
 //---------------------------------------------------------------------------------------
 void CachedConnection::Execute(std::function<void(QueryAdaptorCache&,RunnableRequestBase&)> cb, std::unique_ptr<RunnableRequestBase> request) {
     // Drop this connection's caches if the primary's file data version changed (schema import /
-    // changeset apply) so the worker re-prepares against current schemas.
-    RefreshIfPrimaryChanged();
-
-    SyncAttachDbs();
+    // changeset apply) so the worker re-prepares against current schemas. A resumed stream keeps
+    // stepping the statement it left positioned here, so its connection is left as it is.
+    if (request->GetStream() == nullptr) {
+        RefreshIfPrimaryChanged();
+        SyncAttachDbs();
+    }
     SetRequest(std::move(request));
     // A query executor thread must never let an exception escape: an unhandled exception on a worker
     // thread terminates the process, and the request's promise would never be satisfied, so callers
@@ -305,14 +323,21 @@ void CachedConnection::Execute(std::function<void(QueryAdaptorCache&,RunnableReq
             m_request->SetResponse(m_request->CreateErrorResponse(QueryResponse::Status::Error, "unknown error while executing query"));
         log_error("%s unhandled non-standard exception while executing query.", GetTimestamp().c_str());
     }
-    ClearRequest();
+    auto finished = ClearRequest();
+    if (finished != nullptr && finished->IsParked() && !finished->IsCompleted()) {
+        // the stream keeps this connection until it completes; the worker goes back to the queue.
+        if (finished->GetStream()->GetConnection() == nullptr)
+            finished->GetStream()->SetConnection(Shared());
+        auto& queue = finished->GetQueue();
+        queue.Park(std::move(finished));
+    }
 }
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
-void CachedConnection::ClearRequest() {
+std::unique_ptr<RunnableRequestBase> CachedConnection::ClearRequest() {
     recursive_guard_t lock(m_mutexReq);
-    m_request = nullptr;
+    return std::move(m_request);
 }
 //---------------------------------------------------------------------------------------
 // @bsimethod
@@ -453,6 +478,7 @@ void ConnectionCache::SyncAttachDbs() {
 
     recursive_guard_t lock(m_mutex);
     m_primaryAttachFileHash = hashCode;
+    m_ownConnectionStatements.clear();
     for (auto& conn: m_conns) {
         if (conn != nullptr)
             conn->SyncAttachDbs();
@@ -485,17 +511,34 @@ ConnectionCache::ConnectionCache(ECDb const& primaryDb, uint32_t pool_size): m_p
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
-std::shared_ptr<CachedConnection> ConnectionCache::GetConnection() {
+std::shared_ptr<CachedConnection> ConnectionCache::GetConnection(uint64_t statementHash) {
     if (!m_primaryDb.IsDbOpen())
         throw std::runtime_error("primary db connection must be open");
 
+    // statements prepared before the primary's data version last changed are dropped when the connection
+    // runs its next request (see CachedConnection::RefreshIfPrimaryChanged), so they do not count as prepared.
+    uint32_t dataVersion = 0;
+    if (statementHash != 0)
+        m_primaryDb.GetFileDataVersion(dataVersion);
+
     recursive_guard_t lock(m_mutex);
+    CachedConnection* idle = nullptr;
+    uint32_t pinned = 0;
     for (auto& it : m_conns) {
+        if (it != nullptr && it->IsPinned())
+            ++pinned;
         if (it.use_count() == 1)  {
-            return it;
+            // an idle connection is not touched by any worker, so reading its statement cache under m_mutex is safe.
+            if (statementHash == 0 || it->HasCachedStatement(statementHash, dataVersion))
+                return it;
+            if (idle == nullptr)
+                idle = it.get();
         }
     }
-    if (m_conns.size() < m_poolSize) {
+    if (idle != nullptr)
+        return idle->Shared();
+    // connections held by parked streams do not count, so streams waiting on their consumers cannot starve the pool.
+    if (m_conns.size() < m_poolSize + pinned) {
         // Worker connection ids must never collide with SCHEMA_SOURCE_CONN_ID (UINT16_MAX). The
         // default pool size makes this unreachable, but assert the invariant explicitly.
         BeAssert(m_conns.size() < UINT16_MAX - 1);
@@ -506,6 +549,22 @@ std::shared_ptr<CachedConnection> ConnectionCache::GetConnection() {
     return nullptr;
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+bool ConnectionCache::RequiresOwnConnection(uint64_t statementHash) {
+    recursive_guard_t lock(m_mutex);
+    return m_ownConnectionStatements.find(statementHash) != m_ownConnectionStatements.end();
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void ConnectionCache::SetRequiresOwnConnection(uint64_t statementHash) {
+    recursive_guard_t lock(m_mutex);
+    m_ownConnectionStatements.insert(statementHash);
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -682,17 +741,31 @@ QueryResponse::Ptr RunnableRequestBase::CreateBlobIOResponse(std::vector<uint8_t
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
-QueryResponse::Ptr RunnableRequestBase::CreateECSqlResponse(std::string& resultJson, ECSqlRowProperty::List& meta, uint32_t rowCount, bool done) const {
+QueryResponse::Ptr RunnableRequestBase::CreateECSqlResponse(std::string& resultJson, ECSqlRowProperty::List& meta, uint32_t rowCount, QueryResponse::Status status) const {
     const auto memUsed = (uint32_t)(resultJson.size());
     return std::make_shared<ECSqlResponse>(
         QueryResponse::Stats(GetCpuTime(), GetTotalTime(), memUsed,m_quota, m_prepareTime),
-        done? QueryResponse::Status::Done:QueryResponse::Status::Partial,
+        status,
         "",
         resultJson,
         meta,
         rowCount);
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+QueryResponse::Ptr RunnableRequestBase::CreateECSqlResponse(std::vector<uint8_t>& result, ECSqlRowProperty::List& meta, uint32_t rowCount, QueryResponse::Status status) const {
+    const auto memUsed = (uint32_t)(result.size());
+    return std::make_shared<ECSqlResponse>(
+        QueryResponse::Stats(GetCpuTime(), GetTotalTime(), memUsed,m_quota, m_prepareTime),
+        status,
+        "",
+        result,
+        meta,
+        rowCount);
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -708,13 +781,169 @@ QueryResponse::Ptr RunnableRequestBase::CreateShutDownResponse() const {
 // @bsimethod
 //---------------------------------------------------------------------------------------
 RunnableRequestQueue::RunnableRequestQueue(ECDbCR ecdb): m_nextId(0), m_state(State::Running), m_lastDelayedQueryId(0),m_ecdb(ecdb) {
+    m_resumer = std::make_shared<StreamResumer>(*this);
     auto env = ConcurrentQueryMgr::Config::Get();
     m_quota = env.GetQuota();
+    m_requests.SetIgnorePriority(env.GetIgnorePriority());
     m_maxQueueSize = env.GetRequestQueueSize();
     m_shutdownWhenIdleFor = env.GetAutoShutdownWhenIdleForSeconds();
     m_lastDequeueTime = std::chrono::time_point_cast<std::chrono::seconds>(std::chrono::steady_clock::now());
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void HistogramRecorder::Record(std::chrono::microseconds elapsed) {
+    const auto us = (uint64_t)std::max<int64_t>(0, elapsed.count());
+    const auto ms = us / 1000;
+    int bucket = 0;
+    while (bucket < QueryHistogram::kBucketCount - 1 && ms >= (1ull << bucket))
+        ++bucket;
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_totalUs.fetch_add(us, std::memory_order_relaxed);
+    auto curMax = m_maxUs.load(std::memory_order_relaxed);
+    while (us > curMax && !m_maxUs.compare_exchange_weak(curMax, us, std::memory_order_relaxed)) {}
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+QueryHistogram HistogramRecorder::Snapshot() const {
+    std::array<uint64_t, QueryHistogram::kBucketCount> buckets;
+    for (int i = 0; i < QueryHistogram::kBucketCount; ++i)
+        buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    return QueryHistogram(buckets,
+        m_count.load(std::memory_order_relaxed),
+        std::chrono::microseconds(m_totalUs.load(std::memory_order_relaxed)),
+        std::chrono::microseconds(m_maxUs.load(std::memory_order_relaxed)));
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void HistogramRecorder::Reset() {
+    for (auto& bucket : m_buckets)
+        bucket.store(0);
+    m_count.store(0);
+    m_totalUs.store(0);
+    m_maxUs.store(0);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void RequestScheduler::Push(Request request) {
+    const auto id = request->GetId();
+    Location loc { m_ignorePriority ? 0 : request->GetRequest().GetPriority(), request->GetRequest().GetClientKey(), m_nextSeq++ };
+    auto& restartToken = request->GetRequest().GetRestartToken();
+    if (!restartToken.empty())
+        m_restartTokens.emplace(restartToken, id);
+    m_levels[loc.m_priority].m_clients[loc.m_client].emplace(loc.m_seq, std::move(request));
+    m_index[id] = std::move(loc);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+RequestScheduler::Request RequestScheduler::Take(uint32_t id, Location const& loc) {
+    auto levelIt = m_levels.find(loc.m_priority);
+    auto& level = levelIt->second;
+    auto clientIt = level.m_clients.find(loc.m_client);
+    auto reqIt = clientIt->second.find(loc.m_seq);
+    auto request = std::move(reqIt->second);
+    clientIt->second.erase(reqIt);
+    if (clientIt->second.empty())
+        level.m_clients.erase(clientIt);
+    if (level.m_clients.empty())
+        m_levels.erase(levelIt);
+
+    auto& restartToken = request->GetRequest().GetRestartToken();
+    if (!restartToken.empty()) {
+        auto range = m_restartTokens.equal_range(restartToken);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == id) {
+                m_restartTokens.erase(it);
+                break;
+            }
+        }
+    }
+    m_index.erase(id);
+    return request;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+RequestScheduler::Request RequestScheduler::Pop() {
+    if (m_levels.empty())
+        return nullptr;
+
+    auto& level = m_levels.begin()->second;
+    auto clientIt = level.m_clients.lower_bound(level.m_next);
+    if (clientIt == level.m_clients.end())
+        clientIt = level.m_clients.begin();
+
+    // advance the round-robin cursor past the client being served before Take() may erase it.
+    auto nextIt = std::next(clientIt);
+    level.m_next = nextIt == level.m_clients.end() ? std::string() : nextIt->first;
+
+    auto& front = *clientIt->second.begin();
+    const auto id = front.second->GetId();
+    Location loc = m_index[id];
+    return Take(id, loc);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+RequestScheduler::Request RequestScheduler::Remove(uint32_t id) {
+    auto it = m_index.find(id);
+    if (it == m_index.end())
+        return nullptr;
+    Location loc = it->second;
+    return Take(id, loc);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+std::vector<RequestScheduler::Request> RequestScheduler::RemoveIf(std::function<bool(RunnableRequestBase&)> predicate) {
+    std::vector<uint32_t> ids;
+    ForEach([&](RunnableRequestBase& request) {
+        if (predicate(request))
+            ids.push_back(request.GetId());
+    });
+    std::vector<Request> removed;
+    for (auto id : ids)
+        removed.push_back(Remove(id));
+    return removed;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+std::vector<RequestScheduler::Request> RequestScheduler::RemoveByRestartToken(std::string const& token) {
+    std::vector<uint32_t> ids;
+    auto range = m_restartTokens.equal_range(token);
+    for (auto it = range.first; it != range.second; ++it)
+        ids.push_back(it->second);
+    std::vector<Request> removed;
+    for (auto id : ids)
+        removed.push_back(Remove(id));
+    return removed;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void RequestScheduler::ForEach(std::function<void(RunnableRequestBase&)> cb) const {
+    for (auto& level : m_levels)
+        for (auto& client : level.second.m_clients)
+            for (auto& request : client.second)
+                cb(*request.second);
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -738,16 +967,23 @@ void RunnableRequestQueue::InsertSorted(ConnectionCache& conns, std::unique_ptr<
     auto& restartToken = request->GetRequest().GetRestartToken();
     if (!restartToken.empty()) {
         log_trace("%s request [id=%" PRIu32 "] has restart token '%s', attempting to cancel any existing request in queue.",GetTimestamp().c_str(), request->GetId(), restartToken.c_str());
-        for (auto it = m_requests.begin(); it != m_requests.end();) {
-            auto& existingRestartToken = (*it)->GetRequest().GetRestartToken();
-            if (restartToken == existingRestartToken) {
-                 log_trace("%s found request [id=%" PRIu32 "] with restart token '%s' and will be cancelled in response to request [id=%" PRIu32 "]",
+        for (auto& existing : m_requests.RemoveByRestartToken(restartToken)) {
+            log_trace("%s found request [id=%" PRIu32 "] with restart token '%s' and will be cancelled in response to request [id=%" PRIu32 "]",
+                GetTimestamp().c_str(),
+                existing->GetId(),
+                restartToken.c_str(),
+                request->GetId());
+            existing->SetResponse(existing->CreateCancelResponse());
+        }
+        for (auto it = m_parked.begin(); it != m_parked.end();) {
+            if (it->second->GetRequest().GetRestartToken() == restartToken) {
+                log_trace("%s found parked stream [id=%" PRIu32 "] with restart token '%s' and will be cancelled in response to request [id=%" PRIu32 "]",
                     GetTimestamp().c_str(),
-                    (*it)->GetId(),
+                    it->first,
                     restartToken.c_str(),
                     request->GetId());
-                (*it)->SetResponse((*it)->CreateCancelResponse());
-                it = m_requests.erase(it);
+                it->second->SetResponse(it->second->CreateCancelResponse());
+                it = m_parked.erase(it);
             } else {
                 ++it;
             }
@@ -765,16 +1001,8 @@ void RunnableRequestQueue::InsertSorted(ConnectionCache& conns, std::unique_ptr<
             return false;
         }, true);
     }
-    const auto priority = request->GetRequest().GetPriority();
-    for (auto it = m_requests.begin(); it != m_requests.end(); ++ it) {
-        auto cur_priority = it->get()->GetRequest().GetPriority();
-        if (cur_priority > priority) {
-             m_requests.insert( it, std::move(request));
-             return;
-        }
-    }
     log_trace("%s enqueuing request [id=%" PRIu32 "] complete", GetTimestamp().c_str(), request->GetId());
-    m_requests.insert( m_requests.end(), std::move(request));
+    m_requests.Push(std::move(request));
 }
 
 //---------------------------------------------------------------------------------------
@@ -782,7 +1010,7 @@ void RunnableRequestQueue::InsertSorted(ConnectionCache& conns, std::unique_ptr<
 //---------------------------------------------------------------------------------------
 void RunnableRequestQueue::IfReadyForAutoShutdown(std::function<void()> shutdownCb) {
     recursive_guard_t lock(m_mutex);
-    if (m_shutdownWhenIdleFor == 0s || !m_requests.empty() || m_state.load() != State::Running)
+    if (m_shutdownWhenIdleFor == 0s || !m_requests.Empty() || !m_parked.empty() || m_state.load() != State::Running)
         return;
 
     const auto elapsedSinceLastRequest = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - m_lastDequeueTime);
@@ -795,11 +1023,10 @@ void RunnableRequestQueue::IfReadyForAutoShutdown(std::function<void()> shutdown
 // @bsimethod
 //---------------------------------------------------------------------------------------
 std::unique_ptr<RunnableRequestBase> RunnableRequestQueue::Dequeue() {
-    if (m_requests.empty())
+    if (m_requests.Empty())
         return nullptr;
 
-    auto req = std::move(m_requests.back());
-    m_requests.pop_back();
+    auto req = m_requests.Pop();
     m_lastDequeueTime  = std::chrono::steady_clock::now();
     if (req->IsReady()) {
         log_trace("%s dequeued request [id=%" PRIu32 "]", GetTimestamp().c_str(), req->GetId());
@@ -810,10 +1037,8 @@ std::unique_ptr<RunnableRequestBase> RunnableRequestQueue::Dequeue() {
         m_lastDelayedQueryId = req->GetId();
         log_trace("%s dequeued request [id=%" PRIu32 "] has delay and will be deferred and put back in queue.",GetTimestamp().c_str(), req->GetId());
     }
-    if (m_requests.size() > 1)
-        m_requests.insert(m_requests.end() - 1, std::move(req));
-    else
-        m_requests.push_back(std::move(req));
+    // goes to the back of its client's queue, so other ready requests are served first.
+    m_requests.Push(std::move(req));
 
     std::this_thread::yield();
     return nullptr;
@@ -825,7 +1050,7 @@ std::unique_ptr<RunnableRequestBase> RunnableRequestQueue::Dequeue() {
 std::unique_ptr<RunnableRequestBase> RunnableRequestQueue::WaitForDequeue() {
     std::unique_lock<std::recursive_mutex> lock(m_mutex);
     m_cond.wait(lock, [&](){
-        return !m_requests.empty() || m_state.load() != State::Running;
+        return !m_requests.Empty() || m_state.load() != State::Running;
     });
 
     // If paused, wait until state changes to something else, if we return immediately, this would
@@ -884,7 +1109,7 @@ QueryResponse::Future RunnableRequestQueue::Enqueue(ConnectionCache& conns, Quer
     auto adjustedQuota = AdjustQuota(request->GetQuota());
     auto runnableReq = std::unique_ptr<RunnableRequestBase>(new RunnableRequestWithPromise(*this, std::move(request), adjustedQuota, GetNextId()));
     auto future = ((RunnableRequestWithPromise*)runnableReq.get())->GetFuture();
-    if (m_requests.size() >= m_maxQueueSize) {
+    if (Count() >= m_maxQueueSize) {
         log_warn("%s queue is full, rejecting request [id=%" PRIu32 "]", GetTimestamp().c_str(), runnableReq->GetId());
         runnableReq->SetResponse(RunnableRequestBase::CreateQueueFullResponse());
     } else  {
@@ -920,7 +1145,7 @@ void RunnableRequestQueue::Enqueue(ConnectionCache& conns, QueryRequest::Ptr req
 
     auto adjustedQuota = AdjustQuota(request->GetQuota());
     auto runnableReq = std::unique_ptr<RunnableRequestBase>(new RunnableRequestWithCallback(*this, std::move(request), adjustedQuota, GetNextId(), onComplete));
-    if (m_requests.size() >= m_maxQueueSize) {
+    if (Count() >= m_maxQueueSize) {
         log_warn("%s queue is full, rejecting request [id=%" PRIu32 "]", GetTimestamp().c_str(), runnableReq->GetId());
         runnableReq->SetResponse(RunnableRequestBase::CreateQueueFullResponse());
     } else  {
@@ -943,7 +1168,14 @@ void RunnableRequestQueue::Enqueue(ConnectionCache& conns, QueryRequest::Ptr req
 //---------------------------------------------------------------------------------------
 uint32_t RunnableRequestQueue::Count() {
     recursive_guard_t lock(m_mutex);
-    return (uint32_t)m_requests.size();
+    return (uint32_t)m_requests.Size();
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ConcurrentQueryMgr::ExecutionStats RunnableRequestQueue::GetStats() {
+    return ConcurrentQueryMgr::ExecutionStats(m_queueWait.Snapshot(), m_execution.Snapshot(), Count(), m_planCacheHits.load(), m_planCacheMisses.load());
 }
 
 //---------------------------------------------------------------------------------------
@@ -957,10 +1189,16 @@ bool RunnableRequestQueue::Stop() {
     m_state.store(State::Stop);
 
     recursive_guard_t lock(m_mutex);
-    for(auto & request : m_requests) {
-        log_error("%s cancelling request [id=%" PRIu32 "] due to shutdown.", GetTimestamp().c_str(), request->GetId());
-        request->SetResponse(request->CreateShutDownResponse());
+    m_requests.ForEach([&](RunnableRequestBase& request) {
+        log_error("%s cancelling request [id=%" PRIu32 "] due to shutdown.", GetTimestamp().c_str(), request.GetId());
+        request.SetResponse(request.CreateShutDownResponse());
+    });
+    // parked streams hold worker connections, which must be released before the executor closes them.
+    for (auto& parked : m_parked) {
+        log_error("%s cancelling parked stream [id=%" PRIu32 "] due to shutdown.", GetTimestamp().c_str(), parked.first);
+        parked.second->SetResponse(parked.second->CreateShutDownResponse());
     }
+    m_parked.clear();
     m_cond.notify_all();
     log_trace("%s request queue stopped.", GetTimestamp().c_str());
     return true;
@@ -971,14 +1209,7 @@ bool RunnableRequestQueue::Stop() {
 //---------------------------------------------------------------------------------------
 void RunnableRequestQueue::RemoveIf (std::function<bool(RunnableRequestBase&)> predicate) {
     recursive_guard_t lock(m_mutex);
-    auto it = m_requests.begin();
-    while(it != m_requests.end()) {
-        if (predicate(*(*it))) {
-            it = m_requests.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    m_requests.RemoveIf(predicate);
 }
 
 //---------------------------------------------------------------------------------------
@@ -987,26 +1218,136 @@ void RunnableRequestQueue::RemoveIf (std::function<bool(RunnableRequestBase&)> p
 bool RunnableRequestQueue::CancelRequest(uint32_t id) {
     recursive_guard_t lock(m_mutex);
     log_trace("%s request to cancel [id=%" PRIu32 "]", GetTimestamp().c_str(), id);
-    auto it = std::find_if(std::begin(m_requests), std::end(m_requests), [id](std::unique_ptr<RunnableRequestBase>& v){
-        return v->GetId() == id;
-    });
-    if (it != std::end(m_requests)) {
+    auto request = m_requests.Remove(id);
+    if (request == nullptr) {
+        auto it = m_parked.find(id);
+        if (it != m_parked.end()) {
+            request = std::move(it->second);
+            m_parked.erase(it);
+        }
+    }
+    if (request != nullptr) {
         log_trace("%s request [id=%" PRIu32 "] cancelled", GetTimestamp().c_str(), id);
-        (*it)->SetResponse((*it)->CreateCancelResponse());
-        m_requests.erase(it);
+        request->SetResponse(request->CreateCancelResponse());
         return true;
     }
     return false;
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+std::shared_ptr<void> RunnableRequestQueue::MakeStreamHold(uint32_t id) {
+    auto resumer = m_resumer;
+    return std::shared_ptr<void>(nullptr, [resumer, id](void*) { resumer->Resume(id); });
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void RunnableRequestQueue::Requeue(std::unique_ptr<RunnableRequestBase> request) {
+    log_trace("%s resuming stream [id=%" PRIu32 "]", GetTimestamp().c_str(), request->GetId());
+    request->Unpark();
+    // goes to the back of its client's queue, so other requests get a turn between chunks.
+    m_requests.Push(std::move(request));
+    m_cond.notify_one();
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void RunnableRequestQueue::Park(std::unique_ptr<RunnableRequestBase> request) {
+    recursive_guard_t lock(m_mutex);
+    const auto id = request->GetId();
+    if (m_state.load() == State::Stop) {
+        log_error("%s cancelling parked stream [id=%" PRIu32 "] due to shutdown.", GetTimestamp().c_str(), id);
+        request->SetResponse(request->CreateShutDownResponse());
+        return;
+    }
+    if (m_released.erase(id) != 0) {
+        Requeue(std::move(request));
+        return;
+    }
+    log_trace("%s parked stream [id=%" PRIu32 "] until its chunk is released", GetTimestamp().c_str(), id);
+    m_parked[id] = std::move(request);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void RunnableRequestQueue::Resume(uint32_t id) {
+    recursive_guard_t lock(m_mutex);
+    auto it = m_parked.find(id);
+    if (it == m_parked.end()) {
+        // the chunk was released before the worker that delivered it got to park the request.
+        if (m_state.load() != State::Stop)
+            m_released.insert(id);
+        return;
+    }
+    auto request = std::move(it->second);
+    m_parked.erase(it);
+    Requeue(std::move(request));
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void StreamResumer::Resume(uint32_t id) {
+    recursive_guard_t lock(m_mutex);
+    if (m_queue != nullptr)
+        m_queue->Resume(id);
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
 void RunnableRequestBase::SetResponse(QueryResponse::Ptr response) {
     if (m_isCompleted)
         throw std::runtime_error("already responded");
+    if (m_isDequeued)
+        m_queue.RecordExecution(GetCpuTime());
     try { _SetResponse(response); } catch(std::exception) {}
     m_isCompleted = true;
+    // ends the read transaction and unpins the connection of a stream.
+    m_stream = nullptr;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void RunnableRequestBase::SetChunk(QueryResponse::Ptr response) {
+    if (m_isCompleted)
+        throw std::runtime_error("already responded");
+    BeAssert(SupportsChunks());
+    // the request parks once the chunk is out; it resumes when the last reference to this handle is released,
+    // which is when the callback returns unless the consumer holds on to it (QueryResponse::HoldStream).
+    std::shared_ptr<void> hold;
+    if (CanPark()) {
+        hold = m_queue.MakeStreamHold(m_id);
+        response->m_streamHold = hold;
+    }
+    try { _SetChunk(response); } catch(std::exception) {}
+    m_quotaStartedOn = std::chrono::steady_clock::now();
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void RunnableRequestBase::Park(std::shared_ptr<CachedQueryAdaptor> adaptor, ECSqlColumnarWriter& writer) {
+    BeAssert(CanPark());
+    if (m_stream == nullptr)
+        m_stream = std::make_unique<StreamCursor>(std::move(adaptor), std::move(writer));
+    m_parked = true;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void RunnableRequestBase::OnDequeued() {
+    m_isDequeued = true;
+    m_dequeuedOn = std::chrono::steady_clock::now();
+    // a resumed stream waited since it was put back into the queue, not since it was submitted.
+    m_queue.RecordQueueWait(std::chrono::duration_cast<std::chrono::microseconds>(m_dequeuedOn - m_quotaStartedOn));
 }
 
 
@@ -1258,6 +1599,8 @@ Utf8CP QueryResponse::StatusToString(QueryResponse::Status status) {
             return "Timeout";
         case QueryResponse::Status::ShuttingDown:
             return "ShuttingDown";
+        case QueryResponse::Status::Chunk:
+            return "Chunk";
     };
     return "Unknow QueryResponse::Status code";
 }
@@ -1288,20 +1631,56 @@ void QueryHelper::Execute(CachedQueryAdaptor& cachedAdaptor, RunnableRequestBase
     options.SetConvertClassIdsToClassNames(classIdToClassNames);
     options.SetUseJsNames(request.GetValueFormat() == ECSqlRequest::ECSqlValueFormat::JsNames);
     options.SetDoNotConvertClassIdsToClassNamesWhenAliased(doNotConvertClassIdsToClassNamesWhenAliased);
+    // a resumed stream continues with the next row; its metadata went out with the first chunk.
+    auto stream = runnableRequest.GetStream();
     ECSqlRowProperty::List props;
-    if (includeMetaData) {
+    if (includeMetaData && stream == nullptr) {
         adaptor.GetMetaData(props ,stmt);
     }
     uint32_t row_count = 0;
+    const bool binary = request.GetResultFormat() == ECSqlRequest::ResultFormat::Binary;
+    const bool streaming = request.IsStreaming() && runnableRequest.SupportsChunks();
+    const auto chunkRows = request.GetChunkRows();
+    const auto chunkBytes = request.GetChunkBytes();
+    ECSqlColumnarWriter ownWriter;
+    ECSqlColumnarWriter& writer = stream != nullptr ? stream->GetWriter() : ownWriter;
     std::string& result = cachedAdaptor.ClearAndGetCachedString();
-    result.reserve(QUERY_WORKER_RESULT_RESERVE_BYTES);
-    result.append("[");
+    if (binary) {
+        if (stream == nullptr)
+            writer.Init(stmt, adaptor);
+    } else {
+        result.reserve(QUERY_WORKER_RESULT_RESERVE_BYTES);
+        result.append("[");
+    }
     auto setResult = [&](status st) {
-        result.append("]");
-        if (runnableRequest.IsCancelled())
+        if (runnableRequest.IsCancelled()) {
             runnableRequest.SetResponse(runnableRequest.CreateCancelResponse());
-        else
-            runnableRequest.SetResponse(runnableRequest.CreateECSqlResponse(result, props, row_count, st == status::done));
+        } else if (binary) {
+            std::vector<uint8_t> buffer;
+            writer.Encode(buffer);
+            runnableRequest.SetResponse(runnableRequest.CreateECSqlResponse(buffer, props, row_count, st == status::done ? QueryResponse::Status::Done : QueryResponse::Status::Partial));
+        } else {
+            result.append("]");
+            runnableRequest.SetResponse(runnableRequest.CreateECSqlResponse(result, props, row_count, st == status::done ? QueryResponse::Status::Done : QueryResponse::Status::Partial));
+        }
+    };
+    // hand the rows buffered so far to the caller and start a new chunk. The statement is left
+    // positioned where it is, so the next Step() continues on the same connection and bindings,
+    // either right away or after the request was parked. Metadata is only sent with the first chunk.
+    auto setChunk = [&]() {
+        if (binary) {
+            std::vector<uint8_t> buffer;
+            writer.Encode(buffer);
+            runnableRequest.SetChunk(runnableRequest.CreateECSqlResponse(buffer, props, row_count, QueryResponse::Status::Chunk));
+            writer.Clear();
+        } else {
+            result.append("]");
+            runnableRequest.SetChunk(runnableRequest.CreateECSqlResponse(result, props, row_count, QueryResponse::Status::Chunk));
+            result.clear();
+            result.append("[");
+        }
+        props.clear();
+        row_count = 0;
     };
     auto setError = [&] (QueryResponse::Status status, std::string err) {
         runnableRequest.SetResponse(runnableRequest.CreateErrorResponse(status, err));
@@ -1325,32 +1704,55 @@ void QueryHelper::Execute(CachedQueryAdaptor& cachedAdaptor, RunnableRequestBase
     // go over each row and serialize result
     auto rc = stmt.Step();
     while (rc == BE_SQLITE_ROW) {
-        auto& rowsDoc = cachedAdaptor.ClearAndGetCachedJsonDocument();
-        BeJsValue rows(rowsDoc);
-        if (adaptor.RenderRowAsArray(rows, ECSqlStatementRow(stmt)) != SUCCESS) {
-            setError(QueryResponse::Status::Error_ECSql_RowToJsonFailed, "failed to serialize ecsql statement row to json");
-            return;
-        } else {
+        if (binary) {
+            if (writer.AppendRow(stmt, cachedAdaptor) != SUCCESS) {
+                setError(QueryResponse::Status::Error_ECSql_RowToJsonFailed, "failed to serialize ecsql statement row to binary");
+                return;
+            }
             row_count = row_count + 1;
-            if (row_count == 1) {
-                result.append(rows.Stringify());
+        } else {
+            auto& rowsDoc = cachedAdaptor.ClearAndGetCachedJsonDocument();
+            BeJsValue rows(rowsDoc);
+            if (adaptor.RenderRowAsArray(rows, ECSqlStatementRow(stmt)) != SUCCESS) {
+                setError(QueryResponse::Status::Error_ECSql_RowToJsonFailed, "failed to serialize ecsql statement row to json");
+                return;
             } else {
-                result.append(",").append(rows.Stringify());
+                row_count = row_count + 1;
+                if (row_count == 1) {
+                    result.append(rows.Stringify());
+                } else {
+                    result.append(",").append(rows.Stringify());
+                }
             }
         }
 
-        if (result.size() > V8_MAX_STRING_SIZE) {
+        const auto resultSize = binary ? writer.GetSize() : result.size();
+        if (resultSize > V8_MAX_STRING_SIZE) {
             cachedAdaptor.ReleaseMemory();
             log_trace("%s result size exceeded V8_MAX_STRING_SIZE [id=%" PRIu32 "]",GetTimestamp().c_str(), runnableRequest.GetId());
             setError(QueryResponse::Status::Error, "result size exceeded maximum allowed size");
             return;
         }
 
-        if (runnableRequest.IsTimeOrMemoryExceeded(result)) {
+        if (runnableRequest.IsTimeOrMemoryExceeded(resultSize)) {
             log_trace("%s time or memory exceeded for request [id=%" PRIu32 "]",GetTimestamp().c_str(), runnableRequest.GetId());
             setResult(status::partial);
             return;
         }
+
+        if (streaming && ((chunkRows != 0 && row_count >= chunkRows) || (chunkBytes != 0 && resultSize >= chunkBytes))) {
+            if (runnableRequest.IsCancelled()) {
+                setResult(status::partial);
+                return;
+            }
+            setChunk();
+            if (runnableRequest.CanPark()) {
+                // give the worker back while the consumer processes the chunk; stepping continues from here
+                // once the request is dequeued again (see RunnableRequestQueue::Park).
+                runnableRequest.Park(cachedAdaptor.Shared(), writer);
+                return;
+            }
+        }
         rc = stmt.Step();
     }
 
@@ -1369,6 +1771,219 @@ void QueryHelper::Execute(CachedQueryAdaptor& cachedAdaptor, RunnableRequestBase
         setResult(status::done);
     }
 }
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void ECSqlColumnarWriter::Init(ECSqlStatement const& stmt, ECSqlRowAdaptor const& adaptor) {
+    m_columns.clear();
+    m_strings.clear();
+    m_stringIndex.clear();
+    m_rowCount = 0;
+    m_size = 0;
+    auto& options = adaptor.GetOptions();
+    const int count = stmt.GetColumnCount();
+    m_columns.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        auto prop = stmt.GetColumnInfo(i).GetProperty();
+        auto prim = prop != nullptr ? prop->GetAsPrimitiveProperty() : nullptr;
+        if (prim == nullptr) {
+            m_columns.emplace_back(ColumnKind::Json, false);
+            continue;
+        }
+        switch (prim->GetType()) {
+            case ECN::PRIMITIVETYPE_Boolean:
+                m_columns.emplace_back(ColumnKind::Boolean, false);
+                break;
+            case ECN::PRIMITIVETYPE_Integer:
+                m_columns.emplace_back(ColumnKind::Int64, false);
+                break;
+            case ECN::PRIMITIVETYPE_Double:
+                m_columns.emplace_back(ColumnKind::Double, false);
+                break;
+            case ECN::PRIMITIVETYPE_String:
+                m_columns.emplace_back(ColumnKind::String, false);
+                break;
+            case ECN::PRIMITIVETYPE_DateTime:
+                m_columns.emplace_back(ColumnKind::String, true);
+                break;
+            case ECN::PRIMITIVETYPE_Long: {
+                // mirror ECSqlRowAdaptor::RenderLong(): class ids may be rendered as class names, other ids are raw ids.
+                const auto extendedType = ExtendedTypeHelper::GetExtendedType(prim->GetExtendedTypeName());
+                const auto isClassId = Enum::Intersects<ExtendedTypeHelper::ExtendedType>(extendedType, ExtendedTypeHelper::ExtendedType::ClassIds);
+                const auto isId = Enum::Intersects<ExtendedTypeHelper::ExtendedType>(extendedType, ExtendedTypeHelper::ExtendedType::Ids);
+                if (isClassId && (options.ConvertClassIdsToClassNames() || options.UseJsNames()))
+                    m_columns.emplace_back(ColumnKind::String, true);
+                else if (isClassId || isId)
+                    m_columns.emplace_back(ColumnKind::Id, false);
+                else
+                    m_columns.emplace_back(ColumnKind::Int64, false);
+                break;
+            }
+            default:
+                m_columns.emplace_back(ColumnKind::Json, false);
+                break;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void ECSqlColumnarWriter::Clear() {
+    for (auto& col : m_columns) {
+        col.m_validity.clear();
+        col.m_values.clear();
+    }
+    m_strings.clear();
+    m_stringIndex.clear();
+    m_rowCount = 0;
+    m_size = 0;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void ECSqlColumnarWriter::Append(Column& col, uint64_t value, bool isNull) {
+    if (m_rowCount % 8 == 0)
+        col.m_validity.push_back(0);
+    if (!isNull)
+        col.m_validity.back() |= (uint8_t)(1u << (m_rowCount % 8));
+    col.m_values.push_back(isNull ? 0 : value);
+    m_size += sizeof(uint64_t);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+uint32_t ECSqlColumnarWriter::AddString(Utf8CP str, size_t len) {
+    auto it = m_stringIndex.find(std::string(str, len));
+    if (it != m_stringIndex.end())
+        return it->second;
+    const auto index = (uint32_t)m_strings.size();
+    m_strings.emplace_back(str, len);
+    m_stringIndex.emplace(m_strings.back(), index);
+    m_size += sizeof(uint32_t) + len;
+    return index;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+BentleyStatus ECSqlColumnarWriter::AppendRow(ECSqlStatement const& stmt, CachedQueryAdaptor& cachedAdaptor) {
+    auto& adaptor = cachedAdaptor.GetJsonAdaptor();
+    auto renderValue = [&](IECSqlValue const& val, Utf8String& out) -> bool {
+        // render into an array element so the cached document stays an array and can be cleared cheaply.
+        BeJsValue doc(cachedAdaptor.ClearAndGetCachedJsonDocument());
+        auto jsVal = doc.appendValue();
+        if (adaptor.RenderValue(jsVal, val) != SUCCESS)
+            return false;
+        if (jsVal.isNull())
+            out.clear();
+        else
+            out = jsVal.isString() ? Utf8String(jsVal.asCString()) : jsVal.Stringify();
+        return true;
+    };
+
+    const int count = (int)m_columns.size();
+    Utf8String rendered;
+    for (int i = 0; i < count; ++i) {
+        auto& col = m_columns[i];
+        IECSqlValue const& val = stmt.GetValue(i);
+        if (val.IsNull()) {
+            Append(col, 0, true);
+            continue;
+        }
+        switch (col.m_kind) {
+            case ColumnKind::Boolean:
+                Append(col, val.GetBoolean() ? 1 : 0, false);
+                break;
+            case ColumnKind::Int64:
+                Append(col, (uint64_t)val.GetInt64(), false);
+                break;
+            case ColumnKind::Double: {
+                const double d = val.GetDouble();
+                uint64_t bits;
+                memcpy(&bits, &d, sizeof(bits));
+                Append(col, bits, false);
+                break;
+            }
+            case ColumnKind::Id: {
+                const auto id = val.GetUInt64();
+                Append(col, id, id == 0);
+                break;
+            }
+            case ColumnKind::String:
+                if (!col.m_render) {
+                    Utf8CP str = val.GetText();
+                    Append(col, AddString(str, strlen(str)), false);
+                    break;
+                }
+                [[fallthrough]];
+            case ColumnKind::Json: {
+                if (!renderValue(val, rendered))
+                    return ERROR;
+                if (rendered.empty())
+                    Append(col, 0, true);
+                else
+                    Append(col, AddString(rendered.c_str(), rendered.size()), false);
+                break;
+            }
+        }
+    }
+    ++m_rowCount;
+    return SUCCESS;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void ECSqlColumnarWriter::Encode(std::vector<uint8_t>& out) const {
+    auto pad = [&]() {
+        while (out.size() % 8 != 0)
+            out.push_back(0);
+    };
+    auto write = [&](void const* data, size_t len) {
+        auto bytes = static_cast<uint8_t const*>(data);
+        out.insert(out.end(), bytes, bytes + len);
+    };
+    auto writeU32 = [&](uint32_t v) { write(&v, sizeof(v)); };
+
+    out.clear();
+    out.reserve(m_size + 64 + m_columns.size() * (16 + (m_rowCount + 7) / 8));
+    writeU32(kMagic);
+    writeU32(kVersion);
+    writeU32(m_rowCount);
+    writeU32((uint32_t)m_columns.size());
+    writeU32((uint32_t)m_strings.size());
+    writeU32(0);
+    for (auto& str : m_strings) {
+        writeU32((uint32_t)str.size());
+        write(str.data(), str.size());
+    }
+    pad();
+    for (auto& col : m_columns) {
+        writeU32((uint32_t)col.m_kind);
+        writeU32(0);
+        write(col.m_validity.data(), col.m_validity.size());
+        pad();
+        switch (col.m_kind) {
+            case ColumnKind::Boolean:
+                for (auto v : col.m_values)
+                    out.push_back((uint8_t)v);
+                break;
+            case ColumnKind::String:
+            case ColumnKind::Json:
+                for (auto v : col.m_values)
+                    writeU32((uint32_t)v);
+                break;
+            default:
+                write(col.m_values.data(), col.m_values.size() * sizeof(uint64_t));
+                break;
+        }
+        pad();
+    }
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -1418,6 +2033,15 @@ void QueryHelper::ReadBlob(ECDbCR conn, RunnableRequestBase& runnableRequest) {
     setError(QueryResponse::Status::Error, "BlobIO: unable to read blob due to sqlite error");
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+uint64_t QueryHelper::GetStatementHash(QueryRequest const& request) {
+    if (request.GetKind() != QueryRequest::Kind::ECSql || request.UsePrimaryConnection())
+        return 0;
+    return ECSqlStatement::GetHashCode(FormatQuery(request.GetAsConst<ECSqlRequest>().GetQuery().c_str()).c_str());
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -1480,6 +2104,15 @@ void QueryHelper::Execute(QueryAdaptorCache& adaptorCache, RunnableRequestBase&
     }
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void QueryHelper::Resume(RunnableRequestBase& runnableRequest) {
+    // the final response releases the cursor, so keep the statement alive until stepping returns.
+    auto adaptor = runnableRequest.GetStream()->GetAdaptor();
+    QueryHelper::Execute(*adaptor, runnableRequest);
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -1496,11 +2129,17 @@ QueryExecutor::QueryExecutor(RunnableRequestQueue& queue, ECDbCR primaryDb, uint
                 if (runnableQuery != nullptr) {
                     log_trace("%s executor [id=%" PRIu32 "] dequeued request [id=%" PRIu32 "]", GetTimestamp().c_str(), execId, runnableQuery->GetId());
                     std::shared_ptr<CachedConnection> conn;
-                    conn = m_connCache.GetConnection();
-                    while (conn == nullptr) {
-                        std::this_thread::yield();
-                        std::this_thread::sleep_for(1s);
-                        conn = m_connCache.GetConnection();
+                    if (runnableQuery->GetStream() != nullptr) {
+                        // a parked stream resumes on the connection its statement is positioned on.
+                        conn = runnableQuery->GetStream()->GetConnection();
+                    } else {
+                        const auto statementHash = QueryHelper::GetStatementHash(runnableQuery->GetRequest());
+                        conn = m_connCache.GetConnection(statementHash);
+                        while (conn == nullptr) {
+                            std::this_thread::yield();
+                            std::this_thread::sleep_for(1s);
+                            conn = m_connCache.GetConnection(statementHash);
+                        }
                     }
                     runnableQuery->SetExecutorContext(execId, conn->Id());
                     log_trace("%s executor [id=%" PRIu32 "] with request [id=%" PRIu32 "] is assigned connection [id=%" PRIu32 "]",
@@ -1529,9 +2168,14 @@ QueryExecutor::QueryExecutor(RunnableRequestQueue& queue, ECDbCR primaryDb, uint
                             runnableQuery.SetResponse(runnableQuery.CreateErrorResponse(
                                 QueryResponse::Status::Error,
                                 "primary-connection request must be executed synchronously on the caller thread"));
+                        } else if (runnableQuery.GetStream() != nullptr) {
+                            // still inside the read transaction the stream started with.
+                            QueryHelper::Resume(runnableQuery);
                         } else {
-                            Savepoint txn(adaptorCache.GetConnection().GetDbR(), "concurrent_query");
+                            auto txn = std::make_unique<Savepoint>(adaptorCache.GetConnection().GetDbR(), "concurrent_query");
                             QueryHelper::Execute(adaptorCache, runnableQuery);
+                            if (runnableQuery.IsParked())
+                                runnableQuery.GetStream()->SetTransaction(std::move(txn));
                         }
                         log_trace("%s executing [exec_id=%" PRIu32 ", conn_id=%" PRIu32 ", req_id=%" PRIu32 "] ended.",
                             GetTimestamp().c_str(),
@@ -1619,6 +2263,50 @@ ConcurrentQueryMgr::ConcurrentQueryMgr(ECDbCR ecdb){ m_impl = new Impl(ecdb);}
 ConcurrentQueryMgr::~ConcurrentQueryMgr(){ delete m_impl;}
 QueryResponse::Future ConcurrentQueryMgr::Enqueue(QueryRequest::Ptr request) { return m_impl->Enqueue(std::move(request)); }
 void ConcurrentQueryMgr::Enqueue(QueryRequest::Ptr request, OnCompletion onCompletion){ m_impl->Enqueue(std::move(request), onCompletion); }
+ConcurrentQueryMgr::ExecutionStats ConcurrentQueryMgr::GetStats() const { return m_impl->GetStats(); }
+void ConcurrentQueryMgr::ResetStats() { m_impl->ResetStats(); }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+std::chrono::milliseconds QueryHistogram::GetPercentile(double p) const {
+    if (m_count == 0)
+        return std::chrono::milliseconds(0);
+    const auto target = (uint64_t)std::ceil(m_count * std::min(100.0, std::max(0.0, p)) / 100.0);
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketCount - 1; ++i) {
+        seen += m_buckets[i];
+        if (seen >= target)
+            return std::chrono::milliseconds(1ll << i);
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(m_max);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void QueryHistogram::ToJs(BeJsValue v) const {
+    v.SetEmptyObject();
+    v[JCount] = (int64_t)m_count;
+    v[JTotal] = std::chrono::duration<double, std::milli>(m_total).count();
+    v[JMax] = std::chrono::duration<double, std::milli>(m_max).count();
+    auto buckets = v[JBuckets];
+    buckets.SetEmptyArray();
+    for (auto count : m_buckets)
+        buckets.appendValue() = (int64_t)count;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void ConcurrentQueryMgr::ExecutionStats::ToJs(BeJsValue v) const {
+    v.SetEmptyObject();
+    m_queueWait.ToJs(v[JQueueWait]);
+    m_execution.ToJs(v[JExecution]);
+    v[JPending] = m_pending;
+    v[JPlanCacheHits] = (int64_t)m_planCacheHits;
+    v[JPlanCacheMisses] = (int64_t)m_planCacheMisses;
+}
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -1823,6 +2511,9 @@ void QueryRequest::FromJs(BeJsConst const& val) {
     if (val.isNumericMember(JDelay)) {
         m_delay = std::chrono::milliseconds(val[JDelay].asInt());
     }
+    if (val.isStringMember(JClientKey)) {
+        m_clientKey = val[JClientKey].asCString();
+    }
 }
 
 //---------------------------------------------------------------------------------------
@@ -1885,6 +2576,15 @@ void ECSqlRequest::FromJs(BeJsConst const& val) {
     if (val.isBoolMember(JsReadOptions::JDoNotConvertClassIdsToClassNamesWhenAliased)) {
         m_doNotConvertClassIdsToClassNamesWhenAliased = val[JsReadOptions::JDoNotConvertClassIdsToClassNamesWhenAliased].asBool();
     }
+    if (val.isNumericMember(JResultFormat)) {
+        m_resultFmt = (ResultFormat)val[JResultFormat].asInt();
+    }
+    if (val.isNumericMember(JChunkRows)) {
+        m_chunkRows = val[JChunkRows].asUInt();
+    }
+    if (val.isNumericMember(JChunkBytes)) {
+        m_chunkBytes = val[JChunkBytes].asUInt();
+    }
 }
 
 //---------------------------------------------------------------------------------------
@@ -1929,7 +2629,10 @@ void ECSqlResponse::ToJs(BeJsValue& v, bool includeData) const {
     QueryResponse::ToJs(v, includeData);
     v[JRowCount] = m_rowCount;
     if (includeData) {
-        v[JData] = m_dataJson;
+        if (m_isBinary)
+            v[JData].SetBinary(GetBinaryData(), GetBinaryLength());
+        else
+            v[JData] = m_dataJson;
     }
     auto meta = v[JMeta];
     m_properties.ToJs(meta);
@@ -10,6 +10,9 @@
 #include <future>
 #include <random>
 #include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+#include <atomic>
 
 #define DEFAULT_DONOT_USE_PRIMARY_CONN_TO_PREPARE   false
 #define DEFAULT_IGNORE_DELAY                        true
@@ -87,7 +90,50 @@ struct CachedQueryAdaptor final: std::enable_shared_from_this<CachedQueryAdaptor
         }
 };
 
-struct RunnableRequestQueue;
+//=======================================================================================
+//! Accumulates ECSql rows column by column and encodes them in the layout documented on
+//! ECSqlResponse::GetBinaryData(). Column kinds are resolved once from the statement's
+//! column info, so stepping a row only copies raw values into per-column vectors; only
+//! values without a scalar representation are rendered through the ECSqlRowAdaptor.
+//! @bsiclass
+//=======================================================================================
+struct ECSqlColumnarWriter final {
+    static constexpr uint32_t kMagic = 0x42514345; // 'ECQB'
+    static constexpr uint32_t kVersion = 1;
+    enum class ColumnKind : uint32_t {
+        Boolean = 0,
+        Int64 = 1,
+        Double = 2,
+        Id = 3,
+        String = 4,
+        Json = 5,
+    };
+    private:
+        struct Column final {
+            ColumnKind m_kind;
+            bool m_render; // string value comes from the row adaptor (class names, datetimes)
+            std::vector<uint8_t> m_validity;
+            std::vector<uint64_t> m_values;
+            Column(ColumnKind kind, bool render): m_kind(kind), m_render(render) {}
+        };
+        std::vector<Column> m_columns;
+        std::vector<std::string> m_strings;
+        std::unordered_map<std::string, uint32_t> m_stringIndex;
+        uint32_t m_rowCount;
+        size_t m_size;
+        void Append(Column& col, uint64_t value, bool isNull);
+        uint32_t AddString(Utf8CP str, size_t len);
+    public:
+        ECSqlColumnarWriter(): m_rowCount(0), m_size(0) {}
+        void Init(ECSqlStatement const& stmt, ECSqlRowAdaptor const& adaptor);
+        //! Drops the buffered rows but keeps the column kinds, so streaming can start the next chunk without Init().
+        void Clear();
+        BentleyStatus AppendRow(ECSqlStatement const& stmt, CachedQueryAdaptor& cachedAdaptor);
+        uint32_t GetRowCount() const { return m_rowCount; }
+        //! Approximate size of the encoded result, used to enforce memory quota and V8 limits.
+        size_t GetSize() const { return m_size; }
+        void Encode(std::vector<uint8_t>& out) const;
+};
 
 struct RunnableRequestQueue;
 
@@ -105,6 +151,7 @@ struct QueryAdaptorCache final {
         ~QueryAdaptorCache(){}
         std::shared_ptr<CachedQueryAdaptor> TryGet(Utf8CP ecsql, bool usePrimaryConn, bool suppressLogError, ECSqlStatus& status, std::string& ecsql_error, RunnableRequestQueue& queue, bool & isShutDownInProgress);
         void Reset() { m_cache.clear(); }
+        bool Contains(uint64_t hashCode) const;
         CachedConnection& GetConnection() {return m_conn;}
 };
 
@@ -126,6 +173,61 @@ struct QueryRetryHandler final : BeSQLite::BusyRetry {
 };
 
 struct RunnableRequestBase;
+
+//=======================================================================================
+//! Lock-free recorder behind QueryHistogram. Workers record concurrently; Snapshot() may
+//! observe a sample in the count but not yet in its bucket, which is fine for telemetry.
+//! @bsiclass
+//=======================================================================================
+struct HistogramRecorder final {
+    private:
+        std::array<std::atomic<uint64_t>, QueryHistogram::kBucketCount> m_buckets;
+        std::atomic<uint64_t> m_count;
+        std::atomic<uint64_t> m_totalUs;
+        std::atomic<uint64_t> m_maxUs;
+    public:
+        HistogramRecorder() { Reset(); }
+        void Record(std::chrono::microseconds elapsed);
+        QueryHistogram Snapshot() const;
+        void Reset();
+};
+
+//=======================================================================================
+//! Pending requests ordered by priority (highest first). Within a priority level requests are
+//! grouped by client key and handed out round-robin across clients, FIFO within a client.
+//! Push/Pop/Remove are O(log n). Not thread safe; RunnableRequestQueue holds its mutex.
+//! @bsiclass
+//=======================================================================================
+struct RequestScheduler final {
+    using Request = std::unique_ptr<RunnableRequestBase>;
+    private:
+        struct Location final {
+            int32_t m_priority;
+            std::string m_client;
+            uint64_t m_seq;
+        };
+        struct Level final {
+            std::map<std::string, std::map<uint64_t, Request>> m_clients;
+            std::string m_next; // client to serve next, walks m_clients in key order
+        };
+        std::map<int32_t, Level, std::greater<int32_t>> m_levels;
+        std::unordered_map<uint32_t, Location> m_index;
+        std::unordered_multimap<std::string, uint32_t> m_restartTokens;
+        uint64_t m_nextSeq = 0;
+        bool m_ignorePriority = false;
+        Request Take(uint32_t id, Location const& loc);
+    public:
+        void SetIgnorePriority(bool ignore) { m_ignorePriority = ignore; }
+        void Push(Request request);
+        Request Pop();
+        Request Remove(uint32_t id);
+        std::vector<Request> RemoveIf(std::function<bool(RunnableRequestBase&)> predicate);
+        std::vector<Request> RemoveByRestartToken(std::string const& token);
+        void ForEach(std::function<void(RunnableRequestBase&)> cb) const;
+        size_t Size() const { return m_index.size(); }
+        bool Empty() const { return m_index.empty(); }
+};
+
 //=======================================================================================
 //! @bsiclass
 //=======================================================================================
@@ -154,6 +256,7 @@ struct CachedConnection final : std::enable_shared_from_this<CachedConnection> {
         std::unique_ptr<RunnableRequestBase> m_request;
         uint16_t m_id;
         uint32_t m_primaryFileDataVer = 0;
+        std::atomic_bool m_pinned{false};
         QueryAdaptorCache m_adaptorCache;
         QueryRetryHandler::Ptr m_retryHandler;
         void UpdateSqlFunctions(ConnectionAction);
@@ -163,7 +266,7 @@ struct CachedConnection final : std::enable_shared_from_this<CachedConnection> {
         CachedConnection& operator = (CachedConnection&&)=delete;
         std::vector<FunctionInfo> GetPrimaryDbSqlFunctions() const;
         void SetRequest(std::unique_ptr<RunnableRequestBase> request);
-        void ClearRequest();
+        std::unique_ptr<RunnableRequestBase> ClearRequest();
     public:
         CachedConnection(ConnectionCache& cache, uint16_t id):m_cache(cache), m_id(id), m_adaptorCache(*this),m_retryHandler(QueryRetryHandler::Create(60s)){}
         recursive_mutex_t& GetMutex() { return m_mutexReq; }
@@ -173,6 +276,12 @@ struct CachedConnection final : std::enable_shared_from_this<CachedConnection> {
         void Reset(bool detachDbs);
         void InterruptIf(std::function<bool(RunnableRequestBase const&)>,bool cancel);
         bool IsSync() const { return m_id == 0; }
+        // True if the statement is prepared here and still valid for the given data version of the primary.
+        bool HasCachedStatement(uint64_t hashCode, uint32_t primaryFileDataVersion) const { return m_primaryFileDataVer == primaryFileDataVersion && m_adaptorCache.Contains(hashCode); }
+        // A connection pinned by a streaming request keeps its statement and read transaction open between
+        // chunks; it is not synced or refreshed, and does not count towards the pool size.
+        bool IsPinned() const { return m_pinned.load(); }
+        void SetPinned(bool pinned) { m_pinned.store(pinned); }
         ECDb const& GetPrimaryDb() const;
         ECDb const& GetDb() const {return m_db; }
         ECDb& GetDbR() {return m_db; }
@@ -204,10 +313,28 @@ struct ConnectionCache final {
         recursive_mutex_t m_mutex;
         uint32_t m_poolSize;
         uint64_t m_primaryAttachFileHash = 0;
+        // Hash codes of ECSql that failed to prepare against the schema-source connection but prepared fine
+        // against a worker's own connection (attached table spaces). Other workers skip the doomed attempt.
+        // Reset whenever the attached dbs change.
+        std::unordered_set<uint64_t> m_ownConnectionStatements;
     public:
         ConnectionCache(ECDb const& primaryDb, uint32_t pool_size);
         ECDb const& GetPrimaryDb() const { return m_primaryDb; }
-        std::shared_ptr<CachedConnection> GetConnection();
+        // Returns an idle connection, preferring one that already has the statement with the given ECSql hash
+        // prepared against the primary's current data version, so a query repeated across the pool is parsed and
+        // prepared once per data version rather than once per worker.
+        // The preference never makes a request wait: if no idle connection has the statement, the first idle
+        // one is used and prepares its own copy, so a hot statement still spreads over the pool under load.
+        //
+        // This is affinity only; the translated SQL and the field/binder layout are not shared between
+        // connections. ECSqlStatement translation writes into its parse tree, and fields and binders are
+        // bound to the sqlite3_stmt of the connection that prepared them, so a translated statement cannot be
+        // handed to another connection without reworking ECSqlStatement. Schema lookups are already shared
+        // through the schema-source connection, which is the part of a cold prepare that does not depend on
+        // the connection.
+        std::shared_ptr<CachedConnection> GetConnection(uint64_t statementHash = 0);
+        bool RequiresOwnConnection(uint64_t statementHash);
+        void SetRequiresOwnConnection(uint64_t statementHash);
         CachedConnection& GetSyncConnection();
         // Lazily creates and returns the shared schema-source connection, or nullptr if it cannot be
         // opened (callers then fall back to preparing against the worker's own connection).
@@ -216,6 +343,29 @@ struct ConnectionCache final {
         void SyncAttachDbs();
 };
 
+//=======================================================================================
+//! Where a streaming request left off after delivering a chunk: the connection, the statement
+//! positioned on the next row, the read transaction it steps in and the binary writer's column
+//! layout. The request is parked with its cursor while the consumer processes the chunk, so the
+//! worker can serve other requests; whichever worker dequeues it next resumes stepping here.
+//! @bsiclass
+//=======================================================================================
+struct StreamCursor final {
+    private:
+        std::shared_ptr<CachedConnection> m_conn;
+        std::shared_ptr<CachedQueryAdaptor> m_adaptor;
+        std::unique_ptr<Savepoint> m_txn;
+        ECSqlColumnarWriter m_writer;
+    public:
+        StreamCursor(std::shared_ptr<CachedQueryAdaptor> adaptor, ECSqlColumnarWriter&& writer): m_adaptor(std::move(adaptor)), m_writer(std::move(writer)) {}
+        ~StreamCursor() { if (m_conn != nullptr) m_conn->SetPinned(false); }
+        std::shared_ptr<CachedConnection> GetConnection() const { return m_conn; }
+        std::shared_ptr<CachedQueryAdaptor> GetAdaptor() const { return m_adaptor; }
+        ECSqlColumnarWriter& GetWriter() { return m_writer; }
+        void SetConnection(std::shared_ptr<CachedConnection> conn) { m_conn = std::move(conn); m_conn->SetPinned(true); }
+        void SetTransaction(std::unique_ptr<Savepoint> txn) { m_txn = std::move(txn); }
+};
+
 //=======================================================================================
 //! @bsiclass
 //=======================================================================================
@@ -227,6 +377,7 @@ struct RunnableRequestBase {
         bool m_isDequeued;
         std::chrono::time_point<std::chrono::steady_clock> m_dequeuedOn;
         std::chrono::time_point<std::chrono::steady_clock> m_submittedOn;
+        std::chrono::time_point<std::chrono::steady_clock> m_quotaStartedOn; // restarts with every chunk of a stream
         RunnableRequestQueue& m_queue;
         QueryQuota m_quota;
         std::atomic_bool m_cancelled;
@@ -234,15 +385,31 @@ struct RunnableRequestBase {
         uint32_t m_connId;
         std::atomic_bool m_interrupted;
         std::chrono::milliseconds m_prepareTime;
+        std::unique_ptr<StreamCursor> m_stream;
+        bool m_parked;
         virtual void _SetResponse(QueryResponse::Ptr response) = 0;
+        virtual bool _SupportsChunks() const { return false; }
+        virtual void _SetChunk(QueryResponse::Ptr response) {}
     public:
         RunnableRequestBase(RunnableRequestQueue& queue, QueryRequest::Ptr request, QueryQuota quota, uint32_t id)
             :m_queue(queue), m_request(std::move(request)), m_id(id), m_isCompleted(false),m_dequeuedOn(0s),m_isDequeued(false), m_interrupted(false),
-             m_quota(quota), m_submittedOn(std::chrono::steady_clock::now()), m_cancelled(false), m_executorId(0), m_connId(0),m_prepareTime(0){}
+             m_quota(quota), m_submittedOn(std::chrono::steady_clock::now()), m_quotaStartedOn(m_submittedOn), m_cancelled(false), m_executorId(0), m_connId(0),m_prepareTime(0),m_parked(false){}
         virtual ~RunnableRequestBase(){}
         QueryRequest const& GetRequest() const {return *m_request;}
         uint32_t GetId() const {return m_id; }
         void SetResponse(QueryResponse::Ptr response);
+        // Delivers an intermediate response of a streaming request; the request stays incomplete.
+        void SetChunk(QueryResponse::Ptr response);
+        bool SupportsChunks() const { return _SupportsChunks(); }
+        // Only worker requests park between chunks; a primary-connection stream runs on the caller's thread and keeps stepping.
+        bool CanPark() const { return SupportsChunks() && !m_request->UsePrimaryConnection(); }
+        // Called right after a chunk was delivered: keeps the statement where it is and flags the request to be
+        // handed back to the queue instead of being completed.
+        void Park(std::shared_ptr<CachedQueryAdaptor> adaptor, ECSqlColumnarWriter& writer);
+        // Called when a parked request goes back into the queue; the time quota starts over for the next chunk.
+        void Unpark() { m_parked = false; m_quotaStartedOn = std::chrono::steady_clock::now(); }
+        bool IsParked() const { return m_parked; }
+        StreamCursor* GetStream() { return m_stream.get(); }
         void SetPrepareTime(std::chrono::milliseconds time) { m_prepareTime = time; }
         bool IsCompleted() const {return m_isCompleted; }
         RunnableRequestQueue& GetQueue() { return m_queue;}
@@ -250,11 +417,13 @@ struct RunnableRequestBase {
         void Cancel() { m_cancelled.store(true); }
         bool IsReady() const { return GetTotalTime() >= m_request->GetDelay(); }
         bool IsCancelled () const {return m_cancelled.load(); }
-        bool IsTimeExceeded() const { return m_quota.MaxTimeAllowed() == 0s ? false : GetTotalTime() >  std::chrono::duration_cast<std::chrono::milliseconds>(m_quota.MaxTimeAllowed());}
-        bool IsMemoryExceeded(std::string const& result) const { return m_quota.MaxMemoryAllowed() == 0 ? false : result.size() > m_quota.MaxMemoryAllowed(); }
-        bool IsTimeOrMemoryExceeded(std::string const& result) const { return IsTimeExceeded() || IsMemoryExceeded(result);}
+        bool IsTimeExceeded() const { return m_quota.MaxTimeAllowed() == 0s ? false : std::chrono::steady_clock::now() - m_quotaStartedOn > m_quota.MaxTimeAllowed();}
+        bool IsMemoryExceeded(size_t resultSize) const { return m_quota.MaxMemoryAllowed() == 0 ? false : resultSize > m_quota.MaxMemoryAllowed(); }
+        bool IsMemoryExceeded(std::string const& result) const { return IsMemoryExceeded(result.size()); }
+        bool IsTimeOrMemoryExceeded(size_t resultSize) const { return IsTimeExceeded() || IsMemoryExceeded(resultSize);}
+        bool IsTimeOrMemoryExceeded(std::string const& result) const { return IsTimeOrMemoryExceeded(result.size());}
         void Interrupt(CachedConnection& conn);
-        void OnDequeued()  { m_isDequeued = true; m_dequeuedOn = std::chrono::steady_clock::now(); }
+        void OnDequeued();
         uint32_t GetExecutorId() const {return m_executorId; }
         uint32_t GetConnectionId() const {return m_connId; }
         void SetExecutorContext(uint32_t executorId, uint32_t connId) { m_executorId = executorId;  m_connId = connId;}
@@ -266,7 +435,8 @@ struct RunnableRequestBase {
         QueryResponse::Ptr CreateCancelResponse() const;
         QueryResponse::Ptr CreateBlobIOResponse(std::vector<uint8_t>& meta, bool done, uint32_t rawBlobSize) const;
         QueryResponse::Ptr CreateShutDownResponse() const;
-        QueryResponse::Ptr CreateECSqlResponse(std::string& result, ECSqlRowProperty::List& meta, uint32_t rowcount, bool done) const;
+        QueryResponse::Ptr CreateECSqlResponse(std::string& result, ECSqlRowProperty::List& meta, uint32_t rowcount, QueryResponse::Status status) const;
+        QueryResponse::Ptr CreateECSqlResponse(std::vector<uint8_t>& result, ECSqlRowProperty::List& meta, uint32_t rowcount, QueryResponse::Status status) const;
         static QueryResponse::Ptr CreateQueueFullResponse() ;
 
 };
@@ -291,12 +461,29 @@ struct RunnableRequestWithCallback final : RunnableRequestBase {
     private:
         ConcurrentQueryMgr::OnCompletion m_callback;
         virtual void _SetResponse(QueryResponse::Ptr response) override { m_callback(response); }
+        virtual bool _SupportsChunks() const override { return true; }
+        virtual void _SetChunk(QueryResponse::Ptr response) override { m_callback(response); }
     public:
         RunnableRequestWithCallback(RunnableRequestQueue& queue, QueryRequest::Ptr request, QueryQuota quota, uint32_t id, ConcurrentQueryMgr::OnCompletion& callback): RunnableRequestBase(queue, std::move(request), quota, id), m_callback(callback){}
         virtual ~RunnableRequestWithCallback(){}
 };
 
 struct QueryExecutor;
+//=======================================================================================
+//! Lets the handle returned by QueryResponse::HoldStream() resume a parked stream without
+//! outliving the queue: the queue detaches itself before it is destroyed.
+//! @bsiclass
+//=======================================================================================
+struct StreamResumer final {
+    private:
+        recursive_mutex_t m_mutex;
+        RunnableRequestQueue* m_queue;
+    public:
+        explicit StreamResumer(RunnableRequestQueue& queue): m_queue(&queue) {}
+        void Resume(uint32_t id);
+        void Detach() { recursive_guard_t lock(m_mutex); m_queue = nullptr; }
+};
+
 //=======================================================================================
 //! @bsiclass
 //=======================================================================================
@@ -318,7 +505,15 @@ struct RunnableRequestQueue final {
         uint32_t m_nextId;
         uint32_t m_lastDelayedQueryId;
         QueryQuota m_quota;
-        std::vector<std::unique_ptr<RunnableRequestBase>> m_requests;
+        RequestScheduler m_requests;
+        // streams waiting for the consumer to release their last chunk, and chunks released before their stream was parked.
+        std::unordered_map<uint32_t, std::unique_ptr<RunnableRequestBase>> m_parked;
+        std::unordered_set<uint32_t> m_released;
+        std::shared_ptr<StreamResumer> m_resumer;
+        HistogramRecorder m_queueWait;
+        HistogramRecorder m_execution;
+        std::atomic<uint64_t> m_planCacheHits{0};
+        std::atomic<uint64_t> m_planCacheMisses{0};
         ECDbCR m_ecdb;
         std::chrono::seconds m_shutdownWhenIdleFor;
         std::chrono::time_point<std::chrono::steady_clock> m_lastDequeueTime;
@@ -330,9 +525,10 @@ struct RunnableRequestQueue final {
         std::unique_ptr<RunnableRequestBase> WaitForDequeue();
         QueryQuota AdjustQuota(QueryQuota const& quota) const;
         void ExecuteSynchronously(ConnectionCache&, std::unique_ptr<RunnableRequestBase>);
+        void Requeue(std::unique_ptr<RunnableRequestBase> request);
     public:
         explicit RunnableRequestQueue(ECDbCR ecdb);
-        ~RunnableRequestQueue() { Stop();}
+        ~RunnableRequestQueue() { Stop(); m_resumer->Detach(); }
         bool CancelRequest(uint32_t id);
         ECDbCR GetECDb() const { return m_ecdb; }
         void RemoveIf (std::function<bool(RunnableRequestBase&)> predicate);
@@ -340,6 +536,16 @@ struct RunnableRequestQueue final {
         QueryResponse::Future Enqueue(ConnectionCache&,QueryRequest::Ptr);
         void Enqueue(ConnectionCache&,QueryRequest::Ptr, ConcurrentQueryMgr::OnCompletion onComplete);
         uint32_t Count();
+        // Returns the handle attached to a chunk of the given request; releasing its last reference resumes the stream.
+        std::shared_ptr<void> MakeStreamHold(uint32_t id);
+        // Takes a request that parked after delivering a chunk and keeps it until its chunk is released.
+        void Park(std::unique_ptr<RunnableRequestBase> request);
+        void Resume(uint32_t id);
+        void RecordQueueWait(std::chrono::microseconds elapsed) { m_queueWait.Record(elapsed); }
+        void RecordExecution(std::chrono::microseconds elapsed) { m_execution.Record(elapsed); }
+        void RecordPlanCacheLookup(bool hit) { (hit ? m_planCacheHits : m_planCacheMisses).fetch_add(1, std::memory_order_relaxed); }
+        ConcurrentQueryMgr::ExecutionStats GetStats();
+        void ResetStats() { m_queueWait.Reset(); m_execution.Reset(); m_planCacheHits.store(0); m_planCacheMisses.store(0); }
         bool Stop();
         void IfReadyForAutoShutdown(std::function<void()> shutdownCb);
 };
@@ -370,7 +576,11 @@ struct QueryHelper final {
         static void Execute(CachedQueryAdaptor& cachedAdaptor, RunnableRequestBase& request);
         static void ReadBlob(ECDbCR conn, RunnableRequestBase& request);
     public:
+        // Hash of the ECSql the request prepares on a worker connection, or 0 if it does not prepare one there.
+        static uint64_t GetStatementHash(QueryRequest const& request);
         static void Execute(QueryAdaptorCache& adaptorCache, RunnableRequestBase& request);
+        // Continues a parked stream on the statement its cursor holds.
+        static void Resume(RunnableRequestBase& request);
 };
 
 //=======================================================================================
@@ -417,6 +627,8 @@ struct ConcurrentQueryMgr::Impl  {
         ~Impl();
         QueryResponse::Future Enqueue(QueryRequest::Ptr request) { return m_queue.Enqueue(m_executor.GetConnectionCache(), std::move(request)); }
         void Enqueue(QueryRequest::Ptr request, OnCompletion completion) { m_queue.Enqueue(m_executor.GetConnectionCache(), std::move(request), completion); }
+        ExecutionStats GetStats() { return m_queue.GetStats(); }
+        void ResetStats() { m_queue.ResetStats(); }
 
 };
 
@@ -29,6 +29,84 @@ void ArrayECSqlBinder::Initialize()
         m_json.Clear();
 
     m_rootBinder = std::make_unique<JsonValueBinder>(GetECDb(), GetTypeInfo(), m_json, m_json.GetAllocator());
+    m_idSet = nullptr;
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ECSqlStatus ArrayECSqlBinder::_BindVirtualSet(std::shared_ptr<VirtualSet> virtualSet)
+    {
+    // An IdSet binder accepts an IdSet as a whole. It is handed to the IdSet virtual table as is
+    // without a round trip through JSON.
+    auto idSet = m_binderInfo.IsForIdSet() ? std::dynamic_pointer_cast<IdSet<BeInt64Id>>(virtualSet) : nullptr;
+    if (idSet == nullptr)
+        {
+        LOG.error("Type mismatch. Only an IdSet<BeInt64Id> can be bound to an IdSet parameter.");
+        return ECSqlStatus::Error;
+        }
+
+    Initialize();
+    m_idSet = idSet;
+    return ECSqlStatus::Success;
+    }
+
+//---------------------------------------------------------------------------------------
+// Binds the ids as IdSetModule::IdRuns object via sqlite pointer binding, so that the
+// IdSet virtual table does not need to parse and sort them for every query.
+// bound is false if the JSON array contains elements that are not plain ids. They are left
+// to the virtual table to validate and report.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ECSqlStatus ArrayECSqlBinder::BindIdRuns(bool& bound)
+    {
+    bound = false;
+    bvector<uint64_t> ids;
+    if (m_json.IsArray())
+        {
+        ids.reserve(m_json.Size());
+        for (rapidjson::Value const& val : m_json.GetArray())
+            {
+            uint64_t id = 0;
+            if (val.IsUint64())
+                id = val.GetUint64();
+            else if (val.IsString())
+                BeStringUtilities::ParseUInt64(id, val.GetString());
+
+            if (id == 0)
+                return ECSqlStatus::Success;
+
+            ids.push_back(id);
+            }
+        }
+
+    std::unique_ptr<IdSetModule::IdRuns> runs = std::make_unique<IdSetModule::IdRuns>();
+    if (ids.empty() && m_idSet != nullptr)
+        {
+        // IdSet is ordered already
+        for (BeInt64Id id : *m_idSet)
+            runs->Append(id.GetValue());
+        }
+    else
+        {
+        if (m_idSet != nullptr)
+            {
+            for (BeInt64Id id : *m_idSet)
+                ids.push_back(id.GetValue());
+            }
+
+        runs->Assign(ids);
+        }
+
+    Statement& sqliteStmt = GetSqliteStatement();
+    BeAssert(GetMappedSqlParameterNames().size() == 1 && !GetMappedSqlParameterNames()[0].empty());
+    const int sqlParamIx = sqliteStmt.GetParameterIndex(GetMappedSqlParameterNames()[0].c_str());
+    const DbResult dbRes = sqliteStmt.BindPointer(sqlParamIx, runs.release(), IdSetModule::IdRuns::POINTER_TYPE, &IdSetModule::IdRuns::Destroy);
+    if (BE_SQLITE_OK != dbRes)
+        return ECSqlStatus(dbRes);
+
+    bound = true;
+    return ECSqlStatus::Success;
     }
 
 //---------------------------------------------------------------------------------------
@@ -39,9 +117,17 @@ ECSqlStatus ArrayECSqlBinder::_OnBeforeFirstStep()
     const uint32_t arrayLength = m_json.IsNull() ? 0 : (uint32_t) m_json.Size();
     // from the API we cannot tell between binding NULL and binding an empty array. so we treat them
     // the same and treat it as NULL which means to *not* validate the bounds.
-    if (arrayLength == 0)
+    if (arrayLength == 0 && m_idSet == nullptr)
         return ECSqlStatus::Success;
 
+    if (m_binderInfo.IsForIdSet())
+        {
+        bool bound = false;
+        const ECSqlStatus stat = BindIdRuns(bound);
+        if (!stat.IsSuccess() || bound)
+            return stat;
+        }
+
     const ECSqlStatus typeCheckStat = ArrayConstraintValidator::Validate(GetECDb(), GetTypeInfo(), arrayLength);
     if (!typeCheckStat.IsSuccess())
         return typeCheckStat;
@@ -72,8 +72,11 @@ private:
     rapidjson::Document m_json;
     std::unique_ptr<JsonValueBinder> m_rootBinder = nullptr;
     BinderInfo m_binderInfo;
+    //only relevant if binder is for the IdSet virtual table
+    std::shared_ptr<IdSet<BeInt64Id>> m_idSet;
 
     void Initialize();
+    ECSqlStatus BindIdRuns(bool& bound);
 
     void _OnClearBindings() override { Initialize(); }
     ECSqlStatus _OnBeforeFirstStep() override;
@@ -90,7 +93,7 @@ private:
     ECSqlStatus _BindPoint2d(DPoint2dCR value) override { return m_rootBinder->BindPoint2d(value); }
     ECSqlStatus _BindPoint3d(DPoint3dCR value) override { return m_rootBinder->BindPoint3d(value); }
     ECSqlStatus _BindText(Utf8CP stringValue, IECSqlBinder::MakeCopy makeCopy, int byteCount) override { return m_rootBinder->BindText(stringValue, makeCopy, byteCount); }
-    ECSqlStatus _BindVirtualSet(std::shared_ptr<VirtualSet> virtualSet) override { return ECSqlStatus::Error; }
+    ECSqlStatus _BindVirtualSet(std::shared_ptr<VirtualSet> virtualSet) override;
 
     IECSqlBinder& _BindStructMember(Utf8CP structMemberPropertyName) override { return m_rootBinder->operator[](structMemberPropertyName); }
     IECSqlBinder& _BindStructMember(ECN::ECPropertyId structMemberPropertyId) override { return m_rootBinder->operator[](structMemberPropertyId); }
@@ -289,6 +289,75 @@ bool Reader::Seek(InstanceReader::Position const& pos, InstanceReader::RowCallba
     return hasRow;
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+------
+size_t Reader::SeekMany(bvector<ECInstanceKey> const& keys, InstanceReader::BatchRowCallback callback) const {
+    struct Entry {
+        DbTableId m_tableId;
+        ECInstanceId m_rowId;
+        Class const* m_class;
+        size_t m_index;
+    };
+
+    BeMutexHolder holder(m_mutex);
+    std::vector<Entry> entries;
+    entries.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        auto& key = keys[i];
+        if (!key.IsValid()) {
+            continue;
+        }
+        const auto queryClass = GetOrAddClass(key.GetClassId());
+        if (queryClass == nullptr || queryClass->GetTables().empty()) {
+            continue;
+        }
+        entries.push_back(Entry{queryClass->GetTables().front()->GetId(), key.GetInstanceId(), queryClass, i});
+    }
+
+    // Classes mapped to the same table share its prepared statement, so ordering by table
+    // and then rowid visits each table once and keeps the seeks moving forward in the b-tree.
+    std::sort(entries.begin(), entries.end(), [](Entry const& lhs, Entry const& rhs) {
+        if (lhs.m_tableId != rhs.m_tableId)
+            return lhs.m_tableId < rhs.m_tableId;
+        if (lhs.m_rowId != rhs.m_rowId)
+            return lhs.m_rowId < rhs.m_rowId;
+        return lhs.m_index < rhs.m_index;
+    });
+
+    auto finder = [&](Utf8CP propName) -> std::optional<PropertyReader> {
+        auto prop = m_seekPos.GetClass()->FindProperty(propName);
+        if (prop == nullptr) {
+            return std::nullopt;
+        }
+        return PropertyReader(prop->GetValue());
+    };
+
+    // rows left over from a previous Seek() may be stale, always read them again
+    m_seekPos.Reset();
+    size_t rowCount = 0;
+    for (auto& entry : entries) {
+        bool hasRow;
+        if (m_seekPos.GetClass() == entry.m_class && m_seekPos.GetProperty() == nullptr && m_seekPos.GetRowId() == entry.m_rowId) {
+            // same key listed more than once
+            hasRow = m_seekPos.HasRow();
+        } else {
+            if (m_seekPos.GetClass() != entry.m_class || m_seekPos.GetProperty() != nullptr) {
+                m_seekPos.Reset(*entry.m_class);
+            }
+            hasRow = m_seekPos.Seek(entry.m_rowId);
+        }
+        if (!hasRow) {
+            continue;
+        }
+        ++rowCount;
+        if (!callback(entry.m_index, m_seekPos, finder)) {
+            break;
+        }
+    }
+    return rowCount;
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //+---------------+---------------+---------------+---------------+---------------+------
@@ -1195,6 +1264,13 @@ bool InstanceReader::Seek(Position const& pos, RowCallback callback, Options con
     return m_pImpl->Seek(pos, callback, opt);
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+------
+size_t InstanceReader::SeekMany(bvector<ECInstanceKey> const& keys, BatchRowCallback callback) const {
+    return m_pImpl->SeekMany(keys, callback);
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //+---------------+---------------+---------------+---------------+---------------+------
@@ -254,6 +254,7 @@ struct InstanceReader::Impl final {
             ~Reader() { }
             void Clear() const;
             bool Seek(InstanceReader::Position const& position, InstanceReader::RowCallback callback, InstanceReader::Options const& options) const;
+            size_t SeekMany(bvector<ECInstanceKey> const& keys, InstanceReader::BatchRowCallback callback) const;
             void InvalidateSeekPos(ECInstanceKey const& key);
     };
 
@@ -267,6 +268,9 @@ struct InstanceReader::Impl final {
         bool Seek(Position const& position, RowCallback callback, InstanceReader::Options const& options) const {
             return m_reader.Seek(position, callback, options);
         }
+        size_t SeekMany(bvector<ECInstanceKey> const& keys, BatchRowCallback callback) const {
+            return m_reader.SeekMany(keys, callback);
+        }
         void Reset() { m_reader.Clear(); }
         void InvalidateSeekPos(ECInstanceKey const& key) { m_reader.InvalidateSeekPos(key); }
 };
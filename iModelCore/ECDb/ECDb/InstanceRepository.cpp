@@ -8,6 +8,24 @@ USING_NAMESPACE_BENTLEY_EC
 
 BEGIN_BENTLEY_SQLITE_EC_NAMESPACE
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+static void SetupReadAdaptor(ECSqlRowAdaptor& adaptor, BeJsConst userOptions, JsFormat fmt) {
+    bool wantGeometry = userOptions["wantGeometry"].asBool(false);
+    adaptor.GetOptions().SetAbbreviateBlobs(false);
+    adaptor.GetOptions().SetConvertClassIdsToClassNames(fmt == JsFormat::JsName);
+    adaptor.GetOptions().SetUseJsNames(fmt == JsFormat::JsName);
+    adaptor.GetOptions().SetUseClassFullNameInsteadofClassName(fmt == JsFormat::JsName);
+    if(!wantGeometry){
+        adaptor.SetSkipPropertyHandler([&](ECN::ECPropertyCR prop) {
+            if(ExtendedTypeHelper::FromProperty(prop) == ExtendedTypeHelper::ExtendedType::GeometryStream)
+                return true;
+            return false;
+        });
+    }
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -94,18 +112,7 @@ DbResult InstanceRepository::Read(ECInstanceKeyCR instKey, BeJsValue outInstance
     auto rc = BE_SQLITE_ROW;
     if (!m_ecdb.GetInstanceReader().Seek(pos, [&](const InstanceReader::IRowContext& row, PropertyReader::Finder finder) {
             ECSqlRowAdaptor adaptor(m_ecdb);
-            bool wantGeometry = userOptions["wantGeometry"].asBool(false);
-            adaptor.GetOptions().SetAbbreviateBlobs(false);
-            adaptor.GetOptions().SetConvertClassIdsToClassNames(fmt == JsFormat::JsName);
-            adaptor.GetOptions().SetUseJsNames(fmt == JsFormat::JsName);
-            adaptor.GetOptions().SetUseClassFullNameInsteadofClassName(fmt == JsFormat::JsName);
-            if(!wantGeometry){
-                adaptor.SetSkipPropertyHandler([&](ECN::ECPropertyCR prop) {
-                    if(ExtendedTypeHelper::FromProperty(prop) == ExtendedTypeHelper::ExtendedType::GeometryStream)
-                        return true;
-                    return false;
-                });
-            }
+            SetupReadAdaptor(adaptor, userOptions, fmt);
             if (ERROR == adaptor.RenderRowAsObject(outInstance, row)) {
                 rc = BE_SQLITE_ERROR;
             }
@@ -128,4 +135,53 @@ DbResult InstanceRepository::Read(BeJsConst in, BeJsValue outInstance, BeJsConst
 }
 
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+DbResult InstanceRepository::ReadMany(bvector<ECInstanceKey> const& keys, BeJsValue outInstances, BeJsConst userOptions, JsFormat fmt) const {
+    BeMutexHolder _(m_mutex);
+    m_lastError.clear();
+    outInstances.SetEmptyArray();
+    for (size_t i = 0; i < keys.size(); ++i) {
+        outInstances.appendValue().SetNull();
+    }
+
+    // compact rows are arrays of property values in class property order instead of objects
+    const bool compact = userOptions["compact"].asBool(false);
+    ECSqlRowAdaptor adaptor(m_ecdb);
+    SetupReadAdaptor(adaptor, userOptions, fmt);
+    auto rc = BE_SQLITE_ROW;
+    m_ecdb.GetInstanceReader().SeekMany(keys, [&](size_t index, const InstanceReader::IRowContext& row, PropertyReader::Finder finder) {
+        auto outInstance = outInstances[(BeJsConst::ArrayIndex) index];
+        if (ERROR == adaptor.RenderRow(outInstance, row, compact)) {
+            m_lastError.Sprintf("Failed to render instance %s", keys[index].GetInstanceId().ToHexStr().c_str());
+            rc = BE_SQLITE_ERROR;
+            return false;
+        }
+        return true;
+    });
+    return rc;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+DbResult InstanceRepository::ReadMany(BeJsConst in, BeJsValue outInstances, BeJsConst userOptions, JsFormat fmt) const {
+    if (!in.isArray()) {
+        m_lastError.Sprintf("Expected an array of instance keys");
+        return BE_SQLITE_ERROR;
+    }
+    bvector<ECInstanceKey> keys;
+    keys.reserve(in.size());
+    for (BeJsConst::ArrayIndex i = 0; i < in.size(); ++i) {
+        ECInstanceKey instKey;
+        if (!m_ecdb.GetInstanceWriter().TryGetInstanceKey(instKey, in[i], fmt)) {
+            m_lastError.Sprintf("Failed to resolve instance key at index %u", i);
+            return BE_SQLITE_ERROR;
+        }
+        keys.push_back(instKey);
+    }
+    return ReadMany(keys, outInstances, userOptions, fmt);
+}
+
 END_BENTLEY_SQLITE_EC_NAMESPACE
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include <array>
 BEGIN_BENTLEY_SQLITE_EC_NAMESPACE
 using namespace std::chrono_literals;
 typedef uint32_t TaskId;
@@ -70,12 +71,14 @@ struct QueryRequest {
         static constexpr auto JUsePrimaryConn = "usePrimaryConn";
         static constexpr auto JRestartToken = "restartToken";
         static constexpr auto JDelay = "delay";
+        static constexpr auto JClientKey = "clientKey";
 
         QueryQuota m_quota;
         int32_t m_priority;
         Kind m_kind;
         bool m_usePrimaryConn;
         std::string m_restartToken;
+        std::string m_clientKey;
         std::chrono::milliseconds m_delay;
 
     public:
@@ -91,6 +94,10 @@ struct QueryRequest {
         QueryRequest& SetUsePrimaryConnection(bool usePrimary) { m_usePrimaryConn = usePrimary; return *this;}
         QueryRequest& SetRestartToken(std::string const& token) { m_restartToken = token; return *this;}
         QueryRequest& SetDelay(std::chrono::milliseconds t) noexcept { m_delay = t; return *this;}
+        //! Requests of the same priority are served round-robin across client keys (e.g. a tenant or session id),
+        //! so a burst of requests from one client cannot starve the others. Requests without a key share one slot.
+        QueryRequest& SetClientKey(std::string const& key) { m_clientKey = key; return *this;}
+        std::string const& GetClientKey() const { return m_clientKey; }
         bool UsePrimaryConnection() const noexcept {return m_usePrimaryConn;}
         std::chrono::milliseconds GetDelay() const { return m_delay; }
         QueryQuota const& GetQuota() const noexcept {return m_quota;}
@@ -263,6 +270,11 @@ struct ECSqlRequest : public QueryRequest{
         ECSqlNames = 0,
         JsNames = 1
     };
+    //! Encoding used for the rows of the ECSqlResponse.
+    enum class ResultFormat {
+        Json = 0, //!< rows are returned as a JSON array of arrays (default)
+        Binary = 1, //!< rows are returned as typed column vectors, see ECSqlResponse::GetBinaryData()
+    };
     private:
         static constexpr auto JQuery = "query";
         static constexpr auto JArgs = "args";
@@ -272,6 +284,9 @@ struct ECSqlRequest : public QueryRequest{
         static constexpr auto JConvertClassIdsToClassNames = "convertClassIdsToClassNames";
         static constexpr auto JLimit = "limit";
         static constexpr auto JValueFormat = "valueFormat";
+        static constexpr auto JResultFormat = "resultFormat";
+        static constexpr auto JChunkRows = "chunkRows";
+        static constexpr auto JChunkBytes = "chunkBytes";
         std::string m_query;
         ECSqlParams m_args;
         QueryLimit m_limit;
@@ -281,9 +296,12 @@ struct ECSqlRequest : public QueryRequest{
         bool m_convertClassIdsToClassNames;
         bool m_doNotConvertClassIdsToClassNamesWhenAliased;
         ECSqlValueFormat m_valueFmt;
+        ResultFormat m_resultFmt;
+        uint32_t m_chunkRows;
+        uint32_t m_chunkBytes;
     public:
         ECSqlRequest(std::string const& query, ECSqlParams&& args)
-            :QueryRequest(Kind::ECSql), m_query(query), m_args(std::move(args)),m_abbreviateBlobs(false), m_suppressLogErrors(false),m_includeMetaData(true), m_convertClassIdsToClassNames(false), m_doNotConvertClassIdsToClassNamesWhenAliased(true), m_valueFmt(ECSqlValueFormat::ECSqlNames){}
+            :QueryRequest(Kind::ECSql), m_query(query), m_args(std::move(args)),m_abbreviateBlobs(false), m_suppressLogErrors(false),m_includeMetaData(true), m_convertClassIdsToClassNames(false), m_doNotConvertClassIdsToClassNamesWhenAliased(true), m_valueFmt(ECSqlValueFormat::ECSqlNames), m_resultFmt(ResultFormat::Json), m_chunkRows(0), m_chunkBytes(0){}
         virtual ~ECSqlRequest(){}
         std::string const& GetQuery() const { return m_query; }
         ECSqlParams const& GetArgs() const { return  m_args; }
@@ -295,7 +313,18 @@ struct ECSqlRequest : public QueryRequest{
         bool GetDoNotConvertClassIdsToClassNamesWhenAliased() const { return m_doNotConvertClassIdsToClassNamesWhenAliased; }
         QueryLimit const& GetLimit() const {return m_limit;}
         ECSqlValueFormat GetValueFormat() const { return m_valueFmt; }
+        ResultFormat GetResultFormat() const { return m_resultFmt; }
+        uint32_t GetChunkRows() const { return m_chunkRows; }
+        uint32_t GetChunkBytes() const { return m_chunkBytes; }
+        bool IsStreaming() const { return m_chunkRows != 0 || m_chunkBytes != 0; }
         ECSqlRequest& SetValueFmt(ECSqlValueFormat fmt) noexcept { m_valueFmt = fmt; return *this;}
+        ECSqlRequest& SetResultFormat(ResultFormat fmt) noexcept { m_resultFmt = fmt; return *this;}
+        //! Stream rows as they are stepped instead of buffering the whole page: once a chunk holds maxRows rows or
+        //! maxBytes bytes (0 = no limit) it is delivered with status Chunk. Between chunks the request is parked with
+        //! its statement on the same connection and the worker thread serves other requests; see QueryResponse::HoldStream.
+        //! The time and memory quotas then apply per chunk. Only honored for requests enqueued with a completion
+        //! callback; a future receives a single response as before.
+        ECSqlRequest& SetChunkSize(uint32_t maxRows, uint32_t maxBytes) noexcept { m_chunkRows = maxRows; m_chunkBytes = maxBytes; return *this;}
         ECSqlRequest& SetLimit(QueryLimit limit) noexcept { m_limit = limit; return *this;}
         ECSqlRequest& SetAbbreviateBlobs(bool abbreviateBlobs) { m_abbreviateBlobs = abbreviateBlobs; return *this;}
         ECSqlRequest& SetSuppressLogErrors(bool suppressLogErrors) { m_suppressLogErrors = suppressLogErrors; return *this;}
@@ -315,10 +344,13 @@ struct ECSqlRequest : public QueryRequest{
         ECDB_EXPORT virtual void FromJs(BeJsConst const& val) override;
 };
 
+struct RunnableRequestBase;
+
 //=======================================================================================
 // @bsiclass
 //=======================================================================================
 struct QueryResponse : std::enable_shared_from_this<QueryResponse> {
+    friend struct RunnableRequestBase;
     using Ptr = std::shared_ptr<QueryResponse>;
     enum class Kind {
         BlobIO=0,
@@ -378,6 +410,7 @@ struct QueryResponse : std::enable_shared_from_this<QueryResponse> {
         Timeout = 4, // query time quota expired while it was in queue.
         QueueFull = 5, // could not submit the query as queue was full.
         ShuttingDown = 6, // shutdown in progress.
+        Chunk = 7, // streaming request delivered a chunk of rows, more responses follow.
         Error = 100, // generic error
         Error_ECSql_PreparedFailed = Error + 1, // ecsql prepared failed
         Error_ECSql_StepFailed = Error + 2, // ecsql step failed
@@ -395,6 +428,7 @@ struct QueryResponse : std::enable_shared_from_this<QueryResponse> {
         std::string m_error;
         Stats m_stats;
         Kind m_kind;
+        std::weak_ptr<void> m_streamHold;
     public:
         QueryResponse(Kind kind, Stats stats, Status status, std::string error): m_status(status),m_kind(kind), m_stats(stats), m_error(error) {}
         virtual ~QueryResponse(){}
@@ -403,8 +437,13 @@ struct QueryResponse : std::enable_shared_from_this<QueryResponse> {
         Stats const& GetStats() const { return m_stats; }
         bool IsDone() const noexcept { return m_status == Status::Done;}
         bool IsPartial() const noexcept { return m_status == Status::Partial;}
-        bool IsSuccess() const noexcept { return m_status == Status::Done || m_status == Status::Partial;}
+        bool IsChunk() const noexcept { return m_status == Status::Chunk;}
+        bool IsSuccess() const noexcept { return m_status == Status::Done || m_status == Status::Partial || m_status == Status::Chunk;}
         bool IsError() const noexcept {return !IsSuccess();}
+        //! Only valid while the completion callback for a Chunk response runs. The stream is parked between chunks and
+        //! by default resumes as soon as the callback returns; a consumer that hands the chunk to another thread keeps
+        //! the returned handle until it is done with the chunk, so the next one is not produced before that.
+        std::shared_ptr<void> HoldStream() const { return m_streamHold.lock(); }
         Kind GetKind() const {return m_kind;}
         ECDB_EXPORT static Utf8CP StatusToString(QueryResponse::Status status);
         template <class T>
@@ -433,14 +472,29 @@ struct ECSqlResponse final : public QueryResponse{
         static constexpr auto JRowCount = "rowCount";
         static constexpr auto JMeta = "meta";
         std::string m_dataJson;
+        std::vector<uint8_t> m_dataBinary;
         uint32_t m_rowCount;
         ECSqlRowProperty::List m_properties;
+        bool m_isBinary;
     public:
         ECSqlResponse(Stats stats, Status status, std::string error, std::string & data, ECSqlRowProperty::List& meta, uint32_t rowCount)
-            :QueryResponse(Kind::ECSql,stats, status, error), m_dataJson(std::move(data)), m_properties(std::move(meta)),m_rowCount(rowCount) {}
+            :QueryResponse(Kind::ECSql,stats, status, error), m_dataJson(std::move(data)), m_properties(std::move(meta)),m_rowCount(rowCount), m_isBinary(false) {}
+        ECSqlResponse(Stats stats, Status status, std::string error, std::vector<uint8_t>& data, ECSqlRowProperty::List& meta, uint32_t rowCount)
+            :QueryResponse(Kind::ECSql,stats, status, error), m_dataBinary(std::move(data)), m_properties(std::move(meta)),m_rowCount(rowCount), m_isBinary(true) {}
         virtual ~ECSqlResponse(){}
         ECSqlRowProperty::List const& GetProperties() const { return m_properties; }
         std::string const& asJsonString() const {return m_dataJson; }
+        //! True if the rows were encoded with ECSqlRequest::ResultFormat::Binary. asJsonString() is empty in that case.
+        bool IsBinary() const { return m_isBinary; }
+        //! Rows encoded as typed column vectors (little-endian, every section starts on an 8-byte boundary so it can be
+        //! viewed as a typed array without copying):
+        //!   header  : u32 magic 'ECQB', u32 version, u32 rowCount, u32 columnCount, u32 stringCount, u32 reserved
+        //!   strings : stringCount x (u32 byteLength, utf-8 bytes), shared by all String/Json columns
+        //!   columns : columnCount x (u32 kind, u32 reserved, validity bitmap of ceil(rowCount/8) bytes, values)
+        //! Values are u64 for Id, i64 for Int64, f64 for Double, u8 for Boolean and u32 string indices for String/Json.
+        //! A Json column holds the text the JSON format would have rendered for the value (points, structs, arrays, ...).
+        uint8_t const* GetBinaryData() const { return m_dataBinary.data(); }
+        uint32_t GetBinaryLength() const { return (uint32_t)m_dataBinary.size(); }
         uint32_t GetRowCount() const {return m_rowCount;}
         ECDB_EXPORT void virtual ToJs(BeJsValue& v, bool includeData) const override;
 };
@@ -465,6 +519,35 @@ struct BlobIOResponse : public QueryResponse {
         ECDB_EXPORT void virtual ToJs(BeJsValue& v, bool includeData) const override;
 };
 
+//=======================================================================================
+//! Latency distribution recorded by ConcurrentQueryMgr. Bucket 0 counts samples below 1ms and
+//! bucket i counts samples in [2^(i-1), 2^i) ms; the last bucket also holds everything above.
+// @bsiclass
+//=======================================================================================
+struct QueryHistogram final {
+    static constexpr int kBucketCount = 18;
+    private:
+        static constexpr auto JCount = "count";
+        static constexpr auto JTotal = "totalMs";
+        static constexpr auto JMax = "maxMs";
+        static constexpr auto JBuckets = "buckets";
+        std::array<uint64_t, kBucketCount> m_buckets;
+        uint64_t m_count;
+        std::chrono::microseconds m_total;
+        std::chrono::microseconds m_max;
+    public:
+        QueryHistogram(): m_count(0), m_total(0), m_max(0) { m_buckets.fill(0); }
+        QueryHistogram(std::array<uint64_t, kBucketCount> const& buckets, uint64_t count, std::chrono::microseconds total, std::chrono::microseconds max)
+            : m_buckets(buckets), m_count(count), m_total(total), m_max(max) {}
+        uint64_t GetCount() const { return m_count; }
+        uint64_t GetBucket(int i) const { return m_buckets[i]; }
+        std::chrono::microseconds GetTotal() const { return m_total; }
+        std::chrono::microseconds GetMax() const { return m_max; }
+        //! Upper bound of the bucket holding the p-th percentile (0 < p <= 100), or zero when empty.
+        ECDB_EXPORT std::chrono::milliseconds GetPercentile(double p) const;
+        ECDB_EXPORT void ToJs(BeJsValue) const;
+};
+
 //=======================================================================================
 // @bsiclass
 //=======================================================================================
@@ -553,6 +636,34 @@ struct ConcurrentQueryMgr final {
         ECDB_EXPORT void To(BeJsValue) const;
         void Reset() { *this = GetDefault(); }
     };
+    //! Snapshot of scheduler telemetry, used to tune Config (worker count, queue size, quota) from real load.
+    struct ExecutionStats final {
+        private:
+            static constexpr auto JQueueWait = "queueWait";
+            static constexpr auto JExecution = "execution";
+            static constexpr auto JPending = "pending";
+            static constexpr auto JPlanCacheHits = "planCacheHits";
+            static constexpr auto JPlanCacheMisses = "planCacheMisses";
+            QueryHistogram m_queueWait;
+            QueryHistogram m_execution;
+            uint32_t m_pending;
+            uint64_t m_planCacheHits;
+            uint64_t m_planCacheMisses;
+        public:
+            ExecutionStats(): m_pending(0), m_planCacheHits(0), m_planCacheMisses(0) {}
+            ExecutionStats(QueryHistogram const& queueWait, QueryHistogram const& execution, uint32_t pending, uint64_t planCacheHits, uint64_t planCacheMisses)
+                : m_queueWait(queueWait), m_execution(execution), m_pending(pending), m_planCacheHits(planCacheHits), m_planCacheMisses(planCacheMisses) {}
+            //! Time between Enqueue() and a worker picking the request up.
+            QueryHistogram const& GetQueueWait() const { return m_queueWait; }
+            //! Time between a worker picking the request up and the response being set.
+            QueryHistogram const& GetExecution() const { return m_execution; }
+            uint32_t GetPendingCount() const { return m_pending; }
+            //! ECSql requests that found their statement already prepared on the worker connection they ran on.
+            uint64_t GetPlanCacheHits() const { return m_planCacheHits; }
+            //! ECSql requests that had to parse and prepare their statement.
+            uint64_t GetPlanCacheMisses() const { return m_planCacheMisses; }
+            ECDB_EXPORT void ToJs(BeJsValue) const;
+    };
     public:
         struct Impl; // prevent circular dependency on ECDb
     private:
@@ -566,6 +677,8 @@ struct ConcurrentQueryMgr final {
         ECDB_EXPORT ~ConcurrentQueryMgr();
         ECDB_EXPORT QueryResponse::Future Enqueue(QueryRequest::Ptr);
         ECDB_EXPORT void Enqueue(QueryRequest::Ptr, OnCompletion);
+        ECDB_EXPORT ExecutionStats GetStats() const;
+        ECDB_EXPORT void ResetStats();
 
         // change config
         ECDB_EXPORT static void WithInstance(ECDb const&, std::function<void(ConcurrentQueryMgr&)>);
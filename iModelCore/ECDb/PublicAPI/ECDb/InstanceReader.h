@@ -70,6 +70,9 @@ struct InstanceReader final {
     };
 
     using RowCallback = std::function<void(IRowContext const&, PropertyReader::Finder)>;
+    //! Called for each row found by SeekMany(). The first argument is the index of the key in the input list.
+    //! Return false to stop reading the remaining keys.
+    using BatchRowCallback = std::function<bool(size_t, IRowContext const&, PropertyReader::Finder)>;
     struct Impl;
     private:
         Impl* m_pImpl;
@@ -79,6 +82,10 @@ struct InstanceReader final {
         ECDB_EXPORT explicit InstanceReader(ECDbCR);
         ECDB_EXPORT ~InstanceReader();
         ECDB_EXPORT bool Seek(Position const&, RowCallback, Options const& = Options()) const;
+        //! Read many instances in one pass. Keys are grouped by the table their class maps to and read in rowid order,
+        //! so rows are not necessarily reported in input order. Keys that do not resolve to a row are skipped.
+        //! @return number of rows reported to the callback
+        ECDB_EXPORT size_t SeekMany(bvector<ECInstanceKey> const&, BatchRowCallback) const;
         ECDB_EXPORT void Reset();
         ECDB_EXPORT void InvalidateSeekPos(ECInstanceKey const& key = ECInstanceKey());
 };
@@ -32,6 +32,9 @@ public:
     ECDB_EXPORT DbResult Delete(ECInstanceKeyCR key, BeJsConst userOptions, JsFormat inFmt) const;
     ECDB_EXPORT DbResult Read(BeJsConst key, BeJsValue out, BeJsConst userOptions, JsFormat fmt) const;
     ECDB_EXPORT DbResult Read(ECInstanceKeyCR key, BeJsValue out, BeJsConst userOptions, JsFormat fmt) const;
+    //! Read many instances into an array that matches the order of the keys. Keys that are not found are returned as null.
+    ECDB_EXPORT DbResult ReadMany(BeJsConst keys, BeJsValue out, BeJsConst userOptions, JsFormat fmt) const;
+    ECDB_EXPORT DbResult ReadMany(bvector<ECInstanceKey> const& keys, BeJsValue out, BeJsConst userOptions, JsFormat fmt) const;
 
     Utf8StringCR GetLastError() const { return m_lastError; }
 
@@ -12,6 +12,7 @@ USING_NAMESPACE_BENTLEY_EC
 #include <thread>
 #include <memory>
 #include <mutex>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
 BEGIN_ECDBUNITTESTS_NAMESPACE
@@ -67,6 +68,27 @@ struct ThreadIdFunc : BeSQLite::ScalarFunction {
     static ThreadIdFunc& Instance() { static ThreadIdFunc f; return f; }
 };
 
+// Blocks the worker that executes it until the test opens the gate, so a test can keep one
+// connection busy for exactly as long as it needs without relying on timing.
+struct GateFunc : BeSQLite::ScalarFunction {
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_entered = false;
+    bool m_open = false;
+    GateFunc() : ScalarFunction("imodel_gate", 0){}
+    void _ComputeScalar(BeSQLite::DbFunction::Context& ctx, int nArgs, BeSQLite::DbValue* args) override {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        m_entered = true;
+        m_cv.notify_all();
+        m_cv.wait(lk, [&] { return m_open; });
+        ctx.SetResultInt(1);
+    }
+    void Close() { std::lock_guard<std::mutex> lk(m_mutex); m_entered = false; m_open = false; }
+    void WaitUntilEntered() { std::unique_lock<std::mutex> lk(m_mutex); m_cv.wait(lk, [&] { return m_entered; }); }
+    void Open() { std::lock_guard<std::mutex> lk(m_mutex); m_open = true; m_cv.notify_all(); }
+    static GateFunc& Instance() { static GateFunc f; return f; }
+};
+
 struct StressTest {
     using query_request_t = ECSqlRequest::Ptr;
     using futures_t= std::vector<QueryResponse::Future>;
@@ -1718,4 +1740,341 @@ TEST_F(ConcurrentQueryFixture, CancelAfterCompletionIsSafe) {
     });
 }
 
+//---------------------------------------------------------------------------------------
+// ResultFormat::Binary returns typed column vectors instead of a JSON string. Decode the
+// buffer by hand to pin down the documented layout (header, string dictionary, per column
+// validity bitmap and values, all sections 8-byte aligned).
+//+---------------+---------------+---------------+---------------+---------------+------
+TEST_F(ConcurrentQueryFixture, BinaryResultFormat) {
+    ASSERT_EQ(BentleyStatus::SUCCESS, SetupECDb("BinaryResultFormat.ecdb", SchemaItem(
+        R"xml(<ECSchema schemaName="TestSchema" alias="ts" version="1.0" xmlns="http://www.bentley.com/schemas/Bentley.ECXML.3.1">
+                <ECEntityClass typeName="Foo">
+                    <ECProperty propertyName="s" typeName="string" />
+                    <ECProperty propertyName="i" typeName="int" />
+                    <ECProperty propertyName="d" typeName="double" />
+                    <ECProperty propertyName="b" typeName="boolean" />
+                    <ECProperty propertyName="p" typeName="point2d" />
+                </ECEntityClass>
+            </ECSchema>)xml")));
+    std::vector<ECInstanceKey> keys(3);
+    ECSqlStatement insert;
+    ASSERT_EQ(ECSqlStatus::Success, insert.Prepare(m_ecdb, "INSERT INTO ts.Foo(s,i,d,b,p) VALUES(?,?,?,?,?)"));
+    insert.BindText(1, "a", IECSqlBinder::MakeCopy::No);
+    insert.BindInt(2, 1);
+    insert.BindDouble(3, 1.5);
+    insert.BindBoolean(4, true);
+    insert.BindPoint2d(5, DPoint2d::From(1, 2));
+    ASSERT_EQ(BE_SQLITE_DONE, insert.Step(keys[0]));
+    insert.Reset();
+    insert.ClearBindings();
+    insert.BindText(1, "a", IECSqlBinder::MakeCopy::No);
+    insert.BindDouble(3, 2.5);
+    insert.BindBoolean(4, false);
+    ASSERT_EQ(BE_SQLITE_DONE, insert.Step(keys[1]));
+    insert.Reset();
+    insert.ClearBindings();
+    insert.BindText(1, "b", IECSqlBinder::MakeCopy::No);
+    insert.BindInt(2, 3);
+    insert.BindBoolean(4, true);
+    insert.BindPoint2d(5, DPoint2d::From(3, 4));
+    ASSERT_EQ(BE_SQLITE_DONE, insert.Step(keys[2]));
+    insert.Finalize();
+    m_ecdb.SaveChanges();
+
+    ConcurrentQueryMgr::WithInstance(m_ecdb, [&](auto& mgr) {
+        auto req = ECSqlRequest::MakeRequest("SELECT ECInstanceId, s, i, d, b, p FROM ts.Foo ORDER BY ECInstanceId");
+        req->SetResultFormat(ECSqlRequest::ResultFormat::Binary);
+        auto r = mgr.Enqueue(std::move(req)).Get();
+        ASSERT_EQ(r->GetStatus(), QueryResponse::Status::Done);
+        auto& resp = *((ECSqlResponse*) r.get());
+        ASSERT_TRUE(resp.IsBinary());
+        ASSERT_TRUE(resp.asJsonString().empty());
+        ASSERT_EQ(3, resp.GetRowCount());
+
+        uint8_t const* data = resp.GetBinaryData();
+        size_t pos = 0;
+        auto align = [&]() { pos = (pos + 7) & ~(size_t)7; };
+        auto readU32 = [&]() { uint32_t v; memcpy(&v, data + pos, sizeof(v)); pos += sizeof(v); return v; };
+        auto readU64 = [&]() { uint64_t v; memcpy(&v, data + pos, sizeof(v)); pos += sizeof(v); return v; };
+        ASSERT_EQ(0x42514345u, readU32());
+        ASSERT_EQ(1u, readU32());
+        ASSERT_EQ(3u, readU32());
+        ASSERT_EQ(6u, readU32());
+        const uint32_t stringCount = readU32();
+        readU32();
+        std::vector<std::string> strings;
+        for (uint32_t i = 0; i < stringCount; ++i) {
+            const auto len = readU32();
+            strings.emplace_back((char const*)data + pos, len);
+            pos += len;
+        }
+        align();
+        // 'a' is shared by two rows, plus 'b' and the two distinct rendered points.
+        ASSERT_EQ(4u, stringCount);
+
+        struct Column { uint32_t kind; uint8_t validity; size_t values; };
+        std::vector<Column> cols;
+        const uint32_t sizes[] = {1, 8, 8, 8, 4, 4}; // by kind: Boolean, Int64, Double, Id, String, Json
+        for (int c = 0; c < 6; ++c) {
+            Column col;
+            col.kind = readU32();
+            readU32();
+            col.validity = data[pos];
+            pos += 1;
+            align();
+            col.values = pos;
+            pos += 3 * sizes[col.kind];
+            align();
+            cols.push_back(col);
+        }
+        ASSERT_EQ(pos, resp.GetBinaryLength());
+
+        EXPECT_EQ(3u, cols[0].kind); // Id
+        EXPECT_EQ(4u, cols[1].kind); // String
+        EXPECT_EQ(1u, cols[2].kind); // Int64
+        EXPECT_EQ(2u, cols[3].kind); // Double
+        EXPECT_EQ(0u, cols[4].kind); // Boolean
+        EXPECT_EQ(5u, cols[5].kind); // Json
+
+        EXPECT_EQ(0x7, cols[0].validity);
+        EXPECT_EQ(0x7, cols[1].validity);
+        EXPECT_EQ(0x5, cols[2].validity);
+        EXPECT_EQ(0x3, cols[3].validity);
+        EXPECT_EQ(0x7, cols[4].validity);
+        EXPECT_EQ(0x5, cols[5].validity);
+
+        pos = cols[0].values;
+        for (auto& key : keys)
+            EXPECT_EQ(key.GetInstanceId().GetValue(), readU64());
+
+        pos = cols[1].values;
+        EXPECT_STREQ("a", strings[readU32()].c_str());
+        EXPECT_STREQ("a", strings[readU32()].c_str());
+        EXPECT_STREQ("b", strings[readU32()].c_str());
+
+        pos = cols[2].values;
+        EXPECT_EQ(1, (int64_t)readU64());
+        readU64();
+        EXPECT_EQ(3, (int64_t)readU64());
+
+        double d;
+        memcpy(&d, data + cols[3].values, sizeof(d));
+        EXPECT_EQ(1.5, d);
+        memcpy(&d, data + cols[3].values + 8, sizeof(d));
+        EXPECT_EQ(2.5, d);
+
+        EXPECT_EQ(1, data[cols[4].values]);
+        EXPECT_EQ(0, data[cols[4].values + 1]);
+        EXPECT_EQ(1, data[cols[4].values + 2]);
+
+        pos = cols[5].values;
+        BeJsDocument point;
+        point.Parse(strings[readU32()]);
+        EXPECT_EQ(1.0, point["X"].asDouble());
+        EXPECT_EQ(2.0, point["Y"].asDouble());
+        readU32();
+        point.Parse(strings[readU32()]);
+        EXPECT_EQ(3.0, point["X"].asDouble());
+        EXPECT_EQ(4.0, point["Y"].asDouble());
+    });
+}
+
+//---------------------------------------------------------------------------------------
+// With a single worker, pending requests are served by priority first and then round-robin
+// across client keys, so one client's burst cannot starve another client's request.
+//+---------------+---------------+---------------+---------------+---------------+------
+TEST_F(ConcurrentQueryFixture, PriorityAndFairShareAcrossClients) {
+    ASSERT_EQ(DbResult::BE_SQLITE_OK, SetupECDb("fair_share.ecdb"));
+    auto config = ConcurrentQueryMgr::Config::Get();
+    config.SetWorkerThreadCount(1);
+    ConcurrentQueryMgr::Config::Reset(config);
+    auto& gate = GateFunc::Instance();
+    gate.Close();
+    m_ecdb.AddFunction(gate);
+
+    std::mutex mutex;
+    std::vector<std::string> order;
+    std::atomic<int> pending(0);
+    std::promise<void> allDone;
+    ConcurrentQueryMgr::WithInstance(m_ecdb, [&](auto& mgr) {
+        auto enqueue = [&](std::string const& name, Utf8CP ecsql, std::string const& client, int32_t priority) {
+            auto req = ECSqlRequest::MakeRequest(ecsql);
+            req->SetClientKey(client);
+            req->SetPriority(priority);
+            ++pending;
+            mgr.Enqueue(std::move(req), [&, name](QueryResponse::Ptr r) {
+                EXPECT_TRUE(r->IsSuccess());
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(name);
+                if (--pending == 0)
+                    allDone.set_value();
+            });
+        };
+        // hold the only worker inside imodel_gate() while the rest of the requests queue up.
+        mgr.ResetStats();
+        enqueue("blocker", "SELECT imodel_gate()", "", 0);
+        gate.WaitUntilEntered();
+        for (int i = 0; i < 4; ++i)
+            enqueue("bulk", "SELECT 1", "bulk", 0);
+        enqueue("ui", "SELECT 1", "ui", 0);
+        enqueue("urgent", "SELECT 1", "bulk", 10);
+        EXPECT_EQ(6, mgr.GetStats().GetPendingCount());
+        EXPECT_EQ(1, mgr.GetStats().GetQueueWait().GetCount()) << "only the blocker has been dequeued";
+        gate.Open();
+        allDone.get_future().get();
+
+        ASSERT_EQ(7, order.size());
+        EXPECT_STREQ("blocker", order[0].c_str());
+        EXPECT_STREQ("urgent", order[1].c_str());
+        EXPECT_STREQ("bulk", order[2].c_str());
+        EXPECT_STREQ("ui", order[3].c_str());
+
+        auto stats = mgr.GetStats();
+        EXPECT_EQ(7, stats.GetQueueWait().GetCount());
+        EXPECT_EQ(7, stats.GetExecution().GetCount());
+        EXPECT_EQ(0, stats.GetPendingCount());
+        mgr.ResetStats();
+        EXPECT_EQ(0, mgr.GetStats().GetExecution().GetCount());
+    });
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+------
+TEST_F(ConcurrentQueryFixture, StreamingChunks) {
+    ASSERT_EQ(DbResult::BE_SQLITE_OK, SetupECDb("streaming_chunks.ecdb"));
+    const auto ecsql = "WITH RECURSIVE cnt(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM cnt WHERE x < 1050) SELECT x FROM cnt";
+    for (auto format : {ECSqlRequest::ResultFormat::Json, ECSqlRequest::ResultFormat::Binary}) {
+        std::vector<QueryResponse::Ptr> responses;
+        std::promise<void> done;
+        ConcurrentQueryMgr::WithInstance(m_ecdb, [&](auto& mgr) {
+            auto req = ECSqlRequest::MakeRequest(ecsql);
+            req->SetResultFormat(format);
+            req->SetChunkSize(100, 0);
+            mgr.Enqueue(std::move(req), [&](QueryResponse::Ptr r) {
+                responses.push_back(r);
+                if (!r->IsChunk())
+                    done.set_value();
+            });
+            done.get_future().get();
+        });
+
+        // 10 full chunks followed by the final response holding the remaining 50 rows.
+        ASSERT_EQ(11, responses.size());
+        uint32_t total = 0;
+        for (size_t i = 0; i < responses.size(); ++i) {
+            auto resp = (ECSqlResponse*) responses[i].get();
+            const auto expectedStatus = i + 1 < responses.size() ? QueryResponse::Status::Chunk : QueryResponse::Status::Done;
+            ASSERT_EQ(expectedStatus, resp->GetStatus());
+            ASSERT_TRUE(resp->IsSuccess());
+            ASSERT_EQ(i + 1 < responses.size() ? 100 : 50, resp->GetRowCount());
+            ASSERT_EQ(i == 0 ? 1 : 0, resp->GetProperties().size()) << "metadata is only sent with the first chunk";
+            if (format == ECSqlRequest::ResultFormat::Json) {
+                BeJsDocument rows;
+                rows.Parse(resp->asJsonString());
+                ASSERT_EQ(resp->GetRowCount(), rows.size());
+                ASSERT_EQ(total + 1, rows[0][0].asInt());
+            } else {
+                ASSERT_TRUE(resp->IsBinary());
+                uint32_t header[6];
+                memcpy(header, resp->GetBinaryData(), sizeof(header));
+                ASSERT_EQ(0x42514345u, header[0]); // 'ECQB'
+                ASSERT_EQ(resp->GetRowCount(), header[2]);
+            }
+            total += resp->GetRowCount();
+        }
+        ASSERT_EQ(1050, total);
+    }
+
+    // a request waiting on a future does not stream, it still receives the whole page at once.
+    ConcurrentQueryMgr::WithInstance(m_ecdb, [&](auto& mgr) {
+        auto req = ECSqlRequest::MakeRequest(ecsql);
+        req->SetChunkSize(100, 0);
+        auto r = mgr.Enqueue(std::move(req)).Get();
+        ASSERT_EQ(QueryResponse::Status::Done, r->GetStatus());
+        ASSERT_EQ(1050, ((ECSqlResponse*) r.get())->GetRowCount());
+    });
+}
+
+//---------------------------------------------------------------------------------------
+// A stream does not keep its worker between chunks: while the consumer holds on to a chunk the
+// request is parked, the only worker serves other requests, and the stream continues once the
+// chunk is released.
+//+---------------+---------------+---------------+---------------+---------------+------
+TEST_F(ConcurrentQueryFixture, StreamingParksBetweenChunks) {
+    ASSERT_EQ(DbResult::BE_SQLITE_OK, SetupECDb("streaming_parks.ecdb"));
+    auto config = ConcurrentQueryMgr::Config::Get();
+    config.SetWorkerThreadCount(1);
+    ConcurrentQueryMgr::Config::Reset(config);
+
+    std::vector<uint32_t> rowCounts;
+    std::shared_ptr<void> hold;
+    std::promise<void> firstChunk;
+    std::promise<void> done;
+    ConcurrentQueryMgr::WithInstance(m_ecdb, [&](auto& mgr) {
+        auto req = ECSqlRequest::MakeRequest("WITH RECURSIVE cnt(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM cnt WHERE x < 250) SELECT x FROM cnt");
+        req->SetChunkSize(100, 0);
+        mgr.Enqueue(std::move(req), [&](QueryResponse::Ptr r) {
+            rowCounts.push_back(((ECSqlResponse*) r.get())->GetRowCount());
+            if (rowCounts.size() == 1) {
+                hold = r->HoldStream();
+                firstChunk.set_value();
+            }
+            if (!r->IsChunk())
+                done.set_value();
+        });
+        firstChunk.get_future().get();
+        ASSERT_TRUE(hold != nullptr);
+
+        auto r = mgr.Enqueue(ECSqlRequest::MakeRequest("SELECT 1")).Get();
+        ASSERT_EQ(QueryResponse::Status::Done, r->GetStatus());
+        EXPECT_EQ(1, rowCounts.size()) << "the stream must not continue while its chunk is held";
+
+        hold = nullptr;
+        done.get_future().get();
+    });
+    ASSERT_EQ(3, rowCounts.size());
+    EXPECT_EQ(100, rowCounts[0]);
+    EXPECT_EQ(100, rowCounts[1]);
+    EXPECT_EQ(50, rowCounts[2]);
+}
+
+//---------------------------------------------------------------------------------------
+// A request is routed to an idle worker connection that already has its statement prepared,
+// instead of preparing it again on whichever connection happens to be first in the pool.
+//+---------------+---------------+---------------+---------------+---------------+------
+TEST_F(ConcurrentQueryFixture, PreparedStatementAffinity) {
+    ASSERT_EQ(DbResult::BE_SQLITE_OK, SetupECDb("statement_affinity.ecdb"));
+    auto config = ConcurrentQueryMgr::Config::Get();
+    config.SetWorkerThreadCount(2);
+    ConcurrentQueryMgr::Config::Reset(config);
+    auto& gate = GateFunc::Instance();
+    gate.Close();
+    m_ecdb.AddFunction(gate);
+
+    ConcurrentQueryMgr::WithInstance(m_ecdb, [&](auto& mgr) {
+        const auto ecsql = "SELECT COUNT(*) FROM meta.ECClassDef";
+        mgr.ResetStats();
+        // hold the first connection inside imodel_gate() so the query has to be prepared on the second one.
+        auto blocker = mgr.Enqueue(ECSqlRequest::MakeRequest("SELECT imodel_gate()"));
+        gate.WaitUntilEntered();
+        auto r = mgr.Enqueue(ECSqlRequest::MakeRequest(ecsql)).Get();
+        ASSERT_EQ(QueryResponse::Status::Done, r->GetStatus());
+        gate.Open();
+        ASSERT_EQ(QueryResponse::Status::Done, blocker.Get()->GetStatus());
+        // one prepare on each connection.
+        EXPECT_EQ(0, mgr.GetStats().GetPlanCacheHits());
+        EXPECT_EQ(2, mgr.GetStats().GetPlanCacheMisses());
+
+        // both connections are idle now. Without affinity the first connection would be picked and would
+        // prepare the query a second time; with it, the connection that has it prepared is reused.
+        for (int i = 0; i < 3; ++i) {
+            r = mgr.Enqueue(ECSqlRequest::MakeRequest(ecsql)).Get();
+            ASSERT_EQ(QueryResponse::Status::Done, r->GetStatus());
+        }
+        EXPECT_EQ(3, mgr.GetStats().GetPlanCacheHits());
+        EXPECT_EQ(2, mgr.GetStats().GetPlanCacheMisses());
+    });
+}
+
 END_ECDBUNITTESTS_NAMESPACE
@@ -1403,6 +1403,82 @@ TEST_F(ECDbIdSetVirtualTableTestFixture, SortedDeduplication) {
         ASSERT_EQ(20, count) << "Should have exactly 20 unique IDs";
         }
 }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+------
+TEST_F(ECDbIdSetVirtualTableTestFixture, BindIdSetAsIdRuns) {
+    ASSERT_EQ(BE_SQLITE_OK, SetupECDb("idset_idruns.ecdb"));
+
+    // three runs: 1-5, 100-102, 1000
+    auto idSet = std::make_shared<IdSet<BeInt64Id>>();
+    for (uint64_t id : {102, 5, 1, 3, 2, 4, 100, 1000, 101})
+        idSet->insert(BeInt64Id(id));
+
+    std::vector<int64_t> expected {1, 2, 3, 4, 5, 100, 101, 102, 1000};
+    if ("full scan over a bound IdSet")
+        {
+        ECSqlStatement stmt;
+        ASSERT_EQ(ECSqlStatus::Success, stmt.Prepare(m_ecdb, "SELECT id FROM IdSet(?)"));
+        ASSERT_EQ(ECSqlStatus::Success, stmt.BindVirtualSet(1, idSet));
+
+        std::vector<int64_t> actual;
+        while (stmt.Step() == BE_SQLITE_ROW)
+            actual.push_back(stmt.GetValueInt64(0));
+        ASSERT_EQ(expected, actual);
+
+        // rebinding must not reuse ids of the previous binding
+        stmt.Reset();
+        stmt.ClearBindings();
+        auto other = std::make_shared<IdSet<BeInt64Id>>();
+        other->insert(BeInt64Id((uint64_t) 7));
+        ASSERT_EQ(ECSqlStatus::Success, stmt.BindVirtualSet(1, other));
+        ASSERT_EQ(BE_SQLITE_ROW, stmt.Step());
+        ASSERT_EQ(7, stmt.GetValueInt64(0));
+        ASSERT_EQ(BE_SQLITE_DONE, stmt.Step());
+        }
+
+    if ("point lookup over a bound IdSet")
+        {
+        ECSqlStatement stmt;
+        ASSERT_EQ(ECSqlStatus::Success, stmt.Prepare(m_ecdb, "SELECT id FROM IdSet(?) WHERE id = ?"));
+        for (int64_t id : {0, 1, 5, 6, 99, 100, 102, 103, 999, 1000, 1001})
+            {
+            stmt.Reset();
+            ASSERT_EQ(ECSqlStatus::Success, stmt.BindVirtualSet(1, idSet));
+            ASSERT_EQ(ECSqlStatus::Success, stmt.BindInt64(2, id));
+            const bool isInSet = std::find(expected.begin(), expected.end(), id) != expected.end();
+            ASSERT_EQ(isInSet ? BE_SQLITE_ROW : BE_SQLITE_DONE, stmt.Step()) << id;
+            }
+        }
+
+    if ("array elements and the JSON argument yield the same result")
+        {
+        ECSqlStatement stmt;
+        ASSERT_EQ(ECSqlStatus::Success, stmt.Prepare(m_ecdb, "SELECT a.id FROM IdSet(?) a JOIN IdSet('[1000,\"0x66\",5,4,3,2,1,100,101]') b ON a.id = b.id"));
+        IECSqlBinder& arrayBinder = stmt.GetBinder(1);
+        for (auto it = expected.rbegin(); it != expected.rend(); ++it)
+            ASSERT_EQ(ECSqlStatus::Success, arrayBinder.AddArrayElement().BindInt64(*it));
+
+        std::vector<int64_t> actual;
+        while (stmt.Step() == BE_SQLITE_ROW)
+            actual.push_back(stmt.GetValueInt64(0));
+        std::sort(actual.begin(), actual.end());
+        ASSERT_EQ(expected, actual);
+        }
+
+    if ("only IdSets can be bound as virtual set")
+        {
+        struct EvenIds final : VirtualSet
+            {
+            bool _IsInSet(int nVals, DbValue const* vals) const override { return vals[0].GetValueInt64() % 2 == 0; }
+            };
+
+        ECSqlStatement stmt;
+        ASSERT_EQ(ECSqlStatus::Success, stmt.Prepare(m_ecdb, "SELECT id FROM IdSet(?)"));
+        ASSERT_EQ(ECSqlStatus::Error, stmt.BindVirtualSet(1, std::make_shared<EvenIds>()));
+        }
+}
 #if 0
 //---------------------------------------------------------------------------------------
 // @bsimethod
@@ -3081,6 +3081,92 @@ TEST_F(InstanceReaderFixture, InstanceReaderForceSeek) {
     }, opt));
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+------
+TEST_F(InstanceReaderFixture, SeekMany) {
+    ASSERT_EQ(BentleyStatus::SUCCESS, SetupECDb("InstanceReaderSeekMany.ecdb", SchemaItem(R"xml(<?xml version="1.0" encoding="UTF-8"?>
+        <ECSchema schemaName="TestSchema" alias="ts" version="1.0.0" xmlns="http://www.bentley.com/schemas/Bentley.ECXML.3.1">
+            <ECSchemaReference name="ECDbMap" version="02.00" alias="ecdbmap" />
+            <ECEntityClass typeName="Base" modifier="None">
+                <ECCustomAttributes>
+                    <ClassMap xmlns="ECDbMap.02.00.00">
+                        <MapStrategy>TablePerHierarchy</MapStrategy>
+                    </ClassMap>
+                </ECCustomAttributes>
+                <ECProperty propertyName="Name" typeName="string" />
+            </ECEntityClass>
+            <ECEntityClass typeName="Sub" modifier="None">
+                <BaseClass>Base</BaseClass>
+                <ECProperty propertyName="Num" typeName="int" />
+            </ECEntityClass>
+            <ECEntityClass typeName="Other" modifier="None">
+                <ECProperty propertyName="Name" typeName="string" />
+            </ECEntityClass>
+        </ECSchema>
+    )xml")));
+
+    bvector<ECInstanceKey> keys;
+    auto insert = [&](Utf8CP ecsql, Utf8CP name) {
+        ECSqlStatement stmt;
+        ASSERT_EQ(ECSqlStatus::Success, stmt.Prepare(m_ecdb, ecsql));
+        stmt.BindText(1, name, IECSqlBinder::MakeCopy::No);
+        ECInstanceKey key;
+        ASSERT_EQ(BE_SQLITE_DONE, stmt.Step(key));
+        keys.push_back(key);
+    };
+    for (int i = 0; i < 5; ++i) {
+        insert("INSERT INTO ts.Base(Name) VALUES(?)", SqlPrintfString("base%d", i).GetUtf8CP());
+        insert("INSERT INTO ts.Sub(Name,Num) VALUES(?,1)", SqlPrintfString("sub%d", i).GetUtf8CP());
+        insert("INSERT INTO ts.Other(Name) VALUES(?)", SqlPrintfString("other%d", i).GetUtf8CP());
+    }
+    m_ecdb.SaveChanges();
+
+    // shuffle, add a duplicate and a key that does not exist
+    std::reverse(keys.begin(), keys.end());
+    keys.push_back(keys.front());
+    keys.push_back(ECInstanceKey(keys.front().GetClassId(), ECInstanceId(UINT64_C(9999))));
+
+    std::vector<Utf8String> names(keys.size());
+    const auto otherClassId = m_ecdb.Schemas().GetClassId("ts", "Other");
+    std::vector<std::pair<bool, ECInstanceId>> seenRows;
+    auto rowCount = m_ecdb.GetInstanceReader().SeekMany(keys, [&](size_t index, InstanceReader::IRowContext const& row, PropertyReader::Finder finder) {
+        EXPECT_LT(index, keys.size());
+        auto nameProp = finder("Name");
+        EXPECT_TRUE(nameProp.has_value());
+        names[index] = nameProp->GetReader().GetText();
+        EXPECT_EQ(keys[index].GetInstanceId(), row.GetValue(0).GetId<ECInstanceId>());
+        seenRows.push_back(std::make_pair(keys[index].GetClassId() == otherClassId, row.GetValue(0).GetId<ECInstanceId>()));
+        return true;
+    });
+    ASSERT_EQ(keys.size() - 1, rowCount);
+    ASSERT_TRUE(names.back().empty());
+
+    // every key resolves to the same instance as a single seek would
+    for (size_t i = 0; i < keys.size() - 1; ++i) {
+        ASSERT_TRUE(m_ecdb.GetInstanceReader().Seek(InstanceReader::Position(keys[i].GetInstanceId(), keys[i].GetClassId()), [&](InstanceReader::IRowContext const& row, PropertyReader::Finder finder) {
+            EXPECT_STREQ(finder("Name")->GetReader().GetText(), names[i].c_str());
+        }));
+    }
+
+    // each table is visited once and read in rowid order
+    int tableSwitches = 0;
+    for (size_t i = 1; i < seenRows.size(); ++i) {
+        if (seenRows[i - 1].first != seenRows[i].first) {
+            ++tableSwitches;
+            continue;
+        }
+        EXPECT_LE(seenRows[i - 1].second, seenRows[i].second);
+    }
+    ASSERT_EQ(1, tableSwitches);
+
+    // callback can stop the batch early
+    rowCount = m_ecdb.GetInstanceReader().SeekMany(keys, [&](size_t, InstanceReader::IRowContext const&, PropertyReader::Finder) {
+        return false;
+    });
+    ASSERT_EQ(1, rowCount);
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //+---------------+---------------+---------------+---------------+---------------+------
@@ -1606,6 +1606,7 @@ public:
     bvector<Utf8String>& GetMergedFieldNames() {return m_mergedFieldNames;}
     bvector<ECClassInstanceKey>& GetKeys() {return m_keys;}
     FieldPropertyInstanceKeyMap const& GetFieldInstanceKeys() const {return m_fieldPropertyInstanceKeys;}
+    ECPRESENTATION_EXPORT size_t GetMemoryEstimate() const;
 
 public:
     //! Creates a @ref ContentSetItem.
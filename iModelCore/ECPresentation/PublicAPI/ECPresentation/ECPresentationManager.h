@@ -188,6 +188,8 @@ struct ECPresentationManager : public NonCopyableClass
             Memory,
             Disk,
             Hybrid, // uses memory cache while creating hierarchy and then persists it in disk cache
+            Shared, // same as Hybrid, but the disk cache is keyed by iModel and changeset rather than file path, so all processes on the host that
+                    // open the same iModel version share it. Read-only connections only - writable ones get a Hybrid cache.
             };
 
         private:
@@ -222,10 +224,18 @@ struct ECPresentationManager : public NonCopyableClass
         {
         private:
             size_t m_privateCacheSize;
+            size_t m_memoryLimit;
+            size_t m_connectionMemoryLimit;
         public:
-            ContentCachingParams() : m_privateCacheSize(100) {}
+            ContentCachingParams() : m_privateCacheSize(100), m_memoryLimit(0), m_connectionMemoryLimit(0) {}
             size_t GetPrivateCacheSize() const {return m_privateCacheSize;}
             void SetPrivateCacheSize(size_t size) {m_privateCacheSize = size;}
+            //! Estimated memory, in bytes, content cached by the manager may take. 0 means no limit.
+            size_t GetMemoryLimit() const {return m_memoryLimit;}
+            void SetMemoryLimit(size_t bytes) {m_memoryLimit = bytes;}
+            //! Estimated memory, in bytes, content cached for a single connection may take. 0 means no limit.
+            size_t GetConnectionMemoryLimit() const {return m_connectionMemoryLimit;}
+            void SetConnectionMemoryLimit(size_t bytes) {m_connectionMemoryLimit = bytes;}
         };
 
         //===================================================================================
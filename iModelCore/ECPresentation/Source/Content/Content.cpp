@@ -1417,6 +1417,43 @@ bvector<ECClassInstanceKey> const& ContentSetItem::GetPropertyValueKeys(FieldPro
     return iter->second;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static size_t GetJsonMemoryEstimate(std::pair<std::unique_ptr<rapidjson::Document::AllocatorType>, std::unique_ptr<rapidjson::Document>> const& json)
+    {
+    if (json.first)
+        return json.first->Capacity();
+    if (json.second)
+        return json.second->GetAllocator().Capacity();
+    return 0;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Approximate number of bytes held by this item, including its nested content. Used for
+* limiting the memory used by cached content.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+size_t ContentSetItem::GetMemoryEstimate() const
+    {
+    size_t size = sizeof(ContentSetItem)
+        + (m_inputKeys.capacity() + m_keys.capacity()) * sizeof(ECClassInstanceKey)
+        + m_imageId.capacity()
+        + GetJsonMemoryEstimate(m_values)
+        + GetJsonMemoryEstimate(m_displayValues);
+    for (Utf8StringCR fieldName : m_mergedFieldNames)
+        size += sizeof(Utf8String) + fieldName.capacity();
+    for (auto const& entry : m_fieldPropertyInstanceKeys)
+        size += sizeof(entry) + entry.first.GetFieldName().capacity() + entry.second.capacity() * sizeof(ECClassInstanceKey);
+    for (auto const& entry : m_nestedContent)
+        {
+        size += entry.first.capacity();
+        for (ContentSetItemPtr const& nestedItem : entry.second)
+            size += nestedItem->GetMemoryEstimate();
+        }
+    return size;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -139,15 +139,96 @@ bool ContentProviderKey::operator<(ContentProviderKey const& other) const
     }
 
 /*---------------------------------------------------------------------------------**//**
+* Has to be consistent with operator== - selection info and exclusive include paths are
+* compared by the equality operator only.
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-static void Erase(std::deque<ContentCacheEntry>& vector, std::function<bool(ContentProviderKey const&)> const& predicate)
+size_t ContentProviderKey::GetHash() const
     {
-    auto iter = std::remove_if(vector.begin(), vector.end(), [&predicate](ContentCacheEntry const& entry)
+    size_t hash = std::hash<std::string>{}(m_connectionId);
+    hash = hash * 31 + std::hash<std::string>{}(m_rulesetId);
+    hash = hash * 31 + std::hash<std::string>{}(m_preferredDisplayType);
+    hash = hash * 31 + std::hash<int>{}(m_contentFlags);
+    hash = hash * 31 + std::hash<int>{}((int)m_unitSystem);
+    hash = hash * 31 + std::hash<std::string>{}(m_inputNodeKeys->GetHash());
+    return hash;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static Utf8String GetStatsStr(ContentCacheStats const& stats)
+    {
+    return Utf8PrintfString("Hits: %" PRIu64 ", misses: %" PRIu64 ", evictions: %" PRIu64 ", entries: %" PRIu64 ", memory: %" PRIu64 " bytes.",
+        stats.m_hits, stats.m_misses, stats.m_evictions, (uint64_t)stats.m_entriesCount, (uint64_t)stats.m_memoryEstimate);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ContentCache::Entries::iterator ContentCache::Erase(Entries::iterator iter)
+    {
+    auto range = m_index.equal_range(iter->GetProviderKey().GetHash());
+    for (auto indexIter = range.first; indexIter != range.second; ++indexIter)
+        {
+        if (indexIter->second == iter)
+            {
+            m_index.erase(indexIter);
+            break;
+            }
+        }
+
+    auto connectionMemoryIter = m_connectionMemoryEstimates.find(iter->GetProviderKey().GetConnectionId());
+    if (m_connectionMemoryEstimates.end() != connectionMemoryIter)
+        {
+        connectionMemoryIter->second -= iter->GetMemoryEstimate();
+        if (0 == connectionMemoryIter->second)
+            m_connectionMemoryEstimates.erase(connectionMemoryIter);
+        }
+    m_stats.m_memoryEstimate -= iter->GetMemoryEstimate();
+    --m_stats.m_entriesCount;
+    iter->GetProvider().SetContentLoadedHandler(nullptr);
+    return m_cacheEntries.erase(iter);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ContentCache::Entries::iterator ContentCache::Evict(Entries::iterator iter)
+    {
+    ++m_stats.m_evictions;
+    auto next = Erase(iter);
+    DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_DEBUG, Utf8PrintfString("Evicted content provider from cache. %s", GetStatsStr(m_stats).c_str()));
+    return next;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void ContentCache::Erase(std::function<bool(ContentProviderKey const&)> const& predicate)
+    {
+    for (auto iter = m_cacheEntries.begin(); m_cacheEntries.end() != iter; )
         {
-        return predicate(entry.GetProviderKey());
-        });
-    vector.erase(iter, vector.end());
+        if (predicate(iter->GetProviderKey()))
+            iter = Erase(iter);
+        else
+            ++iter;
+        }
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void ContentCache::ClearCache()
+    {
+    BeMutexHolder lock(m_mutex);
+    for (ContentCacheEntry const& entry : m_cacheEntries)
+        entry.GetProvider().SetContentLoadedHandler(nullptr);
+    m_cacheEntries.clear();
+    m_index.clear();
+    m_connectionMemoryEstimates.clear();
+    m_stats.m_entriesCount = 0;
+    m_stats.m_memoryEstimate = 0;
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -156,8 +237,7 @@ static void Erase(std::deque<ContentCacheEntry>& vector, std::function<bool(Cont
 void ContentCache::ClearCache(IConnectionCR connection)
     {
     BeMutexHolder lock(m_mutex);
-    auto pred = [&](ContentProviderKey const& key){return key.GetConnectionId().Equals(connection.GetId());};
-    Erase(m_cacheEntries, pred);
+    Erase([&](ContentProviderKey const& key){return key.GetConnectionId().Equals(connection.GetId());});
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -166,8 +246,7 @@ void ContentCache::ClearCache(IConnectionCR connection)
 void ContentCache::ClearCache(Utf8StringCR rulesetId)
     {
     BeMutexHolder lock(m_mutex);
-    auto pred = [&](ContentProviderKey const& key){return key.GetRulesetId().Equals(rulesetId);};
-    Erase(m_cacheEntries, pred);
+    Erase([&](ContentProviderKey const& key){return key.GetRulesetId().Equals(rulesetId);});
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -181,26 +260,80 @@ static SpecificationContentProviderPtr GetProviderOrClone(SpecificationContentPr
     return provider.Clone();
     }
 
+/*---------------------------------------------------------------------------------**//**
+* Moves the entry to the most recently used end of the cache.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void ContentCache::MarkUsed(Entries::iterator iter)
+    {
+    m_cacheEntries.splice(m_cacheEntries.end(), m_cacheEntries, iter);
+    iter->SetLastUsed(++m_usageCounter);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Providers measure themselves when their content is loaded or dropped, so reading the
+* estimate doesn't wait for whoever is loading content.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void ContentCache::UpdateMemoryEstimate(ContentCacheEntry& entry)
+    {
+    size_t estimate = entry.GetProvider().GetMemoryEstimate();
+    size_t& connectionEstimate = m_connectionMemoryEstimates[entry.GetProviderKey().GetConnectionId()];
+    connectionEstimate = connectionEstimate - entry.GetMemoryEstimate() + estimate;
+    m_stats.m_memoryEstimate = m_stats.m_memoryEstimate - entry.GetMemoryEstimate() + estimate;
+    entry.SetMemoryEstimate(estimate);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Content is loaded into providers lazily, after they're cached, so the limits are enforced
+* again when a cached provider reports it has loaded its records.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void ContentCache::OnContentLoaded(ContentProviderCR provider)
+    {
+    BeMutexHolder lock(m_mutex);
+    auto iter = std::find_if(m_cacheEntries.begin(), m_cacheEntries.end(), [&](ContentCacheEntry const& entry){return &entry.GetProvider() == &provider;});
+    if (m_cacheEntries.end() == iter)
+        return;
+
+    Utf8String connectionId = iter->GetProviderKey().GetConnectionId();
+    UpdateMemoryEstimate(*iter);
+    DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_TRACE, Utf8PrintfString("Cached content provider loaded its content. %s", GetStatsStr(m_stats).c_str()));
+    LimitMemory(connectionId);
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
 SpecificationContentProviderPtr ContentCache::GetProvider(ContentProviderKey const& key, RulesetVariables const& variables)
     {
     BeMutexHolder lock(m_mutex);
-    for (auto iter = m_cacheEntries.begin(); iter != m_cacheEntries.end(); ++iter)
+    auto match = m_cacheEntries.end();
+    auto range = m_index.equal_range(key.GetHash());
+    for (auto indexIter = range.first; indexIter != range.second; ++indexIter)
         {
-        ContentCacheEntry const& entry = *iter;
-        ContentProviderKey const& cacheKey = entry.GetProviderKey();
-        if (cacheKey == key && variables.Contains(entry.GetRelatedVariables()))
+        ContentCacheEntry const& entry = *indexIter->second;
+        if (entry.GetProviderKey() == key && variables.Contains(entry.GetRelatedVariables())
+            && (m_cacheEntries.end() == match || entry.GetLastUsed() < match->GetLastUsed()))
             {
-            auto provider = GetProviderOrClone(entry.GetProvider());
-            ContentCacheEntry copy(entry);
-            m_cacheEntries.erase(iter);
-            m_cacheEntries.push_back(copy);
-            return provider;
+            match = indexIter->second;
             }
         }
-    return nullptr;
+
+    if (m_cacheEntries.end() == match)
+        {
+        ++m_stats.m_misses;
+        DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_TRACE, Utf8PrintfString("Content cache miss. %s", GetStatsStr(m_stats).c_str()));
+        return nullptr;
+        }
+
+    ++m_stats.m_hits;
+    MarkUsed(match);
+    UpdateMemoryEstimate(*match);
+    auto provider = GetProviderOrClone(match->GetProvider());
+    DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_TRACE, Utf8PrintfString("Content cache hit. %s", GetStatsStr(m_stats).c_str()));
+    LimitMemory(key.GetConnectionId());
+    return provider;
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -242,37 +375,85 @@ void ContentCache::CacheProvider(ContentProviderKey key, SpecificationContentPro
     {
     BeMutexHolder lock(m_mutex);
     RulesetVariables relatedVariables(provider.GetContext().GetRelatedRulesetVariables());
+    size_t hash = key.GetHash();
 
     // remove same provider from cache
-    auto iter = std::remove_if(m_cacheEntries.begin(), m_cacheEntries.end(), [&key, &relatedVariables](ContentCacheEntry const& entry)
+    auto range = m_index.equal_range(hash);
+    for (auto indexIter = range.first; indexIter != range.second; ++indexIter)
         {
-        return entry.GetProviderKey() == key && entry.GetRelatedVariables() == relatedVariables;
-        });
-    m_cacheEntries.erase(iter, m_cacheEntries.end());
+        if (indexIter->second->GetProviderKey() == key && indexIter->second->GetRelatedVariables() == relatedVariables)
+            {
+            Erase(indexIter->second);
+            break;
+            }
+        }
 
     m_cacheEntries.push_back(ContentCacheEntry(key, provider));
-    LimitProviderVariations(key);
+    auto iter = std::prev(m_cacheEntries.end());
+    iter->SetLastUsed(++m_usageCounter);
+    m_index.insert(std::make_pair(hash, iter));
+    ++m_stats.m_entriesCount;
+
+    UpdateMemoryEstimate(*iter);
+    provider.SetContentLoadedHandler([this](ContentProviderCR loaded){OnContentLoaded(loaded);});
+
+    LimitProviderVariations(key, hash);
     if (m_cacheEntries.size() > m_cacheSize)
-        m_cacheEntries.pop_front();
+        Evict(m_cacheEntries.begin());
+    LimitMemory(key.GetConnectionId());
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-void ContentCache::LimitProviderVariations(ContentProviderKey const& key)
+void ContentCache::LimitProviderVariations(ContentProviderKey const& key, size_t hash)
     {
     int variationsCount = 0;
     auto oldestVariation = m_cacheEntries.end();
-    for (auto iter = m_cacheEntries.begin(); m_cacheEntries.end() != iter; iter++)
+    auto range = m_index.equal_range(hash);
+    for (auto indexIter = range.first; indexIter != range.second; ++indexIter)
         {
-        if (iter->GetProviderKey() != key)
+        if (indexIter->second->GetProviderKey() != key)
             continue;
 
         variationsCount++;
-        if (oldestVariation == m_cacheEntries.end())
-            oldestVariation = iter;
+        if (oldestVariation == m_cacheEntries.end() || indexIter->second->GetLastUsed() < oldestVariation->GetLastUsed())
+            oldestVariation = indexIter->second;
         }
 
     if (CONTENTCACHE_Provider_Variations_Limit < variationsCount)
-        m_cacheEntries.erase(oldestVariation);
+        Evict(oldestVariation);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Evicts least recently used entries until the connection's entries and then the whole
+* cache fit their memory limits. The most recently used entry is never evicted.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void ContentCache::LimitMemory(Utf8StringCR connectionId)
+    {
+    if (0 != m_connectionMemoryLimit)
+        {
+        auto connectionMemoryIter = m_connectionMemoryEstimates.find(connectionId);
+        for (auto iter = m_cacheEntries.begin(); m_cacheEntries.end() != iter && m_cacheEntries.end() != std::next(iter); )
+            {
+            if (m_connectionMemoryEstimates.end() == connectionMemoryIter || connectionMemoryIter->second <= m_connectionMemoryLimit)
+                break;
+
+            if (!iter->GetProviderKey().GetConnectionId().Equals(connectionId))
+                {
+                ++iter;
+                continue;
+                }
+
+            iter = Evict(iter);
+            connectionMemoryIter = m_connectionMemoryEstimates.find(connectionId);
+            }
+        }
+
+    if (0 != m_memoryLimit)
+        {
+        while (m_cacheEntries.size() > 1 && m_stats.m_memoryEstimate > m_memoryLimit)
+            Evict(m_cacheEntries.begin());
+        }
     }
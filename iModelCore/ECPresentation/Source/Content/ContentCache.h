@@ -5,7 +5,8 @@
 #pragma once
 #include <ECPresentation/ECPresentation.h>
 #include <ECPresentation/ECPresentationManager.h>
-#include <deque>
+#include <list>
+#include <unordered_map>
 #include "../RulesEngineTypes.h"
 #include "ContentProviders.h"
 
@@ -41,6 +42,7 @@ public:
     ECPRESENTATION_EXPORT bool operator<(ContentProviderKey const& other) const;
     ECPRESENTATION_EXPORT bool operator==(ContentProviderKey const& other) const;
     bool operator!=(ContentProviderKey const& other) const { return !operator==(other); }
+    ECPRESENTATION_EXPORT size_t GetHash() const;
 
     Utf8StringCR GetPreferredDisplayType() const {return m_preferredDisplayType;}
     int GetContentFlags() const {return m_contentFlags;}
@@ -60,32 +62,72 @@ struct ContentCacheEntry
 private:
     ContentProviderKey m_key;
     SpecificationContentProviderPtr m_provider;
+    size_t m_memoryEstimate;
+    uint64_t m_lastUsed;
 public:
     ContentCacheEntry(ContentProviderKey const& key, SpecificationContentProviderR provider)
-        : m_key(key), m_provider(&provider)
+        : m_key(key), m_provider(&provider), m_memoryEstimate(0), m_lastUsed(0)
         {}
     ContentProviderKey const& GetProviderKey() const { return m_key; }
     RulesetVariables GetRelatedVariables() const { return RulesetVariables(m_provider->GetContext().GetRelatedRulesetVariables()); }
     SpecificationContentProviderR GetProvider() const { return *m_provider; }
+    size_t GetMemoryEstimate() const { return m_memoryEstimate; }
+    void SetMemoryEstimate(size_t value) { m_memoryEstimate = value; }
+    uint64_t GetLastUsed() const { return m_lastUsed; }
+    void SetLastUsed(uint64_t value) { m_lastUsed = value; }
 };
 
 /*=================================================================================**//**
 * @bsiclass
 +===============+===============+===============+===============+===============+======*/
+struct ContentCacheStats
+{
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+    size_t m_entriesCount = 0;
+    size_t m_memoryEstimate = 0;
+};
+
+/*=================================================================================**//**
+* LRU cache of content providers. The cache is limited by entries count and, optionally,
+* by the estimated memory used by all providers and by providers of a single connection.
+* @bsiclass
++===============+===============+===============+===============+===============+======*/
 struct ContentCache : NonCopyableClass
 {
 private:
-    std::deque<ContentCacheEntry> m_cacheEntries;
+    typedef std::list<ContentCacheEntry> Entries;
+
+private:
+    Entries m_cacheEntries; // least recently used first
+    std::unordered_multimap<size_t, Entries::iterator> m_index; // ContentProviderKey hash => entries
+    bmap<Utf8String, size_t> m_connectionMemoryEstimates;
     size_t m_cacheSize;
+    size_t m_memoryLimit;
+    size_t m_connectionMemoryLimit;
+    uint64_t m_usageCounter;
+    ContentCacheStats m_stats;
     mutable BeMutex m_mutex;
 
 private:
-    void LimitProviderVariations(ContentProviderKey const& key);
+    Entries::iterator Erase(Entries::iterator iter);
+    Entries::iterator Evict(Entries::iterator iter);
+    void Erase(std::function<bool(ContentProviderKey const&)> const& predicate);
+    void MarkUsed(Entries::iterator iter);
+    void UpdateMemoryEstimate(ContentCacheEntry& entry);
+    void OnContentLoaded(ContentProviderCR provider);
+    void LimitProviderVariations(ContentProviderKey const& key, size_t hash);
+    void LimitMemory(Utf8StringCR connectionId);
 
 public:
-    ContentCache(size_t size = CONTENTCACHE_Size) : m_cacheSize(size) {}
+    ContentCache(size_t size = CONTENTCACHE_Size, size_t memoryLimit = 0, size_t connectionMemoryLimit = 0)
+        : m_cacheSize(size), m_memoryLimit(memoryLimit), m_connectionMemoryLimit(connectionMemoryLimit), m_usageCounter(0)
+        {}
+    ~ContentCache() {ClearCache();}
     BeMutex& GetMutex() {return m_mutex;}
-    void ClearCache() {BeMutexHolder lock(m_mutex); m_cacheEntries.clear();}
+    ContentCacheStats GetStats() const {BeMutexHolder lock(m_mutex); return m_stats;}
+    ECPRESENTATION_EXPORT void ClearCache();
     ECPRESENTATION_EXPORT void ClearCache(IConnectionCR connection);
     ECPRESENTATION_EXPORT void ClearCache(Utf8StringCR rulesetId);
     ECPRESENTATION_EXPORT SpecificationContentProviderPtr GetProvider(ContentProviderKey const& key, RulesetVariables const& variables);
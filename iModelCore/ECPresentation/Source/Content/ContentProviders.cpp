@@ -832,14 +832,14 @@ public:
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
 ContentProvider::ContentProvider(ContentProviderContextR context)
-    : m_context(&context)
+    : m_context(&context), m_memoryEstimate(sizeof(ContentProvider))
     {}
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
 ContentProvider::ContentProvider(ContentProviderCR other)
-    : m_pageOptions(other.m_pageOptions)
+    : m_pageOptions(other.m_pageOptions), m_memoryEstimate(sizeof(ContentProvider))
     {
     m_context = ContentProviderContext::Create(*other.m_context);
     m_descriptor = other.m_descriptor;
@@ -854,6 +854,7 @@ void ContentProvider::InvalidateRecords()
     {
     BeMutexHolder lock(GetMutex());
     m_records = nullptr;
+    UpdateMemoryEstimate();
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -872,6 +873,7 @@ void ContentProvider::InvalidateNestedContentProviders()
     {
     BeMutexHolder lock(GetMutex());
     m_nestedContentProviders.clear();
+    UpdateMemoryEstimate();
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -1144,25 +1146,44 @@ void ContentProvider::_OnDescriptorChanged()
 +---------------+---------------+---------------+---------------+---------------+------*/
 void ContentProvider::_OnPageOptionsChanged()
     {
-    BeMutexHolder lock(GetMutex());
-    m_records = nullptr;
+    InvalidateRecords();
     }
 
 /*---------------------------------------------------------------------------------**//**
+* The content loaded handler is called after the provider is unlocked, so that it may lock
+* whoever owns this provider without risking a deadlock with them locking the provider.
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
 void ContentProvider::Initialize()
     {
     BeMutexHolder lock(GetMutex());
-    if (nullptr != m_records)
+    if (!LoadRecords())
         return;
+    UpdateMemoryEstimate();
+    lock.unlock();
+
+    BeMutexHolder handlerLock(m_contentLoadedHandlerMutex);
+    std::function<void(ContentProviderCR)> handler = m_contentLoadedHandler;
+    handlerLock.unlock();
+    if (handler)
+        handler(*this);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Returns true if records were loaded by this call.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+bool ContentProvider::LoadRecords()
+    {
+    if (nullptr != m_records)
+        return false;
 
     auto scope = Diagnostics::Scope::Create("Initialize content provider");
 
     if (!GetContext().IsQueryContext())
         {
         DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_TRACE, "Not a query context - return.");
-        return;
+        return false;
         }
 
     IECPropertyFormatter const* formatter = GetContext().IsPropertyFormattingContext() ? &GetContext().GetECPropertyFormatter() : nullptr;
@@ -1175,7 +1196,7 @@ void ContentProvider::Initialize()
     if (querySet.GetQueries().empty())
         {
         DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_TRACE, "Empty query set - return.");
-        return;
+        return false;
         }
     DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_TRACE, Utf8PrintfString("Content is built from %" PRIu64 " queries", (uint64_t)querySet.GetQueries().size()));
 
@@ -1245,6 +1266,7 @@ void ContentProvider::Initialize()
         }
     m_records = std::make_unique<bvector<ContentSetItemPtr>>(std::move(records));
     DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_TRACE, Utf8PrintfString("Read content items: %" PRIu64, (uint64_t)m_records->size()));
+    return true;
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -1316,19 +1338,38 @@ size_t ContentProvider::GetFullContentSetSize() const
 +---------------+---------------+---------------+---------------+---------------+------*/
 size_t ContentProvider::GetContentSetSize() const
     {
-    BeMutexHolder lock(GetMutex());
     const_cast<ContentProviderP>(this)->Initialize();
+    BeMutexHolder lock(GetMutex());
     return m_records ? m_records->size() : 0;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* Measures the content records loaded by this provider and its nested content providers.
+* Called with the provider locked whenever records are loaded or dropped.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void ContentProvider::UpdateMemoryEstimate()
+    {
+    size_t size = sizeof(ContentProvider);
+    if (m_records)
+        {
+        size += m_records->capacity() * sizeof(ContentSetItemPtr);
+        for (ContentSetItemPtr const& record : *m_records)
+            size += record->GetMemoryEstimate();
+        }
+    for (auto const& entry : m_nestedContentProviders)
+        size += entry.second->GetMemoryEstimate();
+    m_memoryEstimate = size;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
 bool ContentProvider::GetContentSetItem(ContentSetItemPtr& item, size_t index) const
     {
-    BeMutexHolder lock(GetMutex());
     auto scope = Diagnostics::Scope::Create(Utf8PrintfString("Get content set item at %" PRIu64, (uint64_t)index));
     const_cast<ContentProviderP>(this)->Initialize();
+    BeMutexHolder lock(GetMutex());
 
     if (!GetContentDescriptor())
         {
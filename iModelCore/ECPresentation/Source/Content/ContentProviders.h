@@ -7,6 +7,7 @@
 #include "../Shared/RulesDrivenProviderContext.h"
 #include "ContentQueryBuilder.h"
 #include "ContentQueryResultsReader.h"
+#include <atomic>
 
 BEGIN_BENTLEY_ECPRESENTATION_NAMESPACE
 
@@ -82,9 +83,14 @@ private:
     mutable ContentDescriptorCPtr m_descriptor;
     mutable std::unique_ptr<size_t> m_fullContentSetSize;
     mutable bmap<ContentDescriptor::NestedContentField const*, NestedContentProviderPtr> m_nestedContentProviders;
+    std::atomic<size_t> m_memoryEstimate;
+    std::function<void(ContentProviderCR)> m_contentLoadedHandler;
     mutable BeMutex m_mutex;
+    mutable BeMutex m_contentLoadedHandlerMutex;
 
 private:
+    bool LoadRecords();
+    void UpdateMemoryEstimate();
     NestedContentProviderPtr GetNestedContentProvider(ContentDescriptor::NestedContentField const&, bool) const;
     void LoadNestedContent(ContentSetItemR, bvector<ContentDescriptor::Field*> const&) const;
     void LoadNestedContent(ContentSetItemR) const;
@@ -121,6 +127,10 @@ public:
     ECPRESENTATION_EXPORT bool GetContentSetItem(ContentSetItemPtr& item, size_t index) const;
     ECPRESENTATION_EXPORT size_t GetContentSetSize() const;
     ECPRESENTATION_EXPORT size_t GetFullContentSetSize() const;
+    //! Approximate number of bytes held by the loaded content, as of the last time records were loaded or invalidated.
+    size_t GetMemoryEstimate() const {return m_memoryEstimate;}
+    //! Set a handler which is called every time content records are loaded. The provider isn't locked while the handler runs.
+    void SetContentLoadedHandler(std::function<void(ContentProviderCR)> handler) {BeMutexHolder lock(m_contentLoadedHandlerMutex); m_contentLoadedHandler = handler;}
     
     ECPRESENTATION_EXPORT void SetContentDescriptor(ContentDescriptorCR descriptor);
     void InvalidateDescriptor() {m_descriptor = nullptr;}
@@ -19,6 +19,7 @@ USING_NAMESPACE_BENTLEY_LOGGING
 #define NAVNODES_CACHE_DB_SUFFIX            L"-hierarchies"
 #define NAVNODES_CACHE_DB_VERSION_MAJOR     37
 #define NAVNODES_CACHE_DB_VERSION_MINOR     0
+#define NAVNODES_CACHE_SHARED_MMAP_SIZE     (256 * 1024 * 1024)
 
 #define NAVNODES_CACHE_LockWaitTime 200
 #define NAVNODES_CACHE_LockTimeout 90000
@@ -348,10 +349,54 @@ static bool DeleteSQLiteDbFile(BeFileNameCR path)
 #endif
 
 /*---------------------------------------------------------------------------------**//**
+* Shared caches are addressed by content rather than by file name: every briefcase of the
+* same iModel at the same changeset produces identical hierarchies, no matter where it's
+* located or when it was last modified. Files without a parent changeset (e.g. snapshots or
+* standalone files) may have diverged under the same db GUID, so their key also includes
+* the file's path and modification time.
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-static BeFileName GetCacheDbPath(BeFileNameCR directory, IConnectionCR connection)
+static Utf8String GetSharedCacheKey(IConnectionCR connection)
     {
+    Utf8String parentChangeset;
+    if (BE_SQLITE_ROW != connection.GetDb().QueryBriefcaseLocalValue(parentChangeset, "parentChangeset"))
+        connection.GetDb().QueryBriefcaseLocalValue(parentChangeset, "ParentChangeSetId");
+
+    MD5 md5;
+    Utf8String dbGuid = connection.GetDb().GetDbGuid().ToString();
+    md5.Add(dbGuid.c_str(), dbGuid.size());
+    md5.Add(parentChangeset.c_str(), parentChangeset.size());
+    if (parentChangeset.empty())
+        {
+        BeFileName dbFile(connection.GetDb().GetDbFileName());
+        time_t modifiedTime = 0;
+        dbFile.GetFileTime(nullptr, nullptr, &modifiedTime);
+        Utf8PrintfString fileIdentity("%s:%" PRIu64, dbFile.GetNameUtf8().c_str(), (uint64_t)modifiedTime);
+        md5.Add(fileIdentity.c_str(), fileIdentity.size());
+        }
+    return md5.GetHashString();
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static BeFileName GetSharedCacheDbPath(BeFileNameCR directory, IConnectionCR connection)
+    {
+    BeFileName path = directory.IsEmpty() ? BeFileName(connection.GetDb().GetDbFileName()).GetDirectoryName() : directory;
+    path.AppendToPath(BeFileName(GetSharedCacheKey(connection).c_str()));
+    path.AppendString(NAVNODES_CACHE_DB_SUFFIX);
+    DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::HierarchiesCache, LOG_TRACE, Utf8PrintfString("Using shared cache path: '%s'", path.GetNameUtf8().c_str()));
+    return path;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static BeFileName GetCacheDbPath(BeFileNameCR directory, IConnectionCR connection, NodesCacheType cacheType)
+    {
+    if (NodesCacheType::Shared == cacheType)
+        return GetSharedCacheDbPath(directory, connection);
+
     BeFileName path;
     if (directory.IsEmpty())
         {
@@ -462,6 +507,13 @@ void NodesCache::DbFactory::SetupDbConnection(Db& db, NodesCacheType type, Nulla
         db.TryExecuteSql("PRAGMA main.journal_size_limit=0");
         }
 
+    if (NodesCacheType::Shared == type)
+        {
+        // shared cache is mostly read by many processes - let them all map the same pages instead of each
+        // keeping its own copy in the page cache
+        db.TryExecuteSql(Utf8PrintfString("PRAGMA main.mmap_size=%" PRIu64, (uint64_t)NAVNODES_CACHE_SHARED_MMAP_SIZE).c_str());
+        }
+
     if (memoryCacheLimit.IsValid())
         {
         BeSQLite::Savepoint savepoint(db, "Set memory cache size");
@@ -638,7 +690,7 @@ DbResult NodesCache::DbFactory::CreateTempDiskDb(Db& db, BeFileNameCR baseFileNa
 +---------------+---------------+---------------+---------------+---------------+------*/
 DbResult NodesCache::DbFactory::InitializeDiskDb(Db& db, BeFileNameCR directory, IConnectionCR connection, NodesCacheType cacheType, bool& tempCache)
     {
-    BeFileName path = GetCacheDbPath(directory, connection);
+    BeFileName path = GetCacheDbPath(directory, connection, cacheType);
 
     if (tempCache)
         return CreateTempDiskDb(db, path, connection, cacheType);
@@ -707,7 +759,7 @@ DbResult NodesCache::DbFactory::OpenDiskDb(Db& db) const
     if (result != BE_SQLITE_OK)
         return result;
 
-    SetupDbConnection(db, NodesCacheType::Disk, m_memoryCacheLimit);
+    SetupDbConnection(db, NodesCacheType::Shared == m_cacheType ? NodesCacheType::Shared : NodesCacheType::Disk, m_memoryCacheLimit);
     return result;
     }
 
@@ -733,7 +785,15 @@ std::shared_ptr<NodesCache::DbFactory> NodesCache::DbFactory::Create(IConnection
 #endif
 
     if (IsMemoryCache(cacheType))
-        return std::make_shared<DbFactory>(connection, nullptr, sizeLimit, memoryCacheLimit);
+        return std::make_shared<DbFactory>(connection, nullptr, cacheType, sizeLimit, memoryCacheLimit);
+
+    if (NodesCacheType::Shared == cacheType && !connection.GetDb().IsReadonly())
+        {
+        // a writable connection drifts away from the changeset its shared cache is keyed by as soon as it's modified,
+        // and its hierarchies would then end up in a file other processes read as the original changeset
+        DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::HierarchiesCache, LOG_INFO, "Connection is writable, using a hybrid disk cache instead of a shared one");
+        cacheType = NodesCacheType::HybridDisk;
+        }
 
     Db db;
     DbResult result = InitializeDiskDb(db, directory, connection, cacheType, tempCache);
@@ -749,7 +809,20 @@ std::shared_ptr<NodesCache::DbFactory> NodesCache::DbFactory::Create(IConnection
         DIAGNOSTICS_HANDLE_FAILURE(DiagnosticsCategory::HierarchiesCache, Utf8PrintfString("Failed to initialize nodes cache tables."));
 
     db.SaveChanges();
-    return std::make_shared<DbFactory>(connection, db.GetDbFileName(), sizeLimit, memoryCacheLimit, tempCache);
+    auto factory = std::make_shared<DbFactory>(connection, db.GetDbFileName(), cacheType, sizeLimit, memoryCacheLimit, tempCache);
+    if (NodesCacheType::Shared == cacheType)
+        factory->m_sharedCacheKey = GetSharedCacheKey(connection);
+    return factory;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+bool NodesCache::DbFactory::HasSharedCacheKeyChanged() const
+    {
+    if (NodesCacheType::Shared != m_cacheType || !m_sharedCacheKeyStale.exchange(false))
+        return false;
+    return !m_sharedCacheKey.Equals(GetSharedCacheKey(m_connection));
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -775,7 +848,10 @@ NodesCache::DbFactory::~DbFactory()
     if (BE_SQLITE_OK != openResult)
         return;
 
-    db.SaveProperty(s_connectionLastModTimePropertySpec, std::to_string(GetConnectionLastModTime(m_connection)), nullptr, 0);
+    // shared cache file is already addressed by connection's content, so modification time of this particular
+    // briefcase doesn't tell anything about its validity
+    if (NodesCacheType::Shared != m_cacheType)
+        db.SaveProperty(s_connectionLastModTimePropertySpec, std::to_string(GetConnectionLastModTime(m_connection)), nullptr, 0);
     db.GetDefaultTransaction()->Commit();
     NodesCacheHelpers::LimitCacheSize(db, m_sizeLimit, false);
     }
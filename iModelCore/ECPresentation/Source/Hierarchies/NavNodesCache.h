@@ -11,6 +11,7 @@
 #include "NavNodesDataSource.h"
 #include "NavNodeProviders.h"
 #include "NavNodesCacheHelpers.h"
+#include <atomic>
 
 BEGIN_BENTLEY_ECPRESENTATION_NAMESPACE
 /*=================================================================================**//**
@@ -31,7 +32,8 @@ enum class NodesCacheType
     Memory,
     Disk,
     HybridMemory,
-    HybridDisk
+    HybridDisk,
+    Shared, //!< Disk cache keyed by iModel and changeset, memory-mapped and shared by all processes on the host. Read-only connections only - others get a HybridDisk cache.
     };
 
 /*=================================================================================**//**
@@ -221,10 +223,14 @@ struct NodesCache : INavNodesCache
         {
         private:
             IConnectionCR m_connection;
+            NodesCacheType m_cacheType;
             uint64_t m_sizeLimit;
             Nullable<uint64_t> m_memoryCacheLimit;
             Utf8String m_cachePath;
+            Utf8String m_sharedCacheKey;
             bool m_deleteDb;
+            std::atomic<bool> m_replaced;
+            mutable std::atomic<bool> m_sharedCacheKeyStale;
             BeMutex m_mutex;
 
         private:
@@ -239,17 +245,26 @@ struct NodesCache : INavNodesCache
             DbResult OpenDiskDb(Db& db) const;
 
         public:
-            DbFactory(IConnectionCR connection, Utf8CP path, uint64_t sizeLimit, Nullable<uint64_t> memoryCacheLimit, bool deleteDb = false)
-                : m_connection(connection), m_cachePath(path), m_sizeLimit(sizeLimit), m_memoryCacheLimit(memoryCacheLimit), m_deleteDb(deleteDb)
+            DbFactory(IConnectionCR connection, Utf8CP path, NodesCacheType cacheType, uint64_t sizeLimit, Nullable<uint64_t> memoryCacheLimit, bool deleteDb = false)
+                : m_connection(connection), m_cacheType(cacheType), m_cachePath(path), m_sizeLimit(sizeLimit), m_memoryCacheLimit(memoryCacheLimit), m_deleteDb(deleteDb), m_replaced(false), m_sharedCacheKeyStale(false)
                 {}
             ~DbFactory();
             ECPRESENTATION_EXPORT static std::shared_ptr<DbFactory> Create(IConnectionCR, BeFileNameCR, NodesCacheType, uint64_t, Nullable<uint64_t> const& memoryCacheLimit);
             ECPRESENTATION_EXPORT DbResult CreateDbConnection(Db& db) const;
 
             IConnectionCR GetConnection() const {return m_connection;}
+            NodesCacheType GetCacheType() const {return m_cacheType;}
             Utf8StringCR GetCachePath() const {return m_cachePath;}
             uint64_t GetSizeLimit() const {return m_sizeLimit;}
             void SetSizeLimit(uint64_t limit) {BeMutexHolder lock(m_mutex); m_sizeLimit = limit;}
+            //! Shared caches are keyed by the changeset the connection was at when the cache was created. Returns true if
+            //! the connection has moved to another changeset since. The key is only recomputed after MarkSharedCacheKeyStale.
+            ECPRESENTATION_EXPORT bool HasSharedCacheKeyChanged() const;
+            //! Called when the connection's data changes, e.g. after changesets are applied to it.
+            void MarkSharedCacheKeyStale() const {m_sharedCacheKeyStale = true;}
+            //! Replaced factories are not used to create new caches, and caches created from them should be dropped.
+            bool IsReplaced() const {return m_replaced;}
+            void SetReplaced() {m_replaced = true;}
         };
 
 private:
@@ -349,6 +364,7 @@ public:
     ECPRESENTATION_EXPORT void Persist();
 
     IConnectionCR GetConnection() const {return m_dbFactory->GetConnection();}
+    DbFactory const& GetDbFactory() const {return *m_dbFactory;}
     NavNodesFactory const& GetNodesFactory() const {return m_nodesFactory;}
     INodesProviderContextFactoryCR GetNodesProviderContextFactory() const {return m_contextFactory;}
     INodesProviderFactoryCR GetNodesProviderFactory() const {return m_providersFactory;}
@@ -371,12 +387,14 @@ protected:
     virtual std::shared_ptr<INavNodesCache> _GetCache(Utf8StringCR connectionId, BeGuidCR rootNodeId) const = 0;
     virtual std::shared_ptr<NodesCache> _GetPersistentCache(Utf8StringCR connectionId) const = 0;
     virtual void _ClearCaches(Utf8CP rulesetId) const = 0;
+    virtual void _OnDataChanged(Utf8StringCR connectionId) const {}
 
 public:
     virtual ~INodesCacheManager() {}
     std::shared_ptr<INavNodesCache> GetCache(Utf8StringCR connectionId, BeGuidCR rootNodeId = BeGuid()) const {return _GetCache(connectionId, rootNodeId);}
     std::shared_ptr<NodesCache> GetPersistentCache(Utf8StringCR connectionId) const {return _GetPersistentCache(connectionId);}
     void ClearCaches(Utf8CP rulesetId) const {_ClearCaches(rulesetId);}
+    void OnDataChanged(Utf8StringCR connectionId) const {_OnDataChanged(connectionId);}
 };
 
 /*=================================================================================**//**
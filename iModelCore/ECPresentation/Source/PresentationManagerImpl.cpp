@@ -180,7 +180,7 @@ private:
     INodesProviderFactoryCR m_providersFactory;
     IConnectionManagerCR m_connections;
 
-    bmap<Utf8String, std::shared_ptr<NodesCache::DbFactory>> m_initializedCaches;
+    mutable bmap<Utf8String, std::shared_ptr<NodesCache::DbFactory>> m_initializedCaches;
     mutable BeMutex m_mutex;
 
 private:
@@ -222,6 +222,21 @@ protected:
         }
     BeMutex& GetMutex() const {return m_mutex;}
 
+    // Shared caches are keyed by the changeset of the connection. When the connection moves to another changeset, the
+    // cache factory is replaced so that caches created afterwards use the file of the new changeset. The key is only
+    // recomputed after the connection's data changes (see _OnDataChanged).
+    void ReplaceOutdatedSharedCache(Utf8StringCR connectionId) const
+        {
+        BeMutexHolder lock(m_mutex);
+        auto iter = m_initializedCaches.find(connectionId);
+        if (m_initializedCaches.end() == iter || !iter->second->HasSharedCacheKeyChanged())
+            return;
+
+        DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::HierarchiesCache, LOG_INFO, Utf8PrintfString("Connection '%s' changeset changed, switching shared cache", connectionId.c_str()));
+        iter->second->SetReplaced();
+        iter->second = NodesCache::DbFactory::Create(iter->second->GetConnection(), m_cacheDirectory, _GetCacheType(), m_cacheSizeLimit, m_diskCacheMemoryCacheSize);
+        }
+
     std::shared_ptr<NodesCache> CreateCache(Utf8CP connectionId, bool ensureThreadSafety) const
         {
         BeMutexHolder lock(m_mutex);
@@ -269,6 +284,14 @@ protected:
         {
         IterateCaches([&](std::shared_ptr<NodesCache> cache) {cache->Clear(rulesetId);});
         }
+
+    void _OnDataChanged(Utf8StringCR connectionId) const override
+        {
+        BeMutexHolder lock(m_mutex);
+        auto iter = m_initializedCaches.find(connectionId);
+        if (m_initializedCaches.end() != iter)
+            iter->second->MarkSharedCacheKeyStale();
+        }
 };
 
 /*=================================================================================**//**
@@ -371,6 +394,11 @@ protected:
         {
         bmap<Utf8String, std::shared_ptr<NodesCache>>& threadCaches = GetCachesForCurrentThread();
         auto iter = threadCaches.find(connectionId);
+        if (threadCaches.end() != iter && nullptr != iter->second && iter->second->GetDbFactory().IsReplaced())
+            {
+            threadCaches.erase(iter);
+            iter = threadCaches.end();
+            }
         if (threadCaches.end() == iter)
             iter = threadCaches.Insert(connectionId, CreateCache(connectionId.c_str(), false)).first;
         return iter->second;
@@ -399,7 +427,7 @@ protected:
 
     std::shared_ptr<INavNodesCache> _GetCache(Utf8StringCR connectionId, BeGuidCR rootNodeId) const override
         {
-        auto cache = DiskNodesCacheManager::_FindCache(connectionId);
+        auto cache = _FindCache(connectionId);
         if (nullptr == cache)
             return nullptr;
         return std::make_shared<NodesCacheWrapper>(*cache, rootNodeId);
@@ -412,6 +440,27 @@ public:
         {}
 };
 
+/*=================================================================================**//**
+* @bsiclass
++===============+===============+===============+===============+===============+======*/
+struct SharedNodesCacheManager : HybridNodesCacheManager
+{
+protected:
+    NodesCacheType _GetCacheType() const override {return NodesCacheType::Shared;}
+
+    std::shared_ptr<NodesCache> _FindCache(Utf8StringCR connectionId) const override
+        {
+        ReplaceOutdatedSharedCache(connectionId);
+        return HybridNodesCacheManager::_FindCache(connectionId);
+        }
+
+public:
+    SharedNodesCacheManager(BeFileNameCR tempDirectory, NavNodesFactoryCR nodeFactory, INodesProviderContextFactoryCR nodeProviderContextFactory, INodesProviderFactoryCR nodeProvidersFactory,
+        IConnectionManagerCR connectionManager, uint64_t cacheSizeLimit, Nullable<uint64_t> diskCacheMemoryCacheSize)
+        : HybridNodesCacheManager(tempDirectory, nodeFactory, nodeProviderContextFactory, nodeProvidersFactory, connectionManager, cacheSizeLimit, diskCacheMemoryCacheSize)
+        {}
+};
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -424,6 +473,8 @@ static std::unique_ptr<INodesCacheManager> CreateCacheManager(BeFileNameCR tempD
             return std::make_unique<MemoryNodesCacheManager>(tempDirectory, nodeFactory, nodeProviderContextFactory, nodeProvidersFactory, connectionManager, cacheSizeLimit);
         case ECPresentationManager::Params::CachingParams::Mode::Hybrid:
             return std::make_unique<HybridNodesCacheManager>(tempDirectory, nodeFactory, nodeProviderContextFactory, nodeProvidersFactory, connectionManager, cacheSizeLimit, diskCacheMemoryCacheSize);
+        case ECPresentationManager::Params::CachingParams::Mode::Shared:
+            return std::make_unique<SharedNodesCacheManager>(tempDirectory, nodeFactory, nodeProviderContextFactory, nodeProvidersFactory, connectionManager, cacheSizeLimit, diskCacheMemoryCacheSize);
         case ECPresentationManager::Params::CachingParams::Mode::Disk:
         default:
             return std::make_unique<DiskNodesCacheManager>(tempDirectory, nodeFactory, nodeProviderContextFactory, nodeProvidersFactory, connectionManager, cacheSizeLimit, diskCacheMemoryCacheSize);
@@ -780,7 +831,8 @@ RulesDrivenECPresentationManagerImpl::RulesDrivenECPresentationManagerImpl(Param
 
     m_nodesCachesManager = CreateCacheManager(params.GetCachingParams().GetCacheDirectoryPath(), *m_nodesFactory, *m_nodesProviderContextFactory, *m_nodesProviderFactory,
         *m_connections, params.GetCachingParams().GetCacheMode(), params.GetCachingParams().GetDiskCacheFileSizeLimit(), params.GetCachingParams().GetDiskCacheMemoryCacheSize());
-    m_contentCache = std::make_unique<ContentCache>(params.GetContentCachingParams().GetPrivateCacheSize());
+    m_contentCache = std::make_unique<ContentCache>(params.GetContentCachingParams().GetPrivateCacheSize(),
+        params.GetContentCachingParams().GetMemoryLimit(), params.GetContentCachingParams().GetConnectionMemoryLimit());
 
     m_updateHandler = std::make_unique<UpdateHandler>(*m_nodesCachesManager, m_contentCache.get(), *m_connections, *m_nodesProviderContextFactory,
         *m_nodesProviderFactory, *m_rulesetECExpressionsCache);
@@ -918,10 +970,15 @@ void RulesDrivenECPresentationManagerImpl::_OnECInstancesChanged(ECDbCR db, bvec
     {
     auto scope = Diagnostics::Scope::Create(Utf8PrintfString("ECInstances changed with %" PRIu64 " changes", (uint64_t)changes.size()));
 
+    IConnectionPtr connection = m_connections->GetConnection(db);
+
+    // the connection may have moved to another changeset even if no instances changed
+    if (connection.IsValid())
+        m_nodesCachesManager->OnDataChanged(connection->GetId());
+
     if (changes.empty())
         return;
 
-    IConnectionPtr connection = m_connections->GetConnection(db);
     if (connection.IsNull())
         DIAGNOSTICS_HANDLE_FAILURE(DiagnosticsCategory::Connections, "Failed to get a connection for current task");
 
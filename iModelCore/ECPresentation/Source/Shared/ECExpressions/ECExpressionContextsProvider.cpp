@@ -114,6 +114,7 @@ protected:
     bool _IsNamespace() const override {return m_internalContext->IsNamespace();}
     ExpressionStatus _GetValue(EvaluationResultR evalResult, PrimaryListNodeR primaryList, bvector<ExpressionContextP> const& contexts, ::uint32_t startIndex) override {return m_internalContext->GetValue(evalResult, primaryList, contexts, startIndex);}
     ExpressionStatus _GetReference(EvaluationResultR evalResult, ReferenceResult& refResult, PrimaryListNodeR primaryList, bvector<ExpressionContextP> const& contexts, ::uint32_t startIndex) override {return m_internalContext->GetReference(evalResult, refResult, primaryList, contexts, startIndex);}
+    SymbolExpressionContextP _GetSymbolsContext() override {return m_internalContext.get();}
 
 public:
     static RefCountedPtr<RulesEngineRootSymbolsContext> Create()
@@ -1013,15 +1014,15 @@ ECExpressionEvaluationStatus ECExpressionsHelper::EvaluateECExpression(ECValueR
     {
     auto scope = Diagnostics::Scope::Create(Utf8PrintfString("Evaluate ECExpression: `%s`", expression.c_str()));
 
-    NodePtr node = GetNodeFromExpression(expression.c_str());
-    if (node.IsNull())
+    CompiledExpressionPtr compiled = GetCompiledExpression(expression.c_str(), context);
+    if (compiled.IsNull())
         {
         DIAGNOSTICS_LOG(DiagnosticsCategory::ECExpressions, LOG_TRACE, LOG_ERROR, Utf8PrintfString("Failed to parse ECExpression: %s", expression.c_str()));
         return ECExpressionEvaluationStatus::ParseError;
         }
 
     ValueResultPtr valueResult;
-    if (ExpressionStatus::Success != node->GetValue(valueResult, context))
+    if (ExpressionStatus::Success != compiled->GetValue(valueResult, context))
         {
         DIAGNOSTICS_LOG(DiagnosticsCategory::ECExpressions, LOG_TRACE, LOG_ERROR, Utf8PrintfString("Failed to evaluate ECExpression: %s", expression.c_str()));
         return ECExpressionEvaluationStatus::EvaluationError;
@@ -2557,6 +2558,27 @@ NodePtr ECExpressionsHelper::GetNodeFromExpression(Utf8CP expr)
     return node;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* Compiled expressions are cached per context shape, because symbols are bound to their
+* position in the context they're compiled against.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+CompiledExpressionPtr ECExpressionsHelper::GetCompiledExpression(Utf8CP expression, ExpressionContextR context)
+    {
+    uint64_t contextShape = CompiledExpression::GetContextShape(context);
+    CompiledExpressionPtr compiled;
+    if (SUCCESS == m_cache.Get(compiled, expression, contextShape))
+        return compiled;
+
+    NodePtr node = GetNodeFromExpression(expression);
+    if (node.IsNull())
+        return nullptr;
+
+    compiled = CompiledExpression::Compile(*node, context);
+    m_cache.Add(expression, contextShape, compiled);
+    return compiled;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -2583,6 +2605,19 @@ BentleyStatus ECExpressionsCache::Get(OptimizedExpressionPtr& optimizedExpr, Utf
     return SUCCESS;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+BentleyStatus ECExpressionsCache::Get(CompiledExpressionPtr& compiled, Utf8CP expression, uint64_t contextShape) const
+    {
+    BeMutexHolder lock(m_mutex);
+    auto iter = m_compiledCache.find(make_bpair(Utf8String(expression), contextShape));
+    if (m_compiledCache.end() == iter)
+        return ERROR;
+    compiled = iter->second;
+    return SUCCESS;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -2622,6 +2657,15 @@ void ECExpressionsCache::Add(Utf8CP expression, OptimizedExpressionPtr node)
     m_optimizedCache.Insert(expression, node);
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void ECExpressionsCache::Add(Utf8CP expression, uint64_t contextShape, CompiledExpressionPtr compiled)
+    {
+    BeMutexHolder lock(m_mutex);
+    m_compiledCache.Insert(make_bpair(Utf8String(expression), contextShape), compiled);
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -2639,4 +2683,5 @@ void ECExpressionsCache::Clear()
     BeMutexHolder lock(m_mutex);
     m_cache.clear();
     m_optimizedCache.clear();
+    m_compiledCache.clear();
     }
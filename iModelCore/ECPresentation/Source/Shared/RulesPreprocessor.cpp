@@ -210,11 +210,10 @@ bool RulesPreprocessor::VerifyCondition(Utf8CP condition, ECExpressionsCache& ex
             return optimizedExp->Value(*optimizedParams);
         }
 
-    NodePtr node = ECExpressionsHelper(expressionsCache).GetNodeFromExpression(condition);
-
     ValueResultPtr valueResult;
     ExpressionContextPtr context = contextPreparer();
-    if (ExpressionStatus::Success != node->GetValue(valueResult, *context))
+    CompiledExpressionPtr compiled = ECExpressionsHelper(expressionsCache).GetCompiledExpression(condition, *context);
+    if (compiled.IsNull() || ExpressionStatus::Success != compiled->GetValue(valueResult, *context))
         {
         DIAGNOSTICS_LOG(DiagnosticsCategory::ECExpressions, LOG_TRACE, LOG_ERROR, Utf8PrintfString("Failed to evaluate ECExpression: %s", condition));
         return false;
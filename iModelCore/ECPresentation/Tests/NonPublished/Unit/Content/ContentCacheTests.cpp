@@ -394,3 +394,73 @@ TEST_F(ContentCacheTests, RemovesOldestProviderWhenNewVariationIsCachedForSomePr
     // check if oldest provider is removed
     EXPECT_TRUE(m_cache.GetProvider(oldestProviderKey, oldestProviderVariables).IsNull());
     }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(ContentCacheTests, CountsHitsMissesAndEvictions)
+    {
+    auto providers = CacheProviders(CONTENTCACHE_Size);
+    EXPECT_EQ(providers[0].second, m_cache.GetProvider(providers[0].first, RulesetVariables(providers[0].second->GetContext().GetRelatedRulesetVariables())).get());
+
+    ContentProviderKey key("connection id", "different ruleset", "display type", 0, ECPresentation::UnitSystem::Undefined, *NavNodeKeyListContainer::Create(), nullptr, nullptr);
+    EXPECT_TRUE(m_cache.GetProvider(key, RulesetVariables()).IsNull());
+    CacheProvider(key);
+
+    ContentCacheStats stats = m_cache.GetStats();
+    EXPECT_EQ(1, stats.m_hits);
+    EXPECT_EQ(1, stats.m_misses);
+    EXPECT_EQ(1, stats.m_evictions);
+    EXPECT_EQ(CONTENTCACHE_Size, stats.m_entriesCount);
+    EXPECT_EQ(CONTENTCACHE_Size * CreateProvider()->GetMemoryEstimate(), stats.m_memoryEstimate);
+
+    m_cache.ClearCache();
+    stats = m_cache.GetStats();
+    EXPECT_EQ(0, stats.m_entriesCount);
+    EXPECT_EQ(0, stats.m_memoryEstimate);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(ContentCacheTests, RemovesOldestProvidersWhenMemoryLimitIsExceeded)
+    {
+    size_t providerMemory = CreateProvider()->GetMemoryEstimate();
+    RulesetVariables variables(CreateProvider()->GetContext().GetRelatedRulesetVariables());
+    ContentCache cache(CONTENTCACHE_Size, 2 * providerMemory);
+
+    bvector<ContentProviderKey> keys;
+    for (int i = 0; i < 3; ++i)
+        {
+        keys.push_back(ContentProviderKey("connection id", Utf8PrintfString("ruleset_%d", i), "display type", 0, ECPresentation::UnitSystem::Undefined, *NavNodeKeyListContainer::Create(), nullptr, nullptr));
+        cache.CacheProvider(keys.back(), *CreateProvider());
+        }
+
+    EXPECT_TRUE(cache.GetProvider(keys[0], variables).IsNull());
+    EXPECT_TRUE(cache.GetProvider(keys[1], variables).IsValid());
+    EXPECT_TRUE(cache.GetProvider(keys[2], variables).IsValid());
+    EXPECT_EQ(1, cache.GetStats().m_evictions);
+    EXPECT_EQ(2 * providerMemory, cache.GetStats().m_memoryEstimate);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(ContentCacheTests, RemovesOldestConnectionProvidersWhenConnectionMemoryLimitIsExceeded)
+    {
+    size_t providerMemory = CreateProvider()->GetMemoryEstimate();
+    RulesetVariables variables(CreateProvider()->GetContext().GetRelatedRulesetVariables());
+    ContentCache cache(CONTENTCACHE_Size, 0, providerMemory);
+
+    ContentProviderKey key1("connection 1", "ruleset 1", "display type", 0, ECPresentation::UnitSystem::Undefined, *NavNodeKeyListContainer::Create(), nullptr, nullptr);
+    ContentProviderKey key2("connection 2", "ruleset 1", "display type", 0, ECPresentation::UnitSystem::Undefined, *NavNodeKeyListContainer::Create(), nullptr, nullptr);
+    ContentProviderKey key3("connection 1", "ruleset 2", "display type", 0, ECPresentation::UnitSystem::Undefined, *NavNodeKeyListContainer::Create(), nullptr, nullptr);
+    cache.CacheProvider(key1, *CreateProvider());
+    cache.CacheProvider(key2, *CreateProvider());
+    cache.CacheProvider(key3, *CreateProvider());
+
+    // only the older provider of the connection that exceeded its limit is removed
+    EXPECT_TRUE(cache.GetProvider(key1, variables).IsNull());
+    EXPECT_TRUE(cache.GetProvider(key2, variables).IsValid());
+    EXPECT_TRUE(cache.GetProvider(key3, variables).IsValid());
+    }
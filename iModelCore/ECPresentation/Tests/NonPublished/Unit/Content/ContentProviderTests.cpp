@@ -4,6 +4,7 @@
 *--------------------------------------------------------------------------------------------*/
 #include "ContentProviderTests.h"
 #include "../../../../Source/Content/ContentQueryContracts.h"
+#include "../../../../Source/Content/ContentCache.h"
 
 ECDbTestProject* ContentProviderTests::s_project = nullptr;
 
@@ -607,3 +608,63 @@ TEST_F(ContentProviderTests, CloneContentProviderAndChangeCancelationToken)
     // Check what only one cancelation token has changed
     ASSERT_NE(&provider->GetContext().GetCancelationToken(), &clonedProvider->GetContext().GetCancelationToken());
     }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(ContentProviderTests, ContentCacheMeasuresProvidersWhenTheyLoadContent)
+    {
+    bvector<ECInstanceKey> instanceKeys;
+    for (int i = 0; i < 10; ++i)
+        {
+        IECInstancePtr instance = RulesEngineTestHelpers::InsertInstance(s_project->GetECDb(), *m_widgetClass, [&](IECInstanceR widget)
+            {
+            widget.SetValue("Description", ECValue(Utf8PrintfString("Widget %d with a description long enough to take some memory", i).c_str()));
+            });
+        ECClassInstanceKey key = RulesEngineTestHelpers::GetInstanceKey(*instance);
+        instanceKeys.push_back(ECInstanceKey(key.GetClass()->GetId(), key.GetId()));
+        }
+
+    ContentRule rule;
+    rule.AddSpecification(*new SelectedNodeInstancesSpecification(1, false, "", "", false));
+    auto createProvider = [&]()
+        {
+        ContentProviderContextPtr context = ContentProviderContext::Create(*m_context);
+        return SpecificationContentProvider::Create(*context, ContentRuleInstanceKeys(rule, instanceKeys));
+        };
+
+    // measure a provider before and after loading its content
+    SpecificationContentProviderPtr measured = createProvider();
+    size_t emptyEstimate = measured->GetMemoryEstimate();
+    ASSERT_EQ(10, measured->GetContentSetSize());
+    size_t loadedEstimate = measured->GetMemoryEstimate();
+    EXPECT_GT(loadedEstimate, emptyEstimate + 10 * sizeof(ContentSetItemPtr));
+
+    // the limit fits one provider with loaded content and one without
+    ContentCache cache(CONTENTCACHE_Size, loadedEstimate + emptyEstimate);
+    ContentProviderKey key1(m_connection->GetId(), "ruleset 1", "display type", 0, ECPresentation::UnitSystem::Undefined, *NavNodeKeyListContainer::Create(), nullptr, nullptr);
+    ContentProviderKey key2(m_connection->GetId(), "ruleset 2", "display type", 0, ECPresentation::UnitSystem::Undefined, *NavNodeKeyListContainer::Create(), nullptr, nullptr);
+    SpecificationContentProviderPtr provider1 = createProvider();
+    SpecificationContentProviderPtr provider2 = createProvider();
+    RulesetVariables variables(provider1->GetContext().GetRelatedRulesetVariables());
+    cache.CacheProvider(key1, *provider1);
+    cache.CacheProvider(key2, *provider2);
+    EXPECT_EQ(2 * emptyEstimate, cache.GetStats().m_memoryEstimate);
+
+    // loading content of a cached provider updates the estimate, even while the provider is in use
+    ASSERT_EQ(10, provider1->GetContentSetSize());
+    EXPECT_EQ(loadedEstimate + emptyEstimate, cache.GetStats().m_memoryEstimate);
+    EXPECT_EQ(0, cache.GetStats().m_evictions);
+
+    // loading content of the second provider exceeds the limit and evicts the least recently used one
+    ASSERT_EQ(10, provider2->GetContentSetSize());
+    EXPECT_EQ(1, cache.GetStats().m_evictions);
+    EXPECT_EQ(loadedEstimate, cache.GetStats().m_memoryEstimate);
+    EXPECT_TRUE(cache.GetProvider(key1, variables).IsNull());
+    EXPECT_TRUE(cache.GetProvider(key2, variables).IsValid());
+
+    // content loaded by an evicted provider is not counted
+    provider1->InvalidateContent();
+    ASSERT_EQ(10, provider1->GetContentSetSize());
+    EXPECT_EQ(loadedEstimate, cache.GetStats().m_memoryEstimate);
+    }
@@ -968,4 +968,89 @@ TEST_F(ECExpressionContextsProviderTests, CanUseECDbSymbolsAfterECDbExpressionSy
     ECValue value = EvaluateAndGetResult(Utf8PrintfString("ParentNode.ECInstance.HasRelatedInstance(\"%s\", \"Forward\", \"%s\")", rel->GetFullName(), classDerivedA->GetFullName()).c_str(), *ctx);
     ASSERT_TRUE(value.IsBoolean());
     ASSERT_FALSE(value.GetBoolean());
-    }
\ No newline at end of file
+    }
+
+static Utf8CP s_nodeRulesConditions[] =
+    {
+    "ParentNode.IsNull",
+    "ParentNode.Label = \"MyLabel\" AndAlso ParentNode.Description <> \"\"",
+    "ParentNode.IsInstanceNode OrElse ParentNode.Type = \"test\"",
+    "IIf(ParentNode.IsNull, 1, 2) + 1",
+    "ParentNode.ClassName = \"ClassA\" And ParentNode.SchemaName = \"TestSchema\"",
+    "Not ParentNode.IsNull AndAlso ParentNode.IsOfClass(\"ClassA\", \"TestSchema\")",
+    };
+
+/*---------------------------------------------------------------------------------**//**
+* @betest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(ECExpressionContextsProviderTests, GetNodeRulesContext_CompiledExpressionsEvaluateSameAsExpressionTrees)
+    {
+    IECInstancePtr instance = ECInstanceTestsHelper::CreateInstance("ClassA", GetSchema());
+    bvector<NavNodePtr> parentNodes = {nullptr, TestNodesHelper::CreateCustomNode(*s_connection, "test", "MyLabel", "MyDescription"), TestNodesHelper::CreateInstanceNode(*s_connection, *instance)};
+
+    ECExpressionsCache cache;
+    ECExpressionsHelper helper(cache);
+    for (NavNodePtr const& parentNode : parentNodes)
+        {
+        ExpressionContextPtr ctx = ECExpressionContextsProvider::GetNodeRulesContext(ECExpressionContextsProvider::NodeRulesContextParameters(parentNode.get(), *s_connection,
+            m_rulesetVariables, nullptr));
+        for (Utf8CP condition : s_nodeRulesConditions)
+            {
+            NodePtr node = helper.GetNodeFromExpression(condition);
+            ASSERT_TRUE(node.IsValid());
+            CompiledExpressionPtr compiled = helper.GetCompiledExpression(condition, *ctx);
+            ASSERT_TRUE(compiled.IsValid());
+            EXPECT_EQ(compiled.get(), helper.GetCompiledExpression(condition, *ctx).get());
+
+            EvaluationResult expected;
+            ExpressionStatus expectedStatus = node->GetValue(expected, *ctx);
+            EvaluationResult actual;
+            ASSERT_EQ(expectedStatus, compiled->GetValue(actual, *ctx)) << condition;
+            if (ExpressionStatus::Success == expectedStatus && expected.IsECValue())
+                {
+                ASSERT_TRUE(actual.IsECValue()) << condition;
+                EXPECT_EQ(*expected.GetECValue(), *actual.GetECValue()) << condition;
+                }
+            }
+        }
+    }
+
+#ifdef RUN_PERFORMANCE_TESTS
+/*---------------------------------------------------------------------------------**//**
+* Time to evaluate node rule conditions against freshly created contexts by walking the
+* expression tree versus using the compiled expression.
+* @betest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(ECExpressionContextsProviderTests, GetNodeRulesContext_CompiledExpressionsPerformance)
+    {
+    auto navNode = TestNodesHelper::CreateCustomNode(*s_connection, "test", "MyLabel", "MyDescription");
+    ECExpressionsCache cache;
+    ECExpressionsHelper helper(cache);
+    int const iterations = 10000;
+
+    int evaluations = 0;
+    double treeTime = 0, compiledTime = 0;
+    for (int i = 0; i < iterations; ++i)
+        {
+        ExpressionContextPtr ctx = ECExpressionContextsProvider::GetNodeRulesContext(ECExpressionContextsProvider::NodeRulesContextParameters(navNode.get(), *s_connection,
+            m_rulesetVariables, nullptr));
+        for (Utf8CP condition : s_nodeRulesConditions)
+            {
+            EvaluationResult result;
+            StopWatch treeTimer(true);
+            helper.GetNodeFromExpression(condition)->GetValue(result, *ctx);
+            treeTimer.Stop();
+            treeTime += treeTimer.GetElapsedSeconds();
+
+            StopWatch compiledTimer(true);
+            helper.GetCompiledExpression(condition, *ctx)->GetValue(result, *ctx);
+            compiledTimer.Stop();
+            compiledTime += compiledTimer.GetElapsedSeconds();
+            ++evaluations;
+            }
+        }
+
+    NativeLogging::CategoryLogger("ECPresentation.Tests").infov("Evaluated %d node rule conditions: expression trees in %.3f s, compiled expressions in %.3f s",
+        evaluations, treeTime, compiledTime);
+    }
+#endif
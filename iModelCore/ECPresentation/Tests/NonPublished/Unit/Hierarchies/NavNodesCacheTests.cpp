@@ -2011,6 +2011,7 @@ struct DiskNodesCacheLocationTests : ECPresentationTest
     TestNodesProviderFactory m_providersFactory;
     BeFileName m_directory;
     Utf8String m_ecdbFileName;
+    bvector<std::unique_ptr<ECDb>> m_projectCopies;
     DiskNodesCacheLocationTests() : m_nodesProviderContextFactory(m_connections) {}
     void SetUp() override
         {
@@ -2025,9 +2026,30 @@ struct DiskNodesCacheLocationTests : ECPresentationTest
     virtual void TearDown() override
         {
         m_connections.CloseConnections();
+        m_projectCopies.clear();
         s_project->GetECDb().AbandonChanges();
         }
 
+    IConnectionPtr OpenProjectCopy(Utf8CP name, Utf8CP parentChangeset, Db::OpenMode openMode = Db::OpenMode::Readonly, DefaultTxn defaultTxn = DefaultTxn::Yes)
+        {
+        BeFileName path = m_directory;
+        path.AppendSeparator().AppendUtf8(name);
+        path.BeDeleteFile();
+        BeFileName::BeCopyFile(WString(s_project->GetECDbPath(), true).c_str(), path, true);
+
+        auto db = std::make_unique<ECDb>();
+        EXPECT_EQ(BE_SQLITE_OK, db->OpenBeSQLiteDb(path, Db::OpenParams(Db::OpenMode::ReadWrite)));
+        db->SaveBriefcaseLocalValue("parentChangeset", parentChangeset);
+        db->SaveChanges();
+        if (Db::OpenMode::ReadWrite != openMode)
+            {
+            db->CloseDb();
+            EXPECT_EQ(BE_SQLITE_OK, db->OpenBeSQLiteDb(path, Db::OpenParams(openMode, defaultTxn)));
+            }
+        m_projectCopies.push_back(std::move(db));
+        return m_connections.NotifyConnectionOpened(*m_projectCopies.back());
+        }
+
     static void SetUpTestCase()
         {
         s_project = new ECDbTestProject();
@@ -2086,6 +2108,112 @@ TEST_F(DiskNodesCacheLocationTests, CreatesCacheInTheSameDirectoryAsIModelIfDire
     EXPECT_STREQ(expectedPath.GetNameUtf8().c_str(), cache->GetDb().GetDbFileName());
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(DiskNodesCacheLocationTests, SharedCacheIsAddressedByIModelContentRatherThanFileName)
+    {
+    IConnectionPtr connection = OpenProjectCopy("SharedCacheProject.ecdb", "changeset-1");
+    Utf8String projectFileName = Utf8String(BeFileName(connection->GetECDb().GetDbFileName()).GetFileNameAndExtension().c_str());
+
+    Utf8String sharedCachePath;
+    {
+    auto cache = NodesCache::Create(*connection, m_directory, m_nodesFactory, m_nodesProviderContextFactory, m_providersFactory, NodesCacheType::Shared, true);
+    sharedCachePath = cache->GetDb().GetDbFileName();
+    }
+    BeFileName sharedCacheFile(sharedCachePath.c_str());
+    EXPECT_TRUE(sharedCacheFile.DoesPathExist());
+    EXPECT_STREQ(m_directory.GetNameUtf8().c_str(), sharedCacheFile.GetDirectoryName().GetNameUtf8().c_str());
+    EXPECT_FALSE(sharedCachePath.Contains(projectFileName));
+    EXPECT_TRUE(sharedCachePath.EndsWith("-hierarchies"));
+
+    auto cache = NodesCache::Create(*connection, m_directory, m_nodesFactory, m_nodesProviderContextFactory, m_providersFactory, NodesCacheType::Shared, true);
+    EXPECT_STREQ(sharedCachePath.c_str(), cache->GetDb().GetDbFileName());
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(DiskNodesCacheLocationTests, SharedCacheIsNotSharedBetweenDifferentChangesets)
+    {
+    IConnectionPtr connection1 = OpenProjectCopy("SharedCacheProject1.ecdb", "changeset-1");
+    IConnectionPtr connection1Copy = OpenProjectCopy("SharedCacheProject1Copy.ecdb", "changeset-1");
+    IConnectionPtr connection2 = OpenProjectCopy("SharedCacheProject2.ecdb", "changeset-2");
+
+    auto cache1 = NodesCache::Create(*connection1, m_directory, m_nodesFactory, m_nodesProviderContextFactory, m_providersFactory, NodesCacheType::Shared, true);
+    auto cache1Copy = NodesCache::Create(*connection1Copy, m_directory, m_nodesFactory, m_nodesProviderContextFactory, m_providersFactory, NodesCacheType::Shared, true);
+    auto cache2 = NodesCache::Create(*connection2, m_directory, m_nodesFactory, m_nodesProviderContextFactory, m_providersFactory, NodesCacheType::Shared, true);
+
+    EXPECT_STREQ(cache1->GetDb().GetDbFileName(), cache1Copy->GetDb().GetDbFileName());
+    EXPECT_STRNE(cache1->GetDb().GetDbFileName(), cache2->GetDb().GetDbFileName());
+    EXPECT_FALSE(cache1->GetDbFactory().HasSharedCacheKeyChanged());
+    EXPECT_FALSE(cache2->GetDbFactory().HasSharedCacheKeyChanged());
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(DiskNodesCacheLocationTests, WritableConnectionDoesNotUseSharedCache)
+    {
+    IConnectionPtr readonlyConnection = OpenProjectCopy("SharedCacheProjectReadonly.ecdb", "changeset-1");
+    IConnectionPtr writableConnection = OpenProjectCopy("SharedCacheProjectWritable.ecdb", "changeset-1", Db::OpenMode::ReadWrite);
+
+    BeFileName expectedPath = m_directory;
+    expectedPath.AppendSeparator().AppendUtf8("SharedCacheProjectWritable.ecdb-hierarchies");
+
+    auto readonlyCache = NodesCache::Create(*readonlyConnection, m_directory, m_nodesFactory, m_nodesProviderContextFactory, m_providersFactory, NodesCacheType::Shared, true);
+    auto writableCache = NodesCache::Create(*writableConnection, m_directory, m_nodesFactory, m_nodesProviderContextFactory, m_providersFactory, NodesCacheType::Shared, true);
+    EXPECT_STREQ(expectedPath.GetNameUtf8().c_str(), writableCache->GetDb().GetDbFileName());
+    EXPECT_STRNE(readonlyCache->GetDb().GetDbFileName(), writableCache->GetDb().GetDbFileName());
+
+    // local changes to a writable connection's parent changeset must not affect which cache it uses
+    writableConnection->GetDb().SaveBriefcaseLocalValue("parentChangeset", "changeset-2");
+    EXPECT_FALSE(writableCache->GetDbFactory().HasSharedCacheKeyChanged());
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(DiskNodesCacheLocationTests, SharedCacheOfFileWithoutChangesetsIsNotSharedWithOtherFiles)
+    {
+    IConnectionPtr connection1 = OpenProjectCopy("SharedCacheSnapshot1.ecdb", "");
+    IConnectionPtr connection2 = OpenProjectCopy("SharedCacheSnapshot2.ecdb", "");
+
+    auto cache1 = NodesCache::Create(*connection1, m_directory, m_nodesFactory, m_nodesProviderContextFactory, m_providersFactory, NodesCacheType::Shared, true);
+    auto cache1Again = NodesCache::Create(*connection1, m_directory, m_nodesFactory, m_nodesProviderContextFactory, m_providersFactory, NodesCacheType::Shared, true);
+    auto cache2 = NodesCache::Create(*connection2, m_directory, m_nodesFactory, m_nodesProviderContextFactory, m_providersFactory, NodesCacheType::Shared, true);
+
+    EXPECT_STREQ(cache1->GetDb().GetDbFileName(), cache1Again->GetDb().GetDbFileName());
+    EXPECT_STRNE(cache1->GetDb().GetDbFileName(), cache2->GetDb().GetDbFileName());
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(DiskNodesCacheLocationTests, SharedCacheKeyIsRecomputedOnlyAfterDataChanges)
+    {
+    // no default transaction, so that the file can be modified through another connection
+    IConnectionPtr connection = OpenProjectCopy("SharedCacheProjectPulled.ecdb", "changeset-1", Db::OpenMode::Readonly, DefaultTxn::No);
+    auto cache = NodesCache::Create(*connection, m_directory, m_nodesFactory, m_nodesProviderContextFactory, m_providersFactory, NodesCacheType::Shared, true);
+    EXPECT_FALSE(cache->GetDbFactory().HasSharedCacheKeyChanged());
+
+    // a data change without a changeset change keeps the key
+    cache->GetDbFactory().MarkSharedCacheKeyStale();
+    EXPECT_FALSE(cache->GetDbFactory().HasSharedCacheKeyChanged());
+
+    ECDb writer;
+    ASSERT_EQ(BE_SQLITE_OK, writer.OpenBeSQLiteDb(BeFileName(connection->GetECDb().GetDbFileName()), Db::OpenParams(Db::OpenMode::ReadWrite)));
+    writer.SaveBriefcaseLocalValue("parentChangeset", "changeset-2");
+    writer.SaveChanges();
+    writer.CloseDb();
+
+    // the new changeset is only noticed after the data change is reported, and only once
+    EXPECT_FALSE(cache->GetDbFactory().HasSharedCacheKeyChanged());
+    cache->GetDbFactory().MarkSharedCacheKeyStale();
+    EXPECT_TRUE(cache->GetDbFactory().HasSharedCacheKeyChanged());
+    EXPECT_FALSE(cache->GetDbFactory().HasSharedCacheKeyChanged());
+    }
+
 /*=================================================================================**//**
 * @bsiclass
 +===============+===============+===============+===============+===============+======*/
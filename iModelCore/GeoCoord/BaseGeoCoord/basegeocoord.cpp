@@ -13675,6 +13675,38 @@ StatusInt BaseGCS::ToLocalTransformerJson(BeJsValue jsonValue) const {
     return SUCCESS; // If we get there it simply means there was no transformer so we add nothing
 }
 
+/*---------------------------------------------------------------------------------**//**
+* Folds the status of one conversion into the hardest error found so far. Once a hard error
+* (anything but success or a warning) is recorded it is kept. Otherwise a negative status
+* wins and positive statuses keep the highest value.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static void     AccumulateReprojectStatus (ReprojectStatus& status, ReprojectStatus pointStatus)
+    {
+    if (REPROJECT_Success == pointStatus)
+        return;
+
+    if ((REPROJECT_Success != status) && (REPROJECT_CSMAPERR_OutOfUsefulRange != status) && (REPROJECT_CSMAPERR_VerticalDatumConversionError != status))
+        return;
+
+    if (0 > pointStatus)
+        status = pointStatus;
+    else
+        status = (pointStatus > status ? pointStatus : status);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Reports the same status for all points of a batch conversion that could not be started.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static ReprojectStatus  SetBatchReprojectStatus (ReprojectStatus* outStatuses, int numPoints, ReprojectStatus status)
+    {
+    if (NULL != outStatuses)
+        std::fill (outStatuses, outStatuses + std::max (numPoints, 0), status);
+
+    return status;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * CartesianFromCartesian - Converts from the Cartesian representation of a GCS to
 * the Cartesian of the target.
@@ -13736,6 +13768,56 @@ ReprojectStatus BaseGCS::CartesianFromCartesian(DPoint3dR outCartesian, DPoint3d
     return status;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* CartesianFromCartesian - Converts an array of points from the Cartesian representation
+* of a GCS to the Cartesian of the target, one conversion stage at a time.
+* @return
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ReprojectStatus BaseGCS::CartesianFromCartesian(DPoint3dP outCartesian, ReprojectStatus* outStatuses, DPoint3dCP inCartesian, int numPoints, BaseGCSCR targetGCS) const
+    {
+    // Given the library is NOT initialized ...
+    if (!IsLibraryInitialized())
+        {
+        m_csError = GEOCOORDERR_GeoCoordNotInitialized;
+        return SetBatchReprojectStatus (outStatuses, numPoints, (ReprojectStatus)m_csError);
+        }
+
+    if (!IsValid() || !targetGCS.IsValid())
+        return SetBatchReprojectStatus (outStatuses, numPoints, (ReprojectStatus)GEOCOORDERR_InvalidCoordSys);
+
+    if (0 >= numPoints)
+        return REPROJECT_Success;
+
+    bvector<GeoPoint>           inLatLong (numPoints);
+    bvector<GeoPoint>           outLatLong (numPoints);
+    bvector<ReprojectStatus>    stat1 (numPoints);
+    bvector<ReprojectStatus>    stat2 (numPoints);
+    bvector<ReprojectStatus>    stat3 (numPoints);
+
+    LatLongFromCartesian (inLatLong.data(), stat1.data(), inCartesian, numPoints);
+    LatLongFromLatLong (outLatLong.data(), stat2.data(), inLatLong.data(), numPoints, targetGCS);
+    targetGCS.CartesianFromLatLong (outCartesian, stat3.data(), outLatLong.data(), numPoints);
+
+    // Same rules as the single point version: each point gets the hardest of its three statuses
+    // and the returned status is the hardest over all points.
+    ReprojectStatus status = REPROJECT_Success;
+    for (int iPoint = 0; iPoint < numPoints; ++iPoint)
+        {
+        ReprojectStatus pointStatus = REPROJECT_Success;
+        AccumulateReprojectStatus (pointStatus, stat1[iPoint]);
+        AccumulateReprojectStatus (pointStatus, stat2[iPoint]);
+        AccumulateReprojectStatus (pointStatus, stat3[iPoint]);
+
+        if (NULL != outStatuses)
+            outStatuses[iPoint] = pointStatus;
+
+        AccumulateReprojectStatus (status, pointStatus);
+        }
+
+    return status;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * CartesianFromCartesian2D - Converts from the Cartesian representation of a GCS to
 * the Cartesian of the target.
@@ -22391,6 +22473,42 @@ DPoint3dCR      inCartesian         // => Cartesian, in GCS's units.
     return (ReprojectStatus) CSMap::CS_cs3ll (m_csParameters, &outLatLong, &internalCartesian);
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ReprojectStatus BaseGCS::LatLongFromCartesian
+(
+GeoPointP       outLatLong,         // <= latitude longitude
+ReprojectStatus* outStatuses,       // <= optional per-point status
+DPoint3dCP      inCartesian,        // => Cartesian, in GCS's units.
+int             numPoints           // => number of points
+) const
+    {
+    if (!IsValid())
+        return SetBatchReprojectStatus (outStatuses, numPoints, (ReprojectStatus)GEOCOORDERR_InvalidCoordSys);
+
+    LocalTransformerP   localTransformer = m_localTransformer.get();
+    ReprojectStatus     status = REPROJECT_Success;
+    DPoint3d            internalCartesian;
+
+    for (int iPoint = 0; iPoint < numPoints; ++iPoint)
+        {
+        if (NULL == localTransformer)
+            internalCartesian = inCartesian[iPoint];
+        else
+            localTransformer->InternalCartesianFromCartesian (internalCartesian, inCartesian[iPoint]);
+
+        ReprojectStatus pointStatus = (ReprojectStatus) CSMap::CS_cs3ll (m_csParameters, &outLatLong[iPoint], &internalCartesian);
+
+        if (NULL != outStatuses)
+            outStatuses[iPoint] = pointStatus;
+
+        AccumulateReprojectStatus (status, pointStatus);
+        }
+
+    return status;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -22442,6 +22560,45 @@ GeoPointCR      inLatLong           // => latitude longitude
     return status;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ReprojectStatus BaseGCS::CartesianFromLatLong
+(
+DPoint3dP       outCartesian,       // <= Cartesian, in GCS's units.
+ReprojectStatus* outStatuses,       // <= optional per-point status
+GeoPointCP      inLatLong,          // => latitude longitude
+int             numPoints           // => number of points
+) const
+    {
+    if (!IsValid())
+        return SetBatchReprojectStatus (outStatuses, numPoints, (ReprojectStatus)GEOCOORDERR_InvalidCoordSys);
+
+    LocalTransformerP   localTransformer = m_localTransformer.get();
+    ReprojectStatus     status = REPROJECT_Success;
+    DPoint3d            internalCartesian;
+
+    for (int iPoint = 0; iPoint < numPoints; ++iPoint)
+        {
+        ReprojectStatus pointStatus = (ReprojectStatus) CSMap::CS_ll3cs (m_csParameters, &internalCartesian, &inLatLong[iPoint]);
+
+        // In case a hard error occured ... we zero out all values
+        if ((REPROJECT_Success != pointStatus) && (REPROJECT_CSMAPERR_OutOfUsefulRange != pointStatus) && (REPROJECT_CSMAPERR_VerticalDatumConversionError != pointStatus))
+            outCartesian[iPoint].x = outCartesian[iPoint].y = outCartesian[iPoint].z = 0.0;
+        else if (NULL == localTransformer)
+            outCartesian[iPoint] = internalCartesian;
+        else
+            localTransformer->CartesianFromInternalCartesian (outCartesian[iPoint], internalCartesian);
+
+        if (NULL != outStatuses)
+            outStatuses[iPoint] = pointStatus;
+
+        AccumulateReprojectStatus (status, pointStatus);
+        }
+
+    return status;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -22829,6 +22986,59 @@ BaseGCSCR       targetGCS           // => target coordinate system
     return status;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ReprojectStatus BaseGCS::LatLongFromLatLong
+(
+GeoPointP       outLatLong,         // <= latitude longitude in targetGCS
+ReprojectStatus* outStatuses,       // <= optional per-point status
+GeoPointCP      inLatLong,          // => latitude longitude in this GCS
+int             numPoints,          // => number of points
+BaseGCSCR       targetGCS           // => target coordinate system
+) const
+    {
+    // make sure datum converter is set up for the destination, once for the whole array.
+    if (&targetGCS != m_targetGCS)
+        SetupDatumConverterFor(targetGCS);
+
+    if (!IsValid() || !targetGCS.IsValid())
+        return SetBatchReprojectStatus (outStatuses, numPoints, (ReprojectStatus)GEOCOORDERR_InvalidCoordSys);
+
+    if (NULL == m_datumConverter)
+        {
+        if (0 < numPoints)
+            std::copy (inLatLong, inLatLong + numPoints, outLatLong);
+
+        return SetBatchReprojectStatus (outStatuses, numPoints, REPROJECT_CSMAPERR_DatumConverterNotSet); // May be interpreted as a warning.
+        }
+
+    // See single point version: grid file shifts over one half degree are reverted.
+    bool            gridBased = IsGridBasedDatumConvertCode(GetDatumConvertMethod()) || IsGridBasedDatumConvertCode(targetGCS.GetDatumConvertMethod());
+    ReprojectStatus status = REPROJECT_Success;
+
+    for (int iPoint = 0; iPoint < numPoints; ++iPoint)
+        {
+        GeoPointR       outPoint = outLatLong[iPoint];
+        GeoPointCR      inPoint = inLatLong[iPoint];
+        ReprojectStatus pointStatus = m_datumConverter->ConvertLatLong3D (outPoint, inPoint);
+
+        if (gridBased && REPROJECT_Success == pointStatus && (fabs(outPoint.latitude - inPoint.latitude) > 0.5 || fabs(outPoint.longitude - inPoint.longitude) > 0.5))
+            {
+            outPoint.latitude = inPoint.latitude;
+            outPoint.longitude = inPoint.longitude;
+            pointStatus = REPROJECT_CSMAPERR_OutOfUsefulRange;
+            }
+
+        if (NULL != outStatuses)
+            outStatuses[iPoint] = pointStatus;
+
+        AccumulateReprojectStatus (status, pointStatus);
+        }
+
+    return status;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -1091,6 +1091,21 @@ BASEGEOCOORD_EXPORTED  ReprojectStatus     GetLinearTransformToECEF
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
 BASEGEOCOORD_EXPORTED ReprojectStatus  CartesianFromCartesian(DPoint3dR outCartesian, DPoint3dCR inCartesian, BaseGCSCR targetGCS) const;
+
+/*---------------------------------------------------------------------------------**//**
+* CartesianFromCartesian - Converts an array of points from the Cartesian of the GCS to the Cartesian
+* of the target. Each stage of the conversion is applied to the whole array before the next one.
+* @return The hardest error encountered over all points, with the same meaning as the single point version.
+*
+* @param    outCartesian   OUT Receives the output coordinates. Must hold numPoints entries.
+* @param    outStatuses    OUT Optional. If not NULL, receives the status of each individual point.
+* @param    inCartesian    IN  The input coordinates.
+* @param    numPoints      IN  The number of points to convert.
+* @param    targetGCS      IN  target coordinate system
+*
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+BASEGEOCOORD_EXPORTED ReprojectStatus  CartesianFromCartesian(DPoint3dP outCartesian, ReprojectStatus* outStatuses, DPoint3dCP inCartesian, int numPoints, BaseGCSCR targetGCS) const;
 BASEGEOCOORD_EXPORTED ReprojectStatus  CartesianFromCartesian2D(DPoint2dR outCartesian, DPoint2dCR inCartesian, BaseGCSCR targetGCS) const;
 
 /*---------------------------------------------------------------------------------**//**
@@ -3068,6 +3083,25 @@ DPoint3dR       outCartesian,       // <= cartesian coordinates in this GCS
 GeoPointCR      inLatLong           // => latitude longitude in this GCS
 ) const;
 
+/*---------------------------------------------------------------------------------**//**
+* Calculates the cartesian coordinates of an array of Longitude/Latitude/Elevation points.
+* @param    outCartesian    OUT     The calculated cartesian coordinates. Must hold numPoints entries.
+* @param    outStatuses     OUT     Optional. If not NULL, receives the status of each individual point.
+* @param    inLatLong       IN      The longitude,latitude,elevation in the datum of this GCS.
+* @param    numPoints       IN      The number of points to convert.
+* @return   The hardest error encountered, as returned by #CartesianFromCartesian.
+* @remarks The setup shared by all points (validity checks, datum converter) is performed once for the
+*          whole array, making this method preferable to repeated single point calls for large point sets.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+BASEGEOCOORD_EXPORTED ReprojectStatus   CartesianFromLatLong
+(
+DPoint3dP       outCartesian,       // <= cartesian coordinates in this GCS
+ReprojectStatus* outStatuses,       // <= optional per-point status
+GeoPointCP      inLatLong,          // => latitude longitude in this GCS
+int             numPoints           // => number of points
+) const;
+
 BASEGEOCOORD_EXPORTED ReprojectStatus   ECEFCartesianFromLatLong
 (
     DPoint3dR       outCartesian,       // <= cartesian coordinates in this GCS
@@ -3098,6 +3132,25 @@ GeoPointR       outLatLong,         // <= latitude longitude in this GCS
 DPoint3dCR      inCartesian         // => cartesian coordinates in this GCS
 ) const;
 
+/*---------------------------------------------------------------------------------**//**
+* Calculates the longitude, latitude, and elevation of an array of cartesian points.
+* @param    outLatLong      OUT     The calculated longitude,latitude,elevation. Must hold numPoints entries.
+* @param    outStatuses     OUT     Optional. If not NULL, receives the status of each individual point.
+* @param    inCartesian     IN      The input cartesian coordinates.
+* @param    numPoints       IN      The number of points to convert.
+* @return   The hardest error encountered, as returned by #CartesianFromCartesian.
+* @remarks The setup shared by all points (validity checks, datum converter) is performed once for the
+*          whole array, making this method preferable to repeated single point calls for large point sets.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+BASEGEOCOORD_EXPORTED ReprojectStatus   LatLongFromCartesian
+(
+GeoPointP       outLatLong,         // <= latitude longitude in this GCS
+ReprojectStatus* outStatuses,       // <= optional per-point status
+DPoint3dCP      inCartesian,        // => cartesian coordinates in this GCS
+int             numPoints           // => number of points
+) const;
+
 /*---------------------------------------------------------------------------------**//**
 * Calculates the longitude and latitude from cartesian x and y. Elevation is unchanged.
 * @param    outLatLong      OUT     The calculated longitude and latitude in the datum of this GCS.
@@ -3191,6 +3244,27 @@ GeoPointCR      inLatLong,
 BaseGCSCR       targetGCS
 ) const;
 
+/*---------------------------------------------------------------------------------**//**
+* Calculates the longitude and latitude in the target GCS of an array of points, applying the appropriate datum shift.
+* @param    outLatLong      OUT     The calculated longitude,latitude,elevation in the datum of targetGCS. Must hold numPoints entries.
+* @param    outStatuses     OUT     Optional. If not NULL, receives the status of each individual point.
+* @param    inLatLong       IN      The longitude,latitude,elevation in the datum of this GCS.
+* @param    numPoints       IN      The number of points to convert.
+* @param    targetGCS       IN      The Coordinate System corresponding to outLatLong.
+* @return   The hardest error encountered, as returned by #CartesianFromCartesian.
+* @remarks The setup shared by all points (validity checks, datum converter) is performed once for the
+*          whole array, making this method preferable to repeated single point calls for large point sets.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+BASEGEOCOORD_EXPORTED ReprojectStatus   LatLongFromLatLong
+(
+GeoPointP       outLatLong,
+ReprojectStatus* outStatuses,
+GeoPointCP      inLatLong,
+int             numPoints,
+BaseGCSCR       targetGCS
+) const;
+
 /*---------------------------------------------------------------------------------**//**
 * Calculates the longitude and latitude in the target GCS, applying the appropriate datum shift.
 * @param    outLatLong      OUT     The calculated longitude,latitude in the datum of targetGCS.
@@ -544,6 +544,77 @@ TEST_F(BaseGCSUnitTests, SpecificCoordConversionShellAppomattox)
     EXPECT_NEAR(ptTarget.z, 239.167, 0.002);
 }
 
+/*---------------------------------------------------------------------------------**//**
+* Array conversions must give the same results and statuses as single point ones
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(BaseGCSUnitTests, ArrayConversionsMatchSinglePoint)
+{
+    GeoCoordinates::BaseGCSPtr firstGCS = GeoCoordinates::BaseGCS::CreateGCS("UTM83-16");
+    GeoCoordinates::BaseGCSPtr secondGCS = GeoCoordinates::BaseGCS::CreateGCS("UTM27-16");
+
+    ASSERT_TRUE(firstGCS.IsValid() && firstGCS->IsValid());
+    ASSERT_TRUE(secondGCS.IsValid() && secondGCS->IsValid());
+
+    bvector<DPoint3d> inCartesian;
+    for (int i = 0; i < 50; ++i)
+        inCartesian.push_back(DPoint3d::From(450000.0 + 1000.0 * i, 3900000.0 - 750.0 * i, 10.0 * i));
+
+    // One point far outside the domain so that warnings are also compared.
+    inCartesian.push_back(DPoint3d::From(-8000000.0, 1000000.0, 0.0));
+
+    int numPoints = (int)inCartesian.size();
+    bvector<GeoPoint> latLongs(numPoints);
+    bvector<GeoPoint> targetLatLongs(numPoints);
+    bvector<DPoint3d> outCartesian(numPoints);
+    bvector<DPoint3d> directCartesian(numPoints);
+    bvector<ReprojectStatus> statuses(numPoints);
+    bvector<ReprojectStatus> directStatuses(numPoints);
+
+    ReprojectStatus latLongStatus = firstGCS->LatLongFromCartesian(latLongs.data(), statuses.data(), inCartesian.data(), numPoints);
+    ReprojectStatus expectedStatus = REPROJECT_Success;
+    for (int i = 0; i < numPoints; ++i)
+        {
+        GeoPoint latLong;
+        ReprojectStatus pointStatus = firstGCS->LatLongFromCartesian(latLong, inCartesian[i]);
+        EXPECT_EQ(pointStatus, statuses[i]);
+        EXPECT_DOUBLE_EQ(latLong.longitude, latLongs[i].longitude);
+        EXPECT_DOUBLE_EQ(latLong.latitude, latLongs[i].latitude);
+        EXPECT_DOUBLE_EQ(latLong.elevation, latLongs[i].elevation);
+        if (REPROJECT_Success != pointStatus)
+            expectedStatus = pointStatus;
+        }
+    EXPECT_EQ(expectedStatus, latLongStatus);
+
+    firstGCS->LatLongFromLatLong(targetLatLongs.data(), statuses.data(), latLongs.data(), numPoints, *secondGCS);
+    secondGCS->CartesianFromLatLong(outCartesian.data(), statuses.data(), targetLatLongs.data(), numPoints);
+    for (int i = 0; i < numPoints; ++i)
+        {
+        GeoPoint targetLatLong;
+        firstGCS->LatLongFromLatLong(targetLatLong, latLongs[i], *secondGCS);
+        EXPECT_DOUBLE_EQ(targetLatLong.longitude, targetLatLongs[i].longitude);
+        EXPECT_DOUBLE_EQ(targetLatLong.latitude, targetLatLongs[i].latitude);
+
+        DPoint3d cartesian;
+        EXPECT_EQ(secondGCS->CartesianFromLatLong(cartesian, targetLatLongs[i]), statuses[i]);
+        EXPECT_TRUE(cartesian.IsEqual(outCartesian[i]));
+        }
+
+    firstGCS->CartesianFromCartesian(directCartesian.data(), directStatuses.data(), inCartesian.data(), numPoints, *secondGCS);
+    for (int i = 0; i < numPoints; ++i)
+        {
+        DPoint3d cartesian;
+        EXPECT_EQ(firstGCS->CartesianFromCartesian(cartesian, inCartesian[i], *secondGCS), directStatuses[i]);
+        EXPECT_TRUE(cartesian.IsEqual(directCartesian[i]));
+        }
+
+    // Invalid target reports the error for every point
+    GeoCoordinates::BaseGCSPtr invalidGCS = GeoCoordinates::BaseGCS::CreateGCS();
+    EXPECT_EQ((ReprojectStatus)GEOCOORDERR_InvalidCoordSys, firstGCS->CartesianFromCartesian(directCartesian.data(), directStatuses.data(), inCartesian.data(), numPoints, *invalidGCS));
+    for (auto pointStatus : directStatuses)
+        EXPECT_EQ((ReprojectStatus)GEOCOORDERR_InvalidCoordSys, pointStatus);
+}
+
 /*---------------------------------------------------------------------------------**//**
 * Domain tests
 * @bsimethod
@@ -761,6 +761,7 @@ enum BoolSelect
     BoolSelect_Summed_Positive = 4,   // Positive sum of leaf level integers
     BoolSelect_Summed_NonZero  = 5,   // Nonzero sum of leaf level integers
     BoolSelect_Summed_Negative = 6,    // Negative sum of leaf level integers.
+    BoolSelect_Intersection    = 7,    // INTERSECTION of leaf level bools
     BoolSelect_FromStructure = 1000   // Dictated by structure of supplied data.
     };
 
@@ -972,6 +972,8 @@ GEOMDLLIMPEXP CurveVectorPtr AssembleChains ();
 //flex || Intersection || outRegion = CurveVector::AreaIntersection (regionA, regionB, newToOld) ||
 //flex || Difference || outRegion = CurveVector::AreaDifference (regionA, regionB, newToOld) ||
 //flex || Parity   || outRegion = CurveVector::AreaParity (regionA, regionB, newToOld) ||
+//flex || Union of many || outRegion = CurveVector::AreaUnion (regions, newToOld) ||
+//flex || Intersection of many || outRegion = CurveVector::AreaIntersection (regions, newToOld) ||
 //flex
 
 //! Return a curve vector containing the union of input areas.
@@ -998,10 +1000,25 @@ GEOMDLLIMPEXP static CurveVectorPtr AreaIntersection (CurveVectorCR regionA, Cur
 //! @param [in,out] newToOld (optional) pointer to bvector to receive paring of new and old curves.
 GEOMDLLIMPEXP static CurveVectorPtr AreaParity (CurveVectorCR regionA, CurveVectorCR regionB, CurvePrimitivePtrPairVector *newToOld = NULL);
 
+//! Return a curve vector containing the union of many input areas.
+//! Inputs whose xy ranges overlap (directly or through other inputs) are merged together in a single graph.
+//! Such clusters are independent, and their results are collected into one union region.
+//! @param [in] regions input areas.  Invalid pointers are ignored.
+//! @param [in,out] newToOld (optional) pointer to bvector to receive paring of new and old curves.
+//! @param [in] parallel true to compute the clusters on separate threads (one per core). Leave false when called from a thread pool.
+GEOMDLLIMPEXP static CurveVectorPtr AreaUnion (bvector<CurveVectorPtr> const &regions, CurvePrimitivePtrPairVector *newToOld = NULL, bool parallel = false);
+
+//! Return a curve vector containing the intersection of many input areas, computed in a single graph.
+//! Returns an invalid pointer if the intersection is empty, including when some pair of inputs has disjoint xy ranges.
+//! @param [in] regions input areas.  Invalid pointers are ignored.
+//! @param [in,out] newToOld (optional) pointer to bvector to receive paring of new and old curves.
+//! @param [in] parallel true to reduce union region operands on separate threads (one per core). Leave false when called from a thread pool.
+GEOMDLLIMPEXP static CurveVectorPtr AreaIntersection (bvector<CurveVectorPtr> const &regions, CurvePrimitivePtrPairVector *newToOld = NULL, bool parallel = false);
+
 //! Return a curve vector containing the "inside" areas by various conditions.
 //! @param [in] region Region that may have loops back over its area.
 //! @param [in] select1 Rule for classifying single area: one of AreaSelect_Parity, AreaSelect_CCWPositiveWindingNumber,  AreaSelect_CCWNonzeroWindingNumber, AreaSelect_CCWNegativeWindingNumber
-//! @param [in] select2 Rule for combining leaf left results: One of BoolSelect_Parity, BoolSelect_Union, BoolSelect_Sum_Parity, BoolSelect_CCWPositiveWindingNumber,  BoolSelect_CCWNonzeroWindingNumber, BoolSelect_CCWNegativeWindingNumber
+//! @param [in] select2 Rule for combining leaf left results: One of BoolSelect_Parity, BoolSelect_Union, BoolSelect_Intersection, BoolSelect_Sum_Parity, BoolSelect_CCWPositiveWindingNumber,  BoolSelect_CCWNonzeroWindingNumber, BoolSelect_CCWNegativeWindingNumber
 //! @param [in] reverse to return the opposite set of faces.
 GEOMDLLIMPEXP static CurveVectorPtr AreaAnalysis
         (CurveVectorCR region, AreaSelect select1, BoolSelect select2, bool reverse);
@@ -1141,7 +1141,8 @@ GEOMAPI_VIRTUAL StatusInt   _ProcessClippedPolyface (PolyfaceHeaderR polyfaceHea
 };
 
  //! @description Clip polyface to intersection of an array of plane sets.
-GEOMDLLIMPEXP StatusInt   ClipToPlaneSetIntersection (T_ClipPlaneSets const& planeSets, IClipToPlaneSetOutput& output, bool triangulateOutput) const;
+ //! @param [in] parallel if true, large meshes are clipped in blocks of facets on multiple threads. The output is identical to the serial clip.
+GEOMDLLIMPEXP StatusInt   ClipToPlaneSetIntersection (T_ClipPlaneSets const& planeSets, IClipToPlaneSetOutput& output, bool triangulateOutput, bool parallel = false) const;
 
 
 //!  @description Fast clustered vertex decimator - used during tile generation.
@@ -4,6 +4,8 @@
 *--------------------------------------------------------------------------------------------*/
 #include <bsibasegeomPCH.h>
 #include <Mtg/capi/mtgprint_capi.h>
+#include <atomic>
+#include <thread>
 
 BEGIN_BENTLEY_GEOMETRY_NAMESPACE
 
@@ -30,6 +32,93 @@ CurvePrimitivePtrPair::CurvePrimitivePtrPair (ICurvePrimitivePtr _curveA, ICurve
     {
     }
 
+/*--------------------------------------------------------------------------------**//**
+* Call func (i) for each i in [0, count), spread over the available cores if parallel is set, otherwise in order on the calling thread.
+* Each index is handled by exactly one thread; func must not share mutable state between indices.
+* @bsimethod
++--------------------------------------------------------------------------------------*/
+static void forEach (size_t count, bool parallel, std::function<void (size_t)> const &func)
+    {
+    size_t numThreads = parallel ? std::min ((size_t)std::max (1u, std::thread::hardware_concurrency ()), count) : 1;
+    std::atomic<size_t> next (0);
+    auto worker = [&] ()
+        {
+        for (size_t i; (i = next++) < count;)
+            func (i);
+        };
+
+    if (numThreads <= 1)
+        {
+        worker ();
+        return;
+        }
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < numThreads; i++)
+        threads.emplace_back (worker);
+    worker ();
+    for (auto &thread : threads)
+        thread.join ();
+    }
+
+/*--------------------------------------------------------------------------------**//**
+* Partition regions into clusters connected by (transitive) overlap of their xy ranges.
+* Regions in different clusters cannot interact in an area boolean.
+* Clusters are ordered by their first member, and members keep their input order.
+* @bsimethod
++--------------------------------------------------------------------------------------*/
+static void clusterByXYRange (bvector<CurveVectorCP> const &regions, bvector<bvector<CurveVectorCP>> &clusters)
+    {
+    clusters.clear ();
+    size_t n = regions.size ();
+    bvector<DRange3d> ranges (n);
+    bvector<size_t> order;
+    bvector<size_t> root (n);
+    for (size_t i = 0; i < n; i++)
+        {
+        root[i] = i;
+        if (regions[i]->GetRange (ranges[i]) && !ranges[i].IsNull ())
+            order.push_back (i);
+        }
+
+    auto findRoot = [&] (size_t i)
+        {
+        while (root[i] != i)
+            i = root[i] = root[root[i]];
+        return i;
+        };
+
+    // Sweep in x: only regions starting before the current one ends can overlap it.
+    std::sort (order.begin (), order.end (), [&] (size_t a, size_t b) {return ranges[a].low.x < ranges[b].low.x;});
+    for (size_t a = 0; a < order.size (); a++)
+        {
+        DRange3dCR rangeA = ranges[order[a]];
+        for (size_t b = a + 1; b < order.size () && ranges[order[b]].low.x <= rangeA.high.x + s_vertexAbsTol; b++)
+            {
+            if (rangeA.IntersectsWith (ranges[order[b]], s_vertexAbsTol, 2))
+                {
+                size_t rootA = findRoot (order[a]);
+                size_t rootB = findRoot (order[b]);
+                root[std::max (rootA, rootB)] = std::min (rootA, rootB);
+                }
+            }
+        }
+
+    std::sort (order.begin (), order.end ());
+    bmap<size_t, size_t> rootToCluster;
+    for (size_t i : order)
+        {
+        size_t r = findRoot (i);
+        auto found = rootToCluster.find (r);
+        if (found == rootToCluster.end ())
+            {
+            found = rootToCluster.insert (bpair<size_t, size_t> (r, clusters.size ())).first;
+            clusters.push_back (bvector<CurveVectorCP> ());
+            }
+        clusters[found->second].push_back (regions[i]);
+        }
+    }
+
 
 /*--------------------------------------------------------------------------------**//**
 * @bsistruct
@@ -216,6 +305,35 @@ void Load(CurveVectorCR source, bool advanceGroupAfterPath = true)
      jmdlRG_print (m_rgContext, "After Load");
     }
 
+/*--------------------------------------------------------------------------------**//**
+* Load all loops of the source into the current group, then advance the group id.
+* Only valid when the source's areas do not overlap one another (e.g. the output of a union), so that parity within the group gives the source's area.
+* @bsimethod
++--------------------------------------------------------------------------------------*/
+void LoadAsOneGroup(CurveVectorCR source)
+    {
+    loadLoopsIntoCurrentGroup (source);
+    IncrementNextGroupId ();
+    }
+
+private:
+void loadLoopsIntoCurrentGroup(CurveVectorCR source)
+    {
+    if (source.IsClosedPath ())
+        Load (source, false);
+    else if (source.IsUnionRegion () || source.IsParityRegion ())
+        {
+        for (size_t i = 0; i < source.size (); i++)
+            {
+            CurveVectorCP child = source.at (i)->GetChildCurveVectorCP ();
+            if (NULL != child)
+                loadLoopsIntoCurrentGroup (*child);
+            }
+        }
+    }
+
+public:
+
 
 /*--------------------------------------------------------------------------------**//**
 * @bsimethod
@@ -757,9 +875,131 @@ const char * name = "op"
     return result;
     }
 
+/*--------------------------------------------------------------------------------**//**
+* Merge everything loaded so far and assemble the faces selected by the analysis rules.
+* @bsimethod
++--------------------------------------------------------------------------------------*/
+CurveVectorPtr MergeAndCollectAnalysisFaces (AreaSelect groupOp, BoolSelect boolOp)
+    {
+    CurveVectorPtr result;
+    Merge (true);
+
+    MTG_MarkSet faceSet (GetGraph (), MTG_ScopeFace);
+    if (jmdlRG_collectAnalysisFaces (m_rgContext, groupOp, boolOp, &faceSet, false))
+        {
+        bvector<int> startArray;
+        bvector<int> sequenceArray;
+        bvector<int> nodeIdToDepthArray;
+        jmdlRG_collectAndNumberExtendedFaceLoops (m_rgContext, &startArray, &sequenceArray, &faceSet);
+        jmdlRG_setMarksetDepthByInwardSearch (m_rgContext, &nodeIdToDepthArray, &faceSet);
+        TryAssembleComponents (sequenceArray, nodeIdToDepthArray, result);
+        }
+
+    return result;
+    }
+
+/*--------------------------------------------------------------------------------**//**
+* Union of any number of regions with a single merge.  Each closed path, parity region, and union region child is its own group.
+* @bsimethod
++--------------------------------------------------------------------------------------*/
+static CurveVectorPtr doMultiUnion
+(
+bvector<CurveVectorCP> const &regions,
+CurvePrimitivePtrPairVector *newCurveToOldCurve
+)
+    {
+    AreaBooleanContext context (newCurveToOldCurve);
+    context.SetNextGroupId (0);
+    for (CurveVectorCP region : regions)
+        context.Load (*region);
+
+    return context.MergeAndCollectAnalysisFaces (AreaSelect_Parity, BoolSelect_Union);
+    }
+
+/*--------------------------------------------------------------------------------**//**
+* Intersection of any number of regions with a single merge.  Each region is one group, so a face is in the result if it is in every group.
+* @bsimethod
++--------------------------------------------------------------------------------------*/
+static CurveVectorPtr doMultiIntersection
+(
+bvector<CurveVectorCP> const &regions,
+CurvePrimitivePtrPairVector *newCurveToOldCurve,
+bool parallel
+)
+    {
+    if (regions.empty ())
+        return nullptr;
+
+    // The intersection lies within the intersection of the ranges ...
+    DRange3d commonRange;
+    if (!regions[0]->GetRange (commonRange))
+        return nullptr;
+    for (size_t i = 1; i < regions.size (); i++)
+        {
+        DRange3d range;
+        if (!regions[i]->GetRange (range) || !commonRange.IntersectsWith (range, s_vertexAbsTol, 2))
+            return nullptr;
+        commonRange = DRange3d::FromIntersection (commonRange, range, true);   // planar regions have zero z extent
+        commonRange.Extend (s_vertexAbsTol);
+        }
+
+    // Children of a union region may overlap, so parity over all their loops would be wrong.
+    // Reduce each union region to disjoint areas first; these are independent, so they can be done in parallel.
+    bvector<CurveVectorPtr> reduced (regions.size ());
+    bvector<CurvePrimitivePtrPairVector> reducedToOld (NULL != newCurveToOldCurve ? regions.size () : 0);
+    forEach (regions.size (), parallel, [&] (size_t i)
+        {
+        if (regions[i]->IsUnionRegion ())
+            reduced[i] = doMultiUnion (bvector<CurveVectorCP> (1, regions[i]), NULL != newCurveToOldCurve ? &reducedToOld[i] : NULL);
+        });
+
+    CurvePrimitivePtrPairVector resultToReduced;
+    AreaBooleanContext context (NULL != newCurveToOldCurve ? &resultToReduced : NULL);
+    context.SetNextGroupId (0);
+    for (size_t i = 0; i < regions.size (); i++)
+        {
+        if (regions[i]->IsUnionRegion () && !reduced[i].IsValid ())
+            return nullptr;     // empty operand
+        context.LoadAsOneGroup (reduced[i].IsValid () ? *reduced[i] : *regions[i]);
+        }
+
+    CurveVectorPtr result = context.MergeAndCollectAnalysisFaces (AreaSelect_Parity, BoolSelect_Intersection);
+
+    if (NULL != newCurveToOldCurve)
+        {
+        // Curves that came from a reduced union region map back through that union to the caller's curves.
+        bmap<ICurvePrimitiveCP, ICurvePrimitivePtr> reducedCurveToOld;
+        for (auto const &pairs : reducedToOld)
+            for (auto const &pair : pairs)
+                reducedCurveToOld[pair.curveA.get ()] = pair.curveB;
+
+        for (auto const &pair : resultToReduced)
+            {
+            auto found = reducedCurveToOld.find (pair.curveB.get ());
+            newCurveToOldCurve->push_back (found == reducedCurveToOld.end () ? pair : CurvePrimitivePtrPair (pair.curveA, found->second));
+            }
+        }
+
+    return result;
+    }
 
 };
 
+/*--------------------------------------------------------------------------------**//**
+* Collect the valid members of regions.
+* @bsimethod
++--------------------------------------------------------------------------------------*/
+static bvector<CurveVectorCP> validRegions (bvector<CurveVectorPtr> const &regions)
+    {
+    bvector<CurveVectorCP> valid;
+    for (auto const &region : regions)
+        {
+        if (region.IsValid ())
+            valid.push_back (region.get ());
+        }
+    return valid;
+    }
+
 
 /*--------------------------------------------------------------------------------**//**
 * @bsimethod
@@ -784,6 +1024,61 @@ CurveVectorPtr CurveVector::AreaDifference (CurveVectorCR regionA, CurveVectorCR
 CurveVectorPtr CurveVector::AreaParity (CurveVectorCR regionA, CurveVectorCR regionB, CurvePrimitivePtrPairVector *newToOld)
     {return AreaBooleanContext::doBoolop (regionA, regionB, RGBoolSelect_Parity, newToOld, "Parity");}
 
+/*--------------------------------------------------------------------------------**//**
+* @bsimethod
++--------------------------------------------------------------------------------------*/
+CurveVectorPtr CurveVector::AreaUnion (bvector<CurveVectorPtr> const &regions, CurvePrimitivePtrPairVector *newToOld, bool parallel)
+    {
+    bvector<bvector<CurveVectorCP>> clusters;
+    clusterByXYRange (validRegions (regions), clusters);
+
+    // Clusters cannot interact, so each gets its own graph (and, if parallel, thread).
+    bvector<CurveVectorPtr> clusterUnions (clusters.size ());
+    bvector<CurvePrimitivePtrPairVector> clusterNewToOld (NULL != newToOld ? clusters.size () : 0);
+    forEach (clusters.size (), parallel, [&] (size_t i)
+        {
+        clusterUnions[i] = AreaBooleanContext::doMultiUnion (clusters[i], NULL != newToOld ? &clusterNewToOld[i] : NULL);
+        });
+
+    // The cluster unions are disjoint, so they are simply collected as siblings.
+    CurveVectorPtr result;
+    for (size_t i = 0; i < clusterUnions.size (); i++)
+        {
+        if (NULL != newToOld)
+            newToOld->insert (newToOld->end (), clusterNewToOld[i].begin (), clusterNewToOld[i].end ());
+
+        CurveVectorPtr clusterUnion = clusterUnions[i];
+        if (!clusterUnion.IsValid ())
+            continue;
+
+        if (!result.IsValid ())
+            {
+            result = clusterUnion;
+            continue;
+            }
+
+        if (!result->IsUnionRegion ())
+            {
+            CurveVectorPtr first = result;
+            result = CurveVector::Create (CurveVector::BOUNDARY_TYPE_UnionRegion);
+            result->push_back (ICurvePrimitive::CreateChildCurveVector_SwapFromSource (*first));
+            }
+
+        if (clusterUnion->IsUnionRegion ())
+            result->insert (result->end (), clusterUnion->begin (), clusterUnion->end ());
+        else
+            result->push_back (ICurvePrimitive::CreateChildCurveVector_SwapFromSource (*clusterUnion));
+        }
+
+    return result;
+    }
+
+/*--------------------------------------------------------------------------------**//**
+* @bsimethod
++--------------------------------------------------------------------------------------*/
+CurveVectorPtr CurveVector::AreaIntersection (bvector<CurveVectorPtr> const &regions, CurvePrimitivePtrPairVector *newToOld, bool parallel)
+    {return AreaBooleanContext::doMultiIntersection (validRegions (regions), newToOld, parallel);}
+
 
 /*--------------------------------------------------------------------------------**//**
 * @bsimethod
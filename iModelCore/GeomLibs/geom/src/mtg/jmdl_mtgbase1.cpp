@@ -50,7 +50,6 @@ MTGGraphCP        pGraph,
     }
 
 
-static int s_numAllocatedGraphs = 0;
 /**
 * Create a new graph.  The return value from this function is the
 * to be used as the pGraph argument on all subsequent operations on the
@@ -182,11 +181,7 @@ Public GEOMDLLIMPEXP MTGGraphP jmdlMTGGraph_freeGraph
 MTGGraphP pGraph
 )
     {
-    if (pGraph)
-        {
-        delete pGraph;
-        s_numAllocatedGraphs--;
-        }
+    delete pGraph;
     return NULL;
     }
 
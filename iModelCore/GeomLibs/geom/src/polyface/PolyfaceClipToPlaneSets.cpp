@@ -7,6 +7,8 @@
 
 #include  <Bentley/bset.h>
 #include  <Bentley/bmap.h>
+#include  <atomic>
+#include  <thread>
 
 BEGIN_BENTLEY_GEOMETRY_NAMESPACE
 
@@ -513,8 +515,17 @@ void    Init (PolyfaceVisitorR visitor, OutputChainMap& outputChainMap)
         m_params.resize(count);
         BeStringUtilities::Memcpy (&m_params[0], count * sizeof (DPoint2d), visitor.GetParamCP(), count * sizeof (DPoint2d));
         }
+    // Copy the aux data values rather than the channels, which the visitor refills for every facet.
+    // Facets collected for clipFacetsInParallel are only added to the output after the visitor has moved on.
+    m_auxChannels.clear();
     if (visitor.GetAuxDataCP().IsValid())
-        m_auxChannels = visitor.GetAuxDataCP()->GetChannels();
+        {
+        PolyfaceAuxData::ChannelsCR visitorChannels = visitor.GetAuxDataCP()->GetChannels();
+
+        m_auxChannels.Init (visitorChannels);
+        for (size_t i=0; i<count; i++)
+            m_auxChannels.AppendDataByIndex (visitorChannels, i);
+        }
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -570,14 +581,16 @@ struct PolyfaceClipToPlaneSetContext
     double                              m_areaTolerance;
     OutputChainMap&                     m_outputChainMap;
     T_ClipPlaneSets const&              m_planeSets;
+    bvector<PolyfaceClipFacet>*         m_clippedFacets;    // if set, clipped facets are collected here instead of added to m_builder.
 
-    PolyfaceClipToPlaneSetContext (T_ClipPlaneSets const& planeSets, LightweightPolyfaceBuilder& output, OutputChainMap& chainMap, double tolerance, bool triangulate) :
+    PolyfaceClipToPlaneSetContext (T_ClipPlaneSets const& planeSets, LightweightPolyfaceBuilder& output, OutputChainMap& chainMap, double tolerance, bool triangulate, bvector<PolyfaceClipFacet>* clippedFacets = nullptr) :
                         m_planeSets(planeSets),
                         m_builder (output),
                         m_outputChainMap (chainMap),
                         m_tolerance (tolerance),
                         m_areaTolerance (tolerance * tolerance),
-                        m_triangulate (triangulate) { }
+                        m_triangulate (triangulate),
+                        m_clippedFacets (clippedFacets) { }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
@@ -686,7 +699,10 @@ void   ClipPolyfaceFacet (PolyfaceClipFacet const& facet)
     {
     if (facet.m_index == m_planeSets.size())
         {
-        facet.AddToPolyface (m_builder, m_outputChainMap, m_areaTolerance);
+        if (nullptr != m_clippedFacets)
+            m_clippedFacets->push_back (facet);
+        else
+            facet.AddToPolyface (m_builder, m_outputChainMap, m_areaTolerance);
         return;
         }
 
@@ -731,10 +747,101 @@ StatusInt   finishClipping (LightweightPolyfaceBuilder& outputBuilder,  OutputCh
     return output._ProcessClippedPolyface (clippedMesh);
     }
 
+static size_t   s_minFacetsPerClipBlock = 2000;
+
+/*=================================================================================**//**
+* Clipped facets from a contiguous range of source facets, in source order.
+* @bsiclass
++===============+===============+===============+===============+===============+======*/
+struct  ClippedFacetBlock
+{
+    bvector<PolyfaceClipFacet>      m_facets;           // surviving pieces of all source facets in the block.
+    bvector<size_t>                 m_pieceCounts;      // number of pieces contributed by each source facet.
+};
+
+/*---------------------------------------------------------------------------------**//**
+* Clip blocks of source facets on multiple threads, then add the surviving pieces to the output
+* builder in source order on this thread.  The builder sees exactly the same calls as the serial loop,
+* so point indices and output are identical.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static void clipFacetsInParallel
+(
+PolyfaceQueryCR                 source,
+bvector<size_t> const&          readIndices,
+T_ClipPlaneSets const&          planeSets,
+LightweightPolyfaceBuilder&     outputBuilder,
+OutputChainMap&                 outputChainMap,
+double                          distanceTolerance,
+bool                            triangulateOutput
+)
+    {
+    size_t                      numThreads = std::max (1u, std::thread::hardware_concurrency());
+    size_t                      numBlocks = std::max ((size_t) 1, std::min (4 * numThreads, readIndices.size() / s_minFacetsPerClipBlock));
+    size_t                      blockSize = (readIndices.size() + numBlocks - 1) / numBlocks;
+    bvector<ClippedFacetBlock>  blocks (numBlocks);
+    std::atomic<size_t>         nextBlock (0);
+
+    // The chain map is only read during clipping, and workers never touch the builder.
+    auto worker = [&] ()
+        {
+        for (size_t iBlock; (iBlock = nextBlock++) < numBlocks; )
+            {
+            ClippedFacetBlock&              block = blocks[iBlock];
+            PolyfaceClipFacet               facet (0);
+            PolyfaceClipToPlaneSetContext   clipContext (planeSets, outputBuilder, outputChainMap, distanceTolerance, triangulateOutput, &block.m_facets);
+            PolyfaceVisitorPtr              visitor = PolyfaceVisitor::AttachWithWrap (source, true, 1);
+
+            for (size_t i = iBlock * blockSize, end = std::min (i + blockSize, readIndices.size()); i < end && visitor->MoveToFacetByReadIndex (readIndices[i]); i++)
+                {
+                size_t      numPieces = block.m_facets.size();
+
+                facet.Init (*visitor, outputChainMap);
+                clipContext.ClipPolyfaceFacet (facet);
+                block.m_pieceCounts.push_back (block.m_facets.size() - numPieces);
+                }
+            }
+        };
+
+    std::vector<std::thread>    threads;
+    for (size_t i = 1; i < std::min (numThreads, numBlocks); i++)
+        threads.emplace_back (worker);
+    worker ();
+    for (auto& thread : threads)
+        thread.join ();
+
+    double                      areaTolerance = distanceTolerance * distanceTolerance;
+    size_t                      currentFaceIndex = 0, thisFaceIndex;
+    FacetFaceData               faceData;
+
+    for (size_t iBlock = 0; iBlock < numBlocks; iBlock++)
+        {
+        ClippedFacetBlock const&    block = blocks[iBlock];
+        size_t                      iPiece = 0;
+
+        for (size_t i = 0; i < block.m_pieceCounts.size(); i++)
+            {
+            if (source.TryGetFacetFaceDataAtReadIndex (readIndices[iBlock * blockSize + i], faceData, thisFaceIndex))
+                {
+                if (thisFaceIndex != currentFaceIndex)
+                    {
+                    outputBuilder.EndFace ();
+                    outputBuilder.SetFaceData (faceData);
+                    currentFaceIndex = thisFaceIndex;
+                    }
+                }
+            for (size_t iEnd = iPiece + block.m_pieceCounts[i]; iPiece < iEnd; iPiece++)
+                block.m_facets[iPiece].AddToPolyface (outputBuilder, outputChainMap, areaTolerance);
+            }
+        }
+    outputBuilder.SetFaceData (faceData);
+    outputBuilder.EndFace();
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-StatusInt   PolyfaceQuery::ClipToPlaneSetIntersection (T_ClipPlaneSets const& planeSets, PolyfaceQuery::IClipToPlaneSetOutput& output, bool triangulateOutput) const
+StatusInt   PolyfaceQuery::ClipToPlaneSetIntersection (T_ClipPlaneSets const& planeSets, PolyfaceQuery::IClipToPlaneSetOutput& output, bool triangulateOutput, bool parallel) const
     {
     static double           s_relativeTolerance = 1.0E-6;
     size_t                  index;
@@ -774,6 +881,17 @@ StatusInt   PolyfaceQuery::ClipToPlaneSetIntersection (T_ClipPlaneSets const& pl
     size_t                              currentFaceIndex = 0, thisFaceIndex;
     FacetFaceData                       faceData;
 
+    if (parallel && std::thread::hardware_concurrency() > 1 && GetNumFacet() >= 2 * s_minFacetsPerClipBlock)
+        {
+        bvector<size_t>     readIndices;
+
+        for (PolyfaceVisitorPtr visitor = PolyfaceVisitor::Attach (*this, false); visitor->AdvanceToNextFace(); )
+            readIndices.push_back (visitor->GetReadIndex());
+
+        clipFacetsInParallel (*this, readIndices, planeSets, *outputBuilder, outputChainMap, distanceTolerance, triangulateOutput);
+        return finishClipping(*outputBuilder, outputChainMap, output, triangulateOutput);
+        }
+
     for (PolyfaceVisitorPtr visitor = PolyfaceVisitor::AttachWithWrap (*this, true, 1); visitor->AdvanceToNextFace(); )
         {
         if (TryGetFacetFaceDataAtReadIndex (visitor->GetReadIndex(), faceData, thisFaceIndex))
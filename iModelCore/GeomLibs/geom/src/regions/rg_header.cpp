@@ -7,6 +7,7 @@
 #include <Mtg/capi/mtgprint_capi.h>
 #include "../DeprecatedFunctions.h"
 #include <stdio.h>
+#include <atomic>
 BEGIN_BENTLEY_GEOMETRY_NAMESPACE
 
 static int s_globalNoisy = 0;
@@ -315,17 +316,18 @@ RG_Header   *pRG,
 int period
 )
     {
-    static int s_counter = 0;
+    // Shared by every graph, which may be merged on different threads.
+    static std::atomic<int> s_counter (0);
     static int s_counterFrequency = 0;
     if (pRG->aborted)
         return true;
-    s_counter++;
-    if (period > 0 && s_counter % period != 0)
+    int counter = ++s_counter;
+    if (period > 0 && counter % period != 0)
         return false;
 
 
-    if (s_counterFrequency && s_counter % s_counterFrequency == 0)
-            GEOMAPI_PRINTF ("abort check %d\n", s_counter++);
+    if (s_counterFrequency && counter % s_counterFrequency == 0)
+            GEOMAPI_PRINTF ("abort check %d\n", counter);
     if (pRG->funcs.abortFunction && pRG->funcs.abortFunction (pRG))
         {
         pRG->aborted = true;
@@ -4,9 +4,10 @@
 *--------------------------------------------------------------------------------------------*/
 #include <bsibasegeomPCH.h>
 #include "Regions/rg_intern.h"
+#include <atomic>
 BEGIN_BENTLEY_GEOMETRY_NAMESPACE
 
-static int s_counter;
+static std::atomic<int> s_counter (0);  // debug labels only; graphs may be merged on different threads
 
 /*---------------------------------------------------------------------------------**//**
 *
@@ -107,6 +107,8 @@ struct AreaMarkupContext
                 return m_compositeCount != 0;
             case BoolSelect_Summed_Negative:
                 return m_compositeCount < 0;
+            case BoolSelect_Intersection:
+                return m_compositeNumberIn > 0 && m_compositeNumberIn == (int)groupStateArray.size ();
             }
         // REMARK: BoolSelect_ByStructure should not get this far !!!!
         assert (0);
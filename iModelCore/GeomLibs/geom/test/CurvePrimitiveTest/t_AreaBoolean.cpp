@@ -1300,6 +1300,112 @@ TEST(CurveVector,AreaBooleanMultipleAreas)
     Check::SetMaxVolume (oldVolume);
     }
 
+static double areaXY (CurveVectorPtr const &region)
+    {
+    DPoint3d centroid;
+    double area = 0.0;
+    if (region.IsValid ())
+        region->CentroidAreaXY (centroid, area);
+    return area;
+    }
+
+// Overlapping rectangles and disks around (x0,y0), all within 3.5 of the center.
+static void addFootprintCluster (bvector<CurveVectorPtr> &regions, double x0, double y0)
+    {
+    regions.push_back (CurveVector::CreateRectangle (x0 - 2, y0 - 1, x0 + 1, y0 + 1, 0.0));
+    regions.push_back (CurveVector::CreateRectangle (x0 - 1, y0 - 1.5, x0 + 2, y0 + 0.5, 0.0));
+    regions.push_back (CurveVector::CreateRectangle (x0 - 0.5, y0 - 2, x0 + 0.5, y0 + 2, 0.0));
+    regions.push_back (CurveVector::CreateDisk (DEllipse3d::FromCenterRadiusXY (DPoint3d::From (x0 + 2, y0), 1.0)));
+    regions.push_back (CurveVector::CreateDisk (DEllipse3d::FromCenterRadiusXY (DPoint3d::From (x0 - 2, y0 + 1), 0.75)));
+    }
+
+// numClusterX * numClusterX clusters of footprints on a 10 unit grid.
+static bvector<CurveVectorPtr> footprintGrid (size_t numClusterX)
+    {
+    double spacing = 10.0;
+    bvector<CurveVectorPtr> regions;
+    for (size_t i = 0; i < numClusterX; i++)
+        for (size_t j = 0; j < numClusterX; j++)
+            addFootprintCluster (regions, i * spacing, j * spacing);
+    return regions;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST(CurveVector,AreaUnionMany)
+    {
+    // Footprints in separated clusters, as in floor-plan aggregation.
+    // A pairwise chain re-merges its growing result at every step, so the timed comparison uses a smaller grid than the full check.
+    static size_t s_numClusterX = 25;
+    static size_t s_numBenchmarkClusterX = 6;
+
+    bvector<CurveVectorPtr> benchmarkRegions = footprintGrid (s_numBenchmarkClusterX);
+    auto time0 = BeTimeUtilities::QueryMillisecondsCounter ();
+    CurveVectorPtr serialUnion = CurveVector::AreaUnion (benchmarkRegions);
+    auto time1 = BeTimeUtilities::QueryMillisecondsCounter ();
+    CurveVectorPtr parallelUnion = CurveVector::AreaUnion (benchmarkRegions, NULL, true);
+    auto time2 = BeTimeUtilities::QueryMillisecondsCounter ();
+    CurveVectorPtr chainUnion = benchmarkRegions.front ();
+    for (size_t i = 1; i < benchmarkRegions.size (); i++)
+        chainUnion = CurveVector::AreaUnion (*chainUnion, *benchmarkRegions[i]);
+    auto time3 = BeTimeUtilities::QueryMillisecondsCounter ();
+    printf ("  union of %d regions: AreaUnion %d ms, AreaUnion (parallel) %d ms, pairwise AreaUnion chain %d ms\n",
+        (int)benchmarkRegions.size (), (int)(time1 - time0), (int)(time2 - time1), (int)(time3 - time2));
+
+    Check::Near (areaXY (chainUnion), areaXY (serialUnion), "many = pairwise");
+    Check::Near (areaXY (chainUnion), areaXY (parallelUnion), "parallel = pairwise");
+    if (Check::True (serialUnion.IsValid () && parallelUnion.IsValid (), "union of many"))
+        Check::Size (serialUnion->size (), parallelUnion->size (), "parallel = serial components");
+
+    bvector<CurveVectorPtr> regions = footprintGrid (s_numClusterX);
+    CurveVectorPtr manyUnion = CurveVector::AreaUnion (regions, NULL, true);
+    if (!Check::True (manyUnion.IsValid (), "union of many"))
+        return;
+    Check::True (manyUnion->IsUnionRegion (), "disjoint clusters collected in a union region");
+    Check::Size (s_numClusterX * s_numClusterX, manyUnion->size (), "one component per cluster");
+    Check::Near (areaXY (chainUnion) * (s_numClusterX * s_numClusterX) / (s_numBenchmarkClusterX * s_numBenchmarkClusterX), areaXY (manyUnion), "clusters are translates");
+
+    // newToOld pairs reach the original curves from every cluster.
+    CurvePrimitivePtrPairVector newToOld;
+    CurveVector::AreaUnion (benchmarkRegions, &newToOld);
+    Check::True (newToOld.size () > 0, "newToOld");
+    for (auto const &pair : newToOld)
+        {
+        bool found = false;
+        for (auto const &region : benchmarkRegions)
+            for (auto const &curve : *region)
+                found |= curve.get () == pair.curveB.get ();
+        Check::True (found, "old curve is an input curve");
+        }
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST(CurveVector,AreaIntersectionMany)
+    {
+    bvector<CurveVectorPtr> regions;
+    regions.push_back (CurveVector::CreateRectangle (0, 0, 4, 4, 0.0));
+    regions.push_back (CurveVector::CreateRectangle (1, 1, 5, 3, 0.0));
+    regions.push_back (CurveVector::CreateRectangle (2, -1, 6, 5, 0.0));
+    Check::Near (4.0, areaXY (CurveVector::AreaIntersection (regions)), "three rectangles");
+
+    // A union region whose children overlap counts as one operand.
+    auto overlapping = CurveVector::Create (CurveVector::BOUNDARY_TYPE_UnionRegion);
+    overlapping->Add (CurveVector::CreateRectangle (0, 0, 3, 3, 0.0));
+    overlapping->Add (CurveVector::CreateRectangle (2, 0, 5, 3, 0.0));
+    bvector<CurveVectorPtr> withUnion;
+    withUnion.push_back (overlapping);
+    withUnion.push_back (CurveVector::CreateRectangle (1, 1, 4, 2, 0.0));
+    withUnion.push_back (CurveVector::CreateDisk (DEllipse3d::FromCenterRadiusXY (DPoint3d::From (2.5, 1.5), 10.0)));
+    Check::Near (3.0, areaXY (CurveVector::AreaIntersection (withUnion)), "union region operand");
+    Check::Near (3.0, areaXY (CurveVector::AreaIntersection (withUnion, NULL, true)), "union region operand, parallel");
+
+    regions.push_back (CurveVector::CreateRectangle (10, 10, 11, 11, 0.0));
+    Check::False (CurveVector::AreaIntersection (regions).IsValid (), "disjoint operand");
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -129,3 +129,107 @@ TEST(PolyfaceClipToPlaneSetContext, ClipToIntersection)
 
     Check::ClearGeometry("PolyfaceClipToPlaneSetContext.ClipToIntersection");
     }
+
+struct CaptureClipOutputHandler : PolyfaceQuery::IClipToPlaneSetOutput
+{
+PolyfaceHeaderPtr m_clipped;
+StatusInt   _ProcessUnclippedPolyface(PolyfaceQueryCR polyfaceQuery) override { return SUCCESS; }
+StatusInt   _ProcessClippedPolyface(PolyfaceHeaderR polyfaceHeader) override
+    {
+    m_clipped = polyfaceHeader.Clone();
+    return SUCCESS;
+    }
+};
+
+/*---------------------------------------------------------------------------------**//**
+* Attach an aux channel holding the height of each point.  It interpolates exactly like the points,
+* so every clipped vertex can be checked against its own point.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static void AddHeightAuxData(PolyfaceHeaderR mesh)
+    {
+    bvector<double> heights;
+    for (auto& point : mesh.Point())
+        heights.push_back(point.z);
+    bvector<PolyfaceAuxChannel::DataPtr> heightData{ new PolyfaceAuxChannel::Data(0, std::move(heights)) };
+    PolyfaceAuxData::Channels channels;
+    channels.push_back(new PolyfaceAuxChannel(PolyfaceAuxChannel::DataType::Distance, "Height", "Time", std::move(heightData)));
+    bvector<int32_t> auxIndex = mesh.PointIndex();
+    PolyfaceAuxDataPtr auxData(new PolyfaceAuxData(std::move(auxIndex), std::move(channels)));
+    mesh.SetAuxData(auxData);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static void CheckHeightAuxData(PolyfaceHeaderR mesh, char const* name)
+    {
+    PolyfaceAuxDataCPtr auxData = mesh.GetAuxDataCP();
+    if (!Check::True(auxData.IsValid() && 1 == auxData->GetChannels().size(), "clipped mesh has aux data"))
+        return;
+
+    auto const& heights = auxData->GetChannels().front()->GetData().front()->GetValues();
+    auto const& auxIndex = auxData->GetIndices();
+    auto const& pointIndex = mesh.PointIndex();
+    if (!Check::Size(pointIndex.size(), auxIndex.size(), "aux index count"))
+        return;
+
+    size_t numMismatched = 0;
+    for (size_t i = 0; i < pointIndex.size(); i++)
+        {
+        if (0 == pointIndex[i])
+            continue;
+        double z = mesh.Point()[abs(pointIndex[i]) - 1].z;
+        if (fabs(z - heights[abs(auxIndex[i]) - 1]) > 1.0e-10)
+            numMismatched++;
+        }
+    Check::Size(0, numMismatched, name);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST(PolyfaceClipToPlaneSetContext, ClipToIntersectionParallel)
+    {
+    for (size_t numPerSide : {100, 200, 400})
+        {
+        PolyfaceHeaderPtr polyface = PolyfaceWithSinusoidalGrid(numPerSide, numPerSide, 0.05, 0.05, 0.8, 0.03, true, true);
+        polyface->ConvertToVariableSizeSignedOneBasedIndexedFaceLoops();
+        AddFacetFaceData(*polyface, 10, 10);
+        polyface->BuildNormalsFast(0.4, 0.001);
+        polyface->MarkInvisibleEdges(0.4, nullptr);
+        AddHeightAuxData(*polyface);
+        auto polyfaceRange = DRange3d::From(polyface->Point());
+        DPoint3d center = polyfaceRange.LocalToGlobal(0.5, 0.5, 0.5);
+        double a = sqrt(0.5);
+        ConvexClipPlaneSet convexSetA, convexSetB;
+        convexSetA.push_back(ClipPlane(DPlane3d::FromOriginAndNormal(polyfaceRange.LocalToGlobal(0.9, 0.9, 0.5), DVec3d::From(-1, 0, 0))));
+        convexSetA.push_back(ClipPlane(DPlane3d::FromOriginAndNormal(polyfaceRange.LocalToGlobal(0.1, 0.1, 0.5), DVec3d::From(0, 1, 0))));
+        convexSetB.push_back(ClipPlane(DPlane3d::FromOriginAndNormal(center, DVec3d::From(a, -a, 0))));
+        convexSetB.push_back(ClipPlane(DPlane3d::FromOriginAndNormal(center, DVec3d::From(-0.3, 0.2, 1))));
+        ClipPlaneSet setA, setB;
+        setA.push_back(convexSetA);
+        setB.push_back(convexSetB);
+        T_ClipPlaneSets manySets;
+        manySets.push_back(setA);
+        manySets.push_back(setB);
+
+        CaptureClipOutputHandler serialHandler, parallelHandler;
+        auto time0 = BeTimeUtilities::QueryMillisecondsCounter();
+        Check::True(SUCCESS == polyface->ClipToPlaneSetIntersection(manySets, serialHandler, true, false), "serial clip");
+        auto time1 = BeTimeUtilities::QueryMillisecondsCounter();
+        Check::True(SUCCESS == polyface->ClipToPlaneSetIntersection(manySets, parallelHandler, true, true), "parallel clip");
+        auto time2 = BeTimeUtilities::QueryMillisecondsCounter();
+        printf("  ClipToPlaneSetIntersection %d facets: serial %d ms, parallel %d ms\n", (int) polyface->GetNumFacet(), (int) (time1 - time0), (int) (time2 - time1));
+
+        if (Check::True(serialHandler.m_clipped.IsValid() && parallelHandler.m_clipped.IsValid(), "both clips produce output"))
+            {
+            Check::Size(serialHandler.m_clipped->GetPointCount(), parallelHandler.m_clipped->GetPointCount(), "point count");
+            Check::Size(serialHandler.m_clipped->GetPointIndexCount(), parallelHandler.m_clipped->GetPointIndexCount(), "index count");
+            Check::Size(serialHandler.m_clipped->GetFaceCount(), parallelHandler.m_clipped->GetFaceCount(), "face count");
+            Check::True(serialHandler.m_clipped->IsSameStructureAndGeometry(*parallelHandler.m_clipped, 0.0), "parallel clip matches serial clip");
+            CheckHeightAuxData(*serialHandler.m_clipped, "serial clip aux data matches points");
+            CheckHeightAuxData(*parallelHandler.m_clipped, "parallel clip aux data matches points");
+            }
+        }
+    }
@@ -515,6 +515,9 @@ protected:
 public:
     UnaryArithmeticNode (ExpressionToken tokenId, NodeR left) : UnaryNode (tokenId, left) {}
 
+    //! Applies the operator of this node to an already evaluated operand
+    ExpressionStatus ApplyOperator(EvaluationResultR evalResult, EvaluationResultR operand) const;
+
 };  //  End of struct UnaryArithmeticNode
 
 /*=================================================================================**//**
@@ -560,10 +563,17 @@ protected:
     ExpressionStatus PromoteCommon(EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context, bool allowStrings);
     ExpressionStatus GetOperandValues(EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context);
 
+    //  Evaluates both operands and applies the operator. Nodes which do not always evaluate both operands override this.
+    ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+    //  The operands may be modified by promotion
+    virtual ExpressionStatus _ApplyOperator(EvaluationResultR evalResult, EvaluationResultR leftResult, EvaluationResultR rightResult, ExpressionContextR context) { return ExpressionStatus::NotImpl; }
+
 public:
     BinaryNode (ExpressionToken operatorCode, NodeR left, NodeR right) : m_operatorCode(operatorCode), m_left(&left), m_right(&right) {}
 
-    //  virtual abstract ECEvaluationResult ApplyOperator (ECEvaluationResult leftValue, ECEvaluationResult rightValue);
+    //! Applies the operator of this node to already evaluated operands. The operands may be modified.
+    ExpressionStatus ApplyOperator(EvaluationResultR evalResult, EvaluationResultR leftResult, EvaluationResultR rightResult, ExpressionContextR context)
+                                    { return _ApplyOperator(evalResult, leftResult, rightResult, context); }
 
 };  //  End of struct Binary
 
@@ -576,7 +586,7 @@ public:
 struct          ArithmeticNode : BinaryNode  //  No modifiers -- see ModifierNode
 {
 protected:
-    ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+    ExpressionStatus _ApplyOperator(EvaluationResultR evalResult, EvaluationResultR leftResult, EvaluationResultR rightResult, ExpressionContextR context) override;
 
     virtual ExpressionStatus _Promote(EvaluationResult& leftResult, EvaluationResult& rightResult, 
                                         ExpressionContextR context) { return ExpressionStatus::NotImpl; }
@@ -605,7 +615,7 @@ public:
 struct          ExponentNode : ArithmeticNode
 {
 protected:
-    ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+    ExpressionStatus _ApplyOperator(EvaluationResultR evalResult, EvaluationResultR leftResult, EvaluationResultR rightResult, ExpressionContextR context) override;
 
 public:
     ExponentNode(NodeR left, NodeR right) : ArithmeticNode (TOKEN_Exponentiation, left, right) {}
@@ -621,7 +631,7 @@ public:
 struct          MultiplyNode : ArithmeticNode  //  No modifiers -- see ModifierNode
 {
 protected:
-    ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+    ExpressionStatus _ApplyOperator(EvaluationResultR evalResult, EvaluationResultR leftResult, EvaluationResultR rightResult, ExpressionContextR context) override;
     ResolvedTypeNodePtr _GetResolvedTree(ExpressionResolverR context) override {return context._ResolveMultiplyNode(*this);}
 
 public:
@@ -637,7 +647,7 @@ public:
 struct          DivideNode : ArithmeticNode  //  No modifiers -- see ModifierNode
 {
 protected:
-    ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+    ExpressionStatus _ApplyOperator(EvaluationResultR evalResult, EvaluationResultR leftResult, EvaluationResultR rightResult, ExpressionContextR context) override;
 
     ResolvedTypeNodePtr _GetResolvedTree(ExpressionResolverR context) override {return context._ResolveDivideNode(*this);}
 public:
@@ -676,7 +686,7 @@ public:
 struct          ConcatenateNode : ArithmeticNode 
 {
 protected:
-    ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+    ExpressionStatus _ApplyOperator(EvaluationResultR evalResult, EvaluationResultR leftResult, EvaluationResultR rightResult, ExpressionContextR context) override;
 
     ResolvedTypeNodePtr _GetResolvedTree(ExpressionResolverR context) override {return context._ResolveConcatenateNode(*this);}
 public:
@@ -693,7 +703,7 @@ public:
 struct          ShiftNode : BinaryNode
 {
 protected:
-    ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+    ExpressionStatus _ApplyOperator(EvaluationResultR evalResult, EvaluationResultR leftResult, EvaluationResultR rightResult, ExpressionContextR context) override;
     ResolvedTypeNodePtr _GetResolvedTree(ExpressionResolverR context) override { return context._ResolveShiftNode(*this); }
 
 public:
@@ -710,7 +720,7 @@ public:
 struct          ComparisonNode : BinaryNode
 {
 protected:
-    ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+    ExpressionStatus _ApplyOperator(EvaluationResultR evalResult, EvaluationResultR leftResult, EvaluationResultR rightResult, ExpressionContextR context) override;
 
     ResolvedTypeNodePtr _GetResolvedTree(ExpressionResolverR context) override {return context._ResolveComparisonNode(*this);}
 
@@ -729,6 +739,7 @@ struct          LogicalNode : BinaryNode
 {
 protected:
     ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+    ExpressionStatus _ApplyOperator(EvaluationResultR evalResult, EvaluationResultR leftResult, EvaluationResultR rightResult, ExpressionContextR context) override;
     ResolvedTypeNodePtr _GetResolvedTree(ExpressionResolverR context) override {return context._ResolveLogicalNode(*this);}
     bool _SetOperation(ExpressionToken operatorCode) override
         {
@@ -38,6 +38,7 @@ EXPR_TYPEDEFS(ArgumentTreeNode)
 EXPR_TYPEDEFS(ArithmeticNode)
 EXPR_TYPEDEFS(BinaryNode)
 EXPR_TYPEDEFS(CallNode)
+EXPR_TYPEDEFS(CompiledExpression)
 EXPR_TYPEDEFS(LambdaNode)
 EXPR_TYPEDEFS(ComparisonNode)
 EXPR_TYPEDEFS(ConcatenateNode)
@@ -80,6 +81,7 @@ BEGIN_BENTLEY_ECOBJECT_NAMESPACE
 
 typedef RefCountedPtr<ArgumentTreeNode>             ArgumentTreeNodePtr;
 typedef RefCountedPtr<CallNode>                     CallNodePtr;
+typedef RefCountedPtr<CompiledExpression>           CompiledExpressionPtr;
 typedef RefCountedPtr<LambdaNode>                   LambdaNodePtr;
 typedef RefCountedPtr<ContextSymbol>                ContextSymbolPtr;
 typedef RefCountedPtr<DotNode>                      DotNodePtr;
@@ -233,11 +235,15 @@ protected:
     //  The globalContext may be used to find instance methods
     virtual ExpressionStatus    _GetValue(EvaluationResultR evalResult, PrimaryListNodeR primaryList, bvector<ExpressionContextP> const& contextsStack, ::uint32_t startIndex) = 0;
     virtual ExpressionStatus    _GetReference(EvaluationResultR evalResult, ReferenceResult& refResult, PrimaryListNodeR primaryList, bvector<ExpressionContextP> const& contextsStack, ::uint32_t startIndex) { return ExpressionStatus::NotImpl; }
+    //  Returns the SymbolExpressionContext which _GetValue looks symbols up in, if any. A context which is not a SymbolExpressionContext itself
+    //  may return one only if it forwards _GetValue to it without adding itself to the contexts stack. Used by CompiledExpression.
+    virtual SymbolExpressionContextP _GetSymbolsContext() { return nullptr; }
 #endif
 public:
 #ifndef DOCUMENTATION_GENERATOR
     bool                        IsNamespace () const  { return _IsNamespace(); }
     ExpressionContextP          GetOuterP () const   { return m_outer.get(); }
+    SymbolExpressionContextP    GetSymbolsContext () { return _GetSymbolsContext(); }
     ExpressionStatus            ResolveMethod(MethodReferencePtr& result, Utf8CP ident, bool useOuterIfNecessary, ExpressionMethodType methodType)
                                     { return _ResolveMethod(result, ident, useOuterIfNecessary, methodType); }
 
@@ -357,12 +363,16 @@ protected:
     ECOBJECTS_EXPORT ExpressionStatus _GetReference(EvaluationResultR evalResult, ReferenceResultR refResult, PrimaryListNodeR primaryList, bvector<ExpressionContextP> const& contextsStack, ::uint32_t startIndex) override;
 
     ECOBJECTS_EXPORT bool _IsNamespace() const override {return true;}
+    //  Subclasses which override _GetValue must override this to return nullptr
+    SymbolExpressionContextP _GetSymbolsContext() override {return this;}
     
     SymbolExpressionContext(ExpressionContextP outer) : ExpressionContext(outer) {}
 #endif
 public:
 #ifndef DOCUMENTATION_GENERATOR
     ECOBJECTS_EXPORT SymbolCP       FindCP (Utf8CP ident);
+    size_t                          GetSymbolCount () const {return m_symbols.size();}
+    SymbolP                         GetSymbolAt (size_t index) const {return index < m_symbols.size() ? m_symbols[index].get() : nullptr;}
     ECOBJECTS_EXPORT BentleyStatus  RemoveSymbol (SymbolR symbol);
     ECOBJECTS_EXPORT BentleyStatus  RemoveSymbol (Utf8CP ident);
 
@@ -430,6 +440,9 @@ protected:
 #endif
 
 public:
+#ifndef DOCUMENTATION_GENERATOR
+    ExpressionContextR                              GetContext() const {return *m_context;}
+#endif
     //! Creates a new ContextSymbol
     //! @param[in] name     The name to be used for this context symbol
     //! @param[in] context  The expression context to be used for this context
@@ -1087,6 +1100,92 @@ public:
     ECOBJECTS_EXPORT Utf8String  ToExpressionString() const;
 };  //  End of struct Node
 
+/*=================================================================================**//**
+* A flattened form of an ECExpression tree which can be evaluated repeatedly without
+* walking the tree. Literals are stored as constants, and identifiers resolved by
+* SymbolExpressionContexts are bound to symbol indices when compiled. Sub-expressions
+* which have no compiled form (method calls, lambdas, array access, etc.) are evaluated
+* through the tree.
+* @remarks A compiled expression is bound to the shape of the context it was compiled
+* against (see GetContextShape). Each bound symbol is checked by name on evaluation, as are
+* the inner contexts skipped to reach it, and the primary list is evaluated through the tree
+* if the symbol doesn't match or is shadowed, so evaluating against a context of a different
+* shape gives correct, but slower, results.
+* @remarks A compiled expression is not modified by evaluation and may be evaluated
+* concurrently.
++===============+===============+===============+===============+===============+======*/
+struct          CompiledExpression : RefCountedBase
+{
+#ifndef DOCUMENTATION_GENERATOR
+private:
+    enum class OpCode
+        {
+        PushConstant,   // m_operand is an index into m_constants
+        LoadSymbol,     // m_operand is an index into m_symbolPaths
+        EvaluateNode,   // m_operand is an index into m_nodes
+        Unary,          // m_operand is an index into m_nodes; followed by the operand
+        Binary,         // m_operand is an index into m_nodes; followed by the left and the right operands
+        ShortCircuit,   // m_operand is an index into m_nodes; followed by the left and the right operands, m_end is the end of the right operand
+        IIf,            // followed by the condition, the true and the false operands; m_branchEnd is the end of the true operand, m_end is the end of the false operand
+        };
+
+    struct Instruction
+        {
+        OpCode      m_opCode;
+        uint32_t    m_operand;
+        uint32_t    m_branchEnd;
+        uint32_t    m_end;
+        Instruction(OpCode opCode, uint32_t operand) : m_opCode(opCode), m_operand(operand), m_branchEnd(0), m_end(0) {}
+        };
+
+    //  A symbol found after moving to the outer context m_outerHops times
+    struct SymbolHop
+        {
+        uint32_t    m_outerHops;
+        uint32_t    m_symbolIndex;
+        Utf8CP      m_name;
+        };
+
+    //  All hops but the last one resolve to ContextSymbols
+    struct SymbolPath
+        {
+        PrimaryListNodeP    m_primaryList;
+        bvector<SymbolHop>  m_hops;
+        };
+
+    NodePtr                     m_root;
+    bvector<Instruction>        m_instructions;
+    bvector<EvaluationResult>   m_constants;
+    bvector<NodeP>              m_nodes;
+    bvector<SymbolPath>         m_symbolPaths;
+
+    CompiledExpression(NodeR root) : m_root(&root) {}
+    void Emit(NodeR node, ExpressionContextR context);
+    bool TryBindSymbol(SymbolPath& path, PrimaryListNodeR primaryList, ExpressionContextR context) const;
+    ExpressionStatus LoadSymbol(EvaluationResultR evalResult, SymbolPath const& path, ExpressionContextR context) const;
+    ExpressionStatus Execute(EvaluationResultR evalResult, uint32_t& pc, ExpressionContextR context) const;
+#endif
+
+public:
+    //! Compiles the expression tree rooted at the supplied node. The tree must not be modified afterwards.
+    //! @param[in] root     The root of the expression tree
+    //! @param[in] context  The context which identifiers are bound against
+    ECOBJECTS_EXPORT static CompiledExpressionPtr Compile(NodeR root, ExpressionContextR context);
+
+    //! Returns a hash of the context types and the number of symbols along the chain of outer contexts. Expressions
+    //! compiled against contexts of the same shape can be evaluated against each other without falling back to the tree.
+    ECOBJECTS_EXPORT static uint64_t GetContextShape(ExpressionContextR context);
+
+    //! Evaluates the expression using the supplied context. Gives the same result as Node::GetValue.
+    ECOBJECTS_EXPORT ExpressionStatus GetValue(EvaluationResultR evalResult, ExpressionContextR context) const;
+
+    //! Evaluates the expression using the supplied context
+    ECOBJECTS_EXPORT ExpressionStatus GetValue(ValueResultPtr& valueResult, ExpressionContextR context) const;
+
+    //! Returns the root of the expression tree this expression was compiled from
+    NodeR GetRoot() const {return *m_root;}
+};
+
 /** @endGroup */
 END_BENTLEY_ECOBJECT_NAMESPACE
 
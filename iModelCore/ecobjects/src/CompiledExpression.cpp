@@ -0,0 +1,326 @@
+/*---------------------------------------------------------------------------------------------
+* Copyright (c) Bentley Systems, Incorporated. All rights reserved.
+* See LICENSE.md in the repository root for full copyright notice.
+*--------------------------------------------------------------------------------------------*/
+#include "ECObjectsPch.h"
+
+#include <ECObjects/ECExpressionNode.h>
+#include <typeinfo>
+
+BEGIN_BENTLEY_ECOBJECT_NAMESPACE
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+CompiledExpressionPtr CompiledExpression::Compile(NodeR root, ExpressionContextR context)
+    {
+    CompiledExpressionPtr compiled = new CompiledExpression(root);
+    compiled->Emit(root, context);
+    return compiled;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Operands are emitted right after the instruction which consumes them.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void CompiledExpression::Emit(NodeR node, ExpressionContextR context)
+    {
+    size_t index = m_instructions.size();
+
+    LiteralNode const* literal = dynamic_cast<LiteralNode const*>(&node);
+    if (nullptr != literal)
+        {
+        m_instructions.push_back(Instruction(OpCode::PushConstant, (uint32_t)m_constants.size()));
+        m_constants.push_back(EvaluationResult());
+        m_constants.back() = literal->GetInternalValue();
+        return;
+        }
+
+    if (TOKEN_PrimaryList == node.GetOperation())
+        {
+        SymbolPath path;
+        if (TryBindSymbol(path, static_cast<PrimaryListNodeR>(node), context))
+            {
+            m_instructions.push_back(Instruction(OpCode::LoadSymbol, (uint32_t)m_symbolPaths.size()));
+            m_symbolPaths.push_back(path);
+            return;
+            }
+        }
+    else if (nullptr != dynamic_cast<UnaryArithmeticNodeP>(&node))
+        {
+        m_instructions.push_back(Instruction(OpCode::Unary, (uint32_t)m_nodes.size()));
+        m_nodes.push_back(&node);
+        Emit(*node.GetLeftP(), context);
+        return;
+        }
+    else if (nullptr != dynamic_cast<LogicalNodeP>(&node) && (TOKEN_AndAlso == node.GetOperation() || TOKEN_OrElse == node.GetOperation()))
+        {
+        m_instructions.push_back(Instruction(OpCode::ShortCircuit, (uint32_t)m_nodes.size()));
+        m_nodes.push_back(&node);
+        Emit(*node.GetLeftP(), context);
+        m_instructions[index].m_branchEnd = (uint32_t)m_instructions.size();
+        Emit(*node.GetRightP(), context);
+        m_instructions[index].m_end = (uint32_t)m_instructions.size();
+        return;
+        }
+    else if (nullptr != dynamic_cast<BinaryNodeP>(&node) && nullptr == dynamic_cast<AssignmentNode*>(&node))
+        {
+        m_instructions.push_back(Instruction(OpCode::Binary, (uint32_t)m_nodes.size()));
+        m_nodes.push_back(&node);
+        Emit(*node.GetLeftP(), context);
+        Emit(*node.GetRightP(), context);
+        return;
+        }
+    else if (nullptr != dynamic_cast<IIfNodeP>(&node))
+        {
+        IIfNodeR iif = static_cast<IIfNodeR>(node);
+        m_instructions.push_back(Instruction(OpCode::IIf, 0));
+        Emit(*iif.GetConditionP(), context);
+        Emit(*iif.GetTrueP(), context);
+        m_instructions[index].m_branchEnd = (uint32_t)m_instructions.size();
+        Emit(*iif.GetFalseP(), context);
+        m_instructions[index].m_end = (uint32_t)m_instructions.size();
+        return;
+        }
+
+    m_instructions.push_back(Instruction(OpCode::EvaluateNode, (uint32_t)m_nodes.size()));
+    m_nodes.push_back(&node);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Mirrors the lookup done by SymbolExpressionContext::_GetValue and ContextSymbol::_GetValue.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+bool CompiledExpression::TryBindSymbol(SymbolPath& path, PrimaryListNodeR primaryList, ExpressionContextR context) const
+    {
+    path.m_primaryList = &primaryList;
+    ExpressionContextP current = &context;
+    for (uint32_t nameIndex = 0; ; ++nameIndex)
+        {
+        Utf8CP name = primaryList.GetName(nameIndex);
+        if (nullptr == name)
+            return false;
+
+        SymbolHop hop = {0, 0, name};
+        SymbolP symbol = nullptr;
+        SymbolExpressionContextP symbols = current->GetSymbolsContext();
+        while (nullptr != symbols && nullptr == symbol)
+            {
+            for (size_t i = 0; i < symbols->GetSymbolCount(); ++i)
+                {
+                if (0 == strcmp(name, symbols->GetSymbolAt(i)->GetName()))
+                    {
+                    symbol = symbols->GetSymbolAt(i);
+                    hop.m_symbolIndex = (uint32_t)i;
+                    break;
+                    }
+                }
+
+            if (nullptr == symbol)
+                {
+                ++hop.m_outerHops;
+                current = symbols->GetOuterP();
+                symbols = (nullptr != current) ? current->GetSymbolsContext() : nullptr;
+                }
+            }
+
+        // the symbol is looked up by a context which is not a SymbolExpressionContext or is unknown
+        if (nullptr == symbol)
+            return false;
+
+        path.m_hops.push_back(hop);
+
+        ContextSymbolP contextSymbol = dynamic_cast<ContextSymbolP>(symbol);
+        if (nullptr == contextSymbol || nullptr == contextSymbol->GetContext().GetSymbolsContext() || nullptr == primaryList.GetName(nameIndex + 1))
+            return true;
+
+        current = &contextSymbol->GetContext();
+        }
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* The contexts skipped by a hop are checked for the symbol name, so that a symbol added to
+* an inner context after compiling shadows the bound one just like it does in the tree.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ExpressionStatus CompiledExpression::LoadSymbol(EvaluationResultR evalResult, SymbolPath const& path, ExpressionContextR context) const
+    {
+    bvector<ExpressionContextP> contextsStack;
+    contextsStack.push_back(&context);
+
+    ExpressionContextP current = &context;
+    for (size_t hopIndex = 0; hopIndex < path.m_hops.size(); ++hopIndex)
+        {
+        SymbolHop const& hop = path.m_hops[hopIndex];
+        SymbolExpressionContextP symbols = current->GetSymbolsContext();
+        for (uint32_t i = 0; nullptr != symbols && i < hop.m_outerHops; ++i)
+            {
+            if (nullptr != symbols->FindCP(hop.m_name))
+                return path.m_primaryList->GetValue(evalResult, context);
+
+            contextsStack.push_back(symbols);
+            current = symbols->GetOuterP();
+            symbols = (nullptr != current) ? current->GetSymbolsContext() : nullptr;
+            }
+
+        SymbolP symbol = (nullptr != symbols) ? symbols->GetSymbolAt(hop.m_symbolIndex) : nullptr;
+        if (nullptr == symbol || 0 != strcmp(hop.m_name, symbol->GetName()))
+            break;
+
+        contextsStack.push_back(symbols);
+        if (hopIndex + 1 == path.m_hops.size())
+            return symbol->GetValue(evalResult, *path.m_primaryList, contextsStack, (uint32_t)hopIndex + 1);
+
+        ContextSymbolP contextSymbol = dynamic_cast<ContextSymbolP>(symbol);
+        if (nullptr == contextSymbol)
+            break;
+
+        current = &contextSymbol->GetContext();
+        }
+
+    // the context has a different shape than the one the expression was compiled against
+    return path.m_primaryList->GetValue(evalResult, context);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Evaluates the operation at pc and its operands. On success pc is moved past the operands.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ExpressionStatus CompiledExpression::Execute(EvaluationResultR evalResult, uint32_t& pc, ExpressionContextR context) const
+    {
+    Instruction const& instruction = m_instructions[pc++];
+    switch (instruction.m_opCode)
+        {
+        case OpCode::PushConstant:
+            evalResult = m_constants[instruction.m_operand];
+            return ExpressionStatus::Success;
+
+        case OpCode::LoadSymbol:
+            return LoadSymbol(evalResult, m_symbolPaths[instruction.m_operand], context);
+
+        case OpCode::EvaluateNode:
+            return m_nodes[instruction.m_operand]->GetValue(evalResult, context);
+
+        case OpCode::Unary:
+            {
+            EvaluationResult    operand;
+            ExpressionStatus    status = Execute(operand, pc, context);
+            if (ExpressionStatus::Success != status)
+                return status;
+
+            return static_cast<UnaryArithmeticNodeP>(m_nodes[instruction.m_operand])->ApplyOperator(evalResult, operand);
+            }
+
+        case OpCode::Binary:
+            {
+            EvaluationResult    leftResult;
+            EvaluationResult    rightResult;
+            ExpressionStatus    status = Execute(leftResult, pc, context);
+            if (ExpressionStatus::Success != status)
+                return status;
+
+            status = Execute(rightResult, pc, context);
+            if (ExpressionStatus::Success != status)
+                return status;
+
+            return static_cast<BinaryNodeP>(m_nodes[instruction.m_operand])->ApplyOperator(evalResult, leftResult, rightResult, context);
+            }
+
+        case OpCode::ShortCircuit:
+            {
+            // same semantics as LogicalNode::_GetValue
+            bool                andAlso = TOKEN_AndAlso == m_nodes[instruction.m_operand]->GetOperation();
+            EvaluationResult    leftResult;
+            EvaluationResult    rightResult;
+            uint32_t            operandPc = pc;
+            ExpressionStatus    status = Execute(leftResult, operandPc, context);
+
+            // Treat error as false evaluation value
+            bool leftBool = false;
+            if (ExpressionStatus::Success != status || ExpressionStatus::Success != (status = leftResult.GetBoolean(leftBool, false)))
+                leftBool = false;
+
+            if (leftBool == andAlso)
+                {
+                operandPc = instruction.m_branchEnd;
+                status = Execute(rightResult, operandPc, context);
+                }
+
+            pc = instruction.m_end;
+            if (ExpressionStatus::Success != status)
+                return status;
+
+            leftResult.InitECValue().SetBoolean(leftBool);
+            return andAlso ? Operations::PerformLogicalAnd(evalResult, leftResult, rightResult) : Operations::PerformLogicalOr(evalResult, leftResult, rightResult);
+            }
+
+        case OpCode::IIf:
+            {
+            EvaluationResult    local;
+            ExpressionStatus    status = Execute(local, pc, context);
+            if (ExpressionStatus::Success != status)
+                return status;
+
+            bool    condition;
+            status = local.GetBoolean(condition, false);
+            if (ExpressionStatus::Success != status)
+                return status;
+
+            if (!condition)
+                pc = instruction.m_branchEnd;
+
+            status = Execute(evalResult, pc, context);
+            pc = instruction.m_end;
+            return status;
+            }
+        }
+
+    BeAssert(false && "unexpected op code");
+    return ExpressionStatus::UnknownError;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ExpressionStatus CompiledExpression::GetValue(EvaluationResultR evalResult, ExpressionContextR context) const
+    {
+    uint32_t pc = 0;
+    return Execute(evalResult, pc, context);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ExpressionStatus CompiledExpression::GetValue(ValueResultPtr& valueResult, ExpressionContextR context) const
+    {
+    EvaluationResult    evalResult;
+
+    ExpressionStatus    status = GetValue(evalResult, context);
+    valueResult = ValueResult::Create(evalResult);
+
+    return status;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+uint64_t CompiledExpression::GetContextShape(ExpressionContextR context)
+    {
+    uint64_t shape = 14695981039346656037ULL;
+    auto combine = [&shape](uint64_t value)
+        {
+        shape = (shape ^ value) * 1099511628211ULL;
+        };
+
+    ExpressionContextP current = &context;
+    while (nullptr != current)
+        {
+        SymbolExpressionContextP symbols = current->GetSymbolsContext();
+        combine(typeid(*current).hash_code());
+        combine(nullptr != symbols ? symbols->GetSymbolCount() : UINT64_MAX);
+        current = (nullptr != symbols) ? symbols->GetOuterP() : current->GetOuterP();
+        }
+    return shape;
+    }
+
+END_BENTLEY_ECOBJECT_NAMESPACE
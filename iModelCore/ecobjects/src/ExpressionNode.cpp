@@ -1987,6 +1987,14 @@ ExpressionStatus UnaryArithmeticNode::_GetValue(EvaluationResult& evalResult, Ex
     if (ExpressionStatus::Success != status)
         return status;
 
+    return ApplyOperator(evalResult, inputValue);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ExpressionStatus UnaryArithmeticNode::ApplyOperator(EvaluationResultR evalResult, EvaluationResultR inputValue) const
+    {
     if (_GetOperation() == TOKEN_Minus)
         return Operations::PerformUnaryMinus(evalResult, inputValue);
 
@@ -2247,16 +2255,9 @@ ExpressionStatus IIfNode::_GetValue(EvaluationResult& evalResult, ExpressionCont
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-ExpressionStatus  ArithmeticNode::_GetValue(EvaluationResult& evalResult, ExpressionContextR context)
+ExpressionStatus  ArithmeticNode::_ApplyOperator(EvaluationResultR evalResult, EvaluationResultR leftResult, EvaluationResultR rightResult, ExpressionContextR context)
     {
-    EvaluationResult    leftResult;
-    EvaluationResult    rightResult;
-    ExpressionStatus    status = GetOperandValues(leftResult, rightResult, context);
-
-    if (ExpressionStatus::Success != status)
-        return status;
-
-    status = _Promote(leftResult, rightResult, context);
+    ExpressionStatus    status = _Promote(leftResult, rightResult, context);
     if (ExpressionStatus::Success != status)
         return status;
 
@@ -2266,36 +2267,23 @@ ExpressionStatus  ArithmeticNode::_GetValue(EvaluationResult& evalResult, Expres
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-ExpressionStatus  ConcatenateNode::_GetValue(EvaluationResult& evalResult, ExpressionContextR context)
+ExpressionStatus  ConcatenateNode::_ApplyOperator(EvaluationResultR evalResult, EvaluationResultR leftResult, EvaluationResultR rightResult, ExpressionContextR context)
     {
-    EvaluationResult    leftResult;
-    EvaluationResult    rightResult;
-    ExpressionStatus    status = GetOperandValues(leftResult, rightResult, context);
-
-    if (ExpressionStatus::Success != status)
-        return status;
-
+    ExpressionStatus    status;
     if (((status = Operations::ConvertToString(leftResult)) != ExpressionStatus::Success) || ((status = Operations::ConvertToString(rightResult)) != ExpressionStatus::Success))
         return status;
 
     performConcatenation (evalResult.InitECValue(), *leftResult.GetECValue(), *rightResult.GetECValue());
 
-    ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ConcatenateNode::_GetValue: Result: ", evalResult.ToString().c_str()).c_str());
+    ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ConcatenateNode::_ApplyOperator: Result: ", evalResult.ToString().c_str()).c_str());
     return ExpressionStatus::Success;
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-ExpressionStatus  ShiftNode::_GetValue(EvaluationResult& evalResult, ExpressionContextR context)
+ExpressionStatus  ShiftNode::_ApplyOperator(EvaluationResultR evalResult, EvaluationResultR leftResult, EvaluationResultR rightResult, ExpressionContextR context)
     {
-    EvaluationResult    leftResult;
-    EvaluationResult    rightResult;
-    ExpressionStatus    status = GetOperandValues(leftResult, rightResult, context);
-
-    if (ExpressionStatus::Success != status)
-        return status;
-
     return Operations::PerformShift(evalResult, m_operatorCode, leftResult, rightResult);
     }
 
@@ -2313,9 +2301,7 @@ ExpressionStatus  LogicalNode::_GetValue(EvaluationResult& evalResult, Expressio
     case TOKEN_And:
     case TOKEN_Or:
     case TOKEN_Xor:
-        status = GetOperandValues(leftResult, rightResult, context);
-        if (ExpressionStatus::Success == status)
-            status = Operations::PerformJunctionOperator(evalResult, _GetOperation(), leftResult, rightResult);
+        status = BinaryNode::_GetValue(evalResult, context);
         break;
 
     case TOKEN_AndAlso:
@@ -2349,6 +2335,38 @@ ExpressionStatus  LogicalNode::_GetValue(EvaluationResult& evalResult, Expressio
     return status;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ExpressionStatus  LogicalNode::_ApplyOperator(EvaluationResultR evalResult, EvaluationResultR leftResult, EvaluationResultR rightResult, ExpressionContextR context)
+    {
+    switch (m_operatorCode)
+        {
+    case TOKEN_And:
+    case TOKEN_Or:
+    case TOKEN_Xor:
+        return Operations::PerformJunctionOperator(evalResult, _GetOperation(), leftResult, rightResult);
+        }
+
+    //  Short-circuit operators are handled by _GetValue
+    return ExpressionStatus::NotImpl;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ExpressionStatus BinaryNode::_GetValue(EvaluationResult& evalResult, ExpressionContextR context)
+    {
+    EvaluationResult    leftResult;
+    EvaluationResult    rightResult;
+    ExpressionStatus    status = GetOperandValues(leftResult, rightResult, context);
+
+    if (ExpressionStatus::Success != status)
+        return status;
+
+    return _ApplyOperator(evalResult, leftResult, rightResult, context);
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -2502,45 +2520,24 @@ ExpressionStatus BinaryNode::PromoteCommon(EvaluationResult& leftResult, Evaluat
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-ExpressionStatus ExponentNode::_GetValue(EvaluationResult& evalResult, ExpressionContextR context)
+ExpressionStatus ExponentNode::_ApplyOperator(EvaluationResultR evalResult, EvaluationResultR left, EvaluationResultR right, ExpressionContextR context)
     {
-    EvaluationResult    left;
-    EvaluationResult    right;
-    ExpressionStatus status = GetOperandValues(left, right, context);
-
-    if (ExpressionStatus::Success != status)
-        return status;
-
     return Operations::PerformExponentiation(evalResult, left, right);
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-ExpressionStatus MultiplyNode::_GetValue(EvaluationResult& evalResult, ExpressionContextR context)
+ExpressionStatus MultiplyNode::_ApplyOperator(EvaluationResultR evalResult, EvaluationResultR left, EvaluationResultR right, ExpressionContextR context)
     {
-    EvaluationResult    left;
-    EvaluationResult    right;
-    ExpressionStatus status = GetOperandValues(left, right, context);
-
-    if (ExpressionStatus::Success != status)
-        return status;
-
     return Operations::PerformMultiplication(evalResult, left, right);
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-ExpressionStatus DivideNode::_GetValue(EvaluationResult& evalResult, ExpressionContextR context)
+ExpressionStatus DivideNode::_ApplyOperator(EvaluationResultR evalResult, EvaluationResultR left, EvaluationResultR right, ExpressionContextR context)
     {
-    EvaluationResult    left;
-    EvaluationResult    right;
-    ExpressionStatus status = GetOperandValues(left, right, context);
-
-    if (ExpressionStatus::Success != status)
-        return status;
-
     switch(m_operatorCode)
         {
         case TOKEN_IntegerDivide:
@@ -2552,7 +2549,7 @@ ExpressionStatus DivideNode::_GetValue(EvaluationResult& evalResult, ExpressionC
         }
 
     BeAssert (false && L"bad divide operator");
-    ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_ERROR, Utf8PrintfString("DivideNode::_GetValue: UnknownError. Bad divide operator (left: %s, right: %s)", left.ToString().c_str(), right.ToString().c_str()).c_str());
+    ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_ERROR, Utf8PrintfString("DivideNode::_ApplyOperator: UnknownError. Bad divide operator (left: %s, right: %s)", left.ToString().c_str(), right.ToString().c_str()).c_str());
     return ExpressionStatus::UnknownError;
     }
 
@@ -2681,24 +2678,16 @@ template<> /*static*/ bool     PerformCompare<double> (double l, ExpressionToken
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-ExpressionStatus ComparisonNode::_GetValue(EvaluationResult& evalResult, ExpressionContextR context)
+ExpressionStatus ComparisonNode::_ApplyOperator(EvaluationResultR evalResult, EvaluationResultR leftResult, EvaluationResultR rightResult, ExpressionContextR context)
     {
-    EvaluationResult    leftResult;
-    EvaluationResult    rightResult;
-
-    ExpressionStatus status = GetOperandValues(leftResult, rightResult, context);
-
-    if (ExpressionStatus::Success != status)
-        return status;
-
-    status = PromoteCommon(leftResult, rightResult, context, true);
+    ExpressionStatus status = PromoteCommon(leftResult, rightResult, context, true);
 
     if (ExpressionStatus::Success != status)
         return status;
 
     if (TOKEN_Like == m_operatorCode)
         {
-        ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_ERROR, Utf8PrintfString("ComparisonNode::_GetValue: NotImplemented (operator: %s)", Lexer::GetString(m_operatorCode).c_str()).c_str());
+        ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_ERROR, Utf8PrintfString("ComparisonNode::_ApplyOperator: NotImplemented (operator: %s)", Lexer::GetString(m_operatorCode).c_str()).c_str());
         return ExpressionStatus::NotImpl;
         }
 
@@ -2717,7 +2706,7 @@ ExpressionStatus ComparisonNode::_GetValue(EvaluationResult& evalResult, Express
 
         //  Maybe the not's should be true for this
         evalResult.InitECValue().SetBoolean(boolResult);
-        ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_GetValue: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
+        ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_ApplyOperator: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
         return ExpressionStatus::Success;
         }
 
@@ -2740,7 +2729,7 @@ ExpressionStatus ComparisonNode::_GetValue(EvaluationResult& evalResult, Express
             }
 
         evalResult.InitECValue().SetBoolean(boolResult);
-        ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_GetValue: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
+        ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_ApplyOperator: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
         return ExpressionStatus::Success;
         }
 
@@ -2748,27 +2737,27 @@ ExpressionStatus ComparisonNode::_GetValue(EvaluationResult& evalResult, Express
         {
         case PRIMITIVETYPE_Boolean:
             evalResult.InitECValue().SetBoolean(PerformCompare(ecLeft.GetBoolean(), m_operatorCode, ecRight.GetBoolean()));
-            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_GetValue: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
+            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_ApplyOperator: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
             return ExpressionStatus::Success;
         case PRIMITIVETYPE_Double:
             evalResult.InitECValue().SetBoolean(PerformCompare(ecLeft.GetDouble(), m_operatorCode, ecRight.GetDouble()));
-            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_GetValue: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
+            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_ApplyOperator: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
             return ExpressionStatus::Success;
         case PRIMITIVETYPE_Integer:
             evalResult.InitECValue().SetBoolean(PerformCompare(ecLeft.GetInteger(), m_operatorCode, ecRight.GetInteger()));
-            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_GetValue: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
+            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_ApplyOperator: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
             return ExpressionStatus::Success;
         case PRIMITIVETYPE_Long:
             evalResult.InitECValue().SetBoolean(PerformCompare(ecLeft.GetLong(), m_operatorCode, ecRight.GetLong()));
-            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_GetValue: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
+            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_ApplyOperator: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
             return ExpressionStatus::Success;
         case PRIMITIVETYPE_DateTime:
             evalResult.InitECValue().SetBoolean(PerformCompare(ecLeft.GetDateTimeTicks(), m_operatorCode, ecRight.GetDateTimeTicks()));
-            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_GetValue: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
+            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_ApplyOperator: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
             return ExpressionStatus::Success;
         }
 
-    ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_ERROR, "ComparisonNode::_GetValue: WrongType");
+    ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_ERROR, "ComparisonNode::_ApplyOperator: WrongType");
     return ExpressionStatus::WrongType;
     }
 
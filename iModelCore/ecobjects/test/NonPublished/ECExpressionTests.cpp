@@ -193,6 +193,156 @@ TEST_F(ExpressionTests, LambdaValue_EvaluatesValueListOfContexts)
     EXPECT_EQ(ECValue(456), *agg.m_evaluatedValues[1].GetECValue());
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsistruct
++---------------+---------------+---------------+---------------+---------------+------*/
+struct CompiledExpressionTests : ExpressionTests
+    {
+    static SymbolExpressionContextPtr CreateContext(bool reverseSymbolsOrder)
+        {
+        SymbolExpressionContextPtr outer = SymbolExpressionContext::Create(nullptr);
+        outer->AddSymbol(*ValueSymbol::Create("Outer", ECValue(3)));
+
+        SymbolExpressionContextPtr nodeContext = SymbolExpressionContext::Create(nullptr);
+        nodeContext->AddSymbol(*ValueSymbol::Create("Value", ECValue(10)));
+        nodeContext->AddSymbol(*ValueSymbol::Create("Label", ECValue("x")));
+
+        bvector<SymbolPtr> symbols;
+        symbols.push_back(ValueSymbol::Create("a", ECValue(5)));
+        symbols.push_back(ValueSymbol::Create("b", ECValue("abc")));
+        symbols.push_back(ValueSymbol::Create("flag", ECValue(true)));
+        symbols.push_back(ContextSymbol::CreateContextSymbol("Node", *nodeContext));
+        if (reverseSymbolsOrder)
+            std::reverse(symbols.begin(), symbols.end());
+
+        SymbolExpressionContextPtr context = SymbolExpressionContext::Create(outer.get());
+        for (SymbolPtr const& symbol : symbols)
+            context->AddSymbol(*symbol);
+        return context;
+        }
+
+    static void ExpectSameResults(Utf8CP expr, ExpressionContextR compileContext, ExpressionContextR evaluateContext)
+        {
+        NodePtr node = ECEvaluator::ParseValueExpressionAndCreateTree(expr);
+        ASSERT_TRUE(node.IsValid()) << expr;
+        CompiledExpressionPtr compiled = CompiledExpression::Compile(*node, compileContext);
+
+        EvaluationResult expected;
+        ExpressionStatus expectedStatus = node->GetValue(expected, evaluateContext);
+        EvaluationResult actual;
+        ExpressionStatus actualStatus = compiled->GetValue(actual, evaluateContext);
+
+        ASSERT_EQ(expectedStatus, actualStatus) << expr;
+        if (ExpressionStatus::Success == expectedStatus && expected.IsECValue())
+            {
+            ASSERT_TRUE(actual.IsECValue()) << expr;
+            EXPECT_TRUE(expected.GetECValue()->Equals(*actual.GetECValue())) << expr << ": " << actual.ToString().c_str();
+            }
+        }
+    };
+
+static Utf8CP s_compiledExpressions[] =
+    {
+    "42",
+    "a + Node.Value * 2",
+    "(a - Outer) ^ 2",
+    "a \\ 2 + a Mod 2 + a / 2",
+    "-a",
+    "Not flag",
+    "b & \"d\"",
+    "b + \"d\"",
+    "IIf(flag, b & \"d\", \"no\")",
+    "IIf(Node.Value < 5, 1, 2)",
+    "flag AndAlso Node.Value > 5",
+    "Missing OrElse a = 5",
+    "Missing AndAlso a = 5",
+    "flag And a = 5 Or Node.Label = \"x\"",
+    "1 << a",
+    "b Like \"a%\"",
+    "Missing",
+    "Node.Missing",
+    "Outer + a",
+    };
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(CompiledExpressionTests, EvaluatesSameAsExpressionTree)
+    {
+    SymbolExpressionContextPtr context = CreateContext(false);
+    for (Utf8CP expr : s_compiledExpressions)
+        ExpectSameResults(expr, *context, *context);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(CompiledExpressionTests, EvaluatesSameAsExpressionTreeWhenContextShapeDiffers)
+    {
+    SymbolExpressionContextPtr compileContext = CreateContext(false);
+    SymbolExpressionContextPtr evaluateContext = CreateContext(true);
+    EXPECT_EQ(CompiledExpression::GetContextShape(*compileContext), CompiledExpression::GetContextShape(*evaluateContext));
+
+    for (Utf8CP expr : s_compiledExpressions)
+        ExpectSameResults(expr, *compileContext, *evaluateContext);
+
+    EXPECT_NE(CompiledExpression::GetContextShape(*compileContext), CompiledExpression::GetContextShape(*SymbolExpressionContext::Create(nullptr)));
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(CompiledExpressionTests, InnerSymbolShadowsBoundOuterSymbol)
+    {
+    SymbolExpressionContextPtr compileContext = CreateContext(false);
+    NodePtr node = ECEvaluator::ParseValueExpressionAndCreateTree("Outer + Node.Value");
+    ASSERT_TRUE(node.IsValid());
+    CompiledExpressionPtr compiled = CompiledExpression::Compile(*node, *compileContext);
+
+    EvaluationResult result;
+    ASSERT_EQ(ExpressionStatus::Success, compiled->GetValue(result, *compileContext));
+    EXPECT_EQ(ECValue(13), *result.GetECValue());
+
+    // a context of the same shape in which the inner level defines "Outer" instead of "flag"
+    SymbolExpressionContextPtr outer = SymbolExpressionContext::Create(nullptr);
+    outer->AddSymbol(*ValueSymbol::Create("Outer", ECValue(3)));
+    SymbolExpressionContextPtr nodeContext = SymbolExpressionContext::Create(nullptr);
+    nodeContext->AddSymbol(*ValueSymbol::Create("Value", ECValue(10)));
+    nodeContext->AddSymbol(*ValueSymbol::Create("Label", ECValue("x")));
+    SymbolExpressionContextPtr shadowing = SymbolExpressionContext::Create(outer.get());
+    shadowing->AddSymbol(*ValueSymbol::Create("a", ECValue(5)));
+    shadowing->AddSymbol(*ValueSymbol::Create("b", ECValue("abc")));
+    shadowing->AddSymbol(*ValueSymbol::Create("Outer", ECValue(100)));
+    shadowing->AddSymbol(*ContextSymbol::CreateContextSymbol("Node", *nodeContext));
+    EXPECT_EQ(CompiledExpression::GetContextShape(*compileContext), CompiledExpression::GetContextShape(*shadowing));
+
+    ASSERT_EQ(ExpressionStatus::Success, compiled->GetValue(result, *shadowing));
+    EXPECT_EQ(ECValue(110), *result.GetECValue());
+    for (Utf8CP expr : s_compiledExpressions)
+        ExpectSameResults(expr, *compileContext, *shadowing);
+
+    // a symbol added to the compile context itself after compiling
+    compileContext->AddSymbol(*ValueSymbol::Create("Outer", ECValue(20)));
+    ASSERT_EQ(ExpressionStatus::Success, compiled->GetValue(result, *compileContext));
+    EXPECT_EQ(ECValue(30), *result.GetECValue());
+
+    // a symbol shadowing one bound through a context symbol
+    SymbolExpressionContextPtr innerNode = SymbolExpressionContext::Create(nodeContext.get());
+    innerNode->AddSymbol(*ValueSymbol::Create("Value", ECValue(1)));
+    SymbolExpressionContextPtr nested = SymbolExpressionContext::Create(outer.get());
+    nested->AddSymbol(*ContextSymbol::CreateContextSymbol("Node", *innerNode));
+    NodePtr nodeValue = ECEvaluator::ParseValueExpressionAndCreateTree("Node.Value & Node.Label");
+    ASSERT_TRUE(nodeValue.IsValid());
+    SymbolExpressionContextPtr nestedCompileContext = SymbolExpressionContext::Create(outer.get());
+    nestedCompileContext->AddSymbol(*ContextSymbol::CreateContextSymbol("Node", *SymbolExpressionContext::Create(nodeContext.get())));
+    CompiledExpressionPtr nestedCompiled = CompiledExpression::Compile(*nodeValue, *nestedCompileContext);
+    EvaluationResult expected;
+    ASSERT_EQ(ExpressionStatus::Success, nodeValue->GetValue(expected, *nested));
+    ASSERT_EQ(ExpressionStatus::Success, nestedCompiled->GetValue(result, *nested));
+    EXPECT_TRUE(expected.GetECValue()->Equals(*result.GetECValue()));
+    EXPECT_EQ(ECValue("1x"), *result.GetECValue());
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
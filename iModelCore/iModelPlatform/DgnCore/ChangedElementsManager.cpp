@@ -7,6 +7,7 @@
 #include <ECDb/ECDbApi.h>
 #include <ECPresentation/ECPresentationManager.h>
 #include <ECPresentation/RuleSetLocater.h>
+#include <future>
 
 #define CHANGE_PROPSPEC_NAMESPACE "ec_ChangedElements"
 
@@ -245,13 +246,14 @@ DbResult ChangedElementsManager::InsertEntries(ECDbR cacheDb, ChangesetPropsPtr
 
     modelStmt.Finalize();
 
-    return cacheDb.SaveChanges();
+    // Caller commits, so that several changesets can be written in one transaction
+    return BE_SQLITE_OK;
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-BeFileName    ChangedElementsManager::CloneDb(BeFileNameCR dbFilename)
+BeFileName    ChangedElementsManager::CloneDb(BeFileNameCR dbFilename, int cloneIndex)
     {
     DgnDb::OpenParams params (Db::OpenMode::ReadWrite, BeSQLite::DefaultTxn::Yes, SchemaUpgradeOptions(SchemaUpgradeOptions::DomainUpgradeOptions::SkipCheck));
 
@@ -262,9 +264,16 @@ BeFileName    ChangedElementsManager::CloneDb(BeFileNameCR dbFilename)
         tempFilename = m_tempLocation;
 
     WString name = WString(L"Temp_") + dbFilename.GetFileNameWithoutExtension();
+    if (cloneIndex >= 0)
+        name.append(WPrintfString(L"_%d", cloneIndex));
+
     tempFilename.AppendToPath(name.c_str());
     tempFilename.AppendExtension(L"bim");
 
+    // Indexed clones are positioned at a specific changeset, so a leftover copy can't be reused
+    if (cloneIndex >= 0 && tempFilename.DoesPathExist())
+        tempFilename.BeDeleteFile();
+
     // Try to create temporary file by copying base bim file
     BeFileNameStatus fileStatus = BeFileName::BeCopyFile(dbFilename, tempFilename);
 
@@ -395,14 +404,220 @@ void ChangedElementsManager::ChangedElementsToJSON(BeJsValue val, ChangedElement
         }
     }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+SummaryOptions ChangedElementsManager::GetSummaryOptions(ECPresentationManager* presentationManager, bool wantBriefcaseRoll) const
+    {
+    SummaryOptions options;
+    options.filterSpatial = m_filterSpatial;
+    options.tempLocation = m_tempLocation;
+    options.presentationManager = presentationManager;
+    options.wantParents = m_wantParents;
+    options.wantBriefcaseRoll = wantBriefcaseRoll;
+    options.wantPropertyChecksums = m_wantPropertyChecksums;
+    options.wantRelationshipCaching = m_wantRelationshipCaching;
+    options.relationshipCacheSize = m_relationshipCacheSize;
+    options.wantChunkTraversal = m_wantChunkTraversal;
+    options.wantBoundingBoxes = m_wantBoundingBoxes;
+    return options;
+    }
+
+//---------------------------------------------------------------------------------------
+// Apply a contiguous range of changesets to a cloned briefcase, leaving it closed.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+DbResult ChangedElementsManager::RollClone(BeFileNameCR cloneFilename, bvector<ChangesetPropsPtr>::const_iterator begin, bvector<ChangesetPropsPtr>::const_iterator end)
+    {
+    if (begin == end)
+        return BE_SQLITE_OK;
+
+    bvector<ChangesetPropsCP> changesets;
+    for (auto it = begin; it != end; ++it)
+        changesets.push_back(it->get());
+
+    DbResult result;
+    DgnDb::OpenParams params(DgnDb::OpenMode::ReadWrite, BeSQLite::DefaultTxn::Yes);
+    params.GetSchemaUpgradeOptionsR().SetUpgradeFromRevisions(changesets, RevisionProcessOption::Merge);
+    DgnDbPtr db = DgnDb::OpenIModelDb(&result, cloneFilename, params);
+    if (!db.IsValid())
+        return BE_SQLITE_OK == result ? BE_SQLITE_ERROR : result;
+
+    db->CloseDb();
+    return BE_SQLITE_OK;
+    }
+
+//---------------------------------------------------------------------------------------
+// Split the changesets into one contiguous range per worker. Each worker summarizes its range using its own
+// clone of the briefcase, positioned at the start of the range, and its own presentation manager.
+// The calling thread writes the results to the cache in changeset order, one transaction per range.
+// processed is false if the changesets can't be split this way and should be processed serially instead.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+DbResult ChangedElementsManager::ProcessChangesetsInParallel(ECDbR cacheDb, bvector<ChangesetPropsPtr> const& revisions, bool& processed)
+    {
+    processed = false;
+
+    size_t workerCount = std::min((size_t) m_workerCount, revisions.size());
+    size_t rangeSize = (revisions.size() + workerCount - 1) / workerCount;
+    workerCount = (revisions.size() + rangeSize - 1) / rangeSize;
+
+    // The clones are positioned by rolling a single copy forward through the ranges, so the briefcase must start at the first changeset
+        {
+        DbResult result;
+        DgnDbPtr db = DgnDb::OpenIModelDb(&result, m_dbFilename, DgnDb::OpenParams(Db::OpenMode::Readonly));
+        bool atFirstChangeset = db.IsValid() && db->Txns().GetParentChangesetId().Equals(revisions.front()->GetParentId());
+        db = nullptr;
+        if (!atFirstChangeset)
+            return BE_SQLITE_OK;
+        }
+
+    processed = true;
+    BeFileName positionFilename = CloneDb(m_dbFilename, (int) workerCount);
+
+    struct Summary
+        {
+        bool m_valid = false;
+        bool m_skipped = false; // changed elements could not be read, so the changeset is left out of the cache as in the serial path
+        bvector<ChangedElement> m_elements;
+        };
+
+    std::atomic<bool> abort(false);
+    bvector<std::promise<Summary>> promises(revisions.size());
+    bvector<std::future<Summary>> summaries;
+    for (auto& promise : promises)
+        summaries.push_back(promise.get_future());
+
+    auto summarizeRange = [&](size_t first, size_t last, BeFileName cloneFilename)
+        {
+        // An exception must not escape the thread. Fail the rest of the range instead, so the calling thread stops waiting on it.
+        size_t next = first;
+        try
+            {
+            std::unique_ptr<ECPresentationManager> presentationManager(CreatePresentationManager());
+            if (!m_rulesetDirectory.empty())
+                presentationManager->GetLocaters().RegisterLocater(*DirectoryRuleSetLocater::Create(m_rulesetDirectory.c_str()));
+
+            SummaryOptions options = GetSummaryOptions(presentationManager.get(), true);
+            for (; next < last && !abort; ++next)
+                {
+                Summary result;
+                bvector<ChangesetPropsPtr> currentRevisions;
+                currentRevisions.push_back(revisions[next]);
+                VersionCompareChangeSummaryPtr summary = VersionCompareChangeSummary::Generate(cloneFilename, currentRevisions, options);
+                if (summary.IsValid())
+                    {
+                    result.m_valid = true;
+                    if (SUCCESS != summary->GetChangedElements(result.m_elements))
+                        {
+                        LOG.errorv(L"Problem getting changed elements");
+                        result.m_skipped = true;
+                        result.m_elements.clear();
+                        }
+                    }
+
+                // Release summary to close the clone before it is rolled by the next changeset
+                summary = nullptr;
+                promises[next].set_value(std::move(result));
+                }
+            }
+        catch (std::exception const& e)
+            {
+            LOG.errorv("Changeset processing failed: %s", e.what());
+            }
+        catch (...)
+            {
+            LOG.errorv(L"Changeset processing failed");
+            }
+
+        for (; next < last; ++next)
+            promises[next].set_value(Summary());
+
+        cloneFilename.BeDeleteFile();
+        };
+
+    // Start each worker as soon as its clone is positioned, so summarizing overlaps the remaining positioning
+    std::vector<std::thread> workers;
+
+    // Stop and join the workers however this function exits. They reference promises and the locals above.
+    struct JoinWorkers
+        {
+        std::atomic<bool>& m_abort;
+        std::vector<std::thread>& m_workers;
+        ~JoinWorkers()
+            {
+            m_abort = true;
+            for (auto& worker : m_workers)
+                worker.join();
+            }
+        } joinWorkers {abort, workers};
+
+    DbResult positionStatus = BE_SQLITE_OK;
+    for (size_t worker = 0; worker < workerCount; ++worker)
+        {
+        size_t first = worker * rangeSize;
+        size_t last = std::min(first + rangeSize, revisions.size());
+
+        BeFileName cloneFilename = CloneDb(positionFilename, (int) worker);
+        if (!cloneFilename.DoesPathExist())
+            {
+            LOG.errorv(L"Could not clone briefcase for changeset processing");
+            positionStatus = BE_SQLITE_ERROR;
+            break;
+            }
+
+        workers.emplace_back(summarizeRange, first, last, cloneFilename);
+
+        if (last < revisions.size() && BE_SQLITE_OK != (positionStatus = RollClone(positionFilename, revisions.begin() + first, revisions.begin() + last)))
+            {
+            LOG.errorv(L"Could not apply changesets to position briefcase clone");
+            break;
+            }
+        }
+
+    positionFilename.BeDeleteFile();
+
+    // Write summaries in changeset order as they complete. Only the ranges that have workers can be waited on.
+    size_t available = std::min(workers.size() * rangeSize, revisions.size());
+    DbResult status = BE_SQLITE_OK;
+    for (size_t i = 0; i < available; ++i)
+        {
+        Summary summary = summaries[i].get();
+        if (!summary.m_valid)
+            {
+            LOG.errorv(L"Could not generate change summary for revision");
+            status = BE_SQLITE_ERROR;
+            break;
+            }
+
+        if (!summary.m_skipped && BE_SQLITE_OK != InsertEntries(cacheDb, revisions[i], summary.m_elements))
+            {
+            LOG.errorv(L"Could not insert entries into cache");
+            status = BE_SQLITE_ERROR;
+            break;
+            }
+
+        bool endOfRange = 0 == (i + 1) % rangeSize || i + 1 == revisions.size();
+        if (endOfRange && BE_SQLITE_OK != (status = cacheDb.SaveChanges()))
+            break;
+        }
+
+    if (BE_SQLITE_OK != status)
+        {
+        cacheDb.AbandonChanges();
+        return status;
+        }
+
+    // Ranges that were written before a clone failed to position remain in the cache
+    return positionStatus;
+    }
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
 DbResult ChangedElementsManager::ProcessChangesets(ECDbR cacheDb, Utf8String rulesetId, bvector<ChangesetPropsPtr> const& revisions)
     {
     bool multiProcessing = revisions.size() > 1;
-    // Clone briefcase so that we may roll it if we have multiple changesets to process
-    BeFileName dbFilename = multiProcessing ? CloneDb(m_dbFilename) : m_dbFilename;
 
     bvector<ChangesetPropsPtr> processedRevisions;
     for (ChangesetPropsPtr rev : revisions)
@@ -415,6 +630,17 @@ DbResult ChangedElementsManager::ProcessChangesets(ECDbR cacheDb, Utf8String rul
     if (DateTime::Compare(firstDate, lastDate) != DateTime::CompareResult::EarlierThan)
         std::reverse(processedRevisions.begin(), processedRevisions.end());
 
+    if (multiProcessing && m_workerCount > 1)
+        {
+        bool processed;
+        DbResult result = ProcessChangesetsInParallel(cacheDb, processedRevisions, processed);
+        if (processed)
+            return result;
+        }
+
+    // Clone briefcase so that we may roll it if we have multiple changesets to process
+    BeFileName dbFilename = multiProcessing ? CloneDb(m_dbFilename) : m_dbFilename;
+
     // Use version compare change summary to generate the changed elements list
     for (ChangesetPropsPtr revision : processedRevisions)
         {
@@ -422,17 +648,7 @@ DbResult ChangedElementsManager::ProcessChangesets(ECDbR cacheDb, Utf8String rul
         bvector<ChangesetPropsPtr> currentRevisions;
         currentRevisions.push_back(revision);
 
-        SummaryOptions options;
-        options.filterSpatial = m_filterSpatial;
-        options.tempLocation = m_tempLocation;
-        options.presentationManager = m_presentationManager;
-        options.wantParents = m_wantParents;
-        options.wantBriefcaseRoll = multiProcessing || m_wantBriefcaseRoll;
-        options.wantPropertyChecksums = m_wantPropertyChecksums;
-        options.wantRelationshipCaching = m_wantRelationshipCaching;
-        options.relationshipCacheSize = m_relationshipCacheSize;
-        options.wantChunkTraversal = m_wantChunkTraversal;
-        options.wantBoundingBoxes = m_wantBoundingBoxes;
+        SummaryOptions options = GetSummaryOptions(m_presentationManager, multiProcessing || m_wantBriefcaseRoll);
         VersionCompareChangeSummaryPtr summary = VersionCompareChangeSummary::Generate(dbFilename, currentRevisions, options);
         if (!summary.IsValid())
             {
@@ -449,7 +665,7 @@ DbResult ChangedElementsManager::ProcessChangesets(ECDbR cacheDb, Utf8String rul
             }
 
         // Insert data into the cache
-        if (BE_SQLITE_OK != InsertEntries(cacheDb, revision, elements))
+        if (BE_SQLITE_OK != InsertEntries(cacheDb, revision, elements) || BE_SQLITE_OK != cacheDb.SaveChanges())
             {
             LOG.errorv(L"Could not insert entries into cache");
             return BE_SQLITE_ERROR;
@@ -605,7 +605,7 @@ public:
             BeNapi::ThrowJsException(env, message, (int)status);
         };
 
-        if (parentRevId.length() != SHA1::HashBytes * 2 && !parentRevId.empty()) {
+        if (!ChangesetProps::IsValidParentId(parentRevId)) {
             throwError("Invalid parent changeset id. Expect empty or SHA1 hash", ChangesetStatus::BadVersionId);
         }
 
@@ -613,10 +613,24 @@ public:
             throwError("Invalid changeset file. File not not found.", ChangesetStatus::FileNotFound);
         }
 
+        ChangesetFileReader fs(changesetFile, nullptr);
+        return GenerateId(parentRevId, fs, env);
+    }
+
+    //---------------------------------------------------------------------------------------
+    // @bsimethod
+    //---------------------------------------------------------------------------------------
+    static Utf8String GenerateId(Utf8StringCR parentRevId, ChangesetFileReaderBase const& fs, Napi::Env env) {
+        auto throwError = [&env](const char* message, ChangesetStatus status) {
+            if(env== nullptr) {
+                throw std::runtime_error(message);
+            }
+            BeNapi::ThrowJsException(env, message, (int)status);
+        };
+
         ChangesetIdGenerator idGen;
         idGen.AddStringToHash(parentRevId);
 
-        ChangesetFileReader fs(changesetFile, nullptr);
         auto reader = fs.MakeReader();
 
         DbResult result;
@@ -641,6 +655,13 @@ public:
     }
 };
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+bool ChangesetProps::IsValidParentId(Utf8StringCR parentRevId) {
+    return parentRevId.empty() || parentRevId.length() == SHA1::HashBytes * 2;
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -648,6 +669,13 @@ Utf8String ChangesetProps::ComputeChangesetId(Utf8StringCR parentRevId, BeFileNa
     return ChangesetIdGenerator::GenerateId(parentRevId, changesetFile, env);
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+Utf8String ChangesetProps::ComputeChangesetId(Utf8StringCR parentRevId, ChangesetFileReaderBase const& reader) {
+    return ChangesetIdGenerator::GenerateId(parentRevId, reader, Napi::Env(nullptr));
+}
+
 
 //---------------------------------------------------------------------------------------
 // @bsimethod
@@ -696,6 +724,20 @@ void ChangesetProps::ValidateContent(DgnDbR dgndb) const {
     SetSha1ValidationTime(BeTimeUtilities::QueryMillisecondsCounterUInt32() - startMs);
 }
 
+/**
+ * validate the content of a changeset props against an id that was computed ahead of time from its file.
+ */
+void ChangesetProps::ValidateContent(DgnDbR dgndb, Utf8StringCR computedId) const {
+    if (m_dbGuid != dgndb.GetDbGuid().ToString())
+        dgndb.ThrowException("changeset did not originate from this iModel", (int) ChangesetStatus::WrongDgnDb);
+
+    if (!IsValidParentId(m_parentId))
+        dgndb.ThrowException("Invalid parent changeset id. Expect empty or SHA1 hash", (int) ChangesetStatus::BadVersionId);
+
+    if (m_id != computedId)
+      dgndb.ThrowException("incorrect id for changeset", (int) ChangesetStatus::CorruptedChangeStream);
+}
+
 /**
  * determine whether the Changeset has schema changes.
  */
@@ -14,7 +14,7 @@ enum    ClipStatus
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-StatusInt   ClipVector::ClipPolyface(PolyfaceQueryCR polyface, PolyfaceQuery::IClipToPlaneSetOutput& output, bool triangulateOutput) const
+StatusInt   ClipVector::ClipPolyface(PolyfaceQueryCR polyface, PolyfaceQuery::IClipToPlaneSetOutput& output, bool triangulateOutput, bool parallel) const
     {
     T_ClipPlaneSets         clipPlaneSets;
 
@@ -22,7 +22,7 @@ StatusInt   ClipVector::ClipPolyface(PolyfaceQueryCR polyface, PolyfaceQuery::IC
         if (NULL != primitive->GetClipPlanes())
             clipPlaneSets.push_back(*primitive->GetClipPlanes());
     
-    return polyface.ClipToPlaneSetIntersection(clipPlaneSets, output, triangulateOutput);
+    return polyface.ClipToPlaneSetIntersection(clipPlaneSets, output, triangulateOutput, parallel);
     }
 
 /*=================================================================================**//**
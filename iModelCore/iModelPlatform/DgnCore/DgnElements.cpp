@@ -7,100 +7,219 @@
 BEGIN_BENTLEY_DGN_NAMESPACE
 
 //=======================================================================================
-// Most Recently Used cache of DgnElements for a DgnDb. Holds the N most recently used
-// elements for a DgnDb. As a newer element is added, the least recently used one is dropped
-// if the cache holds more than the maximum size.
+// Most Recently Used cache of DgnElements for a DgnDb. Holds the most recently used
+// elements for a DgnDb, limited both by element count and by the estimated memory of
+// the elements (DgnElement::GetMemorySize). As a newer element is added, the least
+// recently used ones are dropped until the cache is back within its limits.
+// Elements are spread over STRIPES MRU lists by id, each with its own mutex, so that
+// threads looking up different elements do not contend. The limits apply to the cache as
+// a whole: every use of an entry is stamped from one clock, so each stripe's list is
+// ordered by that stamp and the globally least recently used entry is the oldest of the
+// stripe tails.
 // @bsiclass
 //=======================================================================================
 struct ElementMRU
 {
+    static const uint32_t STRIPES = 16;
+
     struct ElemEntry : NonCopyableClass
     {
         uint64_t m_id;
         DgnElementCPtr m_el;
-        ElemEntry(uint64_t id, DgnElementCPtr el) : m_id(id), m_el(el) {}
+        uint64_t m_bytes;
+        uint64_t m_lastUsed;
+        ElemEntry(uint64_t id, DgnElementCPtr el, uint64_t bytes, uint64_t lastUsed) : m_id(id), m_el(el), m_bytes(bytes), m_lastUsed(lastUsed) {}
     };
 
     typedef std::list<ElemEntry> EntryList;
 
-    EntryList m_list;
-    std::unordered_map<uint64_t, EntryList::iterator> m_map;
-    uint32_t m_maxSize;
+    struct Stripe
+    {
+        BeMutex m_mutex;
+        EntryList m_list;
+        std::unordered_map<uint64_t, EntryList::iterator> m_map;
+    };
+
+    Stripe m_stripes[STRIPES];
+    BeMutex m_purgeMutex;                   // serializes eviction, so concurrent adds do not evict more than needed
+    std::atomic<uint32_t> m_maxSize;
+    std::atomic<uint64_t> m_maxBytes {0};   // 0 means no memory limit
+    std::atomic<uint64_t> m_clock {0};
+    std::atomic<uint64_t> m_count {0};
+    std::atomic<uint64_t> m_bytes {0};
+    std::atomic<uint64_t> m_hits {0};
+    std::atomic<uint64_t> m_misses {0};
+    std::atomic<uint64_t> m_evictions {0};
 
     explicit ElementMRU(uint32_t size = 2000) : m_maxSize(size) {}
-    void SetMaxSize(uint32_t newSize) { m_maxSize = newSize; Purge(); }
-    void Clear() {m_map.clear(); m_list.clear();}
-    void MoveToFront(EntryList::iterator it) {m_list.splice(m_list.begin(), m_list, it);}
+    void SetMaxSize(uint32_t newSize) {m_maxSize = newSize; Purge();}
+    void SetMaxBytes(uint64_t maxBytes) {m_maxBytes = maxBytes; Purge();}
+
+    Stripe& GetStripe(uint64_t id) {return m_stripes[(id ^ (id >> 17)) % STRIPES];}
+    bool IsOverLimit() const {uint64_t maxBytes = m_maxBytes.load(); return m_count.load() > m_maxSize.load() || (0 != maxBytes && m_bytes.load() > maxBytes);}
+
+    // mark an entry as most recently used. Caller must hold the stripe's mutex.
+    void Touch(Stripe& stripe, EntryList::iterator it)
+        {
+        it->m_lastUsed = ++m_clock;
+        stripe.m_list.splice(stripe.m_list.begin(), stripe.m_list, it);
+        }
+
+    // move an entry out of its stripe. Caller must hold the stripe's mutex.
+    void Remove(Stripe& stripe, EntryList::iterator it, EntryList& removed)
+        {
+        stripe.m_map.erase(it->m_id);
+        m_bytes -= it->m_bytes;
+        --m_count;
+        removed.splice(removed.end(), stripe.m_list, it);
+        }
+
+    void Clear()
+        {
+        for (auto& stripe : m_stripes)
+            {
+            EntryList dropped;
+                {
+                BeMutexHolder lock(stripe.m_mutex);
+                while (!stripe.m_list.empty())
+                    Remove(stripe, stripe.m_list.begin(), dropped);
+                }
+            // dropped elements are released here, outside the stripe lock.
+            }
+        }
 
     // add an element to the front of the MRU cache.
     void AddElement(DgnElementCR el)
         {
-        if (0 == m_maxSize)
+        if (0 == m_maxSize.load())
             return;
 
         uint64_t id = el.GetElementId().GetValue();
-        auto iter = m_map.find(id);
-        if (iter != m_map.end())
+        uint64_t bytes = el.GetMemorySize();
+        Stripe& stripe = GetStripe(id);
             {
-            iter->second->m_el = &el;
-            MoveToFront(iter->second);
-            return;
+            BeMutexHolder lock(stripe.m_mutex);
+            auto iter = stripe.m_map.find(id);
+            if (iter != stripe.m_map.end())
+                {
+                m_bytes += bytes - iter->second->m_bytes;
+                iter->second->m_el = &el;
+                iter->second->m_bytes = bytes;
+                Touch(stripe, iter->second);
+                }
+            else
+                {
+                stripe.m_list.emplace_front(id, &el, bytes, ++m_clock);
+                stripe.m_map[id] = stripe.m_list.begin();
+                m_bytes += bytes;
+                ++m_count;
+                }
             }
-
-        m_list.emplace_front(id, &el);
-        m_map[id] = m_list.begin();
         Purge();
         }
 
     // look for the element in the MRU cache. If found, move it to most recent
-    DgnElementCP FindElement(DgnElementId eid)
+    DgnElementCPtr FindElement(DgnElementId eid, bool countLookup = true)
         {
         auto id = eid.GetValue();
-        auto iter = m_map.find(id);
-        if (iter == m_map.end())
+        Stripe& stripe = GetStripe(id);
+        BeMutexHolder lock(stripe.m_mutex);
+        auto iter = stripe.m_map.find(id);
+        if (iter == stripe.m_map.end())
+            {
+            if (countLookup)
+                ++m_misses;
             return nullptr;
+            }
 
-        MoveToFront(iter->second);
-        return iter->second->m_el.get();
+        if (countLookup)
+            ++m_hits;
+        Touch(stripe, iter->second);
+        return iter->second->m_el;
         }
 
     // drop an element from MRU cache.
     bool DropElement(DgnElementId eid)
         {
         auto id = eid.GetValue();
-        auto iter = m_map.find(id);
-        if (iter == m_map.end())
-            return false;
+        Stripe& stripe = GetStripe(id);
+        EntryList dropped;
+            {
+            BeMutexHolder lock(stripe.m_mutex);
+            auto iter = stripe.m_map.find(id);
+            if (iter == stripe.m_map.end())
+                return false;
 
-        m_list.erase(iter->second);
-        m_map.erase(iter);
+            Remove(stripe, iter->second, dropped);
+            }
         return true;
         }
 
     // drop multiple elements from MRU cache.
     void DropElements(const DgnElementIdSet& ids)
         {
-        for (auto it = m_list.begin(); it != m_list.end(); )
+        for (auto& stripe : m_stripes)
             {
-            if (ids.Contains(DgnElementId(it->m_id)))
+            EntryList dropped; // declared before the lock, so dropped elements are released after it is unlocked
+            BeMutexHolder lock(stripe.m_mutex);
+            for (auto it = stripe.m_list.begin(); it != stripe.m_list.end(); )
                 {
-                m_map.erase(it->m_id);
-                it = m_list.erase(it);
+                auto next = std::next(it);
+                if (ids.Contains(DgnElementId(it->m_id)))
+                    Remove(stripe, it, dropped);
+                it = next;
                 }
-            else
-                ++it;
             }
         }
 
-    // purge MRU cache until it is less than the maximum size.
+    // drop the least recently used elements of the whole cache until it is within its limits.
+    // Only one stripe mutex is held at a time, so this never deadlocks with lookups.
     void Purge()
         {
-        while (m_map.size() > m_maxSize)
+        if (!IsOverLimit())
+            return;
+
+        EntryList evicted; // declared before the locks, so evicted elements are released after they are unlocked
+        BeMutexHolder purgeLock(m_purgeMutex);
+        while (IsOverLimit())
             {
-            m_map.erase(m_list.back().m_id);
-            m_list.pop_back();
+            Stripe* oldest = nullptr;
+            uint64_t oldestUse = 0;
+            for (auto& stripe : m_stripes)
+                {
+                BeMutexHolder lock(stripe.m_mutex);
+                if (!stripe.m_list.empty() && (nullptr == oldest || stripe.m_list.back().m_lastUsed < oldestUse))
+                    {
+                    oldest = &stripe;
+                    oldestUse = stripe.m_list.back().m_lastUsed;
+                    }
+                }
+
+            if (nullptr == oldest)
+                break;
+
+            BeMutexHolder lock(oldest->m_mutex);
+            // the tail may have been used or dropped since it was found; if so, look again.
+            if (!oldest->m_list.empty() && oldest->m_list.back().m_lastUsed == oldestUse)
+                {
+                Remove(*oldest, std::prev(oldest->m_list.end()), evicted);
+                ++m_evictions;
+                }
             }
         }
+
+    DgnElements::CacheStats GetStats()
+        {
+        DgnElements::CacheStats stats;
+        stats.m_hits = m_hits.load();
+        stats.m_misses = m_misses.load();
+        stats.m_evictions = m_evictions.load();
+        stats.m_count = m_count.load();
+        stats.m_bytes = m_bytes.load();
+        return stats;
+        }
+
+    void ResetStats() {m_hits = 0; m_misses = 0; m_evictions = 0;}
 };
 
 END_BENTLEY_DGN_NAMESPACE
@@ -131,6 +250,31 @@ void DgnElements::SetCacheSize(uint32_t newSize)
     m_mruCache->SetMaxSize(newSize);
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void DgnElements::SetCacheMemoryBudget(uint64_t maxBytes)
+    {
+    BeMutexHolder _v_v(m_mutex);
+    m_mruCache->SetMaxBytes(maxBytes);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+DgnElements::CacheStats DgnElements::GetCacheStats() const
+    {
+    return m_mruCache->GetStats();
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void DgnElements::ResetCacheStats()
+    {
+    m_mruCache->ResetStats();
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -173,7 +317,7 @@ void DgnElements::DropFromPool(DgnElementIdSet ids) const
 DgnElementCP DgnElements::FindLoadedElement(DgnElementId id) const
     {
     BeMutexHolder _v_v(m_mutex);
-    return m_mruCache->FindElement(id);
+    return m_mruCache->FindElement(id).get();
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -345,11 +489,16 @@ DgnElementCPtr DgnElements::LoadElement(DgnElementId elementId,  bool makePersis
      if (!elementId.IsValid())
          return nullptr;
 
+     // a cached element only needs the lock of its cache stripe, so threads finding elements in the cache do not serialize on m_mutex.
+     DgnElementCPtr element = m_mruCache->FindElement(elementId);
+     if (element.IsValid())
+         return element;
+
      // since we can load elements on more than one thread, we need to check that the element doesn't already exist
      // *with the lock held* before we load it. This avoids a race condition where an element is loaded on more than one thread.
      BeMutexHolder _v(m_mutex);
-     DgnElementCP element = FindLoadedElement(elementId);
-     return (nullptr != element) ? element : LoadElement(elementId, true);
+     element = m_mruCache->FindElement(elementId, false);
+     return element.IsValid() ? element : LoadElement(elementId, true);
     }
 
 /*---------------------------------------------------------------------------------**//**
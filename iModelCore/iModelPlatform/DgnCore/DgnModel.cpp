@@ -1066,6 +1066,8 @@ DgnDbStatus GeometricModel3d::_FillRangeIndex() {
 
     m_rangeIndex.reset(new RangeIndex::Tree(true, 20));
 
+    // collect all entries first so the tree can be packed in one pass rather than grown one insert at a time.
+    bvector<RangeIndex::Entry> entries;
     if (!m_isNotSpatiallyLocated) {
         // use the spatial index because it doesn't need any data from the GeometricElement3d table.
         Statement stmt(m_dgndb,
@@ -1082,7 +1084,7 @@ DgnDbStatus GeometricModel3d::_FillRangeIndex() {
                 stmt.GetValueDouble(5),
                 stmt.GetValueDouble(6)
             );
-            m_rangeIndex->AddEntry(RangeIndex::Entry(RangeIndex::FBox(range, false), stmt.GetValueId<DgnElementId>(0)));
+            entries.push_back(RangeIndex::Entry(RangeIndex::FBox(range, false), stmt.GetValueId<DgnElementId>(0)));
         }
     } else {
         // this is only for models that are not in the spatial index (e.g. plan projection models). This is a rare case.
@@ -1104,10 +1106,11 @@ DgnDbStatus GeometricModel3d::_FillRangeIndex() {
                                     ElementAlignedBox3d(low.x, low.y, low.z, high.x, high.y, high.z));
 
             RangeIndex::FBox fBox(placement.CalculateRange(), false);
-            m_rangeIndex->AddEntry(RangeIndex::Entry(fBox, stmt->GetValueId<DgnElementId>(0)));
+            entries.push_back(RangeIndex::Entry(fBox, stmt->GetValueId<DgnElementId>(0)));
         }
     }
 
+    m_rangeIndex->BulkLoad(entries);
     return DgnDbStatus::Success;
 }
 
@@ -1147,6 +1150,7 @@ DgnDbStatus GeometricModel2d::_FillRangeIndex() {
     auto stmt = m_dgndb.GetPreparedECSqlStatement("SELECT ECInstanceId,Origin,Rotation,BBoxLow,BBoxHigh FROM " BIS_SCHEMA(BIS_CLASS_GeometricElement2d) " WHERE Model.Id=?");
     stmt->BindId(1, GetModelId());
 
+    bvector<RangeIndex::Entry> entries;
     while (BE_SQLITE_ROW == stmt->Step()) {
         if (stmt->IsValueNull(2)) // has no placement
             continue;
@@ -1159,9 +1163,10 @@ DgnDbStatus GeometricModel2d::_FillRangeIndex() {
                               ElementAlignedBox2d(low.x, low.y, high.x, high.y));
 
         RangeIndex::FBox fbox(placement.CalculateRange(), true);
-        m_rangeIndex->AddEntry(RangeIndex::Entry(fbox, stmt->GetValueId<DgnElementId>(0)));
+        entries.push_back(RangeIndex::Entry(fbox, stmt->GetValueId<DgnElementId>(0)));
     }
 
+    m_rangeIndex->BulkLoad(entries);
     return DgnDbStatus::Success;
 }
 
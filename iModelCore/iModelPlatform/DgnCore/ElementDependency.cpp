@@ -3,11 +3,7 @@
 * See LICENSE.md in the repository root for full copyright notice.
 *--------------------------------------------------------------------------------------------*/
 #include <DgnPlatformInternal.h>
-
-#define EDGE_QUEUE_TABLE_NAME  "TxnEdgeQueue"
-#define EDGE_QUEUE TEMP_TABLE(EDGE_QUEUE_TABLE_NAME)
-#define NODES_TABLE_NAME "TxnNodes"
-#define NODES TEMP_TABLE(NODES_TABLE_NAME)
+#include <numeric>
 
 #define EDGLOGGER NativeLogging::CategoryLogger("ElementDep")
 #define EDGLOG(sev,...) { EDGLOGGER.messagev(sev, __VA_ARGS__); }
@@ -99,30 +95,40 @@ struct Graph::ChildPropagatesChangesToParent : Graph::TableApi
     };
 
 //=======================================================================================
-//  The queue of all element dependency graph edges found.
+//  Hash for looking up edges by their relationship key
+// @bsiclass
+//=======================================================================================
+struct EdgeKeyHash
+    {
+    size_t operator()(ECInstanceKeyCR key) const {return std::hash<uint64_t>()(key.GetInstanceId().GetValue() * 31 + key.GetClassId().GetValue());}
+    };
+
+//=======================================================================================
+//  The queue of all element dependency graph edges found. Held in memory: it is only
+//  needed for the duration of one propagation and is looked up once or more per edge.
 // @bsiclass
 //=======================================================================================
 struct Graph::EdgeQueue : Graph::TableApi
     {
     private:
-    CachedStatementPtr m_insert, m_select, m_selbyp, m_selbyo, m__updateStatus__;
-    CachedStatementPtr m_setEdgeColor, m_getEdgeColor;
-    Statement m_checkPathStmt;
+    struct Entry
+        {
+        Edge m_edge;
+        EdgeColor m_color = EdgeColor::White;
+        };
 
-    DbResult SelectEdge(Edge&, Statement&);
+    bvector<Entry> m_entries;
+    std::unordered_map<ECInstanceKey, size_t, EdgeKeyHash> m_byKey;
+    std::unordered_map<uint64_t, bvector<size_t>> m_byOutput;
+
+    bvector<Edge> GetEdges(bvector<size_t> indices) const;
 
     public:
-    EdgeQueue(Graph& g);
-    ~EdgeQueue();
-    DbResult AddEdge(Edge&);
-    DbResult StepSelectAll(Edge& edge) {return SelectEdge(edge, *m_select);}
-    void ResetSelectAll() { m_select->Reset(); }
-
-    void ResetSelectAllOrderedByPriority() {m_selbyp->Reset();}
-    DbResult StepSelectAllOrderedByPriority(Edge& edge) {return SelectEdge(edge, *m_selbyp);}
-    DbResult BindSelectByOutput(DgnElementId);
-    DbResult StepSelectByOutput(Edge& edge) {return SelectEdge(edge, *m_selbyo);}
-    EdgeColor GetEdgeColor(ECInstanceKeyCR);
+    EdgeQueue(Graph& g) : TableApi(g) {}
+    bool AddEdge(Edge const&);
+    bvector<Edge> GetEdgesOrderedByPriority() const;
+    bvector<Edge> GetEdgesByOutput(DgnElementId) const;
+    EdgeColor GetEdgeColor(ECInstanceKeyCR) const;
     void SetEdgeColor(ECInstanceKeyCR, EdgeColor);
     };
 
@@ -135,25 +141,35 @@ struct Graph::Nodes : Graph::TableApi
     DEFINE_T_SUPER(Graph::TableApi)
 
     private:
-        CachedStatementPtr m_insert, m_allInputsProcessed, m_anyOutputsProcessed, m_selectInDegree;
-        CachedStatementPtr m_incrementInDegree, m_incrementInputsProcessed, m_incrementOutputsProcessed;
-        CachedStatementPtr m_setDirect, m_selectDirect;
+        struct Node
+            {
+            int m_inDegree = 0;
+            int m_inputsProcessed = 0;
+            int m_outputsProcessed = 0;
+            bool m_inputWasDirectlyChanged = false;
+            int8_t m_directlyChanged = -1; // -1 until looked up in the txn's changed elements
+            };
+
+        std::unordered_map<uint64_t, Node> m_nodes;
+
+        Node* FindNode(DgnElementId nodeId) {auto it = m_nodes.find(nodeId.GetValue()); return m_nodes.end() == it ? nullptr : &it->second;}
+        bool QueryElementDirectlyChanged(DgnElementId);
 
     public:
-        Nodes(Graph&);
-        ~Nodes();
+        Nodes(Graph& graph) : T_Super(graph) {}
 
-        DbResult InsertNode(DgnElementId nodeId);
-        DbResult IncrementInDegree(DgnElementId nodeId);
+        //! @return true if the node was not in the graph yet
+        bool InsertNode(DgnElementId nodeId);
+        void IncrementInDegree(DgnElementId nodeId);
         int GetInDegree(DgnElementId);
 
         //! Increment the processed inputs counter. Input here is an edge ending at the given node.
         //! @param[in] nodeId   Node that the input (edge) points to.
-        DbResult IncrementInputsProcessed(DgnElementId nodeId);
+        void IncrementInputsProcessed(DgnElementId nodeId);
 
         //! Increment the processed outputs counter. Output here is an edge starting at the given node.
         //! @param[in] nodeId   Node that the output (edge) points from (start at).
-        DbResult IncrementOutputsProcessed(DgnElementId nodeId);
+        void IncrementOutputsProcessed(DgnElementId nodeId);
 
         //! Check if all inputs to the given node were processed.
         bool AllInputsProcessed(DgnElementId);
@@ -162,7 +178,7 @@ struct Graph::Nodes : Graph::TableApi
         bool AnyOutputsProcessed(DgnElementId);
 
         //! A direct change has been propagated to this node from one of its inputs
-        DbResult SetInputWasDirectlyChanged(DgnElementId);
+        void SetInputWasDirectlyChanged(DgnElementId);
 
         //! Were any direct changes propagated to any input of this node?
         bool WasInputDirectlyChanged(DgnElementId);
@@ -223,46 +239,14 @@ static void callJsEdgeFunc(Graph const& graph, Edge const& edge, Utf8CP methodNa
     DgnDb::CallJsFunction(jsTxns, methodName, {props});
 }
 
-/*---------------------------------------------------------------------------------**//**
-* @bsimethod
-+---------------+---------------+---------------+---------------+---------------+------*/
-Graph::Nodes::Nodes(Graph& graph) : T_Super(graph)
-    {
-    auto& db = GetDgnDb();
-    if (!db.TableExists(NODES))
-        db.CreateTable(NODES, "ElementId INTEGER PRIMARY KEY, InDegree INTEGER DEFAULT 0, InputsProcessed INTEGER DEFAULT 0, OutputsProcessed INTEGER DEFAULT 0, Direct INTEGER DEFAULT 0");
-
-    db.GetCachedStatement(m_insert, "INSERT OR IGNORE INTO " NODES " (ElementId) VALUES(?)");
-    db.GetCachedStatement(m_incrementInDegree, "UPDATE " NODES " SET InDegree=InDegree+1 WHERE ElementId=?");
-    db.GetCachedStatement(m_selectInDegree, "SELECT InDegree FROM " NODES " WHERE ElementId=?");
-    db.GetCachedStatement(m_setDirect, "UPDATE " NODES " SET Direct=1 WHERE ElementId=?");
-    db.GetCachedStatement(m_selectDirect, "SELECT Direct FROM " NODES " WHERE ElementId=?");
-    db.GetCachedStatement(m_allInputsProcessed, "SELECT EXISTS(SELECT 1 FROM " NODES " WHERE ElementId=? AND InDegree=InputsProcessed LIMIT 1)");
-    db.GetCachedStatement(m_anyOutputsProcessed, "SELECT EXISTS(SELECT 1 FROM " NODES " WHERE ElementId=? AND OutputsProcessed!=0 LIMIT 1)");
-    db.GetCachedStatement(m_incrementInputsProcessed, "UPDATE " NODES " SET InputsProcessed=InputsProcessed+1 WHERE ElementId=?");
-    db.GetCachedStatement(m_incrementOutputsProcessed, "UPDATE " NODES " SET OutputsProcessed=OutputsProcessed+1 WHERE ElementId=?");
-    }
-
-/*---------------------------------------------------------------------------------**//**
-* @bsimethod
-+---------------+---------------+---------------+---------------+---------------+------*/
-Graph::Nodes::~Nodes()
-    {
-    GetDgnDb().ExecuteSql("DELETE FROM " NODES);
-    }
-
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
 bool Graph::Nodes::AllInputsProcessed(DgnElementId nodeId)
     {
     BeAssert(nodeId.IsValid());
-
-    m_allInputsProcessed->Reset();
-    m_allInputsProcessed->BindId(1, nodeId);
-
-    auto stat = m_allInputsProcessed->Step();
-    return BE_SQLITE_ROW != stat ? false :  m_allInputsProcessed->GetValueBoolean(0);
+    auto node = FindNode(nodeId);
+    return nullptr != node && node->m_inDegree == node->m_inputsProcessed;
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -271,36 +255,27 @@ bool Graph::Nodes::AllInputsProcessed(DgnElementId nodeId)
 bool Graph::Nodes::AnyOutputsProcessed(DgnElementId nodeId)
     {
     BeAssert(nodeId.IsValid());
-
-    m_anyOutputsProcessed->Reset();
-    m_anyOutputsProcessed->BindId(1, nodeId);
-
-    auto stat = m_anyOutputsProcessed->Step();
-    return (BE_SQLITE_ROW != stat) ?  false :  m_anyOutputsProcessed->GetValueBoolean(0);
+    auto node = FindNode(nodeId);
+    return nullptr != node && 0 != node->m_outputsProcessed;
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-DbResult Graph::Nodes::InsertNode(DgnElementId nodeId)
+bool Graph::Nodes::InsertNode(DgnElementId nodeId)
     {
     BeAssert(nodeId.IsValid());
-
-    m_insert->Reset();
-    m_insert->BindId(1, nodeId);
-    return m_insert->Step();
+    return m_nodes.emplace(nodeId.GetValue(), Node()).second;
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-DbResult Graph::Nodes::IncrementInDegree(DgnElementId nodeId)
+void Graph::Nodes::IncrementInDegree(DgnElementId nodeId)
     {
     BeAssert(nodeId.IsValid());
-
-    m_incrementInDegree->Reset();
-    m_incrementInDegree->BindId(1, nodeId);
-    return m_incrementInDegree->Step();
+    if (auto node = FindNode(nodeId))
+        ++node->m_inDegree;
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -309,31 +284,18 @@ DbResult Graph::Nodes::IncrementInDegree(DgnElementId nodeId)
 int Graph::Nodes::GetInDegree(DgnElementId nodeId)
     {
     BeAssert(nodeId.IsValid());
-
-    m_selectInDegree->Reset();
-    m_selectInDegree->BindId(1, nodeId);
-
-    auto stat = m_selectInDegree->Step();
-    if (BE_SQLITE_ROW != stat)
-        return 0;
-
-    int inDegree = m_selectInDegree->GetValueInt(0);
-    if (inDegree < 0)
-        return 0;
-
-    return inDegree;
+    auto node = FindNode(nodeId);
+    return nullptr == node ? 0 : node->m_inDegree;
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-DbResult Graph::Nodes::SetInputWasDirectlyChanged(DgnElementId nodeId)
+void Graph::Nodes::SetInputWasDirectlyChanged(DgnElementId nodeId)
     {
     BeAssert(nodeId.IsValid());
-
-    m_setDirect->Reset();
-    m_setDirect->BindId(1, nodeId);
-    return m_setDirect->Step();
+    if (auto node = FindNode(nodeId))
+        node->m_inputWasDirectlyChanged = true;
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -342,39 +304,28 @@ DbResult Graph::Nodes::SetInputWasDirectlyChanged(DgnElementId nodeId)
 bool Graph::Nodes::WasInputDirectlyChanged(DgnElementId nodeId)
     {
     BeAssert(nodeId.IsValid());
-
-    m_selectDirect->Reset();
-    m_selectDirect->BindId(1, nodeId);
-
-    auto stat = m_selectDirect->Step();
-    if (BE_SQLITE_ROW != stat)
-        return 0;
-
-    return m_selectDirect->GetValueBoolean(0);
+    auto node = FindNode(nodeId);
+    return nullptr != node && node->m_inputWasDirectlyChanged;
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-DbResult Graph::Nodes::IncrementInputsProcessed(DgnElementId nodeId)
+void Graph::Nodes::IncrementInputsProcessed(DgnElementId nodeId)
     {
     BeAssert(nodeId.IsValid());
-
-    m_incrementInputsProcessed->Reset();
-    m_incrementInputsProcessed->BindId(1, nodeId);
-    return m_incrementInputsProcessed->Step();
+    if (auto node = FindNode(nodeId))
+        ++node->m_inputsProcessed;
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-DbResult Graph::Nodes::IncrementOutputsProcessed(DgnElementId nodeId)
+void Graph::Nodes::IncrementOutputsProcessed(DgnElementId nodeId)
     {
     BeAssert(nodeId.IsValid());
-
-    m_incrementOutputsProcessed->Reset();
-    m_incrementOutputsProcessed->BindId(1, nodeId);
-    return m_incrementOutputsProcessed->Step();
+    if (auto node = FindNode(nodeId))
+        ++node->m_outputsProcessed;
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -582,12 +533,8 @@ void Graph::WriteEdgeQueueToDot(BeFileNameCR dotFilename)
 
     fwprintf(fp, L"digraph G {\n");
 
-    m_edgeQueue->ResetSelectAllOrderedByPriority();
-    Edge edge;
-    while (m_edgeQueue->StepSelectAllOrderedByPriority(edge) == BE_SQLITE_ROW)
-        {
+    for (auto const& edge : m_edgeQueue->GetEdgesOrderedByPriority())
         WriteDotEdge(fp, edge);
-        }
 
     fwprintf(fp, L"}\n");
 
@@ -707,202 +654,152 @@ DbResult Graph::SetFailedEdgeStatusInDb(Edge const& edge, bool failed)
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-Graph::EdgeQueue::~EdgeQueue()
+bool Graph::EdgeQueue::AddEdge(Edge const& edge)
     {
-    GetDgnDb().ExecuteSql("DELETE FROM " EDGE_QUEUE);
-    }
+    // Don't add the edge to the graph if it's deferred
+    if (edge.IsDeferred())
+        return false;
 
-/*---------------------------------------------------------------------------------**//**
-* @bsimethod
-+---------------+---------------+---------------+---------------+---------------+------*/
-Graph::EdgeQueue::EdgeQueue(Graph& graph) : Graph::TableApi(graph)
-    {
-    auto& db = GetDgnDb();
-    if (!db.TableExists(EDGE_QUEUE))
+    BeAssert(edge.m_ein.IsValid() && edge.m_eout.IsValid() && edge.GetKey().IsValid());
+
+    if (!m_byKey.emplace(edge.GetKey(), m_entries.size()).second)
         {
-        db.CreateTable(EDGE_QUEUE,
-            "ECClassId INTEGER"
-            ", InstanceId INTEGER"
-            ", SourceId INTEGER"
-            ", TargetId INTEGER"
-            ", status INTEGER DEFAULT 0"
-            ", Priority INTEGER DEFAULT 0"
-            ", color INTEGER DEFAULT 0"
-            ", Deleted INTEGER DEFAULT 0 "
-            ", Direct INTEGER DEFAULT 0"
-            ", IsEDE INTEGER DEFAULT 0"
-            ", PRIMARY KEY(ECClassId, InstanceId)");
-
-        // The IsEDE column is 1 for edges created from ElementDrivesElement instances and 0 for all other kinds of edges.
-
-        // NB default color must be 0, i.e., EdgeColor::White
-
-        // The value of column 'Deleted' determines which method to call on the handler:
-        //  0 - call _OnRootChanged
-        //  1 - call _ProcessDeletedDependency
-
-        // *** WIP_GRAPH_PRIORITY
-        //      -- currently, the Priority column is NULL unless the user happens to populate it.
-        //          That is a problem, as we want the default priority to be order of creation.
-        //      -- must change dgn.0.02.ecschema.xml to put an index on the priority column, so that ORDER BY Priority will work
+        //  We already discovered this edge. Nothing to do.
+        EDGLOG(LOG_TRACE, "(KNOWN %s)", m_graph.FmtEdge(edge).c_str());
+        return false;
         }
 
-    db.GetCachedStatement(m_insert, "INSERT INTO " EDGE_QUEUE " (InstanceId,SourceId,TargetId,ECClassId,status,Priority,Deleted,IsEDE) VALUES(?,?,?,?,?,?,?,?)");
-    db.GetCachedStatement(m_setEdgeColor, "UPDATE " EDGE_QUEUE " SET color=? WHERE ECClassId=? AND InstanceId=?");
-    db.GetCachedStatement(m_getEdgeColor, "SELECT color FROM " EDGE_QUEUE " WHERE ECClassId=? AND InstanceId=?");
+    Entry entry;
+    entry.m_edge = edge;
+    entry.m_edge.m_direct = 0; // direct changes are tracked by the nodes, see Nodes::SetInputWasDirectlyChanged
+    m_entries.push_back(entry);
+    m_byOutput[edge.m_eout.GetValue()].push_back(m_entries.size() - 1);
 
-    // NB: All select statements must specify the same columns and in the same order, as they are all processed by a single function, "SelectEdge"
-
-                  // 0          1        2        3         4      5        6       7      8
-#define Q_SEL_COLS " InstanceId,SourceId,TargetId,ECClassId,status,Priority,Deleted,Direct,IsEDE"
-#define Q_TABLES   " " EDGE_QUEUE " "
+    if (m_graph.CheckDirection(edge) != BSISUCCESS)
+        return false;
 
-    db.GetCachedStatement(m_select, "SELECT " Q_SEL_COLS " FROM " Q_TABLES);
-    db.GetCachedStatement(m_selbyp, "SELECT " Q_SEL_COLS " FROM " Q_TABLES " ORDER BY Priority DESC");
-    db.GetCachedStatement(m_selbyo, "SELECT " Q_SEL_COLS " FROM " Q_TABLES " WHERE (TargetId=?) ORDER BY Priority DESC");
+    BeAssert(edge.IsValid());
+    return true;
     }
 
 /*---------------------------------------------------------------------------------**//**
+* Edges with higher priority first, edges with equal priority in the order they were discovered.
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-DbResult Graph::EdgeQueue::SelectEdge(Edge& edge, Statement& stmt)
+bvector<Edge> Graph::EdgeQueue::GetEdges(bvector<size_t> indices) const
     {
-    auto stat = stmt.Step();
-    if (BE_SQLITE_ROW != stat)
-        return stat;
-
-    auto instanceId = stmt.GetValueId<ECInstanceId>(0);
-    edge.m_ein = stmt.GetValueId<DgnElementId>(1);
-    edge.m_eout = stmt.GetValueId<DgnElementId>(2);
-    auto relClassId = stmt.GetValueId<ECClassId>(3);
-    edge.m_status = stmt.GetValueInt(4);
-    edge.m_priority = stmt.GetValueInt64(5);
-    edge.m_deleted = stmt.GetValueBoolean(6);
-    edge.m_direct = stmt.GetValueBoolean(7);
-    edge.m_isEDE = stmt.GetValueBoolean(8);
-
-    edge.m_instanceKey = ECInstanceKey(relClassId, instanceId);
+    std::stable_sort(indices.begin(), indices.end(), [&](size_t lhs, size_t rhs) {return m_entries[lhs].m_edge.m_priority > m_entries[rhs].m_edge.m_priority;});
 
-    BeAssert(edge.IsValid());
-    return BE_SQLITE_ROW;
+    bvector<Edge> edges;
+    edges.reserve(indices.size());
+    for (auto index : indices)
+        edges.push_back(m_entries[index].m_edge);
+    return edges;
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-DbResult Graph::EdgeQueue::BindSelectByOutput(DgnElementId eout)
+bvector<Edge> Graph::EdgeQueue::GetEdgesOrderedByPriority() const
     {
-    m_selbyo->Reset();
-    return m_selbyo->BindId(1, eout);
+    bvector<size_t> indices(m_entries.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    return GetEdges(std::move(indices));
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-DbResult Graph::EdgeQueue::AddEdge(Edge& edge)
+bvector<Edge> Graph::EdgeQueue::GetEdgesByOutput(DgnElementId eout) const
     {
-    // Don't add the edge to the graph if it's deferred
-    if (edge.IsDeferred())
-        return BE_SQLITE_DONE;
-
-    BeAssert(edge.m_ein.IsValid() && edge.m_eout.IsValid() && edge.GetKey().IsValid());
-
-    //  Add edge+path to queue
-    m_insert->Reset();
-    m_insert->BindId(1, edge.GetKey().GetInstanceId());
-    m_insert->BindId(2, edge.m_ein);
-    m_insert->BindId(3, edge.m_eout);
-    m_insert->BindId(4, edge.GetKey().GetClassId());
-    m_insert->BindInt(5, edge.m_status);
-    m_insert->BindInt(6, static_cast<int>(edge.m_priority));
-    m_insert->BindBoolean(7, edge.m_deleted);
-    m_insert->BindBoolean(8, edge.m_isEDE);
-    auto stat = m_insert->Step();
-
-    if (BeSQLiteLib::IsConstraintDbResult(stat))
-        {
-        //  We already discovered this edge. Nothing to do.
-        EDGLOG(LOG_TRACE, "(KNOWN %s)", m_graph.FmtEdge(edge).c_str());
-        return stat;
-        }
-
-    if (m_graph.CheckDirection(edge) != BSISUCCESS)
-        return BE_SQLITE_DONE;
-
-    // EDGLOG(LOG_TRACE, "FOUND %s", m_graph.FmtEdge(edge).c_str());
-
-    BeAssert(edge.IsValid());
-    return BE_SQLITE_DONE;
+    auto it = m_byOutput.find(eout.GetValue());
+    if (m_byOutput.end() == it)
+        return bvector<Edge>();
+    return GetEdges(it->second);
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-Graph::EdgeColor Graph::EdgeQueue::GetEdgeColor(ECInstanceKeyCR key)
+Graph::EdgeColor Graph::EdgeQueue::GetEdgeColor(ECInstanceKeyCR key) const
     {
-    m_getEdgeColor->Reset();
-    m_getEdgeColor->BindId(1, key.GetClassId());
-    m_getEdgeColor->BindId(2, key.GetInstanceId());
-    if (m_getEdgeColor->Step() != BE_SQLITE_ROW)
-        return EdgeColor::White;
-    return (EdgeColor)m_getEdgeColor->GetValueInt(0);
+    auto it = m_byKey.find(key);
+    return m_byKey.end() == it ? EdgeColor::White : m_entries[it->second].m_color;
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
-+---------------+---------------+---------------+------c---------+---------------+------*/
++---------------+---------------+---------------+---------------+---------------+------*/
 void Graph::EdgeQueue::SetEdgeColor(ECInstanceKeyCR key, EdgeColor color)
     {
-    m_setEdgeColor->Reset();
-    m_setEdgeColor->BindInt(1,(int)color);
-    m_setEdgeColor->BindId(2, key.GetClassId());
-    m_setEdgeColor->BindId(3, key.GetInstanceId());
-    auto stat = m_setEdgeColor->Step();
-    UNUSED_VARIABLE(stat);
-    BeAssert(stat == BE_SQLITE_DONE);
+    auto it = m_byKey.find(key);
+    BeAssert(m_byKey.end() != it);
+    if (m_byKey.end() != it)
+        m_entries[it->second].m_color = color;
     }
 
 /*---------------------------------------------------------------------------------**//**
+* Depth-first walk up the suppliers of an edge, firing each edge once all the edges that
+* output its input have fired. Uses an explicit stack, since long chains of dependencies
+* would otherwise overflow the call stack.
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-void Graph::InvokeHandlersInTopologicalOrder_OneGraph(Edge const& edge, bvector<Edge> const& pathToSupplier)
+void Graph::InvokeHandlersInTopologicalOrder_OneGraph(Edge const& root, bvector<Edge> const& pathToRoot)
     {
     auto& edges = *m_edgeQueue;
 
-    //  Detect if we have already processed this edge ... or are in the middle of processing it.
-    auto color = edges.GetEdgeColor(edge.GetKey());
-    if (color != EdgeColor::White)
+    struct Frame
         {
-        if (color == EdgeColor::Gray)
+        Edge m_edge;
+        bvector<Edge> m_suppliers;
+        size_t m_nextSupplier = 0;
+        };
+    bvector<Frame> stack;
+
+    auto schedule = [&](Edge const& edge)
+        {
+        //  Detect if we have already processed this edge ... or are in the middle of processing it.
+        auto color = edges.GetEdgeColor(edge.GetKey());
+        if (color != EdgeColor::White)
             {
-            EDGLOGGER.errorv("EDE: Cycle detected: %s", FmtCyclePath(edge, pathToSupplier).c_str());
-            SetFailedEdgeStatusInDb(edge, true); // mark at least this edge as failed. maybe we should mark the entire cycle??
+            if (color == EdgeColor::Gray)
+                {
+                bvector<Edge> pathToSupplier(pathToRoot);
+                for (auto const& frame : stack)
+                    pathToSupplier.push_back(frame.m_edge);
+                EDGLOGGER.errorv("EDE: Cycle detected: %s", FmtCyclePath(edge, pathToSupplier).c_str());
+                SetFailedEdgeStatusInDb(edge, true); // mark at least this edge as failed. maybe we should mark the entire cycle??
+                }
+            return;
             }
-        return;
-        }
-
-    edges.SetEdgeColor(edge.GetKey(), EdgeColor::Gray);
 
-    // Schedule suppliers of edge's input first.
-    auto pathToEdge(pathToSupplier);
-    pathToEdge.push_back(edge);
+        edges.SetEdgeColor(edge.GetKey(), EdgeColor::Gray);
 
-    edges.BindSelectByOutput(edge.m_ein);      // I want find edges that OUTPUT my input
+        // Schedule suppliers of edge's input first - i.e., edges that OUTPUT my input
+        Frame frame;
+        frame.m_edge = edge;
+        frame.m_suppliers = edges.GetEdgesByOutput(edge.m_ein);
+        stack.push_back(std::move(frame));
+        };
 
-    bvector<Edge> suppliers;
+    schedule(root);
+    while (!stack.empty())
         {
-        Edge supplier;
-        while (edges.StepSelectByOutput(supplier) == BE_SQLITE_ROW)
-            suppliers.push_back(supplier);
-        }
-
-    for (auto const& supplier : suppliers)
-        InvokeHandlersInTopologicalOrder_OneGraph(supplier, pathToEdge);
+        auto& top = stack.back();
+        if (top.m_nextSupplier < top.m_suppliers.size())
+            {
+            Edge supplier = top.m_suppliers[top.m_nextSupplier++];
+            schedule(supplier);
+            continue;
+            }
 
-    //  edge can now be fired.
-    edges.SetEdgeColor(edge.GetKey(), EdgeColor::Black);
+        //  edge can now be fired.
+        Edge edge = top.m_edge;
+        stack.pop_back();
+        edges.SetEdgeColor(edge.GetKey(), EdgeColor::Black);
 
-    InvokeHandler(edge);
+        InvokeHandler(edge);
+        }
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -934,9 +831,7 @@ void Graph::InvokeHandlerForDeletedRelationship(ECInstanceKeyCR key)
 void Graph::InvokeHandlersInTopologicalOrder()
     {
     // This is a total topological sort of the Edge queue.
-    m_edgeQueue->ResetSelectAllOrderedByPriority();
-    Edge edge;
-    while (m_edgeQueue->StepSelectAllOrderedByPriority(edge) == BE_SQLITE_ROW)
+    for (auto const& edge : m_edgeQueue->GetEdgesOrderedByPriority())
         InvokeHandlersInTopologicalOrder_OneGraph(edge, bvector<Edge>());
 
     m_txnMgr.ElementDependencies().m_deletedRels.clear();
@@ -950,7 +845,7 @@ Graph::ElementDrivesElement::ElementDrivesElement(Graph& graph) : TableApi(graph
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-bool Graph::Nodes::WasElementDirectlyChanged(DgnElementId eid)
+bool Graph::Nodes::QueryElementDirectlyChanged(DgnElementId eid)
     {
     auto stmt = GetTxnMgr().GetTxnStatement("SELECT COUNT(*) FROM " TEMP_TABLE(TXN_TABLE_Elements) " WHERE ElementId=?");
     stmt->BindId(1, eid);
@@ -958,6 +853,21 @@ bool Graph::Nodes::WasElementDirectlyChanged(DgnElementId eid)
     return stmt->GetValueInt(0) != 0;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* The txn's changed elements don't change while the graph is processed, so the answer is remembered per node.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+bool Graph::Nodes::WasElementDirectlyChanged(DgnElementId eid)
+    {
+    auto node = FindNode(eid);
+    if (nullptr == node)
+        return QueryElementDirectlyChanged(eid);
+
+    if (node->m_directlyChanged < 0)
+        node->m_directlyChanged = QueryElementDirectlyChanged(eid) ? 1 : 0;
+    return 0 != node->m_directlyChanged;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -1241,8 +1151,8 @@ DbResult Graph::ChildPropagatesChangesToParent::StepSelectByChild(Edge& edge)
 +---------------+---------------+---------------+---------------+---------------+------*/
 void Graph::OnDiscoverNodes(Edge const& edge)
     {
-    auto rcin = m_nodes->InsertNode(edge.m_ein);
-    auto rcout = m_nodes->InsertNode(edge.m_eout);
+    bool newIn = m_nodes->InsertNode(edge.m_ein);
+    bool newOut = m_nodes->InsertNode(edge.m_eout);
 
     m_nodes->IncrementInDegree(edge.m_eout);
 
@@ -1252,9 +1162,9 @@ void Graph::OnDiscoverNodes(Edge const& edge)
         m_nodes->SetInputWasDirectlyChanged(edge.m_eout);
         }
 
-    if (!BeSQLiteLib::IsConstraintDbResult(rcin))
+    if (newIn)
         EDGLOG(LOG_TRACE, "DISCOVERED %s", FmtElement(edge.m_ein).c_str());
-    if (!BeSQLiteLib::IsConstraintDbResult(rcout))
+    if (newOut)
         EDGLOG(LOG_TRACE, "DISCOVERED %s", FmtElement(edge.m_eout).c_str());
     }
 
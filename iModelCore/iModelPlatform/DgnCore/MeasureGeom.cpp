@@ -3,6 +3,7 @@
 * See LICENSE.md in the repository root for full copyright notice.
 *--------------------------------------------------------------------------------------------*/
 #include <DgnPlatformInternal.h>
+#include <folly/BeFolly.h>
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
@@ -1079,6 +1080,29 @@ BentleyStatus MeasureGeomCollector::Process (GeometrySourceCR source)
     return GetOperationStatus ();
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void MeasureGeomCollector::Accumulate (MeasureGeomCollector const& other)
+    {
+    BeAssert (m_opType == other.m_opType);
+
+    m_amountSum += other.m_amountSum;
+    m_volumeSum += other.m_volumeSum;
+    m_areaSum += other.m_areaSum;
+    m_perimeterSum += other.m_perimeterSum;
+    m_lengthSum += other.m_lengthSum;
+    m_closureError += other.m_closureError;
+
+    // First and second moments are about the global origin, so they simply add...
+    m_moment1.Add (other.m_moment1);
+    m_moment2.Add (other.m_moment2);
+
+    m_iXY += other.m_iXY;
+    m_iXZ += other.m_iXZ;
+    m_iYZ += other.m_iYZ;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -1105,20 +1129,72 @@ void MeasureGeomCollector::DoMeasure(BeJsValue out, BeJsConst in, DgnDbR db, ICa
         return;
 
     OperationType opType = input.GetOperation();
-    MeasureGeomCollectorPtr collector = MeasureGeomCollector::Create(opType);
+    bvector<DgnElementId> candidateIds(candidates.begin(), candidates.end());
 
-    for (DgnElementId candidateId : candidates)
+    // The candidates are split round-robin into a fixed number of slices, each measured into its own collector, so the
+    // result does not depend on which thread measured which slice.
+    BeFolly::ThreadPool& threadPool = BeFolly::ThreadPool::GetCpuPool();
+    size_t sliceCount = input.IsParallel() ? std::min(std::max((size_t) 1, threadPool.size()), candidateIds.size()) : 1;
+    bvector<MeasureGeomCollectorPtr> collectors;
+    bvector<uint8_t> succeeded(sliceCount, 0); // one byte per slice, so threads don't share a packed word
+
+    for (size_t i = 0; i < sliceCount; ++i)
+        collectors.push_back(MeasureGeomCollector::Create(opType));
+
+    // Elements are loaded through the element cache, which may be shared between threads; everything else about
+    // measuring an element is independent.
+    auto measureSlice = [&](size_t slice)
         {
-        if (cancel.IsValid() && cancel->IsCanceled())
-            break; // Return what we've processed so far...
+        MeasureGeomCollector& collector = *collectors[slice];
+
+        for (size_t i = slice; i < candidateIds.size(); i += sliceCount)
+            {
+            if (cancel.IsValid() && cancel->IsCanceled())
+                break; // Return what we've processed so far...
+
+            DgnElementCPtr candidateElement = db.Elements().GetElement(candidateIds[i]);
+            GeometrySourceCP candidateSource = candidateElement.IsValid() ? candidateElement->ToGeometrySource() : nullptr;
 
-        DgnElementCPtr candidateElement = db.Elements().GetElement(candidateId);
-        GeometrySourceCP candidateSource = candidateElement.IsValid() ? candidateElement->ToGeometrySource() : nullptr;
+            if (nullptr == candidateSource)
+                continue;
 
-        if (nullptr == candidateSource)
-            continue;
+            if (SUCCESS == collector.Process(*candidateSource))
+                succeeded[slice] = 1;
+            }
+        };
+
+    // The calling thread and the pool both take slices until none are left, so the caller never waits on a slice
+    // that is still queued behind other work in the pool.
+    std::atomic<size_t> nextSlice(0);
+    auto measureSlices = [&]()
+        {
+        for (size_t slice = nextSlice++; slice < sliceCount; slice = nextSlice++)
+            measureSlice(slice);
+        };
+
+    bvector<folly::Future<folly::Unit>> helpers;
+    for (size_t i = 1; i < sliceCount; ++i)
+        {
+        helpers.push_back(folly::via(&threadPool, [&]()
+            {
+            // Needed to handle errors and clear thread exclusion.
+            RefCountedPtr<IRefCounted> errorHandler = T_HOST.GetBRepGeometryAdmin()._CreateWorkerThreadErrorHandler();
+            measureSlices();
+            }));
+        }
+
+    measureSlices();
+    for (auto& helper : helpers)
+        helper.wait();
+
+    // Combine in slice order so the result does not depend on how the threads were scheduled...
+    MeasureGeomCollectorPtr collector = collectors[0];
+    for (size_t i = 0; i < sliceCount; ++i)
+        {
+        if (0 != i)
+            collector->Accumulate(*collectors[i]);
 
-        if (SUCCESS == collector->Process(*candidateSource))
+        if (succeeded[i])
             output.SetStatus(SUCCESS);
         }
 
@@ -3,6 +3,15 @@
 * See LICENSE.md in the repository root for full copyright notice.
 *--------------------------------------------------------------------------------------------*/
 #include <DgnPlatformInternal.h>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define RANGEINDEX_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define RANGEINDEX_NEON
+#endif
 
 using namespace RangeIndex;
 
@@ -144,15 +153,151 @@ static double checkSeparation(SplitEntryP entries, size_t count, SplitAxis axis)
 
     return  maxSeparation;
     }
+
+static const size_t PARALLEL_BULKLOAD_MIN_ENTRIES = 50000;
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static inline double getCenter(FBoxCR range, SplitAxis axis)
+    {
+    switch (axis)
+        {
+        case X_AXIS: return (double) range.Low().x + range.High().x;
+        case Y_AXIS: return (double) range.Low().y + range.High().y;
+        default:     return (double) range.Low().z + range.High().z;
+        }
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Sort-Tile-Recursive ordering: sort by the center along one axis, cut into slices that hold a whole number of nodes
+* and order each slice by the next axis. Afterwards every run of nodeSize consecutive items forms a compact tile.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+template<typename T, typename GetRange>
+static void tileForPacking(T* begin, T* end, size_t nodeSize, int dimensions, int axis, bool parallel, GetRange const& getRange)
+    {
+    std::sort(begin, end, [&](T const& lhs, T const& rhs) {return getCenter(getRange(lhs), (SplitAxis) axis) < getCenter(getRange(rhs), (SplitAxis) axis);});
+    if (axis + 1 >= dimensions)
+        return;
+
+    size_t count = end - begin;
+    size_t nodes = (count + nodeSize - 1) / nodeSize;
+    size_t slices = (size_t) ceil(pow((double) nodes, 1.0 / (dimensions - axis)));
+    size_t sliceSize = nodeSize * ((nodes + slices - 1) / slices);
+
+    auto tileSlices = [&](size_t first, size_t stride)
+        {
+        for (size_t start = first * sliceSize; start < count; start += stride * sliceSize)
+            tileForPacking(begin + start, begin + std::min(start + sliceSize, count), nodeSize, dimensions, axis + 1, false, getRange);
+        };
+
+    size_t threadCount = parallel ? std::min((size_t) std::max(1u, std::thread::hardware_concurrency()), slices) : 1;
+    if (threadCount <= 1)
+        {
+        tileSlices(0, 1);
+        return;
+        }
+
+    // slices are disjoint ranges of the array, so they can be ordered concurrently.
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; ++i)
+        threads.emplace_back(tileSlices, i, threadCount);
+    tileSlices(0, threadCount);
+    for (auto& thread : threads)
+        thread.join();
+    }
+
+// the order of the float lanes of a leaf. Each lane holds one coordinate of every entry.
+enum LaneIndex {LANE_LowX = 0, LANE_LowY, LANE_LowZ, LANE_HighX, LANE_HighY, LANE_HighZ, LANE_Count};
+static const size_t LANE_WIDTH = 4;
+
+//=======================================================================================
+// Tests LANE_WIDTH consecutive leaf entries against a query box at once, using the same
+// inclusive comparisons as Node::Overlaps. Z is ignored for 2d trees.
+// @bsiclass
+//=======================================================================================
+struct OverlapKernel
+{
+#if defined(RANGEINDEX_SSE2)
+    __m128 m_low[3], m_high[3];
+    int m_axes;
+
+    OverlapKernel(FBoxCR box, bool is3d) : m_axes(is3d ? 3 : 2)
+        {
+        m_low[0] = _mm_set1_ps(box.Low().x); m_low[1] = _mm_set1_ps(box.Low().y); m_low[2] = _mm_set1_ps(box.Low().z);
+        m_high[0] = _mm_set1_ps(box.High().x); m_high[1] = _mm_set1_ps(box.High().y); m_high[2] = _mm_set1_ps(box.High().z);
+        }
+
+    unsigned Test(float const* lanes, size_t stride, size_t first) const
+        {
+        __m128 result = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int axis = 0; axis < m_axes; ++axis)
+            {
+            __m128 low = _mm_loadu_ps(lanes + (LANE_LowX + axis) * stride + first);
+            __m128 high = _mm_loadu_ps(lanes + (LANE_HighX + axis) * stride + first);
+            result = _mm_and_ps(result, _mm_and_ps(_mm_cmple_ps(low, m_high[axis]), _mm_cmpge_ps(high, m_low[axis])));
+            }
+        return (unsigned) _mm_movemask_ps(result);
+        }
+#elif defined(RANGEINDEX_NEON)
+    float32x4_t m_low[3], m_high[3];
+    int m_axes;
+
+    OverlapKernel(FBoxCR box, bool is3d) : m_axes(is3d ? 3 : 2)
+        {
+        m_low[0] = vdupq_n_f32(box.Low().x); m_low[1] = vdupq_n_f32(box.Low().y); m_low[2] = vdupq_n_f32(box.Low().z);
+        m_high[0] = vdupq_n_f32(box.High().x); m_high[1] = vdupq_n_f32(box.High().y); m_high[2] = vdupq_n_f32(box.High().z);
+        }
+
+    unsigned Test(float const* lanes, size_t stride, size_t first) const
+        {
+        static const uint32_t s_bits[LANE_WIDTH] = {1, 2, 4, 8};
+        uint32x4_t result = vdupq_n_u32(0xffffffff);
+        for (int axis = 0; axis < m_axes; ++axis)
+            {
+            float32x4_t low = vld1q_f32(lanes + (LANE_LowX + axis) * stride + first);
+            float32x4_t high = vld1q_f32(lanes + (LANE_HighX + axis) * stride + first);
+            result = vandq_u32(result, vandq_u32(vcleq_f32(low, m_high[axis]), vcgeq_f32(high, m_low[axis])));
+            }
+        return vaddvq_u32(vandq_u32(result, vld1q_u32(s_bits)));
+        }
+#else
+    float m_low[3], m_high[3];
+    int m_axes;
+
+    OverlapKernel(FBoxCR box, bool is3d) : m_axes(is3d ? 3 : 2)
+        {
+        m_low[0] = box.Low().x; m_low[1] = box.Low().y; m_low[2] = box.Low().z;
+        m_high[0] = box.High().x; m_high[1] = box.High().y; m_high[2] = box.High().z;
+        }
+
+    unsigned Test(float const* lanes, size_t stride, size_t first) const
+        {
+        unsigned result = (1 << LANE_WIDTH) - 1;
+        for (int axis = 0; axis < m_axes; ++axis)
+            {
+            float const* low = lanes + (LANE_LowX + axis) * stride + first;
+            float const* high = lanes + (LANE_HighX + axis) * stride + first;
+            for (size_t i = 0; i < LANE_WIDTH; ++i)
+                {
+                if (low[i] > m_high[axis] || high[i] < m_low[axis])
+                    result &= ~(1 << i);
+                }
+            }
+        return result;
+        }
+#endif
+};
 END_UNNAMED_NAMESPACE
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-Traverser::Stop Tree::Node::Traverse(Traverser& traverser, TreeCR tree, bool is3d)
+Traverser::Stop Tree::Node::Traverse(Traverser& traverser, TreeCR tree, bool is3d, FBoxCP queryBox)
     {
     LeafNodeP leaf = ToLeaf();
-    return leaf ? leaf->Traverse(traverser, tree, is3d) : ((InternalNodeP) this)->Traverse(traverser, tree, is3d);
+    return leaf ? leaf->Traverse(traverser, tree, is3d, queryBox) : ((InternalNodeP) this)->Traverse(traverser, tree, is3d, queryBox);
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -390,13 +535,16 @@ size_t Tree::InternalNode::GetElementCount()
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-Traverser::Stop Tree::InternalNode::Traverse(Traverser& traverser, TreeCR tree, bool is3d)
+Traverser::Stop Tree::InternalNode::Traverse(Traverser& traverser, TreeCR tree, bool is3d, FBoxCP queryBox)
     {
     if (Traverser::Accept::Yes == traverser._CheckRangeTreeNode(GetRange(), is3d))
         {
         for (auto curr = &m_firstChild[0]; curr < m_endChild; ++curr)
             {
-            if (Traverser::Stop::Yes == (*curr)->Traverse(traverser, tree, is3d))
+            if (nullptr != queryBox && !(*curr)->Overlaps(*queryBox))
+                continue;
+
+            if (Traverser::Stop::Yes == (*curr)->Traverse(traverser, tree, is3d, queryBox))
                 return Traverser::Stop::Yes;
             }
         }
@@ -404,6 +552,21 @@ Traverser::Stop Tree::InternalNode::Traverse(Traverser& traverser, TreeCR tree,
     return Traverser::Stop::No;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void Tree::LeafNode::SetLanes(size_t index, FBoxCR range, TreeCR tree)
+    {
+    float* lanes = GetLanes(tree);
+    size_t stride = tree.m_laneStride;
+    lanes[LANE_LowX * stride + index] = range.Low().x;
+    lanes[LANE_LowY * stride + index] = range.Low().y;
+    lanes[LANE_LowZ * stride + index] = range.Low().z;
+    lanes[LANE_HighX * stride + index] = range.High().x;
+    lanes[LANE_HighY * stride + index] = range.High().y;
+    lanes[LANE_HighZ * stride + index] = range.High().z;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -411,6 +574,7 @@ void Tree::LeafNode::AddEntryToLeaf(Entry const& entry, TreeR root)
     {
     m_nodeRange.Extend(entry.m_range);
 
+    SetLanes(GetEntryCount(), entry.m_range, root);
     *m_endChild = entry;
     ++m_endChild;
 
@@ -449,7 +613,15 @@ bool Tree::LeafNode::DropElement(DgnElementId id, TreeR root)
 
         FBox range = curr->m_range;
         if (curr+1 < m_endChild)
+            {
+            size_t index = curr - m_firstChild;
+            size_t following = (m_endChild - curr) - 1;
+            float* lanes = GetLanes(root);
+            for (size_t lane = 0; lane < LANE_Count; ++lane)
+                memmove(lanes + lane * root.m_laneStride + index, lanes + lane * root.m_laneStride + index + 1, following * sizeof(float));
+
             memmove((void*)curr, (void*)(curr + 1), (m_endChild - curr) * sizeof(Entry));
+            }
         // TODO: Entry is not trivially copyable, so using memmove here is potentially unsafe. 
         // This should be revisited to ensure proper handling of non-trivial members or replaced with a safer alternative.
 
@@ -539,16 +711,50 @@ void Tree::LeafNode::SplitLeafNode(TreeR root)
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-Traverser::Stop Tree::LeafNode::Traverse(Traverser& traverser, TreeCR tree, bool is3d)
+Traverser::Stop Tree::LeafNode::Traverse(Traverser& traverser, TreeCR tree, bool is3d, FBoxCP queryBox)
     {
     if (Traverser::Accept::Yes == traverser._CheckRangeTreeNode(GetRange(), is3d))
         {
+        if (nullptr != queryBox)
+            return TraverseOverlapping(traverser, tree, *queryBox);
+
         for (Entry* curr = &m_firstChild[0]; curr < m_endChild; ++curr)
             {
             if (Traverser::Stop::Yes == traverser._VisitRangeTreeEntry(*curr))
                 return Traverser::Stop::Yes;
 
-            if (tree.m_writeRequest && traverser._AbortOnWriteRequest())
+            if (tree.m_writeRequest.load(std::memory_order_relaxed) && traverser._AbortOnWriteRequest())
+                return Traverser::Stop::Yes;
+            }
+        }
+
+    return Traverser::Stop::No;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Visit only the entries that overlap the query box, testing LANE_WIDTH of them at a time.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+Traverser::Stop Tree::LeafNode::TraverseOverlapping(Traverser& traverser, TreeCR tree, FBoxCR queryBox)
+    {
+    OverlapKernel kernel(queryBox, m_is3d);
+    float const* lanes = GetLanes(tree);
+    size_t count = GetEntryCount();
+    for (size_t first = 0; first < count; first += LANE_WIDTH)
+        {
+        unsigned mask = kernel.Test(lanes, tree.m_laneStride, first);
+        if (count - first < LANE_WIDTH)
+            mask &= (1 << (count - first)) - 1; // the lanes past the last entry are not initialized
+
+        for (size_t i = first; 0 != mask; ++i, mask >>= 1)
+            {
+            if (0 == (mask & 1))
+                continue;
+
+            if (Traverser::Stop::Yes == traverser._VisitRangeTreeEntry(m_firstChild[i]))
+                return Traverser::Stop::Yes;
+
+            if (tree.m_writeRequest.load(std::memory_order_relaxed) && traverser._AbortOnWriteRequest())
                 return Traverser::Stop::Yes;
             }
         }
@@ -556,6 +762,108 @@ Traverser::Stop Tree::LeafNode::Traverse(Traverser& traverser, TreeCR tree, bool
     return Traverser::Stop::No;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* Each thread sticks to one reader slot, handed out round-robin the first time the thread reads any tree.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+std::atomic<int>& Tree::GetReaderSlot() const
+    {
+    static std::atomic<unsigned> s_nextSlot(0);
+    thread_local unsigned t_slot = s_nextSlot.fetch_add(1, std::memory_order_relaxed) % READER_SLOTS;
+    return m_readers[t_slot].m_count;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+bool Tree::HasReaders() const
+    {
+    for (auto const& slot : m_readers)
+        {
+        if (slot.m_count.load() > 0)
+            return true;
+        }
+    return false;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* The reader announces itself in its slot and then checks for a writer. The writer raises its flag and then
+* checks the slots. Both use sequentially consistent operations, so at least one of them sees the other: either
+* the reader backs off until the writer is done, or the writer backs off until the readers are gone.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+Tree::ReadLock::ReadLock(TreeCR tree) : m_tree(tree), m_slot(tree.GetReaderSlot())
+    {
+    while (true)
+        {
+        m_slot.fetch_add(1);
+        if (!tree.m_writeActive.load())
+            return;
+
+        // a writer is active or waiting for readers to drain. Back off and wait for it to finish.
+        m_slot.fetch_sub(1);
+        BeMutexHolder holder(tree.m_cv.GetMutex());
+        tree.m_cv.notify_all();
+        while (tree.m_writeActive.load())
+            tree.m_cv.InfiniteWait(holder);
+        }
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+Tree::ReadLock::~ReadLock()
+    {
+    BeAssert(m_slot.load() > 0);
+    m_slot.fetch_sub(1);
+    if (m_tree.m_writeRequest.load() || m_tree.m_writeActive.load())
+        {
+        BeMutexHolder holder(m_tree.m_cv.GetMutex());
+        m_tree.m_cv.notify_all();
+        }
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+Tree::WriteLock::WriteLock(TreeR tree) : m_tree(tree)
+    {
+    BeMutexHolder holder(tree.m_cv.GetMutex());
+    while (tree.m_hasWriter)
+        tree.m_cv.InfiniteWait(holder);
+    tree.m_hasWriter = true;
+
+    while (true)
+        {
+        tree.m_writeActive.store(true);
+        if (!tree.HasReaders())
+            break;
+
+        // Readers are still inside. Lower the flag again so that readers never wait on a writer that is waiting on
+        // them (a thread may take a second ReadLock while holding one), and wait for the readers to leave.
+        tree.m_writeActive.store(false);
+        tree.m_writeRequest.store(true);
+        tree.m_cv.notify_all();
+        while (tree.HasReaders())
+            tree.m_cv.InfiniteWait(holder);
+        }
+    tree.m_writeRequest.store(false);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+Tree::WriteLock::~WriteLock()
+    {
+        {
+        BeMutexHolder holder(m_tree.m_cv.GetMutex());
+        BeAssert(m_tree.m_writeActive.load() && m_tree.m_hasWriter);
+        m_tree.m_writeActive.store(false);
+        m_tree.m_hasWriter = false;
+        }
+    m_tree.m_cv.notify_all();
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -590,6 +898,61 @@ void Tree::AddEntry(Entry const& entry)
         ((InternalNodeP)m_root)->AddEntry(entry, *this);
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+BentleyStatus Tree::BulkLoad(bvector<Entry>& entries, bool parallel)
+    {
+    WriteLock lock(*this);
+    if (!m_leafIdx.empty())
+        return ERROR;
+
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [](Entry const& entry) {return !entry.m_range.IsValid();}), entries.end());
+    if (entries.empty())
+        return SUCCESS;
+
+    if (nullptr != m_root) // an empty tree holds at most one empty leaf
+        {
+        BeAssert(m_root->IsLeaf());
+        FreeLeafNode(m_root->ToLeaf());
+        m_root = nullptr;
+        }
+
+    const int dimensions = m_is3d ? 3 : 2;
+    tileForPacking(entries.data(), entries.data() + entries.size(), m_leafNodeSize, dimensions, X_AXIS,
+        parallel && entries.size() >= PARALLEL_BULKLOAD_MIN_ENTRIES, [](Entry const& entry) -> FBoxCR {return entry.m_range;});
+
+    bvector<Node*> level;
+    level.reserve(entries.size() / m_leafNodeSize + 1);
+    for (size_t start = 0; start < entries.size(); start += m_leafNodeSize)
+        {
+        LeafNodeP leaf = AllocateLeafNode();
+        for (size_t i = start; i < std::min(start + m_leafNodeSize, entries.size()); ++i)
+            leaf->AddEntryToLeaf(entries[i], *this);
+        level.push_back(leaf);
+        }
+
+    // pack each level into full parents until a single root remains. Nodes are never filled past their size, so no splits happen here.
+    while (level.size() > 1)
+        {
+        tileForPacking(level.data(), level.data() + level.size(), m_internalNodeSize, dimensions, X_AXIS, false, [](Node* const& node) -> FBoxCR {return node->GetRange();});
+
+        bvector<Node*> parents;
+        parents.reserve(level.size() / m_internalNodeSize + 1);
+        for (size_t start = 0; start < level.size(); start += m_internalNodeSize)
+            {
+            InternalNodeP parent = AllocateInternalNode();
+            for (size_t i = start; i < std::min(start + m_internalNodeSize, level.size()); ++i)
+                parent->AddInternalNode(level[i], *this);
+            parents.push_back(parent);
+            }
+        level.swap(parents);
+        }
+
+    m_root = level.front();
+    return SUCCESS;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -630,7 +993,8 @@ void Tree::SetNodeSizes(size_t internalNodeSize, size_t leafNodeSize)
     m_internalNodeSize = internalNodeSize;
     m_leafNodeSize = leafNodeSize;
 
-    m_leafNodes.SetEntrySize(sizeof(Tree::LeafNode) + ((int) leafNodeSize*sizeof(Entry)), 1);
+    m_laneStride = ((leafNodeSize + 1 + LANE_WIDTH - 1) / LANE_WIDTH) * LANE_WIDTH; // a leaf holds up to leafNodeSize+1 entries before it splits
+    m_leafNodes.SetEntrySize(sizeof(Tree::LeafNode) + ((int) leafNodeSize*sizeof(Entry)) + LANE_Count*m_laneStride*sizeof(float), 1);
     m_internalNodes.SetEntrySize(sizeof(Tree::InternalNode) + ((int) internalNodeSize*sizeof(NodeP)), 1);
     }
 
@@ -640,5 +1004,5 @@ void Tree::SetNodeSizes(size_t internalNodeSize, size_t leafNodeSize)
 Traverser::Stop Tree::Traverse(Traverser& traverser)
     {
     ReadLock lock(*this);
-    return (nullptr == m_root) ? Traverser::Stop::No : m_root->Traverse(traverser, *this, Is3d());
+    return (nullptr == m_root) ? Traverser::Stop::No : m_root->Traverse(traverser, *this, Is3d(), traverser._GetQueryBox());
     }
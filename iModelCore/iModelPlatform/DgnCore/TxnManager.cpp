@@ -5,6 +5,8 @@
 #include <DgnPlatformInternal.h>
 #include <BeSQLite/Profiler.h>
 #include <Bentley/SHA1.h>
+#include <deque>
+#include <future>
 
 BEGIN_UNNAMED_NAMESPACE
 
@@ -290,6 +292,7 @@ static DbResult ApplySchemaChangesInOrder(ChangeStreamCR changeset, DbR db, Appl
 END_UNNAMED_NAMESPACE
 
 #define FILE_BASED_TXN_PROP "fileBasedTxns"
+#define FILE_BASED_TXN_CODEC_PROP "fileBasedTxnCodec"
 
 //---------------------------------------------------------------------------------------
 // @bsimethod
@@ -306,6 +309,18 @@ bool TxnManager::IsFileBasedTxnEnabled() const {
     return val == "1";
 }
 
+/*---------------------------------------------------------------------------------**//**
+* Codec for new .txn files. LZMA unless the briefcase opts in to Snappy, which is much faster
+* to write but produces larger files. Reading detects the codec of each file.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TxnManager::TxnFileCodec TxnManager::GetTxnFileCodec() const {
+    Utf8String val;
+    if (m_dgndb.QueryBriefcaseLocalValue(val, FILE_BASED_TXN_CODEC_PROP) == BE_SQLITE_ROW && val.EqualsIAscii("snappy"))
+        return TxnFileCodec::Snappy;
+    return TxnFileCodec::Lzma;
+}
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -393,44 +408,53 @@ static bool ParseFileBasedTxnHeader(FileBasedTxnHeader& outHeader, void const* b
 }
 
 /*---------------------------------------------------------------------------------**//**
-* Write a changeset to a .txn file using LZMA compression. Computes SHA1 checksum of
-* the written file and returns it via outChecksum.
+* Write a changeset to filePath with the briefcase's txn codec and return the SHA1 checksum
+* of the written file via outChecksum. Both writers hash the file while they write it, so it
+* is never read back.
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-DbResult TxnManager::WriteTxnToFile(TxnId txnId, ChangeSetCR changeset, Byte* outChecksum) {
-    if (EnsureTxnDirectory() != SUCCESS) {
-        LOG.error("WriteTxnToFile: failed to create txns directory");
-        return BE_SQLITE_ERROR;
+DbResult TxnManager::WriteTxnFile(BeFileNameCR filePath, ChangeSetCR changeset, Byte* outChecksum) {
+    auto reader = changeset._GetReader();
+    if (GetTxnFileCodec() == TxnFileCodec::Snappy) {
+        SnappyChangesetFileWriter writer(filePath, &m_dgndb);
+        DbResult rc = writer.Initialize();
+        if (rc == BE_SQLITE_OK)
+            rc = writer.ReadFrom(*reader);
+        if (rc == BE_SQLITE_OK)
+            rc = writer.Finish(outChecksum);
+        if (rc != BE_SQLITE_OK)
+            LOG.errorv("WriteTxnFile: failed to write changeset: %s", BeSQLiteLib::GetErrorName(rc));
+        return rc;
     }
 
-    BeFileName filePath = GetTxnFilePath(txnId);
+    DdlChanges emptyDdl;
+    ChangesetFileWriter writer(filePath, false /*containsEcSchemaChanges*/, emptyDdl, &m_dgndb);
+    DbResult rc = writer.Initialize();
+    if (rc != BE_SQLITE_OK) {
+        LOG.errorv("WriteTxnFile: failed to initialize writer: %s", BeSQLiteLib::GetErrorName(rc));
+        return rc;
+    }
 
-    // Write changeset to file using ChangesetFileWriter with LZMA compression.
-    // Use a scope block so the writer destructor finalizes the file before we read it back for checksumming.
-    {
-        DdlChanges emptyDdl;
-        ChangesetFileWriter writer(filePath, false /*containsEcSchemaChanges*/, emptyDdl, &m_dgndb);
-        DbResult rc = writer.Initialize();
-        if (rc != BE_SQLITE_OK) {
-            LOG.errorv("WriteTxnToFile: failed to initialize writer: %s", BeSQLiteLib::GetErrorName(rc));
-            return rc;
-        }
+    rc = writer.ReadFrom(*reader);
+    if (rc == BE_SQLITE_OK)
+        rc = writer.Finish(outChecksum);
+    if (rc != BE_SQLITE_OK)
+        LOG.errorv("WriteTxnFile: failed to write changeset: %s", BeSQLiteLib::GetErrorName(rc));
+    return rc;
+}
 
-        auto reader = changeset._GetReader();
-        rc = writer.ReadFrom(*reader);
-        if (rc != BE_SQLITE_OK) {
-            LOG.errorv("WriteTxnToFile: failed to write changeset: %s", BeSQLiteLib::GetErrorName(rc));
-            return rc;
-        }
+/*---------------------------------------------------------------------------------**//**
+* Write a changeset to the .txn file of txnId. Computes SHA1 checksum of the written file
+* and returns it via outChecksum.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+DbResult TxnManager::WriteTxnToFile(TxnId txnId, ChangeSetCR changeset, Byte* outChecksum) {
+    if (EnsureTxnDirectory() != SUCCESS) {
+        LOG.error("WriteTxnToFile: failed to create txns directory");
+        return BE_SQLITE_ERROR;
     }
 
-    // Compute SHA1 checksum of the file using streaming reads
-    DbResult checksumRc = ComputeFileChecksumStreaming(filePath, outChecksum);
-    if (checksumRc != BE_SQLITE_OK) {
-        LOG.error("WriteTxnToFile: failed to compute checksum");
-        return checksumRc;
-    }
-    return BE_SQLITE_OK;
+    return WriteTxnFile(GetTxnFilePath(txnId), changeset, outChecksum);
 }
 
 /*---------------------------------------------------------------------------------**//**
@@ -458,13 +482,18 @@ DbResult TxnManager::ReadTxnFromFile(TxnId txnId, Byte const* expectedChecksum,
         return BE_SQLITE_ERROR;
     }
 
-    // Read changeset from LZMA-compressed file using ChangesetFileReaderBase
-    bvector<BeFileName> files;
-    files.push_back(filePath);
-    ChangesetFileReaderBase reader(files, &m_dgndb);
+    // Read changeset from the file with the codec it was written with
     changeset.Clear();
-    auto fileReader = reader.MakeReader();
-    DbResult rc = changeset.ReadFrom(*fileReader);
+    DbResult rc;
+    if (SnappyChangesetFileWriter::IsSnappyChangesetFile(filePath)) {
+        SnappyChangesetFileReader reader(filePath, &m_dgndb);
+        rc = changeset.ReadFrom(*reader._GetReader());
+    } else {
+        bvector<BeFileName> files;
+        files.push_back(filePath);
+        ChangesetFileReaderBase reader(files, &m_dgndb);
+        rc = changeset.ReadFrom(*reader.MakeReader());
+    }
     if (rc != BE_SQLITE_OK) {
         LOG.errorv("ReadTxnFromFile: failed to read changeset from file: %s", filePath.GetNameUtf8().c_str());
         return rc;
@@ -1949,6 +1978,8 @@ void TxnManager::SetChangesetHealthStatistics(ChangesetPropsCR revision) {
     stats["changeset_index"] = revision.GetChangesetIndex();
     stats["uncompressed_size_bytes"] = static_cast<int64_t>(revision.GetUncompressedSize());
     stats["sha1_validation_time_ms"] = static_cast<int64_t>(revision.GetSha1ValidationTime());
+    stats["decompress_time_ms"] = static_cast<int64_t>(revision.GetDecompressTime());
+    stats["prefetch_wait_time_ms"] = static_cast<int64_t>(revision.GetPrefetchWaitTime());
     m_changesetHealthStatistics[revision.GetChangesetId()] = stats.Stringify();
 }
 
@@ -2167,7 +2198,7 @@ void TxnManager::RevertTimelineChanges(std::vector<ChangesetPropsPtr> changesetP
 /*---------------------------------------------------------------------------------**/ /**
  * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-ChangesetStatus TxnManager::MergeChangeset(ChangesetPropsCR changeset, bool fastForward, bool noUpdateLoop) {
+void TxnManager::CheckCanMergeChangeset() {
     ThrowIfChangesetInProgress();
 
     if (m_dgndb.IsReadonly())
@@ -2176,6 +2207,13 @@ ChangesetStatus TxnManager::MergeChangeset(ChangesetPropsCR changeset, bool fast
     auto conf = PullMergeConf::Load(m_dgndb);
     if (HasChanges() && !(conf.InProgress()))
         m_dgndb.ThrowException("unsaved changes present", (int) ChangesetStatus::HasUncommittedChanges);
+}
+
+/*---------------------------------------------------------------------------------**/ /**
+ * @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ChangesetStatus TxnManager::MergeChangeset(ChangesetPropsCR changeset, bool fastForward, bool noUpdateLoop) {
+    CheckCanMergeChangeset();
 
     changeset.ValidateContent(m_dgndb);
 
@@ -2184,8 +2222,13 @@ ChangesetStatus TxnManager::MergeChangeset(ChangesetPropsCR changeset, bool fast
 
     ChangesetFileReader changeStream(changeset.GetFileName(), &m_dgndb);
 
-    const bool containsDDLChanges = changeset.ContainsDdlChanges(m_dgndb);
+    return MergeChangeset(changeset, changeStream, changeset.ContainsDdlChanges(m_dgndb), fastForward, noUpdateLoop);
+}
 
+/*---------------------------------------------------------------------------------**/ /**
+ * @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ChangesetStatus TxnManager::MergeChangeset(ChangesetPropsCR changeset, ChangesetFileReader& changeStream, bool containsDDLChanges, bool fastForward, bool noUpdateLoop) {
     ChangesetStatus status;
     if (containsDDLChanges) {
         // Note: Schema changes may not necessary imply ddl changes. They could just be 'minor' ecschema/mapping changes.
@@ -2202,6 +2245,132 @@ ChangesetStatus TxnManager::MergeChangeset(ChangesetPropsCR changeset, bool fast
     return MergeDataChanges(changeset, changeStream, hasEcOrDdlChanges, fastForward, noUpdateLoop);
 }
 
+//=======================================================================================
+// A changeset that was decompressed into memory and hashed on a worker thread, ready to be applied.
+// @bsiclass
+//=======================================================================================
+struct PrefetchedChangeset {
+    std::unique_ptr<ChangesetFileReader> m_reader;
+    Utf8String m_computedId;
+    bool m_containsDdlChanges = false;
+    DbResult m_result = BE_SQLITE_OK;
+    Utf8String m_error;
+    uint32_t m_decompressTime = 0;
+    uint32_t m_validateTime = 0;
+
+    //! Runs on a worker thread, so it must not touch the DgnDb. A changeset that decompresses to more than maxBytes is
+    //! not kept in memory; it is hashed here and applied by streaming from its file.
+    static PrefetchedChangeset Load(ChangesetPropsCPtr changeset, DgnDbP dgndb, size_t maxBytes) {
+        PrefetchedChangeset prefetched;
+        prefetched.m_reader = std::make_unique<ChangesetFileReader>(changeset->GetFileName(), dgndb);
+        if (!changeset->GetFileName().DoesPathExist()) {
+            prefetched.m_result = BE_SQLITE_CANTOPEN;
+            prefetched.m_error = "changeset file does not exist";
+            return prefetched;
+        }
+
+        auto startMs = BeTimeUtilities::QueryMillisecondsCounterUInt32();
+        prefetched.m_result = prefetched.m_reader->Preload(maxBytes);
+        prefetched.m_decompressTime = BeTimeUtilities::QueryMillisecondsCounterUInt32() - startMs;
+        if (BE_SQLITE_OK != prefetched.m_result) {
+            prefetched.m_error = "error reading changeset data";
+            return prefetched;
+        }
+
+        DdlChanges ddlChanges;
+        prefetched.m_result = prefetched.m_reader->MakeReader()->GetSchemaChanges(prefetched.m_containsDdlChanges, ddlChanges);
+        if (BE_SQLITE_OK != prefetched.m_result) {
+            prefetched.m_error = "error reading changeset data";
+            return prefetched;
+        }
+
+        // leave the id empty; ValidateContent reports the bad parent id on the apply thread
+        if (!ChangesetProps::IsValidParentId(changeset->GetParentId()))
+            return prefetched;
+
+        startMs = BeTimeUtilities::QueryMillisecondsCounterUInt32();
+        try {
+            prefetched.m_computedId = ChangesetProps::ComputeChangesetId(changeset->GetParentId(), *prefetched.m_reader);
+        } catch (std::exception const& e) {
+            prefetched.m_result = BE_SQLITE_CORRUPT;
+            prefetched.m_error = e.what();
+        }
+        prefetched.m_validateTime = BeTimeUtilities::QueryMillisecondsCounterUInt32() - startMs;
+        return prefetched;
+    }
+};
+
+/*---------------------------------------------------------------------------------**/ /**
+ * Merge changesets in order. Decompression and hashing only read the changeset files, so the next changesets are
+ * prepared on worker threads while the current one is applied. Everything that touches the DgnDb stays on this thread.
+ * With a prefetchCount of 0 each changeset is prepared on this thread right before it is applied.
+ * At most prefetchCount + 1 changesets are in memory at once, so each may keep that share of maxPrefetchBytes.
+ * @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ChangesetStatus TxnManager::MergeChangesets(std::vector<ChangesetPropsPtr> const& changesets, bool fastForward, bool noUpdateLoop, uint32_t prefetchCount, size_t maxPrefetchBytes) {
+    if (changesets.empty())
+        return ChangesetStatus::Success;
+
+    CheckCanMergeChangeset();
+
+    const size_t maxPreloadBytes = maxPrefetchBytes / ((size_t) prefetchCount + 1);
+    std::deque<std::future<PrefetchedChangeset>> pending;
+    size_t nextToLoad = 0;
+    auto loadMore = [&]() {
+        while (nextToLoad < changesets.size() && pending.size() < prefetchCount) {
+            ChangesetPropsCPtr changeset = changesets[nextToLoad++];
+            pending.push_back(std::async(std::launch::async, &PrefetchedChangeset::Load, changeset, &m_dgndb, maxPreloadBytes));
+        }
+    };
+
+    StopWatch total(true);
+    loadMore();
+    for (auto const& changeset : changesets) {
+        CheckCanMergeChangeset();
+
+        auto startMs = BeTimeUtilities::QueryMillisecondsCounterUInt32();
+        PrefetchedChangeset prefetched;
+        if (pending.empty()) {
+            prefetched = PrefetchedChangeset::Load(changeset, &m_dgndb, maxPreloadBytes);
+            ++nextToLoad;
+        } else {
+            prefetched = pending.front().get();
+            pending.pop_front();
+        }
+        changeset->SetPrefetchWaitTime(BeTimeUtilities::QueryMillisecondsCounterUInt32() - startMs);
+        changeset->SetDecompressTime(prefetched.m_decompressTime);
+        changeset->SetSha1ValidationTime(prefetched.m_validateTime);
+        if (prefetched.m_reader->IsPreloaded())
+            changeset->SetUncompressedSize(prefetched.m_reader->GetPreloadedSize());
+        loadMore();
+
+        if (BE_SQLITE_OK != prefetched.m_result) {
+            if (BE_SQLITE_CANTOPEN == prefetched.m_result)
+                m_dgndb.ThrowException(prefetched.m_error.c_str(), (int) ChangesetStatus::FileNotFound);
+            m_dgndb.ThrowException(prefetched.m_error.c_str(), (int) ChangesetStatus::CorruptedChangeStream);
+        }
+
+        changeset->ValidateContent(m_dgndb, prefetched.m_computedId);
+        if (GetParentChangesetId() != changeset->GetParentId())
+            m_dgndb.ThrowException("changeset out of order", (int) ChangesetStatus::ParentMismatch);
+
+        startMs = BeTimeUtilities::QueryMillisecondsCounterUInt32();
+        auto status = MergeChangeset(*changeset, *prefetched.m_reader, prefetched.m_containsDdlChanges, fastForward, noUpdateLoop);
+        changeset->SetApplyTime(BeTimeUtilities::QueryMillisecondsCounterUInt32() - startMs);
+
+        LOG.infov("MergeChangesets: changeset [%d] wait=%ums decompress=%ums sha1=%ums apply=%ums size=%" PRIuPTR,
+            changeset->GetChangesetIndex(), changeset->GetPrefetchWaitTime(), changeset->GetDecompressTime(),
+            changeset->GetSha1ValidationTime(), changeset->GetApplyTime(), changeset->GetUncompressedSize());
+
+        if (ChangesetStatus::Success != status)
+            return status;
+    }
+
+    total.Stop();
+    LOG.infov("MergeChangesets: merged %" PRIuPTR " changesets in %.3fs", changesets.size(), total.GetElapsedSeconds());
+    return ChangesetStatus::Success;
+}
+
 /*---------------------------------------------------------------------------------**/ /**
   * call the javascript `txn.reportError` method
   @bsimethod
@@ -4179,28 +4348,10 @@ DbResult TxnManager::PullMergeUpdateTxn(ChangeSetCR changeSet, TxnId id) {
         tempPath.append(L".tmp");
 
         // Write changeset to the temp file
-        {
-            DdlChanges emptyDdl;
-            ChangesetFileWriter writer(tempPath, false /*containsEcSchemaChanges*/, emptyDdl, &m_dgndb);
-            rc = writer.Initialize();
-            if (rc != BE_SQLITE_OK) {
-                LOG.errorv("PullMergeUpdateTxn: failed to initialize writer: %s", BeSQLiteLib::GetErrorName(rc));
-                return rc;
-            }
-            auto reader = changeSet._GetReader();
-            rc = writer.ReadFrom(*reader);
-            if (rc != BE_SQLITE_OK) {
-                LOG.errorv("PullMergeUpdateTxn: failed to write changeset to temp file: %s", BeSQLiteLib::GetErrorName(rc));
-                tempPath.BeDeleteFile();
-                return rc;
-            }
-        }
-
-        // Compute checksum of the temp file
         Byte checksum[SHA1::HashBytes];
-        rc = ComputeFileChecksumStreaming(tempPath, checksum);
+        rc = WriteTxnFile(tempPath, changeSet, checksum);
         if (rc != BE_SQLITE_OK) {
-            LOG.error("PullMergeUpdateTxn: failed to compute checksum of temp file");
+            LOG.errorv("PullMergeUpdateTxn: failed to write changeset to temp file: %s", BeSQLiteLib::GetErrorName(rc));
             tempPath.BeDeleteFile();
             return rc;
         }
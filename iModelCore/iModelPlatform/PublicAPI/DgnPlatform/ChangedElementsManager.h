@@ -42,6 +42,7 @@ struct ChangedElementsManager final {
         bool        m_wantChunkTraversal;
         bool        m_wantBoundingBoxes;
         int         m_relationshipCacheSize;
+        int         m_workerCount;
         BeFileName  m_tempLocation;
         Utf8String  m_rulesetDirectory;
         ECPresentationManager* m_presentationManager;
@@ -49,7 +50,10 @@ struct ChangedElementsManager final {
         DbResult AddMetadataToChangeCacheFile(ECDb& cacheFile) const;
         DbResult InsertEntries(ECDbR cacheDb, ChangesetPropsPtr revision, bvector<ChangedElement> const& elements);
         bool HasChangeset(ECDbR cacheDb, ChangesetPropsPtr revision);
-        BeFileName CloneDb(BeFileNameCR dbFilename);
+        BeFileName CloneDb(BeFileNameCR dbFilename, int cloneIndex = -1);
+        SummaryOptions GetSummaryOptions(ECPresentationManager* presentationManager, bool wantBriefcaseRoll) const;
+        DbResult ProcessChangesetsInParallel(ECDbR cacheDb, bvector<ChangesetPropsPtr> const& revisions, bool& processed);
+        static DbResult RollClone(BeFileNameCR cloneFilename, bvector<ChangesetPropsPtr>::const_iterator begin, bvector<ChangesetPropsPtr>::const_iterator end);
 
         bmap<DgnModelId, AxisAlignedBox3d> static ComputeChangedModels(ChangedElementsMap const& changedElements);
         bmap<DgnModelId, AxisAlignedBox3d> static ComputeChangedModels(bvector<ChangedElement> const& elements);
@@ -71,9 +75,9 @@ struct ChangedElementsManager final {
         BE_JSON_NAME(newChecksums);
 
         // Maintain a passed db for older function calls
-        ChangedElementsManager(DgnDbPtr db) : m_dbFilename(db->GetFileName()), m_filterSpatial(false), m_wantParents(false), m_wantBriefcaseRoll(false), m_wantPropertyChecksums(true), m_wantRelationshipCaching(true), m_wantChunkTraversal(false), m_presentationManager(CreatePresentationManager()) {}
+        ChangedElementsManager(DgnDbPtr db) : m_dbFilename(db->GetFileName()), m_filterSpatial(false), m_wantParents(false), m_wantBriefcaseRoll(false), m_wantPropertyChecksums(true), m_wantRelationshipCaching(true), m_wantChunkTraversal(false), m_workerCount(1), m_presentationManager(CreatePresentationManager()) {}
 
-        ChangedElementsManager(BeFileNameCR dbFilename) : m_dbFilename(dbFilename), m_filterSpatial(false), m_wantParents(false), m_wantBriefcaseRoll(false), m_wantPropertyChecksums(true), m_wantRelationshipCaching(true), m_wantChunkTraversal(false), m_presentationManager(CreatePresentationManager()) {}
+        ChangedElementsManager(BeFileNameCR dbFilename) : m_dbFilename(dbFilename), m_filterSpatial(false), m_wantParents(false), m_wantBriefcaseRoll(false), m_wantPropertyChecksums(true), m_wantRelationshipCaching(true), m_wantChunkTraversal(false), m_workerCount(1), m_presentationManager(CreatePresentationManager()) {}
 
         DGNPLATFORM_EXPORT ~ChangedElementsManager();
 
@@ -93,6 +97,8 @@ struct ChangedElementsManager final {
         void SetRelationshipCacheSize(int size) { m_relationshipCacheSize = size; }
         //! Whether to store bounding boxes for changed model volume computation
         void SetWantBoundingBoxes(bool value) { m_wantBoundingBoxes = value; }
+        //! Number of threads used to process multiple changesets. Each thread rolls its own clone of the briefcase through a contiguous range of the changesets
+        void SetWorkerCount(int count) { m_workerCount = std::max(1, count); }
         //! Set presentation manager to use in processing
         DGNPLATFORM_EXPORT void SetPresentationRulesetDirectory(Utf8String rulesetDir);
         //! Set the temp location where the cloned Dbs are stored and cached for processing
@@ -35,7 +35,7 @@ struct ClipVector : RefCounted<T_ClipPrimitiveVector>
     DGNPLATFORM_EXPORT BentleyStatus TransformInPlace(TransformCR transform);
     DGNPLATFORM_EXPORT void Append(ClipVectorCR clip);
     DGNPLATFORM_EXPORT void AppendCopy(ClipVectorCR clip);
-    DGNPLATFORM_EXPORT StatusInt ClipPolyface(PolyfaceQueryCR polyface, struct PolyfaceQuery::IClipToPlaneSetOutput& output, bool triangulateOutput) const;
+    DGNPLATFORM_EXPORT StatusInt ClipPolyface(PolyfaceQueryCR polyface, struct PolyfaceQuery::IClipToPlaneSetOutput& output, bool triangulateOutput, bool parallel = false) const;
     DGNPLATFORM_EXPORT void SetInvisible(bool invisible);
     DGNPLATFORM_EXPORT void ExtractBoundaryLoops(int *nLoops, int nLoopPoints[], DPoint2dP loopPoints[], ClipMask* clipMaskP, double* zFrontP, double* zBackP, TransformP transformP, DPoint2dP pointBuffer, size_t nPoints) const;
     DGNPLATFORM_EXPORT bool GetRange(DRange3dR range, TransformCP transform) const;
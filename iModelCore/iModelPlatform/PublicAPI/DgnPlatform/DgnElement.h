@@ -4160,6 +4160,28 @@ public:
     //! @note If there are currently more than newMax elements in memory, the oldest ones are removed until the size is newMax.
     DGNPLATFORM_EXPORT void SetCacheSize(uint32_t newMax);
 
+    //! Set the maximum estimated memory, in bytes, of the elements held by the element cache for this DgnDb. This limit applies in
+    //! addition to the element count set by SetCacheSize and uses DgnElement::GetMemorySize as each element's size.
+    //! @param maxBytes The memory budget of the element cache. Set to 0 (the default) for no memory limit.
+    //! @note If the cache currently holds more than maxBytes, the least recently used elements are removed until it does not.
+    DGNPLATFORM_EXPORT void SetCacheMemoryBudget(uint64_t maxBytes);
+
+    //! Counters of the element cache for this DgnDb.
+    struct CacheStats
+    {
+        uint64_t m_hits = 0;        //!< lookups that found the element in the cache
+        uint64_t m_misses = 0;      //!< lookups that did not
+        uint64_t m_evictions = 0;   //!< elements dropped to stay within the cache limits
+        uint64_t m_count = 0;       //!< elements currently in the cache
+        uint64_t m_bytes = 0;       //!< estimated memory of the elements currently in the cache
+    };
+
+    //! Get the counters of the element cache. Hits, misses and evictions accumulate until ResetCacheStats is called.
+    DGNPLATFORM_EXPORT CacheStats GetCacheStats() const;
+
+    //! Reset the hit, miss and eviction counters of the element cache.
+    DGNPLATFORM_EXPORT void ResetCacheStats();
+
     //! Empty the Most Recentley Used element cache for this DgnDb.
     DGNPLATFORM_EXPORT void ClearCache();
 
@@ -32,8 +32,10 @@ struct Request  {
     Request(BeJsConst val): m_value(val) {}
     BE_JSON_NAME(operation)
     BE_JSON_NAME(candidates)
+    BE_JSON_NAME(parallel)
     bool IsValid() const {return m_value.isMember(json_operation()) && m_value.isMember(json_candidates());}
     OperationType GetOperation() const {auto value = m_value[json_operation()]; return (OperationType) value.asUInt();}
+    bool IsParallel() const {return m_value[json_parallel()].asBool(false);}
 
     DgnElementIdSet GetCandidates() const {
         DgnElementIdSet elements;
@@ -197,10 +199,15 @@ DGNPLATFORM_EXPORT BentleyStatus Process (GeometricPrimitiveCR, DgnDbR, Transfor
 //! Visit the supplied element and accumulate the measure information.
 DGNPLATFORM_EXPORT BentleyStatus Process (GeometrySourceCR);
 
+//! Add the sums accumulated by another collector of the same operation type to this one.
+//! Sums are kept about the global origin, so the combined centroid and moments are the same as if a single collector had processed the geometry of both.
+DGNPLATFORM_EXPORT void Accumulate (MeasureGeomCollector const& other);
+
 //! Create new instance of a measure geometry collector.
 DGNPLATFORM_EXPORT static MeasureGeomCollectorPtr Create (OperationType opType);
 
 //! Query the mass properties as a json value.
+//! If the input has "parallel" set, the candidates are divided between the calling thread and the BeFolly CPU pool, which each load and measure their share of the elements.
 DGNPLATFORM_EXPORT static  void DoMeasure(BeJsValue out, BeJsConst input, DgnDbR db, ICancellablePtr cancel=nullptr);
 
 }; // MeasureGeomCollector
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <PlacementOnEarth/Placement.h>
+#include <atomic>
 
 BEGIN_BENTLEY_DGN_NAMESPACE
 
@@ -138,6 +139,11 @@ struct Traverser
     virtual ~Traverser() {}
     virtual bool _AbortOnWriteRequest() const {return true;}
 
+    //! A traverser that only accepts nodes and entries whose range overlaps a fixed box may return that box. The tree then tests
+    //! all the entries of a leaf against it at once and skips nodes and entries outside it without offering them to the traverser.
+    //! Everything that does overlap the box is still passed to _CheckRangeTreeNode and _VisitRangeTreeEntry as usual.
+    virtual FBoxCP _GetQueryBox() const {return nullptr;}
+
     enum class Accept : bool {Yes=1, No=0,};
     virtual Accept _CheckRangeTreeNode(FBoxCR, bool is3d) const = 0;   // true == process node
 
@@ -156,25 +162,28 @@ struct Tree
     //=======================================================================================
     //! On construction block until no write active. Then hold read lock until destruction.
     //! Note that there can be more than one simultaneous readers.
+    //! Readers only touch their own reader slot and the write flag, so uncontended readers never take a mutex
+    //! and readers on different threads do not share a cache line.
     // @bsiclass
     //=======================================================================================
     struct ReadLock
     {
         TreeCR m_tree;
-        ReadLock(TreeCR tree) : m_tree(tree) {BeMutexHolder holder(tree.m_cv.GetMutex()); while (tree.m_writeActive) tree.m_cv.InfiniteWait(holder); ++tree.m_readers;}
-        ~ReadLock() {{BeMutexHolder holder(m_tree.m_cv.GetMutex()); --m_tree.m_readers; BeAssert(m_tree.m_readers>=0);} m_tree.m_cv.notify_all();}
+        std::atomic<int>& m_slot;
+        DGNPLATFORM_EXPORT ReadLock(TreeCR tree);
+        DGNPLATFORM_EXPORT ~ReadLock();
     };
 
     //=======================================================================================
     //! On construction block until no readers. Then hold write lock until destruction.
-    //! There can only be one writer.
+    //! There can only be one writer at a time; other writers wait for it.
     // @bsiclass
     //=======================================================================================
     struct WriteLock
     {
         TreeR m_tree;
-        WriteLock(TreeR tree) : m_tree(tree) {BeMutexHolder holder(tree.m_cv.GetMutex()); while (tree.m_readers>0){tree.m_writeRequest=true; tree.m_cv.InfiniteWait(holder);} tree.m_writeRequest=false; BeAssert(!tree.m_writeActive); tree.m_writeActive=true;}
-        ~WriteLock() {{BeMutexHolder holder(m_tree.m_cv.GetMutex()); BeAssert(m_tree.m_writeActive); m_tree.m_writeActive=false; } m_tree.m_cv.notify_all();}
+        DGNPLATFORM_EXPORT WriteLock(TreeR tree);
+        DGNPLATFORM_EXPORT ~WriteLock();
     };
 
     //=======================================================================================
@@ -200,7 +209,7 @@ struct Tree
         FBoxCR GetRangeCR() {return m_nodeRange;}
         bool Overlaps(FBoxCR range) const;
         bool CompletelyContains(FBoxCR range) const;
-        Traverser::Stop Traverse(Traverser&, TreeCR tree, bool is3d);
+        Traverser::Stop Traverse(Traverser&, TreeCR tree, bool is3d, FBoxCP queryBox);
     };
 
     //=======================================================================================
@@ -219,7 +228,10 @@ struct Tree
         bool DropElement(DgnElementId, TreeR);
         size_t GetEntryCount() const {return m_endChild - m_firstChild;}
         EntryCP FindElement(DgnElementId) const;
-        Traverser::Stop Traverse(Traverser&, TreeCR tree, bool is3d);
+        float* GetLanes(TreeCR tree) const {return (float*) (m_firstChild + tree.m_leafNodeSize + 1);}
+        void SetLanes(size_t index, FBoxCR range, TreeCR tree);
+        Traverser::Stop Traverse(Traverser&, TreeCR tree, bool is3d, FBoxCP queryBox);
+        Traverser::Stop TraverseOverlapping(Traverser&, TreeCR tree, FBoxCR queryBox);
     };
 
     //=======================================================================================
@@ -240,7 +252,7 @@ struct Tree
         void ValidateInternalRange();
         size_t GetEntryCount() const {return m_endChild - m_firstChild;}
         void ClearChildren() {m_endChild = m_firstChild; ClearRange();}
-        Traverser::Stop Traverse(Traverser&, TreeCR tree, bool is3d);
+        Traverser::Stop Traverse(Traverser&, TreeCR tree, bool is3d, FBoxCP queryBox);
         DGNPLATFORM_EXPORT size_t GetElementCount();
     };
 
@@ -251,15 +263,26 @@ private:
 
     DgnMemoryPool<LeafNode,128> m_leafNodes;
     DgnMemoryPool<InternalNode,512> m_internalNodes;
+    // Active readers are counted in per-thread slots, each on its own cache line, rather than in one shared counter.
+    static const int READER_SLOTS = 16;
+    struct alignas(64) ReaderSlot {std::atomic<int> m_count {0};};
+
     LeafIdx m_leafIdx;      // map to the leaf holding each entry
     Node* m_root = nullptr;
     bool m_is3d;
-    bool m_writeActive = false;
-    bool m_writeRequest = false;
-    mutable int m_readers = 0;
+    bool m_hasWriter = false;  // guarded by m_cv's mutex
+    std::atomic<bool> m_writeActive {false};
+    std::atomic<bool> m_writeRequest {false};
+    mutable ReaderSlot m_readers[READER_SLOTS];
     size_t m_internalNodeSize;
     size_t m_leafNodeSize;
-    mutable BentleyApi::BeConditionVariable m_cv;
+    // Each leaf also keeps the ranges of its entries as separate low/high x/y/z float lanes, stored after its entries,
+    // so that all of them can be tested against a query box with a few vector instructions.
+    size_t m_laneStride;
+    mutable BentleyApi::BeConditionVariable m_cv;  // only used when a reader and a writer actually collide
+
+    std::atomic<int>& GetReaderSlot() const;
+    bool HasReaders() const;
 
     InternalNode* AllocateInternalNode() {return new (m_internalNodes.AllocateNode()) InternalNode(m_is3d);}
     LeafNode* AllocateLeafNode() {return new (m_leafNodes.AllocateNode()) LeafNode(m_is3d);}
@@ -294,6 +317,14 @@ public:
 
     DGNPLATFORM_EXPORT void AddEntry(Entry const&);
 
+    //! Build the tree from a set of entries in one pass rather than with one AddEntry call per entry. The entries are
+    //! ordered with Sort-Tile-Recursive and packed bottom-up into full nodes, which is much faster for large sets and
+    //! yields tighter nodes, so queries visit fewer of them. The tree may still be modified normally afterwards.
+    //! @param[in] entries the entries to add. They are reordered. Entries with an invalid range are skipped.
+    //! @param[in] parallel if true, large inputs are sorted on multiple threads.
+    //! @return SUCCESS, or ERROR if the tree is not empty.
+    DGNPLATFORM_EXPORT BentleyStatus BulkLoad(bvector<Entry>& entries, bool parallel = true);
+
     //! Find an element in the range index and return the Entry information.
     //! @param[in] id The id of the element to find
     //! @return the Entry for the specified element. Will be nullptr if the element is not in the index.
@@ -455,8 +455,11 @@ private:
     BeSQLite::DbResult ReadDataChanges(BeSQLite::ChangeSet&, TxnId rowid, TxnAction);
 
     // File-based txn storage
+    enum class TxnFileCodec { Lzma, Snappy };
     bool IsFileBasedTxnEnabled() const;
+    TxnFileCodec GetTxnFileCodec() const;
     BentleyStatus EnsureTxnDirectory() const;
+    BeSQLite::DbResult WriteTxnFile(BeFileNameCR filePath, BeSQLite::ChangeSetCR changeset, Byte* outChecksum);
     BeSQLite::DbResult WriteTxnToFile(TxnId txnId, BeSQLite::ChangeSetCR changeset, Byte* outChecksum);
     BeSQLite::DbResult ReadTxnFromFile(TxnId txnId, Byte const* expectedChecksum, BeSQLite::ChangeSet& changeset);
     void DeleteTxnFile(TxnId txnId);
@@ -482,6 +485,8 @@ private:
     void WriteChangesToFile(BeFileNameCR pathname, BeSQLite::DdlChangesCR ddlChanges, BeSQLite::ChangeGroupCR dataChangeGroup);
     ChangesetStatus MergeDdlChanges(ChangesetPropsCR revision, ChangesetFileReader& revisionReader);
     ChangesetStatus MergeDataChanges(ChangesetPropsCR revision, ChangesetFileReader& revisionReader, bool containsSchemaChanges, bool fastForward, bool noUpdateLoop = false);
+    void CheckCanMergeChangeset();
+    ChangesetStatus MergeChangeset(ChangesetPropsCR revision, ChangesetFileReader& revisionReader, bool containsDdlChanges, bool fastForward, bool noUpdateLoop);
     ChangesetStatus ProcessRevisions(bvector<ChangesetPropsCP> const &revisions, RevisionProcessOption processOptions);
 
     TxnTable* FindTxnTable(Utf8CP tableName) const;
@@ -508,6 +513,13 @@ public:
     DGNPLATFORM_EXPORT void FinishCreateChangeset(int32_t changesetIndex, bool keepFile = false);
     DGNPLATFORM_EXPORT void StopCreateChangeset(bool keepFile);
     DGNPLATFORM_EXPORT ChangesetStatus MergeChangeset(ChangesetPropsCR revision, bool fastforward, bool noUpdateLoop = false);
+    //! Merge a sequence of changesets, in order. The next changesets are decompressed and validated on worker threads
+    //! while the current one is applied. At most prefetchCount changesets are prepared ahead of the one being applied;
+    //! with 0, each changeset is prepared on the calling thread right before it is applied.
+    //! The decompressed changesets held in memory never exceed maxPrefetchBytes in total: a changeset larger than its
+    //! share of the budget is hashed and applied by streaming from its file instead.
+    //! The time spent in each stage is recorded on each ChangesetProps.
+    DGNPLATFORM_EXPORT ChangesetStatus MergeChangesets(std::vector<ChangesetPropsPtr> const& changesets, bool fastForward, bool noUpdateLoop = false, uint32_t prefetchCount = 2, size_t maxPrefetchBytes = 512 * 1024 * 1024);
     DGNPLATFORM_EXPORT void RevertTimelineChanges(std::vector<ChangesetPropsPtr> changesets, bool skipSchemaChanges);
     DGNPLATFORM_EXPORT void ReverseChangeset(ChangesetPropsCR revision, bool noUpdateLoop = false);
     DGNPLATFORM_EXPORT std::unique_ptr<BeSQLite::ChangeSet> CreateChangesetFromLocalChanges(bool includeInMemoryChanges);
@@ -1046,6 +1058,9 @@ struct ChangesetProps : RefCountedBase {
 private:
     size_t uncompressedSize;
     mutable unsigned int m_sha1ValidationTime;
+    mutable unsigned int m_decompressTime = 0;
+    mutable unsigned int m_prefetchWaitTime = 0;
+    mutable unsigned int m_applyTime = 0;
 
 public:
     TxnManager::TxnId m_endTxnId;
@@ -1072,6 +1087,15 @@ public:
     size_t GetUncompressedSize() const { return uncompressedSize; }
     unsigned int GetSha1ValidationTime() const { return m_sha1ValidationTime; }
     void SetSha1ValidationTime(unsigned int time) const { m_sha1ValidationTime = time; }
+    //! Time spent decompressing the changeset into memory ahead of applying it (see TxnManager::MergeChangesets)
+    unsigned int GetDecompressTime() const { return m_decompressTime; }
+    void SetDecompressTime(unsigned int time) const { m_decompressTime = time; }
+    //! Time the apply thread spent waiting for the changeset to be decompressed and validated
+    unsigned int GetPrefetchWaitTime() const { return m_prefetchWaitTime; }
+    void SetPrefetchWaitTime(unsigned int time) const { m_prefetchWaitTime = time; }
+    //! Time spent applying the changeset and notifying the TxnTables
+    unsigned int GetApplyTime() const { return m_applyTime; }
+    void SetApplyTime(unsigned int time) const { m_applyTime = time; }
 
     //! Get or set the user name
     Utf8StringCR GetUserName() const { return m_userName; }
@@ -1090,8 +1114,15 @@ public:
     //! Determines if the revision contains schema changes
     DGNPLATFORM_EXPORT bool ContainsDdlChanges(DgnDbR dgndb) const;
     DGNPLATFORM_EXPORT void ValidateContent(DgnDbR dgndb) const;
+    //! Validate the content against a changeset id that was already computed from the file, e.g. on a worker thread.
+    //! Checks the parent id first, like ValidateContent(DgnDbR).
+    void ValidateContent(DgnDbR dgndb, Utf8StringCR computedId) const;
+    //! Determine whether parentRevId is empty or has the form of a SHA1 hash
+    static bool IsValidParentId(Utf8StringCR parentRevId);
     DGNPLATFORM_EXPORT void Dump(DgnDbR dgndb) const;
     DGNPLATFORM_EXPORT static Utf8String ComputeChangesetId(Utf8StringCR parentRevId, BeFileNameCR changesetFile, Napi::Env env);
+    //! Compute the changeset id from a reader. Throws std::runtime_error if the changeset cannot be read. Does not use the Db.
+    static Utf8String ComputeChangesetId(Utf8StringCR parentRevId, BeSQLite::ChangesetFileReaderBase const& reader);
 };
 
 //=======================================================================================
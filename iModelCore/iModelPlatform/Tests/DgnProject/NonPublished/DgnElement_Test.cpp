@@ -1298,6 +1298,92 @@ TEST_F(DgnElementTests, ParentChildSameModel)
         }
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(DgnElementTests, ElementCacheLimitsAndStats)
+    {
+    SetupSeedProject();
+
+    PhysicalModelPtr model = DgnDbTestUtils::InsertPhysicalModel(*m_db, "TestModel");
+    DgnCategoryId categoryId = DgnDbTestUtils::InsertSpatialCategory(*m_db, "TestCategory");
+
+    bvector<DgnElementId> elementIds;
+    for (int i = 0; i < 200; ++i)
+        {
+        GenericPhysicalObjectPtr element = GenericPhysicalObject::Create(*model, categoryId);
+        ASSERT_TRUE(element->Insert().IsValid());
+        elementIds.push_back(element->GetElementId());
+        }
+    m_db->SaveChanges();
+
+    auto& elements = m_db->Elements();
+    elements.ClearCache();
+    elements.ResetCacheStats();
+    DgnElements::CacheStats stats = elements.GetCacheStats();
+    EXPECT_EQ(0, stats.m_hits);
+    EXPECT_EQ(0, stats.m_misses);
+    EXPECT_EQ(0, stats.m_count);
+    EXPECT_EQ(0, stats.m_bytes);
+
+    for (auto id : elementIds)
+        EXPECT_TRUE(elements.GetElement(id).IsValid());
+
+    stats = elements.GetCacheStats();
+    EXPECT_GE(stats.m_misses, elementIds.size());
+    EXPECT_GE(stats.m_count, elementIds.size());
+    EXPECT_GT(stats.m_bytes, 0);
+
+    for (auto id : elementIds)
+        EXPECT_TRUE(elements.GetElement(id).IsValid());
+
+    stats = elements.GetCacheStats();
+    EXPECT_GE(stats.m_hits, elementIds.size());
+    EXPECT_EQ(0, stats.m_evictions);
+
+    // a memory budget of a quarter of what is loaded must evict elements until the cache fits into it.
+    uint64_t budget = stats.m_bytes / 4;
+    elements.SetCacheMemoryBudget(budget);
+    stats = elements.GetCacheStats();
+    EXPECT_LE(stats.m_bytes, budget);
+    EXPECT_LT(stats.m_count, elementIds.size());
+    EXPECT_GT(stats.m_evictions, 0);
+
+    // loading every element again must stay within the budget.
+    for (auto id : elementIds)
+        EXPECT_TRUE(elements.GetElement(id).IsValid());
+    EXPECT_LE(elements.GetCacheStats().m_bytes, budget);
+
+    // the count limit still applies.
+    elements.SetCacheMemoryBudget(0);
+    elements.SetCacheSize(16);
+    for (auto id : elementIds)
+        EXPECT_TRUE(elements.GetElement(id).IsValid());
+    EXPECT_LE(elements.GetCacheStats().m_count, 16);
+
+    // the limits apply to the whole cache, not to each of its stripes, and evict in least recently used order.
+    elements.SetCacheSize(10);
+    EXPECT_EQ(10, elements.GetCacheStats().m_count);
+    for (auto id : elementIds)
+        EXPECT_TRUE(elements.GetElement(id).IsValid());
+    EXPECT_EQ(10, elements.GetCacheStats().m_count);
+    for (size_t i = 0; i < elementIds.size(); ++i)
+        EXPECT_EQ(i >= elementIds.size() - 10, nullptr != elements.FindLoadedElement(elementIds[i])) << i;
+
+    // using the oldest cached element protects it from the next eviction.
+    DgnElementId oldest = elementIds[elementIds.size() - 10];
+    EXPECT_TRUE(nullptr != elements.FindLoadedElement(oldest));
+    EXPECT_TRUE(elements.GetElement(elementIds.front()).IsValid());
+    EXPECT_TRUE(nullptr != elements.FindLoadedElement(oldest));
+    EXPECT_TRUE(nullptr == elements.FindLoadedElement(elementIds[elementIds.size() - 9]));
+    EXPECT_EQ(10, elements.GetCacheStats().m_count);
+
+    elements.SetCacheSize(2000);
+    elements.ResetCacheStats();
+    stats = elements.GetCacheStats();
+    EXPECT_EQ(0, stats.m_hits + stats.m_misses + stats.m_evictions);
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -0,0 +1,157 @@
+/*---------------------------------------------------------------------------------------------
+* Copyright (c) Bentley Systems, Incorporated. All rights reserved.
+* See LICENSE.md in the repository root for full copyright notice.
+*--------------------------------------------------------------------------------------------*/
+#include "../TestFixture/DgnDbTestFixtures.h"
+#include <DgnPlatform/MeasureGeom.h>
+
+USING_NAMESPACE_BENTLEY_DPTEST
+
+//=======================================================================================
+// @bsiclass
+//=======================================================================================
+struct MeasureGeomTests : public DgnDbTestFixture
+{
+    bvector<DgnElementId> InsertSolids();
+    void Measure(BeJsValue out, bvector<DgnElementId> const& ids, bool parallel);
+};
+
+/*---------------------------------------------------------------------------------**//**
+* Insert an assortment of boxes, spheres and cylinders of different sizes, spread out so the moments of the whole set are not symmetric.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+bvector<DgnElementId> MeasureGeomTests::InsertSolids()
+    {
+    SpatialModelPtr model = m_db->Models().Get<SpatialModel>(m_defaultModelId).get();
+    bvector<DgnElementId> ids;
+    for (int i = 0; i < 12; ++i)
+        {
+        DPoint3d origin = DPoint3d::From(3.0 * i, 1.5 * (i % 4), 0.5 * i * i);
+        double size = 1.0 + 0.25 * i;
+        ISolidPrimitivePtr solid;
+        switch (i % 3)
+            {
+            case 0:
+                solid = ISolidPrimitive::CreateDgnBox(DgnBoxDetail::InitFromCenterAndSize(origin, DPoint3d::From(size, 2.0 * size, 0.5 * size), true));
+                break;
+            case 1:
+                solid = ISolidPrimitive::CreateDgnSphere(DgnSphereDetail(origin, size));
+                break;
+            default:
+                solid = ISolidPrimitive::CreateDgnCone(DgnConeDetail(origin, DPoint3d::FromSumOf(origin, DVec3d::From(0.0, size, 2.0 * size)), size, size, true));
+                break;
+            }
+
+        DgnElementPtr el = TestElement::Create(*m_db, m_defaultModelId, m_defaultCategoryId, DgnCode());
+        GeometryBuilderPtr builder = GeometryBuilder::Create(*model, m_defaultCategoryId, DPoint3d::FromZero());
+        EXPECT_TRUE(builder->Append(*solid));
+        EXPECT_EQ(SUCCESS, builder->Finish(*el->ToGeometrySourceP()));
+        DgnElementCPtr inserted = m_db->Elements().Insert(*el);
+        EXPECT_TRUE(inserted.IsValid());
+        if (inserted.IsValid())
+            ids.push_back(inserted->GetElementId());
+        }
+    return ids;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void MeasureGeomTests::Measure(BeJsValue out, bvector<DgnElementId> const& ids, bool parallel)
+    {
+    BeJsDocument input;
+    input[MeasureGeomCollector::Request::json_operation()] = (uint32_t) MeasureGeomCollector::AccumulateVolumes;
+    input[MeasureGeomCollector::Request::json_parallel()] = parallel;
+    auto candidates = input[MeasureGeomCollector::Request::json_candidates()];
+    for (auto id : ids)
+        candidates.appendValue() = id.ToHexStr();
+
+    MeasureGeomCollector::DoMeasure(out, input, *m_db);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static void expectSameMassProperties(BeJsConst expected, BeJsConst actual)
+    {
+    auto expectNear = [](double a, double b) {EXPECT_NEAR(a, b, 1.0e-10 * std::max(1.0, std::abs(a)));};
+
+    EXPECT_EQ(expected[MeasureGeomCollector::Response::json_status()].asUInt(), actual[MeasureGeomCollector::Response::json_status()].asUInt());
+    for (Utf8CP name : {MeasureGeomCollector::Response::json_volume(), MeasureGeomCollector::Response::json_area(), MeasureGeomCollector::Response::json_ixy(), MeasureGeomCollector::Response::json_ixz(), MeasureGeomCollector::Response::json_iyz()})
+        expectNear(expected[name].asDouble(), actual[name].asDouble());
+
+    for (Utf8CP name : {MeasureGeomCollector::Response::json_centroid(), MeasureGeomCollector::Response::json_moments()})
+        {
+        DPoint3d expectedPoint = BeJsGeomUtils::ToDPoint3d(expected[name]);
+        DPoint3d actualPoint = BeJsGeomUtils::ToDPoint3d(actual[name]);
+        expectNear(expectedPoint.x, actualPoint.x);
+        expectNear(expectedPoint.y, actualPoint.y);
+        expectNear(expectedPoint.z, actualPoint.z);
+        }
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(MeasureGeomTests, ParallelMeasureMatchesSerial)
+    {
+    SetupSeedProject();
+    bvector<DgnElementId> ids = InsertSolids();
+    ASSERT_EQ(12, ids.size());
+    m_db->SaveChanges();
+
+    BeJsDocument serial;
+    Measure(serial, ids, false);
+    EXPECT_EQ((uint32_t) SUCCESS, serial[MeasureGeomCollector::Response::json_status()].asUInt());
+    EXPECT_LT(0.0, serial[MeasureGeomCollector::Response::json_volume()].asDouble());
+
+    // repeat, so differently scheduled runs are compared as well
+    for (int i = 0; i < 4; ++i)
+        {
+        BeJsDocument parallel;
+        Measure(parallel, ids, true);
+        expectSameMassProperties(serial, parallel);
+        }
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Splitting the solids between collectors and accumulating them must give the same result as measuring them all in one,
+* however many threads the CPU pool happens to have on the machine running the test.
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(MeasureGeomTests, AccumulatedCollectorsMatchSingleCollector)
+    {
+    SetupSeedProject();
+    bvector<DgnElementId> ids = InsertSolids();
+    ASSERT_EQ(12, ids.size());
+
+    MeasureGeomCollectorPtr single = MeasureGeomCollector::Create(MeasureGeomCollector::AccumulateVolumes);
+    for (auto id : ids)
+        EXPECT_EQ(SUCCESS, single->Process(*m_db->Elements().GetElement(id)->ToGeometrySource()));
+
+    for (size_t sliceCount : {2, 3, 5, 12})
+        {
+        bvector<MeasureGeomCollectorPtr> slices;
+        for (size_t i = 0; i < sliceCount; ++i)
+            slices.push_back(MeasureGeomCollector::Create(MeasureGeomCollector::AccumulateVolumes));
+        for (size_t i = 0; i < ids.size(); ++i)
+            slices[i % sliceCount]->Process(*m_db->Elements().GetElement(ids[i])->ToGeometrySource());
+        for (size_t i = 1; i < sliceCount; ++i)
+            slices[0]->Accumulate(*slices[i]);
+
+        BeJsDocument expected, actual;
+        MeasureGeomCollector::Response expectedResponse(expected), actualResponse(actual);
+        for (auto pair : {std::make_pair(&expectedResponse, single), std::make_pair(&actualResponse, slices[0])})
+            {
+            pair.first->SetStatus(SUCCESS);
+            pair.first->SetVolume(pair.second->GetVolume());
+            pair.first->SetArea(pair.second->GetArea());
+            pair.first->SetCentroid(pair.second->GetCentroid());
+            pair.first->SetIXY(pair.second->GetIXY());
+            pair.first->SetIXZ(pair.second->GetIXZ());
+            pair.first->SetIYZ(pair.second->GetIYZ());
+            pair.first->SetMoments(pair.second->GetMoments());
+            }
+        expectSameMassProperties(expected, actual);
+        }
+    }
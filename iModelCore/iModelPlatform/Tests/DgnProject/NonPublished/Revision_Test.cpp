@@ -450,6 +450,92 @@ TEST_F(RevisionTestFixture, MoreWorkflow)
     // expectToThrow([&]() { m_db->Txns().PullMergeApply(*revision1); }, "Detected 1 foreign key conflicts in ChangeSet. Aborting merge.");
     }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+TEST_F(RevisionTestFixture, MergeChangesetsPipelined)
+    {
+    SetupDgnDb(RevisionTestFixture::s_seedFileInfo.fileName, L"MergeChangesetsPipelined.bim");
+    m_db->SaveChanges("Created Initial Model");
+    ASSERT_TRUE(CreateRevision("-cs0").IsValid());
+    BackupTestFile();
+
+    std::vector<ChangesetPropsPtr> changesets;
+    bvector<DgnElementId> elementIds;
+    for (int i = 1; i <= 4; ++i)
+        {
+        DgnElementId elementId = RevisionTestFixture::InsertPhysicalElement(*m_db, *m_defaultModel, m_defaultCategoryId, i, i, i);
+        ASSERT_TRUE(elementId.IsValid());
+        elementIds.push_back(elementId);
+        m_db->SaveChanges("Inserted an element");
+
+        ChangesetPropsPtr changeset = CreateRevision(Utf8PrintfString("-cs%d", i).c_str());
+        ASSERT_TRUE(changeset.IsValid());
+        changesets.push_back(changeset);
+        }
+
+    // delete the last element again so the final changeset holds a delete
+    DgnElementCPtr el = m_db->Elements().Get<DgnElement>(elementIds.back());
+    ASSERT_TRUE(el.IsValid());
+    ASSERT_EQ(DgnDbStatus::Success, m_db->Elements().Delete(*el));
+    el = nullptr;
+    m_db->SaveChanges("Deleted an element");
+    ChangesetPropsPtr lastChangeset = CreateRevision("-cs5");
+    ASSERT_TRUE(lastChangeset.IsValid());
+    changesets.push_back(lastChangeset);
+
+    RestoreTestFile();
+    for (auto const& elementId : elementIds)
+        EXPECT_FALSE(m_db->Elements().GetElement(elementId).IsValid());
+
+    // prefetch fewer changesets than we merge, so the pipeline has to refill
+    EXPECT_EQ(ChangesetStatus::Success, m_db->Txns().MergeChangesets(changesets, false, false, 1));
+    EXPECT_STREQ(lastChangeset->GetChangesetId().c_str(), m_db->Txns().GetParentChangesetId().c_str());
+    for (size_t i = 0; i < elementIds.size() - 1; ++i)
+        EXPECT_TRUE(m_db->Elements().GetElement(elementIds[i]).IsValid());
+    EXPECT_FALSE(m_db->Elements().GetElement(elementIds.back()).IsValid());
+
+    for (auto const& changeset : changesets)
+        EXPECT_GT(changeset->GetUncompressedSize(), 0);
+
+    // without prefetching, each changeset is prepared right before it is applied
+    RestoreTestFile();
+    for (auto const& changeset : changesets)
+        changeset->SetUncompressedSize(0);
+    EXPECT_EQ(ChangesetStatus::Success, m_db->Txns().MergeChangesets(changesets, false, false, 0));
+    EXPECT_STREQ(lastChangeset->GetChangesetId().c_str(), m_db->Txns().GetParentChangesetId().c_str());
+    for (size_t i = 0; i < elementIds.size() - 1; ++i)
+        EXPECT_TRUE(m_db->Elements().GetElement(elementIds[i]).IsValid());
+    EXPECT_FALSE(m_db->Elements().GetElement(elementIds.back()).IsValid());
+    for (auto const& changeset : changesets)
+        EXPECT_GT(changeset->GetUncompressedSize(), 0);
+
+    // with a budget too small to hold any changeset, each one is hashed and applied by streaming from its file
+    RestoreTestFile();
+    for (auto const& changeset : changesets)
+        changeset->SetUncompressedSize(0);
+    EXPECT_EQ(ChangesetStatus::Success, m_db->Txns().MergeChangesets(changesets, false, false, 2, 1));
+    EXPECT_STREQ(lastChangeset->GetChangesetId().c_str(), m_db->Txns().GetParentChangesetId().c_str());
+    for (size_t i = 0; i < elementIds.size() - 1; ++i)
+        EXPECT_TRUE(m_db->Elements().GetElement(elementIds[i]).IsValid());
+    EXPECT_FALSE(m_db->Elements().GetElement(elementIds.back()).IsValid());
+    for (auto const& changeset : changesets)
+        EXPECT_EQ(0, changeset->GetUncompressedSize());
+
+    // out of order changesets are rejected before anything is applied
+    RestoreTestFile();
+    std::vector<ChangesetPropsPtr> outOfOrder = {changesets[1], changesets[0]};
+    expectToThrow([&]() { m_db->Txns().MergeChangesets(outOfOrder, false); }, "changeset out of order");
+    EXPECT_FALSE(m_db->Elements().GetElement(elementIds.front()).IsValid());
+
+    // a malformed parent id is reported as such, as it is by MergeChangeset
+    RestoreTestFile();
+    ChangesetPropsCPtr first = changesets.front();
+    std::vector<ChangesetPropsPtr> badParent = {new ChangesetProps(first->GetChangesetId(), first->GetChangesetIndex(), "not-a-sha1", first->GetDbGuid(), first->GetFileName(), first->GetChangesetType())};
+    expectToThrow([&]() { m_db->Txns().MergeChangesets(badParent, false); }, "Invalid parent changeset id. Expect empty or SHA1 hash");
+    EXPECT_FALSE(m_db->Elements().GetElement(elementIds.front()).IsValid());
+    }
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
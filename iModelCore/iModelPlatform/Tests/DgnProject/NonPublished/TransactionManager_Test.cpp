@@ -1122,4 +1122,56 @@ TEST_F(TransactionManagerTests, FileBasedTxnMixedMode)
     stat = txns.ReinstateTxn();
     EXPECT_EQ(DgnDbStatus::Success, stat);
     EXPECT_TRUE(m_db->Elements().GetElement(el2->GetElementId()).IsValid());
+}
+
+/*---------------------------------------------------------------------------------**//**
+* Test file-based txns written with different codecs coexist
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(TransactionManagerTests, FileBasedTxnCodecs)
+{
+    SetupSeedProject(BeSQLite::Db::OpenMode::ReadWrite, true /*=needBriefcase*/);
+    auto& txns = m_db->Txns();
+
+    ASSERT_EQ(BE_SQLITE_DONE, m_db->SaveBriefcaseLocalValue("fileBasedTxns", "1"));
+    m_db->SaveChanges();
+
+    // LZMA is the default codec
+    auto el1 = InsertElement("LzmaTxn");
+    ASSERT_TRUE(el1.IsValid());
+    m_db->SaveChanges("lzma change");
+    BeFileName lzmaFile = txns.GetTxnFilePath(txns.GetLastTxnId());
+    ASSERT_TRUE(lzmaFile.DoesPathExist());
+    EXPECT_FALSE(SnappyChangesetFileWriter::IsSnappyChangesetFile(lzmaFile));
+
+    // Unknown values keep LZMA
+    ASSERT_EQ(BE_SQLITE_DONE, m_db->SaveBriefcaseLocalValue("fileBasedTxnCodec", "lz4"));
+    m_db->SaveChanges();
+    auto el2 = InsertElement("UnknownCodecTxn");
+    ASSERT_TRUE(el2.IsValid());
+    m_db->SaveChanges("unknown codec change");
+    EXPECT_FALSE(SnappyChangesetFileWriter::IsSnappyChangesetFile(txns.GetTxnFilePath(txns.GetLastTxnId())));
+
+    // Snappy on request
+    ASSERT_EQ(BE_SQLITE_DONE, m_db->SaveBriefcaseLocalValue("fileBasedTxnCodec", "snappy"));
+    m_db->SaveChanges();
+    auto el3 = InsertElement("SnappyTxn");
+    ASSERT_TRUE(el3.IsValid());
+    m_db->SaveChanges("snappy change");
+    EXPECT_TRUE(SnappyChangesetFileWriter::IsSnappyChangesetFile(txns.GetTxnFilePath(txns.GetLastTxnId())));
+
+    // Undo and redo read each file with its own codec
+    EXPECT_EQ(DgnDbStatus::Success, txns.ReverseSingleTxn());
+    EXPECT_FALSE(m_db->Elements().GetElement(el3->GetElementId()).IsValid());
+    EXPECT_EQ(DgnDbStatus::Success, txns.ReverseSingleTxn());
+    EXPECT_FALSE(m_db->Elements().GetElement(el2->GetElementId()).IsValid());
+    EXPECT_EQ(DgnDbStatus::Success, txns.ReverseSingleTxn());
+    EXPECT_FALSE(m_db->Elements().GetElement(el1->GetElementId()).IsValid());
+
+    EXPECT_EQ(DgnDbStatus::Success, txns.ReinstateTxn());
+    EXPECT_TRUE(m_db->Elements().GetElement(el1->GetElementId()).IsValid());
+    EXPECT_EQ(DgnDbStatus::Success, txns.ReinstateTxn());
+    EXPECT_TRUE(m_db->Elements().GetElement(el2->GetElementId()).IsValid());
+    EXPECT_EQ(DgnDbStatus::Success, txns.ReinstateTxn());
+    EXPECT_TRUE(m_db->Elements().GetElement(el3->GetElementId()).IsValid());
 }
\ No newline at end of file
@@ -1342,6 +1342,63 @@ TEST_F(VersionCompareTestFixture, ChangedElementsManagerTest1)
     cacheDb.CloseDb();
     }
 
+//-------------------------------------------------------------------------------------------
+// @bsimethod
+//-------------------------------------------------------------------------------------------
+TEST_F(VersionCompareTestFixture, ChangedElementsManagerTest_Parallel)
+    {
+    // Process changesets with several workers, each summarizing a range of changesets in its own clone
+    bvector<ChangesetPropsPtr> changesets;
+    DgnDbPtr initialDb = CloneTemporaryDb(m_db);
+    ASSERT_TRUE(initialDb.IsValid());
+
+    // CHANGESETS 1-4: one insert each, and the second changeset also updates the first element
+    bvector<DgnElementPtr> elements;
+    for (int i = 0; i < 4; ++i)
+        {
+        elements.push_back(InsertPhysicalElement(Utf8PrintfString("P%d", i).c_str()));
+        if (1 == i)
+            ModifyElementPlacement(elements[0]->GetElementId());
+        changesets.push_back(CreateRevision(Utf8PrintfString("-cs%d", i + 1).c_str()));
+        }
+
+    BeFileName cacheFilename;
+    BeTest::GetHost().GetOutputRoot(cacheFilename);
+    cacheFilename.AppendToPath(L"ChangedElementsParallel.chems");
+    if (BeFileName::DoesPathExist(cacheFilename.GetName()))
+        BeFileName::BeDeleteFile(cacheFilename.GetName());
+
+    ChangedElementsManager ceMgr(initialDb);
+    ceMgr.SetWantChunkTraversal(true);
+    ceMgr.SetWorkerCount(3);
+    ECDb cacheDb;
+    EXPECT_EQ(BE_SQLITE_OK, ceMgr.CreateChangedElementsCache(cacheDb, cacheFilename));
+    EXPECT_EQ(BE_SQLITE_OK, ceMgr.ProcessChangesets(cacheDb, "Items", changesets));
+
+    // Every changeset is in the cache, with the changes made in it and nothing else
+    for (size_t i = 0; i < changesets.size(); ++i)
+        {
+        EXPECT_TRUE(ceMgr.IsProcessed(cacheDb, changesets[i]->GetChangesetId()));
+
+        ChangedElementsMap map;
+        EXPECT_EQ(BE_SQLITE_OK, ceMgr.GetChangedElements(cacheDb, map, changesets[i]->GetChangesetId(), changesets[i]->GetChangesetId()));
+        EXPECT_EQ(1 == i ? 2 : 1, map.size());
+        EXPECT_FALSE(map.find(elements[i]->GetECInstanceKey()) == map.end());
+        EXPECT_EQ(DbOpcode::Insert, map[elements[i]->GetECInstanceKey()].m_opcode);
+        if (1 == i)
+            EXPECT_EQ(DbOpcode::Update, map[elements[0]->GetECInstanceKey()].m_opcode);
+        }
+
+    // Accumulating across the ranges processed by different workers is the same as processing serially
+    ChangedElementsMap map;
+    EXPECT_EQ(BE_SQLITE_OK, ceMgr.GetChangedElements(cacheDb, map, changesets.front()->GetChangesetId(), changesets.back()->GetChangesetId()));
+    EXPECT_EQ(4, map.size());
+    for (DgnElementPtr const& element : elements)
+        EXPECT_EQ(DbOpcode::Insert, map[element->GetECInstanceKey()].m_opcode);
+
+    cacheDb.CloseDb();
+    }
+
 //-------------------------------------------------------------------------------------------
 // @bsimethod
 //-------------------------------------------------------------------------------------------
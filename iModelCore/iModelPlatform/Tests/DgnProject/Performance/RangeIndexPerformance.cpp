@@ -0,0 +1,204 @@
+/*---------------------------------------------------------------------------------------------
+* Copyright (c) Bentley Systems, Incorporated. All rights reserved.
+* See LICENSE.md in the repository root for full copyright notice.
+*--------------------------------------------------------------------------------------------*/
+#include "../TestFixture/DgnDbTestFixtures.h"
+#include <DgnPlatform/RangeIndex.h>
+#include <Bentley/BeTimeUtilities.h>
+#include <thread>
+
+USING_NAMESPACE_BENTLEY_DPTEST
+
+/*=================================================================================**//**
+* Counts the entries that overlap a box.
+* @bsiclass
++===============+===============+===============+===============+===============+======*/
+struct RangeIndexBoxCounter : RangeIndex::Traverser
+{
+    RangeIndex::FBox m_box;
+    size_t m_hits = 0;
+    mutable size_t m_nodeVisits = 0;
+    bool m_useQueryBox = false;
+    RangeIndexBoxCounter(DRange3dCR box, bool useQueryBox = false) : m_box(box, false), m_useQueryBox(useQueryBox) {}
+    bool _AbortOnWriteRequest() const override {return false;}
+    RangeIndex::FBoxCP _GetQueryBox() const override {return m_useQueryBox ? &m_box : nullptr;}
+    Accept _CheckRangeTreeNode(RangeIndex::FBoxCR range, bool is3d) const override {++m_nodeVisits; return range.IntersectsWith(m_box) ? Accept::Yes : Accept::No;}
+    Stop _VisitRangeTreeEntry(RangeIndex::EntryCR entry) override {if (entry.m_range.IntersectsWith(m_box)) ++m_hits; return Stop::No;}
+};
+
+//---------------------------------------------------------------------------------------
+// Throughput of concurrent Traverse calls from 1 to 32 reader threads while a writer keeps
+// adding and removing elements.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+TEST(RangeIndexPerformance, ConcurrentTraverse)
+    {
+    static const int GRID = 100;        // GRID^2 unit boxes
+    static const int QUERY_SIZE = 10;   // each query overlaps about QUERY_SIZE^2 entries
+    static const uint32_t RUN_MILLIS = 500;
+
+    RangeIndex::Tree tree(true, 20);
+    uint64_t nextId = 1;
+    for (int x = 0; x < GRID; ++x)
+        for (int y = 0; y < GRID; ++y)
+            tree.AddEntry(RangeIndex::Entry(RangeIndex::FBox(DRange3d::From(x, y, 0, x + .5, y + .5, .5), false), DgnElementId(nextId++)));
+    const size_t initialCount = tree.GetCount();
+
+    for (int readers : {1, 2, 4, 8, 16, 32})
+        {
+        std::atomic<bool> stop(false);
+        std::atomic<uint64_t> traversals(0);
+        std::atomic<uint64_t> writes(0);
+        std::vector<std::thread> threads;
+        for (int r = 0; r < readers; ++r)
+            {
+            threads.emplace_back([&, r]()
+                {
+                uint64_t count = 0;
+                int offset = r;
+                while (!stop.load(std::memory_order_relaxed))
+                    {
+                    offset = (offset * 31 + 7) % (GRID - QUERY_SIZE);
+                    RangeIndexBoxCounter counter(DRange3d::From(offset, offset, 0, offset + QUERY_SIZE, offset + QUERY_SIZE, 1));
+                    tree.Traverse(counter);
+                    EXPECT_GE(counter.m_hits, (size_t) QUERY_SIZE * QUERY_SIZE);
+                    ++count;
+                    }
+                traversals.fetch_add(count);
+                });
+            }
+
+        std::thread writer([&]()
+            {
+            uint64_t id = nextId + 1000000;
+            while (!stop.load(std::memory_order_relaxed))
+                {
+                tree.AddEntry(RangeIndex::Entry(RangeIndex::FBox(DRange3d::From(1, 1, 0, 2, 2, 1), false), DgnElementId(id)));
+                EXPECT_EQ(SUCCESS, tree.RemoveElement(DgnElementId(id)));
+                ++id;
+                writes.fetch_add(1);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            });
+
+        StopWatch timer(true);
+        std::this_thread::sleep_for(std::chrono::milliseconds(RUN_MILLIS));
+        stop.store(true);
+        for (auto& thread : threads)
+            thread.join();
+        writer.join();
+        timer.Stop();
+
+        EXPECT_EQ(initialCount, tree.GetCount());
+        EXPECT_GT(writes.load(), 0u);
+        Utf8PrintfString description("RangeIndex Traverse with %d reader thread(s) and one writer: %.0f traversals/s (%" PRIu64 " writes)",
+            readers, traversals.load() / timer.GetElapsedSeconds(), writes.load());
+        LOGTODB(TEST_DETAILS, timer.GetElapsedSeconds(), (int) traversals.load(), description.c_str());
+        }
+    }
+
+//---------------------------------------------------------------------------------------
+// Build time and query cost (node visits) of a tree built with BulkLoad versus one built
+// with one AddEntry call per element, for the same scattered entries.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+TEST(RangeIndexPerformance, BulkLoadVersusIncremental)
+    {
+    static const int QUERIES = 1000;
+
+    for (int grid : {100, 300, 1000})
+        {
+        // visit the grid cells in a scrambled order, as element ids rarely follow spatial locality.
+        bvector<RangeIndex::Entry> entries;
+        const uint64_t cells = (uint64_t) grid * grid;
+        for (uint64_t i = 0; i < cells; ++i)
+            {
+            uint64_t cell = (i * 7919) % cells;
+            double x = (double) (cell % grid), y = (double) (cell / grid);
+            entries.push_back(RangeIndex::Entry(RangeIndex::FBox(DRange3d::From(x, y, 0, x + .5, y + .5, .5), false), DgnElementId(i + 1)));
+            }
+
+        RangeIndex::Tree incremental(true, 20);
+        StopWatch incrementalTimer(true);
+        for (auto const& entry : entries)
+            incremental.AddEntry(entry);
+        incrementalTimer.Stop();
+
+        RangeIndex::Tree packed(true, 20);
+        StopWatch packedTimer(true);
+        EXPECT_EQ(SUCCESS, packed.BulkLoad(entries));
+        packedTimer.Stop();
+
+        ASSERT_EQ(incremental.GetCount(), packed.GetCount());
+        ASSERT_EQ(ERROR, packed.BulkLoad(entries));
+
+        size_t incrementalVisits = 0, packedVisits = 0;
+        for (int q = 0; q < QUERIES; ++q)
+            {
+            double offset = (double) ((q * 31) % (grid - 5));
+            DRange3d box = DRange3d::From(offset, offset, 0, offset + 5, offset + 5, 1);
+            RangeIndexBoxCounter incrementalCounter(box), packedCounter(box);
+            incremental.Traverse(incrementalCounter);
+            packed.Traverse(packedCounter);
+            EXPECT_EQ(incrementalCounter.m_hits, packedCounter.m_hits);
+            incrementalVisits += incrementalCounter.m_nodeVisits;
+            packedVisits += packedCounter.m_nodeVisits;
+            }
+
+        Utf8PrintfString incrementalDescription("RangeIndex AddEntry of %" PRIu64 " entries: %" PRIu64 " node visits for %d queries", cells, (uint64_t) incrementalVisits, QUERIES);
+        LOGTODB(TEST_DETAILS, incrementalTimer.GetElapsedSeconds(), (int) cells, incrementalDescription.c_str());
+        Utf8PrintfString packedDescription("RangeIndex BulkLoad of %" PRIu64 " entries: %" PRIu64 " node visits for %d queries", cells, (uint64_t) packedVisits, QUERIES);
+        LOGTODB(TEST_DETAILS, packedTimer.GetElapsedSeconds(), (int) cells, packedDescription.c_str());
+        }
+    }
+
+//---------------------------------------------------------------------------------------
+// Box queries through a traverser that reports its query box, so that the entries of each
+// leaf are tested against it in one batch, versus one that tests each entry itself.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+TEST(RangeIndexPerformance, BatchedOverlapTest)
+    {
+    static const int GRID = 500;
+    static const int QUERIES = 2000;
+
+    RangeIndex::Tree tree(true, 20);
+    uint64_t nextId = 1;
+    for (int x = 0; x < GRID; ++x)
+        for (int y = 0; y < GRID; ++y)
+            tree.AddEntry(RangeIndex::Entry(RangeIndex::FBox(DRange3d::From(x, y, 0, x + .5, y + .5, .5), false), DgnElementId(nextId++)));
+
+    // remove every third entry so that leaves have been compacted at least once.
+    for (uint64_t id = 1; id < nextId; id += 3)
+        ASSERT_EQ(SUCCESS, tree.RemoveElement(DgnElementId(id)));
+
+    for (int querySize : {2, 20, 100})
+        {
+        size_t perEntryHits = 0, batchedHits = 0;
+        StopWatch perEntryTimer(true);
+        for (int q = 0; q < QUERIES; ++q)
+            {
+            double offset = (double) ((q * 31) % (GRID - querySize));
+            RangeIndexBoxCounter counter(DRange3d::From(offset, offset, 0, offset + querySize, offset + querySize, 1));
+            tree.Traverse(counter);
+            perEntryHits += counter.m_hits;
+            }
+        perEntryTimer.Stop();
+
+        StopWatch batchedTimer(true);
+        for (int q = 0; q < QUERIES; ++q)
+            {
+            double offset = (double) ((q * 31) % (GRID - querySize));
+            RangeIndexBoxCounter counter(DRange3d::From(offset, offset, 0, offset + querySize, offset + querySize, 1), true);
+            tree.Traverse(counter);
+            batchedHits += counter.m_hits;
+            }
+        batchedTimer.Stop();
+
+        EXPECT_EQ(perEntryHits, batchedHits);
+        Utf8PrintfString perEntryDescription("RangeIndex %d box queries of size %d, entries tested one at a time", QUERIES, querySize);
+        LOGTODB(TEST_DETAILS, perEntryTimer.GetElapsedSeconds(), QUERIES, perEntryDescription.c_str());
+        Utf8PrintfString batchedDescription("RangeIndex %d box queries of size %d, entries tested in batches", QUERIES, querySize);
+        LOGTODB(TEST_DETAILS, batchedTimer.GetElapsedSeconds(), QUERIES, batchedDescription.c_str());
+        }
+    }
@@ -0,0 +1,66 @@
+/*---------------------------------------------------------------------------------------------
+* Copyright (c) Bentley Systems, Incorporated. All rights reserved.
+* See LICENSE.md in the repository root for full copyright notice.
+*--------------------------------------------------------------------------------------------*/
+#include "../TestFixture/DgnDbTestFixtures.h"
+#include <Bentley/BeTimeUtilities.h>
+
+USING_NAMESPACE_BENTLEY_SQLITE
+USING_NAMESPACE_BENTLEY_DPTEST
+
+/*=================================================================================**//**
+* @bsiclass
++===============+===============+===============+===============+===============+======*/
+struct TxnCommitPerformanceTest : public DgnDbTestFixture
+{
+    //! Insert elementCount elements, then time the SaveChanges call that commits them as one txn.
+    double TimeCommit(int elementCount, Utf8CP prefix)
+        {
+        for (int i = 0; i < elementCount; ++i)
+            {
+            Utf8PrintfString code("%s-%d", prefix, i);
+            TestElementPtr element = TestElement::Create(*m_db, m_defaultModelId, m_defaultCategoryId, code.c_str());
+            element->SetUserLabel(code.c_str());
+            EXPECT_TRUE(m_db->Elements().Insert(*element).IsValid());
+            }
+
+        StopWatch timer(true);
+        EXPECT_EQ(BE_SQLITE_OK, m_db->SaveChanges(prefix));
+        timer.Stop();
+        return timer.GetElapsedSeconds();
+        }
+};
+
+//---------------------------------------------------------------------------------------
+// SaveChanges latency of a briefcase that stores txns in the database, in LZMA .txn files
+// (the default for file-based txns) and in Snappy .txn files.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+TEST_F(TxnCommitPerformanceTest, FileBasedTxnCommit)
+    {
+    static const int COMMITS = 5;
+
+    SetupSeedProject(BeSQLite::Db::OpenMode::ReadWrite, true /*=needBriefcase*/);
+
+    for (int elementCount : {1000, 10000, 50000})
+        {
+        for (Utf8CP codec : {"", "lzma", "snappy"})
+            {
+            bool fileBased = 0 != *codec;
+            ASSERT_EQ(BE_SQLITE_DONE, m_db->SaveBriefcaseLocalValue("fileBasedTxns", fileBased ? "1" : "0"));
+            ASSERT_EQ(BE_SQLITE_DONE, m_db->SaveBriefcaseLocalValue("fileBasedTxnCodec", fileBased ? codec : "lzma"));
+            m_db->SaveChanges();
+
+            double seconds = 0;
+            for (int commit = 0; commit < COMMITS; ++commit)
+                seconds += TimeCommit(elementCount, Utf8PrintfString("%s-%d-%d", fileBased ? codec : "db", elementCount, commit).c_str());
+
+            if (fileBased)
+                EXPECT_EQ(0 == strcmp(codec, "snappy"), SnappyChangesetFileWriter::IsSnappyChangesetFile(m_db->Txns().GetTxnFilePath(m_db->Txns().GetLastTxnId())));
+
+            Utf8PrintfString description("TxnManager SaveChanges of %d inserted elements with txns stored %s: %.2f ms per commit",
+                elementCount, fileBased ? Utf8PrintfString("in %s .txn files", codec).c_str() : "in the database", 1000.0 * seconds / COMMITS);
+            LOGTODB(TEST_DETAILS, seconds, COMMITS, description.c_str());
+            }
+        }
+    }
@@ -145,6 +145,10 @@ protected:
 
     // Invoked by Napi::AsyncWorker::Execute if DgnDbWorker::Execute is not called because IsCanceled returns true.
     virtual void OnSkipped() { SetError("The operation was canceled"); }
+
+    // Invoked on the thread that calls Cancel, after the worker has been flagged as canceled. Lets an Execute that
+    // waits on something other than the DgnDb wake up and return.
+    virtual void OnCanceled() { }
 public:
     // Construct only on the main thread.
     DgnDbWorker(DgnDbR db, Napi::Env env);
@@ -154,7 +158,7 @@ public:
     Napi::Promise Queue();
 
     // Cancel the worker's scheduled execution if it has not already begun executing.
-    void Cancel() { m_canceled.store(true); }
+    void Cancel() { m_canceled.store(true); OnCanceled(); }
     bool IsCanceled() override { return m_canceled.load(); }
 
     DgnDbR GetDb() const;
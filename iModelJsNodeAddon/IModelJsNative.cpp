@@ -470,6 +470,10 @@ public:
         auto& db = GetOpenedDb(info);
         return JsInterop::ReadInstance(db, info);
     }
+    Napi::Value ReadInstances(NapiInfoCR info) {
+        auto& db = GetOpenedDb(info);
+        return JsInterop::ReadInstances(db, info);
+    }
     Napi::Value InsertInstance(NapiInfoCR info) {
         auto& db = GetOpenedDb(info);
         return JsInterop::InsertInstance(db, info);
@@ -492,6 +496,10 @@ public:
     void ConcurrentQueryShutdown(NapiInfoCR info) {
         ConcurrentQueryMgr::Shutdown(m_ecdb);
     }
+    Napi::Value ConcurrentQueryStats(NapiInfoCR info) {
+        OPTIONAL_ARGUMENT_BOOL(0, reset, false);
+        return JsInterop::ConcurrentQueryStats(GetOpenedDb(info), Env(), reset);
+    }
     void CloseDbIfOpen() {
         if (m_ecdb.IsDbOpen()) {
             m_ecdb.AbandonChanges();
@@ -653,6 +661,7 @@ public:
             InstanceMethod("concurrentQueryExecute", &NativeECDb::ConcurrentQueryExecute),
             InstanceMethod("concurrentQueryResetConfig", &NativeECDb::ConcurrentQueryResetConfig),
             InstanceMethod("concurrentQueryShutdown", &NativeECDb::ConcurrentQueryShutdown),
+            InstanceMethod("concurrentQueryStats", &NativeECDb::ConcurrentQueryStats),
             InstanceMethod("createDb", &NativeECDb::CreateDb),
             InstanceMethod("dispose", &NativeECDb::Dispose),
             InstanceMethod("dropSchemas", &NativeECDb::DropSchemas),
@@ -672,6 +681,7 @@ public:
             InstanceMethod("schemaSyncGetSyncDbInfo", &NativeECDb::SchemaSyncGetSyncDbInfo),
             InstanceMethod("openDb", &NativeECDb::OpenDb),
             InstanceMethod("readInstance", &NativeECDb::ReadInstance),
+            InstanceMethod("readInstances", &NativeECDb::ReadInstances),
             InstanceMethod("insertInstance", &NativeECDb::InsertInstance),
             InstanceMethod("updateInstance", &NativeECDb::UpdateInstance),
             InstanceMethod("deleteInstance", &NativeECDb::DeleteInstance),
@@ -1691,6 +1701,8 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps<DgnDb>
             jsObj.Set("changesetIndex", Napi::Number::New(env, changeset["changeset_index"].asUInt()));
             jsObj.Set("uncompressedSizeBytes", Napi::Number::New(env, changeset["uncompressed_size_bytes"].asUInt()));
             jsObj.Set("sha1ValidationTimeMs", Napi::Number::New(env, changeset["sha1_validation_time_ms"].asUInt()));
+            jsObj.Set("decompressTimeMs", Napi::Number::New(env, changeset["decompress_time_ms"].asUInt()));
+            jsObj.Set("prefetchWaitTimeMs", Napi::Number::New(env, changeset["prefetch_wait_time_ms"].asUInt()));
             jsObj.Set("insertedRows", Napi::Number::New(env, changeset["inserted_rows"].asUInt()));
             jsObj.Set("updatedRows", Napi::Number::New(env, changeset["updated_rows"].asUInt()));
             jsObj.Set("deletedRows", Napi::Number::New(env, changeset["deleted_rows"].asUInt()));
@@ -1835,6 +1847,39 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps<DgnDb>
         return results;
     }
 
+    // Typed array variants of the above: points are packed x,y,z in a Float64Array and the result is {coords: Float64Array, statuses: Int32Array}.
+    Napi::Value ConvertCoordsArray(NapiInfoCR info, void (*convert)(DPoint3dP, ReprojectStatus*, DPoint3dCP, size_t, DgnDbR, Utf8StringCR)) {
+        if (info.Length() < 1 || !info[0].IsTypedArray() || info[0].As<Napi::TypedArray>().TypedArrayType() != napi_float64_array) {
+            THROW_JS_IMODEL_NATIVE_EXCEPTION(info.Env(), "expect Float64Array argument", IModelJsNativeErrorKey::BadArg);
+        }
+        auto input = info[0].As<Napi::Float64Array>();
+        if (0 != input.ElementLength() % 3) {
+            THROW_JS_IMODEL_NATIVE_EXCEPTION(info.Env(), "Float64Array length must be a multiple of 3", IModelJsNativeErrorKey::BadArg);
+        }
+        OPTIONAL_ARGUMENT_STRING(1, gcs);
+
+        size_t numPoints = input.ElementLength() / 3;
+        auto coords = Napi::Float64Array::New(Env(), input.ElementLength());
+        bvector<ReprojectStatus> statusList(numPoints);
+        convert(reinterpret_cast<DPoint3dP>(coords.Data()), statusList.data(), reinterpret_cast<DPoint3dCP>(input.Data()), numPoints, GetOpenedDb(info), gcs);
+
+        auto statuses = Napi::Int32Array::New(Env(), numPoints);
+        std::copy(statusList.begin(), statusList.end(), statuses.Data());
+
+        auto result = Napi::Object::New(Env());
+        result.Set("coords", coords);
+        result.Set("statuses", statuses);
+        return result;
+    }
+
+    Napi::Value GetIModelCoordsFromGeoCoordsArray(NapiInfoCR info) {
+        return ConvertCoordsArray(info, &JsInterop::GetIModelCoordsFromGeoCoords);
+    }
+
+    Napi::Value GetGeoCoordsFromIModelCoordsArray(NapiInfoCR info) {
+        return ConvertCoordsArray(info, &JsInterop::GetGeoCoordsFromIModelCoords);
+    }
+
     Napi::Value GetIModelProps(NapiInfoCR info) {
         auto& db = GetOpenedDb(info);
         OPTIONAL_ARGUMENT_STRING(0, when);
@@ -2015,6 +2060,22 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps<DgnDb>
         return JsInterop::ExportGraphicsAsync(db, exportProps);
         }
 
+    Napi::Value ExportGraphicsStream(NapiInfoCR info)
+        {
+        auto& db = GetOpenedDb(info);
+        REQUIRE_ARGUMENT_ANY_OBJ(0, exportProps);
+
+        Napi::Value onGraphicsVal = exportProps.Get("onGraphics");
+        if (!onGraphicsVal.IsFunction())
+            THROW_JS_TYPE_EXCEPTION("onGraphics must be a function");
+
+        Napi::Value elementIdArrayVal = exportProps.Get("elementIdArray");
+        if (!elementIdArrayVal.IsArray())
+            THROW_JS_TYPE_EXCEPTION("elementIdArray must be an array");
+
+        return JsInterop::ExportGraphicsStream(db, exportProps);
+        }
+
     Napi::Value ExportPartGraphicsAsync(NapiInfoCR info)
         {
         auto& db = GetOpenedDb(info);
@@ -2707,6 +2768,10 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps<DgnDb>
         auto& db = GetOpenedDb(info);
         return JsInterop::ReadInstance(db, info);
     }
+    Napi::Value ReadInstances(NapiInfoCR info) {
+        auto& db = GetOpenedDb(info);
+        return JsInterop::ReadInstances(db, info);
+    }
     Napi::Value InsertInstance(NapiInfoCR info) {
         auto& db = GetWritableDb(info);
         return JsInterop::InsertInstance(db, info);
@@ -2888,6 +2953,33 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps<DgnDb>
         return Napi::Number::New(Env(), memoryUsed);
         }
 
+    Napi::Value GetElementCacheStats(NapiInfoCR info)
+        {
+        auto& elements = GetOpenedDb(info).Elements();
+        OPTIONAL_ARGUMENT_BOOL(0, reset, false);
+        auto stats = elements.GetCacheStats();
+        if (reset)
+            elements.ResetCacheStats();
+
+        BeJsNapiObject retVal(Env());
+        retVal["hits"] = (int64_t) stats.m_hits;
+        retVal["misses"] = (int64_t) stats.m_misses;
+        retVal["evictions"] = (int64_t) stats.m_evictions;
+        retVal["count"] = (int64_t) stats.m_count;
+        retVal["bytes"] = (int64_t) stats.m_bytes;
+        return retVal;
+        }
+
+    void SetElementCacheLimits(NapiInfoCR info)
+        {
+        auto& elements = GetOpenedDb(info).Elements();
+        REQUIRE_ARGUMENT_ANY_OBJ(0, limits);
+        if (limits.Has("maxCount"))
+            elements.SetCacheSize(limits.Get("maxCount").ToNumber().Uint32Value());
+        if (limits.Has("maxBytes"))
+            elements.SetCacheMemoryBudget((uint64_t) limits.Get("maxBytes").ToNumber().Int64Value());
+        }
+
     Napi::Value StartProfiler(NapiInfoCR info)
         {
         auto& db = GetOpenedDb(info);;
@@ -2966,6 +3058,38 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps<DgnDb>
         return Napi::Boolean::New(Env(), isPaused);
     }
 
+    void EnableSqlMonitor(NapiInfoCR info)
+        {
+        auto& db = GetOpenedDb(info);
+        REQUIRE_ARGUMENT_BOOL(0, enable);
+        if (enable)
+            BeSQLite::Profiler::EnableMonitor(db);
+        else
+            BeSQLite::Profiler::DisableMonitor(db);
+        }
+
+    Napi::Value GetSqlMonitorSnapshot(NapiInfoCR info)
+        {
+        auto monitor = BeSQLite::Profiler::GetMonitor(GetOpenedDb(info));
+        if (monitor == nullptr)
+            return Env().Undefined();
+
+        OPTIONAL_ARGUMENT_INTEGER(0, topN, 20);
+        OPTIONAL_ARGUMENT_STRING(1, sortBy);
+        OPTIONAL_ARGUMENT_BOOL(2, reset, false);
+        auto order = BeSQLite::Profiler::Monitor::SortBy::TotalTime;
+        if (sortBy == "maxTime")
+            order = BeSQLite::Profiler::Monitor::SortBy::MaxTime;
+        else if (sortBy == "count")
+            order = BeSQLite::Profiler::Monitor::SortBy::Count;
+
+        BeJsNapiObject retVal(Env());
+        retVal.From(monitor->GetSnapshot(topN, order));
+        if (reset)
+            monitor->Reset();
+        return retVal;
+        }
+
     void ApplyChangeset(NapiInfoCR info) {
         auto& db = GetWritableDb(info);
         REQUIRE_ARGUMENT_ANY_OBJ(0, changeset);
@@ -2985,6 +3109,45 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps<DgnDb>
         if (ChangesetStatus::Success != stat)
             BeNapi::ThrowJsException(info.Env(), "error applying changeset", (int)stat, IModelJsNativeErrorKeyHelper::GetITwinError(IModelJsNativeErrorKey::ChangesetError));
     }
+    Napi::Value ApplyChangesets(NapiInfoCR info) {
+        auto& db = GetWritableDb(info);
+        if (info.Length() < 1 || !info[0].IsArray()) {
+            THROW_JS_TYPE_EXCEPTION("Argument 0 must be an array of changesets props")
+        }
+        REQUIRE_ARGUMENT_BOOL(1, fastForward);
+        OPTIONAL_ARGUMENT_BOOL(2, noUpdateLoop, false);
+        OPTIONAL_ARGUMENT_UINTEGER(3, prefetchCount, 2);
+
+        std::vector<ChangesetPropsPtr> changesets;
+        Napi::Array arr = info[0].As<Napi::Array>();
+        for (uint32_t arrIndex = 0; arrIndex < arr.Length(); ++arrIndex) {
+            Napi::Value arrValue = arr[arrIndex];
+            if (!arrValue.IsObject()) {
+                THROW_JS_TYPE_EXCEPTION("Expect an object in the array")
+            }
+            changesets.push_back(JsInterop::GetChangesetProps(db.GetDbGuid().ToString(), arrValue));
+        }
+
+        ChangesetStatus stat = db.Txns().MergeChangesets(changesets, fastForward, noUpdateLoop, prefetchCount);
+        if (ChangesetStatus::Success != stat)
+            BeNapi::ThrowJsException(info.Env(), "error applying changeset", (int)stat, IModelJsNativeErrorKeyHelper::GetITwinError(IModelJsNativeErrorKey::ChangesetError));
+
+        auto env = info.Env();
+        auto timings = Napi::Array::New(env, changesets.size());
+        for (uint32_t i = 0; i < changesets.size(); ++i) {
+            auto const& changeset = *changesets[i];
+            auto jsObj = Napi::Object::New(env);
+            jsObj.Set("changesetId", Napi::String::New(env, changeset.GetChangesetId().c_str()));
+            jsObj.Set("changesetIndex", Napi::Number::New(env, changeset.GetChangesetIndex()));
+            jsObj.Set("uncompressedSizeBytes", Napi::Number::New(env, (double) changeset.GetUncompressedSize()));
+            jsObj.Set("decompressTimeMs", Napi::Number::New(env, changeset.GetDecompressTime()));
+            jsObj.Set("sha1ValidationTimeMs", Napi::Number::New(env, changeset.GetSha1ValidationTime()));
+            jsObj.Set("prefetchWaitTimeMs", Napi::Number::New(env, changeset.GetPrefetchWaitTime()));
+            jsObj.Set("applyTimeMs", Napi::Number::New(env, changeset.GetApplyTime()));
+            timings.Set(i, jsObj);
+        }
+        return timings;
+    }
     void RevertTimelineChanges(NapiInfoCR info) {
         auto& db = GetWritableDb(info);
         if (info.Length() < 1 || !info[0].IsArray()) {
@@ -3037,6 +3200,11 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps<DgnDb>
     void ConcurrentQueryShutdown(NapiInfoCR info) {
         ConcurrentQueryMgr::Shutdown(GetOpenedDb(info));
     }
+
+    Napi::Value ConcurrentQueryStats(NapiInfoCR info) {
+        OPTIONAL_ARGUMENT_BOOL(0, reset, false);
+        return JsInterop::ConcurrentQueryStats(GetOpenedDb(info), Env(), reset);
+    }
     static Napi::Value ZlibCompress(NapiInfoCR info) {
         if (info.Length() < 1 || !info[0].IsTypedArray()){
             THROW_JS_IMODEL_NATIVE_EXCEPTION(info.Env(), "expect UInt8Array argument", IModelJsNativeErrorKey::BadArg);
@@ -3262,6 +3430,7 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps<DgnDb>
             InstanceMethod("addChildPropagatesChangesToParentRelationship", &NativeDgnDb::AddChildPropagatesChangesToParentRelationship),
             InstanceMethod("invalidateFontMap", &NativeDgnDb::InvalidateFontMap),
             InstanceMethod("applyChangeset", &NativeDgnDb::ApplyChangeset),
+            InstanceMethod("applyChangesets", &NativeDgnDb::ApplyChangesets),
             InstanceMethod("revertTimelineChanges", &NativeDgnDb::RevertTimelineChanges),
             InstanceMethod("attachChangeCache", &NativeDgnDb::AttachChangeCache),
             InstanceMethod("beginMultiTxnOperation", &NativeDgnDb::BeginMultiTxnOperation),
@@ -3278,6 +3447,7 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps<DgnDb>
             InstanceMethod("concurrentQueryExecute", &NativeDgnDb::ConcurrentQueryExecute),
             InstanceMethod("concurrentQueryResetConfig", &NativeDgnDb::ConcurrentQueryResetConfig),
             InstanceMethod("concurrentQueryShutdown", &NativeDgnDb::ConcurrentQueryShutdown),
+            InstanceMethod("concurrentQueryStats", &NativeDgnDb::ConcurrentQueryStats),
             InstanceMethod("createBRepGeometry", &NativeDgnDb::CreateBRepGeometry),
             InstanceMethod("createChangeCache", &NativeDgnDb::CreateChangeCache),
             InstanceMethod("createClassViewsInDb", &NativeDgnDb::CreateClassViewsInDb),
@@ -3304,6 +3474,7 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps<DgnDb>
             InstanceMethod("exportGraphics", &NativeDgnDb::ExportGraphics),
             InstanceMethod("exportPartGraphics", &NativeDgnDb::ExportPartGraphics),
             InstanceMethod("exportGraphicsAsync", &NativeDgnDb::ExportGraphicsAsync),
+            InstanceMethod("exportGraphicsStream", &NativeDgnDb::ExportGraphicsStream),
             InstanceMethod("exportPartGraphicsAsync", &NativeDgnDb::ExportPartGraphicsAsync),
             InstanceMethod("exportSchema", &NativeDgnDb::ExportSchema),
             InstanceMethod("exportSchemas", &NativeDgnDb::ExportSchemas),
@@ -3316,6 +3487,7 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps<DgnDb>
             InstanceMethod("getBriefcaseId", &NativeDgnDb::GetBriefcaseId),
             InstanceMethod("getChangesetSize", &NativeDgnDb::GetChangesetSize),
             InstanceMethod("getChangeTrackingMemoryUsed", &NativeDgnDb::GetChangeTrackingMemoryUsed),
+            InstanceMethod("getElementCacheStats", &NativeDgnDb::GetElementCacheStats),
             InstanceMethod("getCodeValueBehavior", &NativeDgnDb::GetCodeValueBehavior),
             InstanceMethod("getCurrentChangeset", &NativeDgnDb::GetCurrentChangeset),
             InstanceMethod("getCurrentTxnId", &NativeDgnDb::GetCurrentTxnId),
@@ -3328,15 +3500,19 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps<DgnDb>
             InstanceMethod("patchJsonProperties", &NativeDgnDb::PatchJsonProperties),
             InstanceMethod("clearECDbCache", &NativeDgnDb::ClearECDbCache),
             InstanceMethod("resolveInstanceKey", &NativeDgnDb::ResolveInstanceKey),
+            InstanceMethod("setElementCacheLimits", &NativeDgnDb::SetElementCacheLimits),
             InstanceMethod("readInstance", &NativeDgnDb::ReadInstance),
+            InstanceMethod("readInstances", &NativeDgnDb::ReadInstances),
             InstanceMethod("insertInstance", &NativeDgnDb::InsertInstance),
             InstanceMethod("updateInstance", &NativeDgnDb::UpdateInstance),
             InstanceMethod("deleteInstance", &NativeDgnDb::DeleteInstance),
             InstanceMethod("executeSql", &NativeDgnDb::ExecuteSql),
             InstanceMethod("getFilePath", &NativeDgnDb::GetFilePath),
             InstanceMethod("getGeoCoordinatesFromIModelCoordinates", &NativeDgnDb::GetGeoCoordsFromIModelCoords),
+            InstanceMethod("getGeoCoordinatesFromIModelCoordinatesArray", &NativeDgnDb::GetGeoCoordsFromIModelCoordsArray),
             InstanceMethod("getGeometryContainment", &NativeDgnDb::GetGeometryContainment),
             InstanceMethod("getIModelCoordinatesFromGeoCoordinates", &NativeDgnDb::GetIModelCoordsFromGeoCoords),
+            InstanceMethod("getIModelCoordinatesFromGeoCoordinatesArray", &NativeDgnDb::GetIModelCoordsFromGeoCoordsArray),
             InstanceMethod("getIModelId", &NativeDgnDb::GetIModelId),
             InstanceMethod("getIModelProps", &NativeDgnDb::GetIModelProps),
             InstanceMethod("getITwinId", &NativeDgnDb::GetITwinId),
@@ -3420,6 +3596,8 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps<DgnDb>
             InstanceMethod("simplifyElementGeometry", &NativeDgnDb::SimplifyElementGeometry),
             InstanceMethod("startCreateChangeset", &NativeDgnDb::StartCreateChangeset),
             InstanceMethod("startProfiler", &NativeDgnDb::StartProfiler),
+            InstanceMethod("enableSqlMonitor", &NativeDgnDb::EnableSqlMonitor),
+            InstanceMethod("getSqlMonitorSnapshot", &NativeDgnDb::GetSqlMonitorSnapshot),
             InstanceMethod("stopProfiler", &NativeDgnDb::StopProfiler),
             InstanceMethod("schemaSyncSetDefaultUri", &NativeDgnDb::SchemaSyncSetDefaultUri),
             InstanceMethod("schemaSyncGetDefaultUri", &NativeDgnDb::SchemaSyncGetDefaultUri),
@@ -3880,6 +4058,7 @@ struct NativeChangedElementsECDb : BeObjectWrap<NativeChangedElementsECDb>
             OPTIONAL_ARGUMENT_INTEGER(10, relationshipCacheSize, 200000);
             OPTIONAL_ARGUMENT_BOOL(11, wantChunkTraversal, false);
             OPTIONAL_ARGUMENT_BOOL(12, wantBoundingBoxes, false);
+            OPTIONAL_ARGUMENT_INTEGER(13, workerCount, 1);
 
             if (GetECDb().IsReadonly())
                 return Napi::Number::New(Env(), (int) BE_SQLITE_READONLY);
@@ -3898,6 +4077,7 @@ struct NativeChangedElementsECDb : BeObjectWrap<NativeChangedElementsECDb>
             m_manager->SetRelationshipCacheSize(relationshipCacheSize);
             m_manager->SetWantChunkTraversal(wantChunkTraversal);
             m_manager->SetWantBoundingBoxes(wantBoundingBoxes);
+            m_manager->SetWorkerCount(workerCount);
 
             if (!rulesetDir.empty())
                 m_manager->SetPresentationRulesetDirectory(rulesetDir);
@@ -4211,25 +4391,9 @@ public:
             stat = m_binder->BindVirtualSet(idSet);
         else if(binderInfo.GetType() == BinderInfo::BinderType::Array && binderInfo.IsForIdSet())
         {
-            bool allElementsAdded = true;
-            for(auto it = idSet->begin(); it != idSet->end(); ++it)
-            {
-                if(!(*it).IsValid())
-                {
-                    allElementsAdded = false;
-                    break;
-                }
-                stat = m_binder->AddArrayElement().BindInt64((int64_t) (*it).GetValue());
-                if(!stat.IsSuccess())
-                {
-                    allElementsAdded = false;
-                    break;
-                }
-            }
-            if(allElementsAdded) // If even one array element has failed to be added we set the status for the entire operation as ECSqlStatus::Error
-                stat = ECSqlStatus::Success;
-            else
-                stat = ECSqlStatus::Error;
+            // The set is handed to the IdSet virtual table as sorted id runs, without a round trip through JSON
+            bool allIdsValid = std::all_of(idSet->begin(), idSet->end(), [](BeInt64Id id) { return id.IsValid(); });
+            stat = allIdsValid ? m_binder->BindVirtualSet(idSet) : ECSqlStatus::Error;
         }
         else
             stat = ECSqlStatus::Error;
@@ -434,14 +434,18 @@ struct JsInterop {
     BE_JSON_NAME(fileName)
     BE_JSON_NAME(findOrphanedBlocks)
     BE_JSON_NAME(finishedAtOrAfterTime)
+    BE_JSON_NAME(first)
     BE_JSON_NAME(fonts)
     BE_JSON_NAME(forceUseId)
     BE_JSON_NAME(globalOrigin)
     BE_JSON_NAME(guid)
+    BE_JSON_NAME(hints)
     BE_JSON_NAME(httpTimeout)
     BE_JSON_NAME(id)
     BE_JSON_NAME(index)
+    BE_JSON_NAME(indexes)
     BE_JSON_NAME(isPublic)
+    BE_JSON_NAME(last)
     BE_JSON_NAME(localFileName)
     BE_JSON_NAME(lockedBy)
     BE_JSON_NAME(lockExpireSeconds)
@@ -467,6 +471,7 @@ struct JsInterop {
     BE_JSON_NAME(rootDir)
     BE_JSON_NAME(rootSubject)
     BE_JSON_NAME(row)
+    BE_JSON_NAME(rowIdRanges)
     BE_JSON_NAME(secure)
     BE_JSON_NAME(schemaLockHeld)
     BE_JSON_NAME(schemaSyncDbUri)
@@ -479,7 +484,9 @@ struct JsInterop {
     BE_JSON_NAME(storageType)
     BE_JSON_NAME(subId)
     BE_JSON_NAME(systemFont)
+    BE_JSON_NAME(table)
     BE_JSON_NAME(tableName)
+    BE_JSON_NAME(tables)
     BE_JSON_NAME(tempFileBase)
     BE_JSON_NAME(timeout)
     BE_JSON_NAME(type)
@@ -530,6 +537,7 @@ public:
     static DgnDbStatus ExportGraphics(DgnDbR db, Napi::Object const& exportProps);
     static DgnDbStatus ExportPartGraphics(DgnDbR db, Napi::Object const& exportProps);
     static Napi::Value ExportGraphicsAsync(DgnDbR db, Napi::Object const& exportProps);
+    static Napi::Value ExportGraphicsStream(DgnDbR db, Napi::Object const& exportProps);
     static Napi::Value ExportPartGraphicsAsync(DgnDbR db, Napi::Object const& exportProps);
     static Napi::Value GenerateElementMeshes(DgnDbR, Napi::Object const&);
 
@@ -550,6 +558,7 @@ public:
     static void UpdateProjectExtents(DgnDbR dgndb, BeJsConst newExtents);
     static void UpdateIModelProps(DgnDbR dgndb, BeJsConst);
     static Napi::Value ReadInstance(ECDbR db, NapiInfoCR info);
+    static Napi::Value ReadInstances(ECDbR db, NapiInfoCR info);
     static Napi::Value InsertInstance(ECDbR db, NapiInfoCR info);
     static Napi::Value UpdateInstance(ECDbR db, NapiInfoCR info);
     static Napi::Value DeleteInstance(ECDbR db, NapiInfoCR info);
@@ -575,6 +584,8 @@ public:
 
     static BentleyStatus GetGeoCoordsFromIModelCoords(BeJsValue, DgnDbR, BeJsConst);
     static BentleyStatus GetIModelCoordsFromGeoCoords(BeJsValue, DgnDbR, BeJsConst);
+    static void GetGeoCoordsFromIModelCoords(DPoint3dP geoPoints, ReprojectStatus* statuses, DPoint3dCP iModelPoints, size_t numPoints, DgnDbR, Utf8StringCR target);
+    static void GetIModelCoordsFromGeoCoords(DPoint3dP iModelPoints, ReprojectStatus* statuses, DPoint3dCP geoPoints, size_t numPoints, DgnDbR, Utf8StringCR source);
 
     static void GetIModelProps(BeJsValue, DgnDbCR dgndb, Utf8StringCR when);
     static DgnElementIdSet FindGeometryPartReferences(bvector<Utf8String> const& partIds, bool is2d, DgnDbR db);
@@ -582,12 +593,14 @@ public:
     static void ConcurrentQueryExecute(ECDbCR ecdb, Napi::Object request, Napi::Function callback);
     static Napi::Object  ConcurrentQueryResetConfig(Napi::Env, Napi::Object);
     static Napi::Object  ConcurrentQueryResetConfig(Napi::Env);
+    static Napi::Object  ConcurrentQueryStats(ECDbCR ecdb, Napi::Env, bool reset);
     static void GetTileTree(ICancellableP, DgnDbR db, Utf8StringCR id, Napi::Function& callback);
     static void GetTileContent(ICancellableP, DgnDbR db, Utf8StringCR treeId, Utf8StringCR tileId, Napi::Function& callback);
     static void SetMaxTileCacheSize(uint64_t maxBytes);
 
     [[noreturn]] static void ThrowJsException(Utf8CP msg);
     static Json::Value ExecuteTest(DgnDbR, Utf8StringCR testName, Utf8StringCR params);
+    static Json::Value BenchmarkUnifyIndices(Utf8StringCR params);
     static NativeLogging::CategoryLogger GetNativeLogger();
 
     static Napi::Env& Env() { static Napi::Env s_env(nullptr); return s_env; }
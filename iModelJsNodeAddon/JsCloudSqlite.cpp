@@ -3,6 +3,7 @@
 * See LICENSE.md in the repository root for full copyright notice.
 *--------------------------------------------------------------------------------------------*/
 #include "IModelJsNative.h"
+#include <atomic>
 
 // cspell:ignore nblock ndirty napi ncache walfile prefetching
 
@@ -916,7 +917,11 @@ struct JsCloudPrefetch : Napi::ObjectWrap<JsCloudPrefetch> {
 
     struct PrefetchWorker : Napi::AsyncWorker {
         CloudPrefetch m_prefetch;
-        bool m_aborted = false;
+        CloudPrefetch::Hints m_hints;
+        Db m_hintsDb;
+        CloudContainerP m_container;
+        Utf8String m_dbName;
+        std::atomic<bool> m_aborted {false};
         int m_maxRequests = 6;
         int m_minRequests = 3;
         int m_timeout = 100;
@@ -930,11 +935,14 @@ struct JsCloudPrefetch : Napi::ObjectWrap<JsCloudPrefetch> {
             auto rc = m_prefetch.Init(*container, dbName);
             if (rc != BE_SQLITE_OK)
                 THROW_JS_BE_SQLITE_EXCEPTION(Env(), "error initializing prefetch", rc);
+            m_container = container;
+            m_dbName = dbName;
             if (info[2].IsObject()) {
                 BeJsValue args(info[2]);
                 m_maxRequests = std::min(30, args[JSON_NAME(nRequests)].asInt(m_maxRequests));
                 m_minRequests = std::min(30, args[JSON_NAME(minRequests)].asInt(m_minRequests));
                 m_timeout = args[JSON_NAME(timeout)].asInt(m_timeout);
+                ReadHints(args[JSON_NAME(hints)]);
             }
             m_jsPrefetch.Reset(jsObj.Value(), 1);
             // set up notification if the container is being disconnected (e.g. on exit) to stop this prefetch
@@ -943,6 +951,35 @@ struct JsCloudPrefetch : Napi::ObjectWrap<JsCloudPrefetch> {
             });
         }
 
+        void ReadHints(BeJsConst hints) {
+            if (!hints.isObject())
+                return;
+            hints[JSON_NAME(tables)].ForEachArrayMember([&](BeJsValue::ArrayIndex, BeJsConst name) {
+                m_hints.m_tables.push_back(name.asString());
+                return false;
+            });
+            hints[JSON_NAME(indexes)].ForEachArrayMember([&](BeJsValue::ArrayIndex, BeJsConst name) {
+                m_hints.m_indexes.push_back(name.asString());
+                return false;
+            });
+            hints[JSON_NAME(rowIdRanges)].ForEachArrayMember([&](BeJsValue::ArrayIndex, BeJsConst range) {
+                CloudPrefetch::Hints::RowIdRange rowIdRange;
+                rowIdRange.m_table = range[JSON_NAME(table)].asString();
+                rowIdRange.m_first = range[JSON_NAME(first)].asInt64();
+                rowIdRange.m_last = range[JSON_NAME(last)].asInt64();
+                m_hints.m_rowIdRanges.push_back(rowIdRange);
+                return false;
+            });
+        }
+
+        /**
+         * Read the hinted parts of the database through a connection of our own. Those are demand requests, so they are downloaded ahead of
+         * the blind prefetch, which backs off to `minRequests` while they're outstanding.
+         */
+        void FetchHinted() { // runs on its own thread, alongside Execute. Execute closes m_hintsDb after joining it, so it can interrupt this safely.
+            CloudPrefetch::FetchHinted(m_hintsDb, m_hints, m_container->m_cache->GetBlockSize(), [this]() { return m_aborted.load(); });
+        }
+
         ~PrefetchWorker() {
             BeAssert(!m_prefetch.IsRunning());
             if (nullptr != m_removeMe) // drop this object from listeners of disconnect from container
@@ -962,9 +999,21 @@ struct JsCloudPrefetch : Napi::ObjectWrap<JsCloudPrefetch> {
          */
         void Execute() override { // runs on worker thread
             int nRequest = m_minRequests;
+            std::thread hinted;
+            if (!m_hints.IsEmpty()) {
+                Db::OpenParams params(Db::OpenMode::Readonly);
+                auto dbName = params.SetFromContainer(m_dbName.c_str(), m_container);
+                // failing to open is not fatal, the whole database is still prefetched below
+                if (BE_SQLITE_OK == m_hintsDb.OpenBeSQLiteDb(dbName.c_str(), params))
+                    hinted = std::thread([this]() { FetchHinted(); });
+            }
+
             while (true) {
-                if (m_aborted)
+                if (m_aborted) {
+                    if (hinted.joinable())
+                        m_hintsDb.Interrupt(); // FetchHinted checks m_aborted between steps; this stops a step that is waiting for a download
                     break; // we were asked to stop from another thread
+                }
 
                 // m_prefetch.Run returns after the earlier of:
                 //  1. any prefetch request completes,
@@ -988,6 +1037,11 @@ struct JsCloudPrefetch : Napi::ObjectWrap<JsCloudPrefetch> {
                 nRequest = (stats.m_nDemand > 0) ? m_minRequests : m_maxRequests;
             }
 
+            if (hinted.joinable()) {
+                hinted.join();
+                m_hintsDb.CloseDb();
+            }
+
             BeMutexHolder lock(m_cv.GetMutex());
             m_prefetch.Stop(); // aborted, finished, or failed. Free the SQLite prefetch object
             m_cv.notify_all(); // tell waiters
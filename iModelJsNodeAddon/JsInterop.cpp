@@ -488,6 +488,22 @@ Napi::Object JsInterop::ConcurrentQueryResetConfig(Napi::Env env, Napi::Object c
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
+Napi::Object JsInterop::ConcurrentQueryStats(ECDbCR ecdb, Napi::Env env, bool reset) {
+    auto stats = Napi::Object::New(env);
+    try {
+        ConcurrentQueryMgr::WithInstance(ecdb, [&](ConcurrentQueryMgr& mgr) {
+            mgr.GetStats().ToJs(stats);
+            if (reset)
+                mgr.ResetStats();
+        });
+    } catch (std::exception const& ex) {
+        THROW_JS_IMODEL_NATIVE_EXCEPTION(env, ex.what(), IModelJsNativeErrorKey::BadArg);
+    }
+    return stats;
+}
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
 void JsInterop::ConcurrentQueryExecute(ECDbCR ecdb, Napi::Object requestObj, Napi::Function callback) {
     // The whole native operation is guarded: WithInstance throws for a closed db and Deserialize throws
     // for malformed/unsupported requests. Letting either escape into the N-API layer would call
@@ -506,7 +522,11 @@ void JsInterop::ConcurrentQueryExecute(ECDbCR ecdb, Napi::Object requestObj, Nap
                     else if (value->GetKind() == QueryResponse::Kind::ECSql) {
                         auto& resp = value->GetAsConst<ECSqlResponse>();
                         resp.ToJs(beJsResp, false);
-                        if (!resp.asJsonString().empty()) {
+                        if (resp.IsBinary()) {
+                            auto rows = Napi::Uint8Array::New(Env(), resp.GetBinaryLength());
+                            memcpy(rows.Data(), resp.GetBinaryData(), resp.GetBinaryLength());
+                            jsResp[ECSqlResponse::JData] = rows;
+                        } else if (!resp.asJsonString().empty()) {
                             auto parse = Env().Global().Get("JSON").As<Napi::Object>().Get("parse").As<Napi::Function>();
                             auto rows = Napi::String::New(Env(), resp.asJsonString());
                             jsResp[ECSqlResponse::JData] = parse({ rows });
@@ -528,10 +548,14 @@ void JsInterop::ConcurrentQueryExecute(ECDbCR ecdb, Napi::Object requestObj, Nap
                 });
                 return;
             }
-            auto threadSafeFunc = Napi::ThreadSafeFunction::New(requestObj.Env(), callback, "concurrent_query", 0, 1);
+            // a streaming request stays parked, without a worker, until JS has taken the chunk it was handed:
+            // the call below holds the stream until the JS callback has run. So at most one chunk is queued
+            // here at a time and the call never waits on JS.
+            auto threadSafeFunc = Napi::ThreadSafeFunction::New(requestObj.Env(), callback, "concurrent_query", 1, 1);
             mgr.Enqueue(std::move(request), [=](QueryResponse::Ptr value) {
+                auto hold = value->HoldStream();
                 if(threadSafeFunc.BlockingCall (
-                    [=]( Napi::Env env, Napi::Function jsCallback) {
+                    [value, hold]( Napi::Env env, Napi::Function jsCallback) {
                         // this runs from the thread safe function, which N-API invokes through a plain
                         // C callback, so nothing may be thrown out of here. Turn any failure into a
                         // pending JS exception instead of letting it reach std::terminate.
@@ -543,7 +567,11 @@ void JsInterop::ConcurrentQueryExecute(ECDbCR ecdb, Napi::Object requestObj, Nap
                             } else if (value->GetKind() ==  QueryResponse::Kind::ECSql) {
                                 auto& resp = value->GetAsConst<ECSqlResponse>();
                                 resp.ToJs(beJsResp, false);
-                                if (!resp.asJsonString().empty()) {
+                                if (resp.IsBinary()) {
+                                    auto rows = Napi::Uint8Array::New(env, resp.GetBinaryLength());
+                                    memcpy(rows.Data(), resp.GetBinaryData(), resp.GetBinaryLength());
+                                    jsResp[ECSqlResponse::JData] = rows;
+                                } else if (!resp.asJsonString().empty()) {
                                     auto parse = env.Global().Get("JSON").As<Napi::Object>().Get("parse").As<Napi::Function>();
                                     auto rows = Napi::String::New(env, resp.asJsonString());
                                     jsResp[ECSqlResponse::JData] = parse({rows});
@@ -568,7 +596,8 @@ void JsInterop::ConcurrentQueryExecute(ECDbCR ecdb, Napi::Object requestObj, Nap
                 }) != napi_ok) {
                     // do nothing
                 }
-                const_cast<Napi::ThreadSafeFunction&>(threadSafeFunc).Release();
+                if (!value->IsChunk())
+                    const_cast<Napi::ThreadSafeFunction&>(threadSafeFunc).Release();
             });
         });
     } catch (Napi::Error const&) {
@@ -1114,6 +1143,35 @@ Napi::Value JsInterop::ReadInstance(ECDbR db, NapiInfoCR info) {
     return outInstance;
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+Napi::Value JsInterop::ReadInstances(ECDbR db, NapiInfoCR info) {
+    if (ARGUMENT_IS_NOT_PRESENT(0) || !info[0].IsArray()) {
+        THROW_JS_TYPE_EXCEPTION("Argument 0 must be an array of instance keys");
+    }
+    REQUIRE_ARGUMENT_ANY_OBJ(1, argsObj);
+
+    auto& repo = db.GetInstanceRepository();
+    auto keys = BeJsValue(info[0].As<Napi::Object>());
+    auto args = BeJsValue(argsObj);
+
+    auto fmt = JsFormat::Standard;
+    if (args.isBoolMember("useJsNames") && args.asBool(false)){
+        fmt = JsFormat::JsName;
+    }
+
+    BeJsNapiObject outInstances(info.Env(), "[]");
+    auto rc = repo.ReadMany(keys, outInstances, args, fmt);
+    if (rc != BE_SQLITE_ROW) {
+        if (repo.GetLastError().empty()) {
+            THROW_JS_BE_SQLITE_EXCEPTION(info.Env(), "Failed to read instances", rc);
+        }
+        THROW_JS_BE_SQLITE_EXCEPTION(info.Env(), repo.GetLastError().c_str(), rc);
+    }
+    return outInstances;
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
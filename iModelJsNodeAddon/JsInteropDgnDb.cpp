@@ -1459,59 +1459,73 @@ static void populateGeoCoordResult(BeJsValue result, bvector<DPoint3d> const& po
     }
 
 //---------------------------------------------------------------------------------------
+// Converts iModel coordinates to the target GCS, or to the lat/long of the iModel GCS when target is empty.
+// All points go through the array conversions of BaseGCS so the per-GCS setup is only done once.
 // @bsimethod
 //---------------------------------------------------------------------------------------
-BentleyStatus JsInterop::GetGeoCoordsFromIModelCoords(BeJsValue results, DgnDbR dgnDb, BeJsConst props)
+void JsInterop::GetGeoCoordsFromIModelCoords(DPoint3dP geoPoints, ReprojectStatus* statuses, DPoint3dCP iModelPoints, size_t numPoints, DgnDbR dgnDb, Utf8StringCR target)
     {
-    // get the vector of points.
-    bvector<DPoint3d> iModelPoints;
-    BeJsGeomUtils::DPoint3dVectorFromJson(iModelPoints, props[json_iModelCoords()]);
+    auto gcs = dgnDb.GeoLocation().GetDgnGCS();
+    GeoCoordinates::BaseGCSP targetGCS = target.empty() ? nullptr : BaseGCSCache::GetGCSP(target, dgnDb);
 
-    // create return vectors.
-    bvector<DPoint3d> geoPoints(iModelPoints.size());
-    bvector<ReprojectStatus> statusList(geoPoints.size());
+    // No iModel GCS or invalid target
+    if (nullptr == gcs || !gcs->IsValid() || (!target.empty() && nullptr == targetGCS))
+        {
+        std::fill(statuses, statuses + numPoints, ReprojectStatus::REPROJECT_BadArgument);
+        return;
+        }
 
-    // get the GCS
-    Utf8String target = props[json_target()].asString();
-    GeoCoordinates::BaseGCSP targetGCS = nullptr;
+    bvector<DPoint3d> cartesian(numPoints);
+    for (size_t i = 0; i < numPoints; ++i)
+        gcs->CartesianFromUors(cartesian[i], iModelPoints[i]);
 
+    if (nullptr != targetGCS)
+        gcs->CartesianFromCartesian(geoPoints, statuses, cartesian.data(), static_cast<int>(numPoints), *targetGCS);
+    else
+        gcs->LatLongFromCartesian(reinterpret_cast<GeoPointP>(geoPoints), statuses, cartesian.data(), static_cast<int>(numPoints));
+    }
+
+//---------------------------------------------------------------------------------------
+// Converts coordinates of the source GCS, or lat/long of the iModel GCS when source is empty, to iModel coordinates.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void JsInterop::GetIModelCoordsFromGeoCoords(DPoint3dP iModelPoints, ReprojectStatus* statuses, DPoint3dCP geoPoints, size_t numPoints, DgnDbR dgnDb, Utf8StringCR source)
+    {
     auto gcs = dgnDb.GeoLocation().GetDgnGCS();
+    GeoCoordinates::BaseGCSP sourceGCS = source.empty() ? nullptr : BaseGCSCache::GetGCSP(source, dgnDb);
 
-    bool targetValid = true;
-    if (target.length() != 0)
+    // No iModel GCS or invalid source
+    if (nullptr == gcs || !gcs->IsValid() || (!source.empty() && nullptr == sourceGCS))
         {
-        targetGCS = BaseGCSCache::GetGCSP(target, dgnDb);
-
-        if (nullptr == targetGCS)
-            targetValid = false;
+        std::fill(statuses, statuses + numPoints, ReprojectStatus::REPROJECT_BadArgument);
+        return;
         }
 
-    // If targetGCS is nullptr and target valid at this point we only want cartesian to latitude/longitude conversion switched below
+    bvector<DPoint3d> cartesian(numPoints);
+    if (nullptr != sourceGCS)
+        sourceGCS->CartesianFromCartesian(cartesian.data(), statuses, geoPoints, static_cast<int>(numPoints), *gcs);
+    else
+        gcs->CartesianFromLatLong(cartesian.data(), statuses, reinterpret_cast<GeoPointCP>(geoPoints), static_cast<int>(numPoints));
 
-    auto outputStatus = statusList.begin();
-    for (auto input = iModelPoints.begin(), output = geoPoints.begin(); input != iModelPoints.end(); input++, output++, outputStatus++)
-        {
-        if (nullptr != gcs && gcs->IsValid())
-            {
-            if (nullptr != targetGCS)
-                {
-                DPoint3d targetCartesian;
-                gcs->CartesianFromUors(targetCartesian, *input);
-                *outputStatus = gcs->CartesianFromCartesian(*output, targetCartesian, *targetGCS);
-                }
-            else
-                {
-                if (targetValid)
-                    *outputStatus = gcs->LatLongFromUors((GeoPointR) *output, *input);
-                else
-                    *outputStatus = ReprojectStatus::REPROJECT_BadArgument; // Invalid target
-                }
-            }
-        else
-            {
-            *outputStatus = ReprojectStatus::REPROJECT_BadArgument;
-            }
-        }
+    for (size_t i = 0; i < numPoints; ++i)
+        gcs->UorsFromCartesian(iModelPoints[i], cartesian[i]);
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+BentleyStatus JsInterop::GetGeoCoordsFromIModelCoords(BeJsValue results, DgnDbR dgnDb, BeJsConst props)
+    {
+    // get the vector of points.
+    bvector<DPoint3d> iModelPoints;
+    BeJsGeomUtils::DPoint3dVectorFromJson(iModelPoints, props[json_iModelCoords()]);
+
+    // create return vectors.
+    bvector<DPoint3d> geoPoints(iModelPoints.size());
+    bvector<ReprojectStatus> statusList(geoPoints.size());
+
+    // If target is empty we only want cartesian to latitude/longitude conversion
+    GetGeoCoordsFromIModelCoords(geoPoints.data(), statusList.data(), iModelPoints.data(), iModelPoints.size(), dgnDb, props[json_target()].asString());
 
     // Put the results (a point named p and a status named s) into a Json object.
     populateGeoCoordResult(results[json_geoCoords()], geoPoints, statusList);
@@ -1531,48 +1545,8 @@ BentleyStatus JsInterop::GetIModelCoordsFromGeoCoords(BeJsValue results, DgnDbR
     bvector<DPoint3d> iModelPoints(geoPoints.size());
     bvector<ReprojectStatus> statusList(geoPoints.size());
 
-    // Note that the sourceGCS will be null if the source was empty (indicating transform to self lat/long)
-    auto gcs = dgnDb.GeoLocation().GetDgnGCS();
-
-    // get the GCS
-    Utf8String source = props[json_source()].asString();
-    GeoCoordinates::BaseGCSP sourceGCS = nullptr;
-
-    bool sourceValid = true;
-    if (source.length() != 0)
-        {
-        sourceGCS = BaseGCSCache::GetGCSP(source, dgnDb);
-        if (nullptr == sourceGCS)
-            sourceValid = false;
-        }
-
-    // If sourceGCS is nullptr and source valid at this point we only want cartesian to latitude/longitude conversion switched below
-
-    auto outputStatus = statusList.begin();
-    for (auto input = geoPoints.begin(), output = iModelPoints.begin(); input != geoPoints.end(); ++input, ++output, ++outputStatus)
-        {
-        if (nullptr != gcs && gcs->IsValid())
-            {
-            DPoint3d targetCartesian;
-            // get point into the correct Datum.
-            if (nullptr != sourceGCS)
-                {
-                *outputStatus = sourceGCS->CartesianFromCartesian(targetCartesian, *input, *gcs);
-                gcs->UorsFromCartesian(*output, targetCartesian);
-                }
-            else
-                {
-                if (sourceValid)
-                    *outputStatus = gcs->UorsFromLatLong(*output, (GeoPointCR) *input);
-                else
-                    *outputStatus = ReprojectStatus::REPROJECT_BadArgument; // Invalid source
-                }
-            }
-        else
-            {
-            *outputStatus = ReprojectStatus::REPROJECT_BadArgument;
-            }
-        }
+    // If source is empty we only want latitude/longitude to cartesian conversion
+    GetIModelCoordsFromGeoCoords(iModelPoints.data(), statusList.data(), geoPoints.data(), geoPoints.size(), dgnDb, props[json_source()].asString());
 
     // Put the results (a point named p and a status named s) into a Json object.
     populateGeoCoordResult(results[json_iModelCoords()], iModelPoints, statusList);
@@ -42,23 +42,21 @@ IntermediateMesh(PolyfaceQueryCR pf, TransformCR transform, std::unique_ptr<FPoi
     uint32_t indexOffset1 = isMirrored ? 2 : 1;
     uint32_t indexOffset2 = isMirrored ? 1 : 2;
 
-    // Remove blocking, switch to zero-index, discard edge visibility
+    // Remove blocking, switch to zero-index, discard edge visibility (no sign visibility on normals).
+    // Point and normal indices share the same blocking, so strip both in a single pass.
     uint32_t srcIndexCount = (uint32_t) pf.GetPointIndexCount();
     int32_t const* srcPointIndices = pf.GetPointIndexCP();
-    for (uint32_t dst = 0, src = 0; src < srcIndexCount; src += 4, dst += 3)
-        {
-        m_pointIndices[dst]     = abs(srcPointIndices[src]) - 1;
-        m_pointIndices[dst + 1] = abs(srcPointIndices[src + indexOffset1]) - 1;
-        m_pointIndices[dst + 2] = abs(srcPointIndices[src + indexOffset2]) - 1;
-        }
-
-    // Remove blocking, switch to zero-index (no sign visibility on normals)
     int32_t const* srcNormalIndices = pf.GetNormalIndexCP();
-    for (uint32_t dst = 0, src = 0; src < srcIndexCount; src += 4, dst += 3)
+    int32_t* dstPointIndices = m_pointIndices.get();
+    int32_t* dstNormalIndices = m_normalIndices.get();
+    for (uint32_t src = 0; src < srcIndexCount; src += 4, dstPointIndices += 3, dstNormalIndices += 3)
         {
-        m_normalIndices[dst]        = srcNormalIndices[src] - 1;
-        m_normalIndices[dst + 1]    = srcNormalIndices[src + indexOffset1] - 1;
-        m_normalIndices[dst + 2]    = srcNormalIndices[src + indexOffset2] - 1;
+        dstPointIndices[0]  = abs(srcPointIndices[src]) - 1;
+        dstPointIndices[1]  = abs(srcPointIndices[src + indexOffset1]) - 1;
+        dstPointIndices[2]  = abs(srcPointIndices[src + indexOffset2]) - 1;
+        dstNormalIndices[0] = srcNormalIndices[src] - 1;
+        dstNormalIndices[1] = srcNormalIndices[src + indexOffset1] - 1;
+        dstNormalIndices[2] = srcNormalIndices[src + indexOffset2] - 1;
         }
 
     // No work needed for params - if necessary, mirroring transform is applied at creation time in _ProcessPolyface
@@ -70,12 +68,22 @@ IntermediateMesh(PolyfaceQueryCR pf, TransformCR transform, std::unique_ptr<FPoi
     isIdentity = normalMatrix.IsIdentity(); // check if it was just translation
     if (!isIdentity) normalMatrix.Invert();
 
+    // Hoist the identity check out of the loop so the common untransformed case is a straight narrowing copy
     DPoint3dCP srcNormals = pf.GetNormalCP();
+    FPoint3d* dstNormals = m_normals.get();
+    if (isIdentity)
+        {
+        for (uint32_t i = 0; i < m_normalCount; ++i)
+            dstNormals[i] = FPoint3d::From(srcNormals[i]);
+        return;
+        }
+
     for (uint32_t i = 0; i < m_normalCount; ++i)
         {
         DPoint3d tmpNormal = srcNormals[i];
-        if (!isIdentity) { normalMatrix.MultiplyTranspose(tmpNormal); tmpNormal.Normalize(); }
-        m_normals[i] = FPoint3d::From(tmpNormal);
+        normalMatrix.MultiplyTranspose(tmpNormal);
+        tmpNormal.Normalize();
+        dstNormals[i] = FPoint3d::From(tmpNormal);
         }
     }
 }; // IntermediateMesh
@@ -90,12 +98,20 @@ bvector<double>     points;
 bvector<float>      normals;
 bvector<float>      params;
 
+// Grow geometrically rather than to the exact size requested - many small polyfaces are often bucketed into one mesh,
+// and reserving exactly for each of them would reallocate on every call.
+template<typename T> static void ReserveAtLeast(bvector<T>& v, size_t count)
+    {
+    if (count > v.capacity())
+        v.reserve(std::max(count, v.capacity() * 2));
+    }
+
 void AddVertex(DPoint3dCR p, FPoint3dCR n, FPoint2dCR uv)
     {
     indices.push_back((int32_t)points.size() / 3);
-    points.insert(points.end(), { p.x, p.y, p.z });
-    normals.insert(normals.end(), { n.x, n.y, n.z });
-    params.insert(params.end(), { uv.x, uv.y });
+    points.push_back(p.x); points.push_back(p.y); points.push_back(p.z);
+    normals.push_back(n.x); normals.push_back(n.y); normals.push_back(n.z);
+    params.push_back(uv.x); params.push_back(uv.y);
     }
 };
 
@@ -114,13 +130,14 @@ static void unifyIndices(IntermediateMesh const& inMesh, ExportGraphicsMesh& out
     std::unique_ptr<Node[]> remapper(new Node[inMesh.m_pointCount]);
     memset(remapper.get(), 0, sizeof(Node) * inMesh.m_pointCount);
 
-    // Reserve for at least best case compression
-    outMesh.points.reserve(outMesh.points.size() + inMesh.m_pointCount * 3);
-    outMesh.normals.reserve(outMesh.normals.size() + inMesh.m_pointCount * 3);
-    outMesh.params.reserve(outMesh.params.size() + inMesh.m_pointCount * 2);
-
+    // Indices are bounded by the input index count. Vertices are reserved for the best case (no seams) and grow from
+    // there as needed - sizing them for the worst case would zero-fill several times the memory most meshes use.
     uint32_t indexCount = inMesh.m_indexCount;
-    outMesh.indices.reserve(outMesh.indices.size() + indexCount);
+    size_t vertexCount = outMesh.points.size() / 3 + inMesh.m_pointCount;
+    ExportGraphicsMesh::ReserveAtLeast(outMesh.indices, outMesh.indices.size() + indexCount);
+    ExportGraphicsMesh::ReserveAtLeast(outMesh.points, vertexCount * 3);
+    ExportGraphicsMesh::ReserveAtLeast(outMesh.normals, vertexCount * 3);
+    ExportGraphicsMesh::ReserveAtLeast(outMesh.params, vertexCount * 2);
 
     constexpr static float UV_TOLERANCE = 0.00025; // ~1 pixel at 4K
 
@@ -922,16 +939,17 @@ static void convertPartInstances(Napi::Env& env, Napi::Array& napiArray, DgnElem
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
+// Mimic GeometrySelector3d in Tile.cpp - just get the element bits we need and dodge
+// the mutex contention that comes with loading full elements.
+static const Utf8CP s_selectGeometrySql = "SELECT CategoryId,GeometryStream,Yaw,Pitch,Roll,Origin_X,Origin_Y,Origin_Z,"
+    "BBoxLow_X,BBoxLow_Y,BBoxLow_Z,BBoxHigh_X,BBoxHigh_Y,BBoxHigh_Z FROM "
+    BIS_TABLE(BIS_CLASS_GeometricElement3d) " WHERE ElementId=?";
+
 static BeSQLite::CachedStatementPtr getSelectStatement(DgnDbR db)
     {
-    // Mimic GeometrySelector3d in Tile.cpp - just get the element bits we need and dodge
-    // the mutex contention that comes with loading full elements.
-    const Utf8CP sql = "SELECT CategoryId,GeometryStream,Yaw,Pitch,Roll,Origin_X,Origin_Y,Origin_Z,"
-        "BBoxLow_X,BBoxLow_Y,BBoxLow_Z,BBoxHigh_X,BBoxHigh_Y,BBoxHigh_Z FROM "
-        BIS_TABLE(BIS_CLASS_GeometricElement3d) " WHERE ElementId=?";
-    return db.GetCachedStatement(sql);
+    return db.GetCachedStatement(s_selectGeometrySql);
     }
-static Placement3d getPlacement(BeSQLite::CachedStatement& stmt)
+static Placement3d getPlacement(BeSQLite::Statement& stmt)
     {
     Angle yaw   = Angle::FromDegrees(stmt.GetValueDouble(2));
     Angle pitch = Angle::FromDegrees(stmt.GetValueDouble(3));
@@ -946,6 +964,32 @@ static Placement3d getPlacement(BeSQLite::CachedStatement& stmt)
 
 namespace {
 
+// The options of an ExportGraphics request that apply to every element. Read from the request props on the main thread.
+struct ExportGraphicsOptions
+{
+    IFacetOptionsPtr    m_facetOptions;
+    double              m_decimationTolerance = 0.0;
+    double              m_minLineStyleComponentSize = 0.0;
+    bool                m_saveInstances = false;
+    bool                m_generateLines = false;
+
+    explicit ExportGraphicsOptions(Napi::Object const& exportProps)
+        {
+        m_facetOptions = createFacetOptions(exportProps);
+
+        Napi::Number napiMinLineStyleComponentSize = exportProps.Get("minLineStyleComponentSize").As<Napi::Number>();
+        if (napiMinLineStyleComponentSize.IsNumber())
+            m_minLineStyleComponentSize = napiMinLineStyleComponentSize.DoubleValue();
+
+        Napi::Number napiDecimationTolerance = exportProps.Get("decimationTol").As<Napi::Number>();
+        if (napiDecimationTolerance.IsNumber())
+            m_decimationTolerance = napiDecimationTolerance.DoubleValue();
+
+        m_saveInstances = exportProps.Get("partInstanceArray").IsArray();
+        m_generateLines = exportProps.Get("onLineGraphics").IsFunction();
+        }
+};
+
 struct ExportGraphicsJob
 {
 private:
@@ -967,23 +1011,38 @@ ExportGraphicsJob(DgnDbR db, IFacetOptionsPtr fo, DgnElementId elId, bool saveIn
     }
 
 public:
+    // Loads the geometry of one element into a new job, or returns nullptr if the element has no 3d geometry.
+    // This does not touch Javascript, so it may be invoked in a worker thread with a statement owned by that thread.
+static std::unique_ptr<ExportGraphicsJob> Load(DgnDbR db, BeSQLite::Statement& stmt, ExportGraphicsOptions const& options, DgnElementId elementId)
+    {
+    // Mimic GeometrySelector3d in Tile.cpp
+    stmt.Reset();
+    stmt.BindInt64(1, elementId.GetValueUnchecked());
+    if (BeSQLite::BE_SQLITE_ROW != stmt.Step())
+        return nullptr;
+
+    GeometryStream geomStream;
+    auto status = db.Elements().LoadGeometryStream(geomStream, stmt.GetValueBlob(1), stmt.GetColumnBytes(1));
+    if (status != DgnDbStatus::Success)
+        return nullptr;
+
+    std::unique_ptr<ExportGraphicsJob> job(new ExportGraphicsJob(db, options.m_facetOptions, elementId, options.m_saveInstances,
+        options.m_decimationTolerance, options.m_generateLines, options.m_minLineStyleComponentSize));
+    job->m_geom.m_categoryId = stmt.GetValueId<DgnCategoryId>(0);
+    job->m_geom.m_placement = getPlacement(stmt);
+    job->m_geom.m_geomStream = std::move(geomStream);
+
+    job->m_context.SetDgnDb(db);
+    return job;
+    }
+
     // Creates a new job. This must be invoked in the main thread.
 static bvector<std::unique_ptr<ExportGraphicsJob>> Create(DgnDbR db, Napi::Object const& exportProps)
     {
     BeSQLite::CachedStatementPtr stmt = getSelectStatement(db);
-    IFacetOptionsPtr facetOptions = createFacetOptions(exportProps);
+    ExportGraphicsOptions options(exportProps);
     Napi::Array elementIdArray = exportProps.Get("elementIdArray").As<Napi::Array>();
 
-    double minLineStyleComponentSize = 0.0;
-    Napi::Number napiMinLineStyleComponentSize = exportProps.Get("minLineStyleComponentSize").As<Napi::Number>();
-    if (napiMinLineStyleComponentSize.IsNumber())
-        minLineStyleComponentSize = napiMinLineStyleComponentSize.DoubleValue();
-
-    double decimationTolerance = 0.0;
-    Napi::Number napiDecimationTolerance = exportProps.Get("decimationTol").As<Napi::Number>();
-    if (napiDecimationTolerance.IsNumber())
-        decimationTolerance = napiDecimationTolerance.DoubleValue();
-
     bvector<std::unique_ptr<ExportGraphicsJob>> jobs;
     jobs.reserve(elementIdArray.Length());
 
@@ -991,9 +1050,6 @@ static bvector<std::unique_ptr<ExportGraphicsJob>> Create(DgnDbR db, Napi::Objec
     Napi::Function onLineGraphicsCb = exportProps.Get("onLineGraphics").As<Napi::Function>();
     Napi::Array napiPartArray = exportProps.Get("partInstanceArray").As<Napi::Array>();
 
-    bool saveInstances = napiPartArray.IsArray();
-    bool generateLines = onLineGraphicsCb.IsFunction();
-
     auto env = exportProps.Env();
 
     for (uint32_t i = 0; i < elementIdArray.Length(); ++i)
@@ -1005,24 +1061,10 @@ static bvector<std::unique_ptr<ExportGraphicsJob>> Create(DgnDbR db, Napi::Objec
         if (!elementId.IsValid())
             continue;
 
-        // Mimic GeometrySelector3d in Tile.cpp
-        stmt->Reset();
-        stmt->BindInt64(1, elementId.GetValueUnchecked());
-        if (BeSQLite::BE_SQLITE_ROW != stmt->Step())
+        auto job = Load(db, *stmt, options, elementId);
+        if (!job)
             continue;
 
-        GeometryStream geomStream;
-        auto status = db.Elements().LoadGeometryStream(geomStream, stmt->GetValueBlob(1), stmt->GetColumnBytes(1));
-        if (status != DgnDbStatus::Success) 
-            continue;
-
-        auto job = new ExportGraphicsJob(db, facetOptions, elementId, saveInstances, decimationTolerance, generateLines, minLineStyleComponentSize);
-        job->m_geom.m_categoryId = stmt->GetValueId<DgnCategoryId>(0);
-        job->m_geom.m_placement = getPlacement(*stmt);
-        job->m_geom.m_geomStream = std::move(geomStream);
-        
-        job->m_context.SetDgnDb(db);
-
         if (onGraphicsCb.IsFunction())
             job->m_onGraphicsCbRef = Napi::Persistent(onGraphicsCb);
         if (onLineGraphicsCb.IsFunction())
@@ -1030,7 +1072,7 @@ static bvector<std::unique_ptr<ExportGraphicsJob>> Create(DgnDbR db, Napi::Objec
         if (napiPartArray.IsArray())
             job->m_napiPartArrayRef = Napi::Persistent(napiPartArray);
 
-        jobs.emplace_back(job);
+        jobs.emplace_back(std::move(job));
         }
 
     return jobs;
@@ -1051,6 +1093,13 @@ void Execute()
 
     // Finishes the job after the Execute method has completed. This must be invoked in the main thread.
 void Finish(Napi::Env& env)
+    {
+    Napi::Array napiPartArray = m_napiPartArrayRef.Value();
+    Finish(env, m_onGraphicsCbRef.Value(), m_onLineGraphicsCbRef.Value(), napiPartArray);
+    }
+
+    // Reports the results of the job to the supplied callbacks after the Execute method has completed. This must be invoked in the main thread.
+void Finish(Napi::Env& env, Napi::Function onGraphicsCb, Napi::Function onLineGraphicsCb, Napi::Array& napiPartArray)
     {
     if (m_caughtException)
         {
@@ -1068,7 +1117,6 @@ void Finish(Napi::Env& env)
 
     Napi::String elementIdString = createIdString(env, m_elementId);
 
-    Napi::Function onGraphicsCb = m_onGraphicsCbRef.Value();
     if (onGraphicsCb.IsFunction())
         {
         for (auto& entry : m_processor.m_cachedEntries)
@@ -1090,7 +1138,6 @@ void Finish(Napi::Env& env)
             }
         }
 
-    Napi::Function onLineGraphicsCb = m_onLineGraphicsCbRef.Value();
     if (onLineGraphicsCb.IsFunction())
         {
         for (auto& entry : m_processor.m_cachedLineStrings)
@@ -1107,7 +1154,6 @@ void Finish(Napi::Env& env)
             }
         }
 
-    Napi::Array napiPartArray = m_napiPartArrayRef.Value();
     if (napiPartArray.IsArray() && !m_instances.empty())
         {
         convertPartInstances(env, napiPartArray, m_elementId, m_instances);
@@ -1376,6 +1422,290 @@ Napi::Value JsInterop::ExportGraphicsAsync(DgnDbR db, Napi::Object const& export
     return all.Call(promiseConstructor, { promises });
     }
 
+namespace {
+
+//=======================================================================================
+// Exports the graphics of a list of elements from a single DgnDbWorker. The worker loads
+// each element's geometry on its own thread and facets it on the CPU pool, keeping at most
+// twice batchSize elements in flight. Finished elements go to the main thread in batches
+// of at most batchSize through a ThreadSafeFunction, with at most maxPendingBatches not yet
+// reported. When Javascript falls behind, the worker waits instead of accumulating meshes. Elements are reported in the order of
+// elementIdArray unless the request specifies ordered=false, in which case they are
+// reported as soon as they finish.
+// @bsistruct
+//=======================================================================================
+struct ExportGraphicsStreamWorker : DgnDbWorker
+{
+    DEFINE_T_SUPER(DgnDbWorker);
+private:
+    typedef bvector<std::unique_ptr<ExportGraphicsJob>> Batch;
+
+    struct InFlightJob
+    {
+        std::unique_ptr<ExportGraphicsJob> m_job;
+        bool m_executed = false; // guarded by m_cv's mutex
+    };
+
+    ExportGraphicsOptions           m_options;
+    bvector<DgnElementId>           m_elementIds;
+    Napi::FunctionReference         m_onGraphicsCb;
+    Napi::FunctionReference         m_onLineGraphicsCb;
+    Napi::FunctionReference         m_onBatchCb;
+    Napi::Reference<Napi::Array>    m_partInstanceArray;
+    Napi::ThreadSafeFunction        m_batches;
+    BeConditionVariable             m_cv;
+    uint32_t                        m_batchSize;
+    size_t                          m_maxPendingBatches;
+    size_t                          m_pendingBatches = 0; // posted but not yet reported; guarded by m_cv's mutex
+    bool                            m_ordered;
+    std::atomic<bool>               m_completed {false};
+    bool                            m_settled = false; // main thread only
+
+    void Settle(Napi::Env env, Napi::Value const* error)
+        {
+        if (m_settled)
+            return;
+
+        m_settled = true;
+        if (nullptr != error)
+            m_promise.Reject(*error);
+        else if (m_completed.load())
+            m_promise.Resolve(env.Undefined());
+        else
+            m_promise.Reject(Napi::Error::New(env, "The operation was canceled").Value());
+        }
+
+    // Invoked in the main thread for each batch posted by the worker thread.
+    void ReportBatch(Napi::Env env, Batch& batch)
+        {
+        if (m_settled || IsCanceled())
+            return;
+
+        Napi::HandleScope scope(env);
+        Napi::Function onGraphicsCb = m_onGraphicsCb.Value();
+        Napi::Function onLineGraphicsCb = m_onLineGraphicsCb.Value();
+        Napi::Array partInstanceArray = m_partInstanceArray.Value();
+        try
+            {
+            for (auto& job : batch)
+                {
+                job->Finish(env, onGraphicsCb, onLineGraphicsCb, partInstanceArray);
+                job = nullptr; // free the meshes while they're still in cache
+                }
+
+            if (!m_onBatchCb.IsEmpty())
+                m_onBatchCb.Call({Napi::Number::New(env, (double) batch.size())});
+            }
+        catch (Napi::Error const& error)
+            {
+            // a throwing callback stops the export and rejects the promise with its error.
+            Cancel();
+            Napi::Value value = error.Value();
+            Settle(env, &value);
+            }
+        }
+
+    // Hand a batch to the main thread, waiting while maxPendingBatches batches have not been reported yet. The main thread
+    // signals m_cv after reporting each batch. Gives up if the worker is canceled in the meantime, so that a main thread
+    // that waits for workers to finish (e.g. to close the DgnDb) never waits on us in turn.
+    void PostBatch(Batch& batch)
+        {
+        BeMutexHolder lock(m_cv.GetMutex());
+        while (m_pendingBatches >= m_maxPendingBatches && !IsCanceled())
+            m_cv.InfiniteWait(lock);
+
+        if (IsCanceled())
+            {
+            batch.clear();
+            return;
+            }
+
+        ++m_pendingBatches;
+        lock.unlock();
+
+        Batch* posted = new Batch(std::move(batch));
+        batch.clear();
+        napi_status status = m_batches.NonBlockingCall(posted, [this](Napi::Env env, Napi::Function, Batch* data)
+            {
+            ReportBatch(env, *data);
+            delete data;
+
+            BeMutexHolder lock(m_cv.GetMutex());
+            --m_pendingBatches;
+            m_cv.notify_all();
+            });
+
+        if (napi_ok != status)
+            {
+            delete posted;
+            lock.lock();
+            --m_pendingBatches;
+            }
+        }
+
+    void OnCanceled() override
+        {
+        BeMutexHolder lock(m_cv.GetMutex());
+        m_cv.notify_all();
+        }
+
+    // true if the in-flight jobs include one that may be reported now.
+    bool HasReportableJob(std::list<InFlightJob> const& inFlight) const
+        {
+        if (m_ordered)
+            return inFlight.front().m_executed;
+
+        for (auto const& entry : inFlight)
+            {
+            if (entry.m_executed)
+                return true;
+            }
+        return false;
+        }
+
+protected:
+    void Execute() override
+        {
+        DgnDbR db = GetDb();
+        BeSQLite::Statement stmt(db, s_selectGeometrySql); // not the cached statement, which the main thread may be using
+        BeFolly::ThreadPool& threadPool = BeFolly::ThreadPool::GetCpuPool();
+        const size_t maxInFlight = 2 * m_batchSize;
+
+        std::list<InFlightJob> inFlight;
+        Batch batch;
+        size_t next = 0;
+        while (!IsCanceled())
+            {
+            // keep the CPU pool busy, but with only a bounded number of elements in memory.
+            while (inFlight.size() < maxInFlight && next < m_elementIds.size())
+                {
+                auto job = ExportGraphicsJob::Load(db, stmt, m_options, m_elementIds[next++]);
+                if (!job)
+                    continue;
+
+                inFlight.emplace_back();
+                InFlightJob* entry = &inFlight.back();
+                entry->m_job = std::move(job);
+                folly::via(&threadPool, [this, entry]()
+                    {
+                    // Needed to handle errors and clear thread exclusion.
+                    RefCountedPtr<IRefCounted> errorHandler = T_HOST.GetBRepGeometryAdmin()._CreateWorkerThreadErrorHandler();
+                    entry->m_job->Execute();
+
+                    BeMutexHolder lock(m_cv.GetMutex());
+                    entry->m_executed = true;
+                    m_cv.notify_all();
+                    });
+                }
+
+            if (inFlight.empty())
+                break;
+
+            BeMutexHolder lock(m_cv.GetMutex());
+            while (!HasReportableJob(inFlight))
+                m_cv.InfiniteWait(lock);
+
+            for (auto it = inFlight.begin(); it != inFlight.end(); )
+                {
+                if (!it->m_executed)
+                    {
+                    if (m_ordered)
+                        break;
+
+                    ++it;
+                    continue;
+                    }
+
+                batch.push_back(std::move(it->m_job));
+                it = inFlight.erase(it);
+                if (batch.size() >= m_batchSize)
+                    {
+                    // the pool only touches the entries' m_executed flags, so the list can be walked on without the lock.
+                    lock.unlock();
+                    PostBatch(batch);
+                    lock.lock();
+                    }
+                }
+            }
+
+        if (!batch.empty() && !IsCanceled())
+            PostBatch(batch);
+
+        // jobs still executing on the CPU pool refer to their entries, so wait for them before returning.
+        BeMutexHolder lock(m_cv.GetMutex());
+        for (auto& entry : inFlight)
+            {
+            while (!entry.m_executed)
+                m_cv.InfiniteWait(lock);
+            }
+
+        if (!IsCanceled() && next >= m_elementIds.size())
+            m_completed.store(true);
+        }
+
+    // The promise is settled by the finalizer of m_batches, after every posted batch has been reported.
+    void OnOK() override {m_batches.Release();}
+    void OnError(Napi::Error const& e) override
+        {
+        Napi::Value value = e.Value();
+        Settle(Env(), &value);
+        m_batches.Release();
+        }
+
+public:
+    ExportGraphicsStreamWorker(DgnDbR db, Napi::Object const& exportProps) : T_Super(db, exportProps.Env()), m_options(exportProps)
+        {
+        Napi::Array elementIdArray = exportProps.Get("elementIdArray").As<Napi::Array>();
+        m_elementIds.reserve(elementIdArray.Length());
+        for (uint32_t i = 0; i < elementIdArray.Length(); ++i)
+            {
+            std::string elementIdStr = elementIdArray.Get(i).As<Napi::String>().Utf8Value();
+            DgnElementId elementId(BeInt64Id::FromString(elementIdStr.c_str()).GetValue());
+            if (elementId.IsValid())
+                m_elementIds.push_back(elementId);
+            }
+
+        Napi::Value onGraphicsCb = exportProps.Get("onGraphics");
+        if (onGraphicsCb.IsFunction())
+            m_onGraphicsCb = Napi::Persistent(onGraphicsCb.As<Napi::Function>());
+        Napi::Value onLineGraphicsCb = exportProps.Get("onLineGraphics");
+        if (onLineGraphicsCb.IsFunction())
+            m_onLineGraphicsCb = Napi::Persistent(onLineGraphicsCb.As<Napi::Function>());
+        Napi::Value onBatchCb = exportProps.Get("onBatch");
+        if (onBatchCb.IsFunction())
+            m_onBatchCb = Napi::Persistent(onBatchCb.As<Napi::Function>());
+        Napi::Value partInstanceArray = exportProps.Get("partInstanceArray");
+        if (partInstanceArray.IsArray())
+            m_partInstanceArray = Napi::Persistent(partInstanceArray.As<Napi::Array>());
+
+        Napi::Value batchSize = exportProps.Get("batchSize");
+        m_batchSize = batchSize.IsNumber() ? std::max(1u, batchSize.As<Napi::Number>().Uint32Value()) : 64;
+        Napi::Value ordered = exportProps.Get("ordered");
+        m_ordered = ordered.IsBoolean() ? ordered.As<Napi::Boolean>().Value() : true;
+        Napi::Value maxPendingBatches = exportProps.Get("maxPendingBatches");
+        m_maxPendingBatches = maxPendingBatches.IsNumber() ? std::max(1u, maxPendingBatches.As<Napi::Number>().Uint32Value()) : 2;
+
+        DgnDbWorkerPtr self(this);
+        m_batches = Napi::ThreadSafeFunction::New(Env(), Napi::Function::New(Env(), [](NapiInfoCR) {}), "ExportGraphics batches", m_maxPendingBatches, 1,
+            [self](Napi::Env env) {((ExportGraphicsStreamWorker&) *self).Settle(env, nullptr);});
+        }
+};
+
+} // namespace
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+Napi::Value JsInterop::ExportGraphicsStream(DgnDbR db, Napi::Object const& exportProps)
+    {
+    DgnDbWorkerPtr worker = new ExportGraphicsStreamWorker(db, exportProps);
+
+    Napi::Object response = Napi::Object::New(Env());
+    response.Set("result", worker->Queue());
+    response.Set("cancel", Napi::Function::New(Env(), [worker](NapiInfoCR) {worker->Cancel();}));
+    return response;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -1393,6 +1723,89 @@ Napi::Value JsInterop::ExportPartGraphicsAsync(DgnDbR db, Napi::Object const& ex
     return worker->Queue();
     }
 
+/*---------------------------------------------------------------------------------**//**
+* Times the conversion of a large mesh to IntermediateMesh and the unification of its indices,
+* for the "benchmarkUnifyIndices" test (see JsInterop::ExecuteTest). The mesh is a gridSize x gridSize
+* grid of quads split into triangles. Alternate triangles use different normals, so that most points
+* need more than one output vertex.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+Json::Value JsInterop::BenchmarkUnifyIndices(Utf8StringCR params)
+    {
+    Json::Value props = Json::Value::From(params);
+    uint32_t gridSize = props.isMember("gridSize") ? props["gridSize"].asUInt() : 1000;
+    uint32_t iterations = props.isMember("iterations") ? std::max(1u, props["iterations"].asUInt()) : 10;
+
+    PolyfaceHeaderPtr pf = PolyfaceHeader::CreateVariableSizeIndexed();
+    for (uint32_t j = 0; j <= gridSize; ++j)
+        for (uint32_t i = 0; i <= gridSize; ++i)
+            pf->Point().push_back(DPoint3d::From(i, j, 0.01 * ((i * 7 + j * 3) % 11)));
+
+    pf->Normal().push_back(DVec3d::From(0, 0, 1));
+    pf->Normal().push_back(DVec3d::FromNormalizedCrossProduct(DVec3d::From(1, 0, 0.1), DVec3d::From(0, 1, 0.1)));
+
+    auto addTriangle = [&](int32_t a, int32_t b, int32_t c, int32_t normal)
+        {
+        for (int32_t index : {a, b, c})
+            {
+            pf->PointIndex().push_back(index + 1);
+            pf->NormalIndex().push_back(normal + 1);
+            }
+        pf->PointIndex().push_back(0);
+        pf->NormalIndex().push_back(0);
+        };
+
+    const int32_t rowLength = (int32_t)gridSize + 1;
+    for (int32_t j = 0; j < (int32_t)gridSize; ++j)
+        {
+        for (int32_t i = 0; i < (int32_t)gridSize; ++i)
+            {
+            int32_t corner = j * rowLength + i;
+            addTriangle(corner, corner + 1, corner + rowLength + 1, 0);
+            addTriangle(corner, corner + rowLength + 1, corner + rowLength, 1);
+            }
+        }
+
+    const uint32_t triangleCount = 2 * gridSize * gridSize;
+    DPoint3dCP points = pf->GetPointCP();
+    int32_t const* pointIndices = pf->GetPointIndexCP();
+    double convertSeconds = 0.0, unifySeconds = 0.0;
+    size_t vertexCount = 0;
+    for (uint32_t iteration = 0; iteration < iterations; ++iteration)
+        {
+        std::unique_ptr<FPoint2d[]> computedParams(new FPoint2d[3 * triangleCount]);
+        for (uint32_t i = 0, param = 0; i < 4 * triangleCount; i += 4)
+            {
+            for (uint32_t k = 0; k < 3; ++k, ++param)
+                {
+                DPoint3dCR point = points[pointIndices[i + k] - 1];
+                computedParams[param].x = static_cast<float>(point.x / gridSize);
+                computedParams[param].y = static_cast<float>(point.y / gridSize);
+                }
+            }
+
+        StopWatch convertTimer(true);
+        IntermediateMesh mesh(*pf, Transform::FromIdentity(), std::move(computedParams));
+        convertTimer.Stop();
+
+        ExportGraphicsMesh exportMesh;
+        StopWatch unifyTimer(true);
+        unifyIndices(mesh, exportMesh);
+        unifyTimer.Stop();
+
+        convertSeconds += convertTimer.GetElapsedSeconds();
+        unifySeconds += unifyTimer.GetElapsedSeconds();
+        vertexCount = exportMesh.points.size() / 3;
+        }
+
+    Json::Value result;
+    result["triangleCount"] = triangleCount;
+    result["vertexCount"] = (uint32_t)vertexCount;
+    result["convertMs"] = 1000.0 * convertSeconds / iterations;
+    result["unifyMs"] = 1000.0 * unifySeconds / iterations;
+    return result;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -266,5 +266,6 @@ Json::Value IModelJsNative::JsInterop::ExecuteTest(DgnDbR db, Utf8StringCR testN
 	if (testName.Equals("rotateCameraLocal")) return rotateCameraLocal(db, params);
 	if (testName.Equals("buildKnownGeometryStream")) return buildKnownGeometryStream(db, params);
 	if (testName.Equals("deserializeGeometryStream")) return deserializeGeometryStream(db, params);
+	if (testName.Equals("benchmarkUnifyIndices")) return BenchmarkUnifyIndices(params);
 	return Json::Value();
     }
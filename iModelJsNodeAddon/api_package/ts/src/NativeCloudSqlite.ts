@@ -162,6 +162,17 @@ export namespace NativeCloudSqlite {
     timeout?: number;
     /** The number of prefetch requests to issue while there is foreground activity. Default is 3. */
     minRequests?: number;
+    /** Parts of the database to download before the rest. They are requested on demand, ahead of the blind prefetch of the whole database. */
+    hints?: PrefetchHints;
+  }
+
+  export interface PrefetchHints {
+    /** Names of tables whose entire b-tree should be fetched first. */
+    tables?: string[];
+    /** Names of indexes whose entire b-tree should be fetched first. */
+    indexes?: string[];
+    /** Ranges of rows (inclusive) within a table that should be fetched first. */
+    rowIdRanges?: { table: string, first: number, last: number }[];
   }
 
   export interface CleanDeletedBlocksOptions {
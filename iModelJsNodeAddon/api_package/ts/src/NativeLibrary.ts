@@ -280,10 +280,31 @@ export declare namespace IModelJsNative {
   };
 
   namespace ConcurrentQuery {
-    /**
+    /** Called once per request, or, when the request sets `chunkRows`/`chunkBytes`, once per chunk of rows
+     * (status `7`, more to follow) and then once more with the final response. The next chunk is only read
+     * after this callback returned for the previous one, and the time quota applies to each chunk.
      * @internal
      */
     type OnResponse = (response: DbResponse) => void;
+    /** Latency histogram. Bucket 0 counts samples below 1ms and bucket i samples in [2^(i-1), 2^i) ms.
+     * @internal
+     */
+    interface Histogram {
+      count: number;
+      totalMs: number;
+      maxMs: number;
+      buckets: number[];
+    }
+    /** Scheduler telemetry of a concurrent query manager.
+     * @internal
+     */
+    interface Stats {
+      queueWait: Histogram;
+      execution: Histogram;
+      pending: number;
+      planCacheHits: number;
+      planCacheMisses: number;
+    }
     /** Configuration for concurrent query manager
      * @internal
      */
@@ -292,6 +313,7 @@ export declare namespace IModelJsNative {
     concurrentQueryExecute(request: DbRequest, onResponse: ConcurrentQuery.OnResponse): void;
     concurrentQueryResetConfig(config?: QueryConfig): QueryConfig;
     concurrentQueryShutdown(): void;
+    concurrentQueryStats(reset?: boolean): ConcurrentQuery.Stats;
   }
 
   /** Concurrent query config which should be set before making first call to concurrent query manager.
@@ -413,6 +435,8 @@ export declare namespace IModelJsNative {
     changesetId: string;
     uncompressedSizeBytes: number;
     sha1ValidationTimeMs: number;
+    decompressTimeMs: number;
+    prefetchWaitTimeMs: number;
     insertedRows: number;
     updatedRows: number;
     deletedRows: number;
@@ -420,6 +444,17 @@ export declare namespace IModelJsNative {
     totalFullTableScans: number;
     perStatementStats: [PerStatementHealthStats];
   }
+  /** Time spent in each stage of [[DgnDb.applyChangesets]] for one changeset. */
+  interface ChangesetApplyTimings {
+    changesetId: string;
+    changesetIndex: number;
+    uncompressedSizeBytes: number;
+    decompressTimeMs: number;
+    sha1ValidationTimeMs: number;
+    /** time the apply thread waited for the changeset to be decompressed and validated */
+    prefetchWaitTimeMs: number;
+    applyTimeMs: number;
+  }
   interface ECSqlRowAdaptorOptions {
     abbreviateBlobs?: boolean;
     classIdsToClassNames?: boolean;
@@ -560,6 +595,55 @@ export declare namespace IModelJsNative {
     readonly parentChangesetIndex?: string;
   }
 
+  /** Counters of the element cache of a DgnDb. */
+  export interface ElementCacheStats {
+    /** lookups that found the element in the cache */
+    hits: number;
+    /** lookups that did not */
+    misses: number;
+    /** elements dropped to stay within the cache limits */
+    evictions: number;
+    /** elements currently in the cache */
+    count: number;
+    /** estimated memory in bytes of the elements currently in the cache */
+    bytes: number;
+  }
+
+  /** Coordinates converted by the typed array variants of the geo coordinate conversions. */
+  export interface GeoCoordinatesArrayResult {
+    /** converted points, packed as x,y,z triplets in the order of the input */
+    coords: Float64Array;
+    /** status of each point, with the same values as the `s` member of the JSON results */
+    statuses: Int32Array;
+  }
+
+  /** Statistics of a single SQL statement recorded by the SQL monitor. */
+  export interface SqlMonitorStatement {
+    /** the statement text, truncated to 255 characters */
+    sql: string;
+    /** number of executions */
+    count: number;
+    elapsed_ns: number;
+    max_elapsed_ns: number;
+    /** rows inserted, updated or deleted */
+    rows_changed: number;
+    /** rows visited by full table scans */
+    full_scan_steps: number;
+    /** page cache misses on the connection while the statement ran */
+    cache_misses: number;
+  }
+
+  /** A snapshot of the SQL monitor. */
+  export interface SqlMonitorSnapshot {
+    statements: SqlMonitorStatement[];
+    /** statement executions per latency bucket, where bucket i holds latencies under 2^i microseconds */
+    latency_histogram_us: number[];
+    /** executions not attributed to a statement because the monitor had no index entry free for it */
+    dropped: number;
+    /** statements whose slot in the monitor's ring was taken over by a newer statement */
+    evicted: number;
+  }
+
   export interface TxnProps {
     id: TxnIdString;
     sessionId: number;
@@ -629,6 +713,7 @@ export declare namespace IModelJsNative {
     public addChildPropagatesChangesToParentRelationship(schemaName: string, relClassName: string): BentleyStatus;
     public invalidateFontMap(): void;
     public applyChangeset(changeSet: ChangesetFileProps, fastForward: boolean, noUpdateLoop?: boolean): void;
+    public applyChangesets(changeSets: ChangesetFileProps[], fastForward: boolean, noUpdateLoop?: boolean, prefetchCount?: number): ChangesetApplyTimings[];
     public revertTimelineChanges(changeSet: ChangesetFileProps[], skipSchemaChanges: boolean): void;
     public attachChangeCache(changeCachePath: string): DbResult;
     public beginMultiTxnOperation(): DbResult;
@@ -645,6 +730,7 @@ export declare namespace IModelJsNative {
     public concurrentQueryExecute(request: DbRequest, onResponse: ConcurrentQuery.OnResponse): void;
     public concurrentQueryResetConfig(config?: QueryConfig): QueryConfig;
     public concurrentQueryShutdown(): void;
+    public concurrentQueryStats(reset?: boolean): ConcurrentQuery.Stats;
     public createBRepGeometry(createProps: any/* BRepGeometryCreate */): IModelStatus;
     public createChangeCache(changeCacheFile: ECDb, changeCachePath: string): DbResult;
     public createClassViewsInDb(): BentleyStatus;
@@ -671,6 +757,13 @@ export declare namespace IModelJsNative {
     public exportGraphics(exportProps: any/* ExportGraphicsProps */): DbResult;
     public exportPartGraphics(exportProps: any/* ExportPartGraphicsProps */): DbResult;
     public exportGraphicsAsync(exportProps: any/* ExportGraphicsProps */): Promise<void>;
+    /** Export the graphics of `exportProps.elementIdArray` from a single worker, reporting finished elements to the main thread in batches.
+     * In addition to ExportGraphicsProps, `exportProps` may specify `batchSize` (elements per batch, default 64), `ordered`
+     * (report elements in the order of elementIdArray, default true), `maxPendingBatches` (batches awaiting delivery before the worker waits, default 2),
+     * and `onBatch` (called with the number of elements in each batch after their graphics have been reported).
+     * `result` rejects if the export is canceled or if a callback throws.
+     */
+    public exportGraphicsStream(exportProps: any/* ExportGraphicsProps */): { result: Promise<void>, cancel: () => void };
     public exportPartGraphicsAsync(exportProps: any/* ExportPartGraphicsProps */): Promise<void>;
     public exportSchema(schemaName: string, exportDirectory: string, outFileName?: string): SchemaWriteStatus;
     public exportSchemas(exportDirectory: string): SchemaWriteStatus;
@@ -683,6 +776,8 @@ export declare namespace IModelJsNative {
     public getBriefcaseId(): number;
     public getChangesetSize(): number;
     public getChangeTrackingMemoryUsed(): number;
+    /** Get the counters of the element cache. Hits, misses and evictions accumulate until `reset` is true. */
+    public getElementCacheStats(reset?: boolean): ElementCacheStats;
     public getCodeValueBehavior(): "exact" | "trim-unicode-whitespace";
     public getCurrentChangeset(): ChangesetIndexAndId;
     public getCurrentTxnId(): TxnIdString;
@@ -691,16 +786,23 @@ export declare namespace IModelJsNative {
     public executeSql(sql: string): DbResult;
     public getFilePath(): string; // full path of the DgnDb file
     public getGeoCoordinatesFromIModelCoordinates(points: GeoCoordinatesRequestProps): GeoCoordinatesResponseProps;
+    /** Convert iModel coordinates, packed as x,y,z triplets, to `target` (a GCS json or datum name), or to the lat/long of the iModel GCS if omitted. */
+    public getGeoCoordinatesFromIModelCoordinatesArray(iModelCoords: Float64Array, target?: string): GeoCoordinatesArrayResult;
     public getGeometryContainment(props: object): Promise<GeometryContainmentResponseProps>;
     public getIModelCoordinatesFromGeoCoordinates(points: IModelCoordinatesRequestProps): IModelCoordinatesResponseProps;
+    /** Convert coordinates of `source` (a GCS json or datum name), or lat/long of the iModel GCS if omitted, packed as x,y,z triplets, to iModel coordinates. */
+    public getIModelCoordinatesFromGeoCoordinatesArray(geoCoords: Float64Array, source?: string): GeoCoordinatesArrayResult;
     public getIModelId(): GuidString;
     public getIModelProps(when?: "pullMerge"): IModelProps;
     public resolveInstanceKey(args: ResolveInstanceKeyArgs): ResolveInstanceKeyResult;
     public readInstance(key: NodeJS.Dict<any>, args: NodeJS.Dict<any>): NodeJS.Dict<any>;
+    public readInstances(keys: NodeJS.Dict<any>[], args: NodeJS.Dict<any>): Array<NodeJS.Dict<any> | any[] | null>;
     public insertInstance(inst: NodeJS.Dict<any>, args: NodeJS.Dict<any>): Id64String;
     public updateInstance(inst: NodeJS.Dict<any>, args: NodeJS.Dict<any>): boolean;
     public deleteInstance(key: NodeJS.Dict<any>, args: NodeJS.Dict<any>): boolean;
     public patchJsonProperties(jsonProps: string): string;
+    /** Set the maximum number of elements and/or the memory budget in bytes (0 for none) of the element cache. */
+    public setElementCacheLimits(limits: { maxCount?: number, maxBytes?: number }): void;
     public newBeGuid(): GuidString;
 
     public clearECDbCache(): void;
@@ -795,6 +897,12 @@ export declare namespace IModelJsNative {
     public startCreateChangeset(): ChangesetFileProps;
     public startProfiler(scopeName?: string, scenarioName?: string, overrideFile?: boolean, computeExecutionPlan?: boolean): DbResult;
     public stopProfiler(): { rc: DbResult, elapsedTime?: number, scopeId?: number, fileName?: string };
+    /** Turn the always-on, in-memory SQL statement monitor on or off. Unlike the profiler, it writes nothing to disk. */
+    public enableSqlMonitor(enable: boolean): void;
+    /** Get the `topN` statements recorded by the SQL monitor (default 20, ordered by total time), or undefined if it is not enabled.
+     * Pass `reset` to zero the counters after taking the snapshot.
+     */
+    public getSqlMonitorSnapshot(topN?: number, sortBy?: "totalTime" | "maxTime" | "count", reset?: boolean): SqlMonitorSnapshot | undefined;
     public enableChangesetStatsTracking(): void;
     public disableChangesetStatsTracking(): void;
     public getChangesetHealthData(changesetId: string): ChangesetHealthStats;
@@ -892,6 +1000,7 @@ export declare namespace IModelJsNative {
     public getFilePath(): string;
     public resolveInstanceKey(args: ResolveInstanceKeyArgs): ResolveInstanceKeyResult;
     public readInstance(key: NodeJS.Dict<any>, args: NodeJS.Dict<any>): NodeJS.Dict<any>;
+    public readInstances(keys: NodeJS.Dict<any>[], args: NodeJS.Dict<any>): Array<NodeJS.Dict<any> | any[] | null>;
     public insertInstance(inst: NodeJS.Dict<any>, args: NodeJS.Dict<any>): Id64String;
     public updateInstance(inst: NodeJS.Dict<any>, args: NodeJS.Dict<any>): boolean;
     public deleteInstance(key: NodeJS.Dict<any>, args: NodeJS.Dict<any>): boolean;
@@ -906,6 +1015,7 @@ export declare namespace IModelJsNative {
     public concurrentQueryExecute(request: DbRequest, onResponse: ConcurrentQuery.OnResponse): void;
     public concurrentQueryResetConfig(config?: QueryConfig): QueryConfig;
     public concurrentQueryShutdown(): void;
+    public concurrentQueryStats(reset?: boolean): ConcurrentQuery.Stats;
     public attachDb(filename: string, alias: string): void;
     public detachDb(alias: string): void;
     public clearECDbCache(): void;
@@ -919,7 +1029,7 @@ export declare namespace IModelJsNative {
     public isOpen(): boolean;
     public closeDb(): void;
     public processChangesets(db: DgnDb, changesets: ChangesetFileProps[], rulesetId: string, filterSpatial?: boolean, wantParents?: boolean, wantPropertyChecksums?: boolean, rulesetDir?: string, tempDir?: string, wantChunkTraversal?: boolean): DbResult;
-    public processChangesetsAndRoll(dbFilename: string, dbGuid: string, changesets: ChangesetFileProps[], rulesetId: string, filterSpatial?: boolean, wantParents?: boolean, wantPropertyChecksums?: boolean, rulesetDir?: string, tempDir?: string, wantRelationshipCaching?: boolean, relationshipCacheSize?: number, wantChunkTraversal?: boolean, wantBoundingBoxes?: boolean): DbResult;
+    public processChangesetsAndRoll(dbFilename: string, dbGuid: string, changesets: ChangesetFileProps[], rulesetId: string, filterSpatial?: boolean, wantParents?: boolean, wantPropertyChecksums?: boolean, rulesetDir?: string, tempDir?: string, wantRelationshipCaching?: boolean, relationshipCacheSize?: number, wantChunkTraversal?: boolean, wantBoundingBoxes?: boolean, workerCount?: number): DbResult;
     public getChangedElements(startChangesetId: string, endChangesetId: string): ErrorStatusOrResult<IModelStatus, any>;
     public isProcessed(changesetId: string): boolean;
     public cleanCaches(): void;
@@ -1465,7 +1575,13 @@ export declare namespace IModelJsNative {
     disk?: ECPresentationDiskHierarchyCacheConfig;
   }
 
-  type ECPresentationHierarchyCacheConfig = ECPresentationMemoryHierarchyCacheConfig | ECPresentationDiskHierarchyCacheConfig | ECPresentationHybridHierarchyCacheConfig;
+  /** Hybrid cache whose disk part is keyed by iModel and changeset, so processes opening the same iModel version share it. Writable connections fall back to `hybrid`. */
+  interface ECPresentationSharedHierarchyCacheConfig {
+    mode: "shared";
+    disk?: ECPresentationDiskHierarchyCacheConfig;
+  }
+
+  type ECPresentationHierarchyCacheConfig = ECPresentationMemoryHierarchyCacheConfig | ECPresentationDiskHierarchyCacheConfig | ECPresentationHybridHierarchyCacheConfig | ECPresentationSharedHierarchyCacheConfig;
 
   type ECPresentationManagerResponse<TResult> = ErrorStatusOrResult<ECPresentationStatus, TResult> & {
     diagnostics?: any;
@@ -1483,6 +1599,10 @@ export declare namespace IModelJsNative {
     updateCallback: (updateInfo: any) => void;
     cacheConfig: ECPresentationHierarchyCacheConfig;
     contentCacheSize?: number;
+    /** Estimated memory, in bytes, cached content may take. Unlimited if not set. */
+    contentCacheMemoryLimit?: number;
+    /** Estimated memory, in bytes, content cached for a single iModel may take. Unlimited if not set. */
+    contentCacheConnectionMemoryLimit?: number;
     workerConnectionCacheSize?: number;
     useMmap?: boolean | number;
   }
@@ -4,12 +4,27 @@
 *--------------------------------------------------------------------------------------------*/
 
 import { expect } from "chai";
+import { createHmac } from "crypto";
 import * as fs from "fs";
 import { join } from "path";
+import { DbResult } from "@itwin/core-bentley";
 import { NativeCloudSqlite } from "../NativeCloudSqlite";
 import { IModelJsNative } from "../NativeLibrary";
 import { getOutputDir, iModelJsNative } from "./utils";
 
+// The well-known development account of the Azurite storage emulator.
+const azuriteBaseUri = "http://127.0.0.1:10000/devstoreaccount1";
+const azuriteAccount = "devstoreaccount1";
+const azuriteKey = "Eby8vdM02xNOcqFlqUwJPLlmEtlCDXJ1OUzFT50uSRZ6IFsuFq2UVErCz4I6tq/K1SZFPTOtr/KBHBeksoGMGw==";
+
+/** Make an account SAS token with full access to blobs in the Azurite emulator. */
+function makeAzuriteSasToken(): string {
+  const params = { sv: "2019-12-12", ss: "b", srt: "sco", sp: "rwdlacup", se: new Date(Date.now() + 60 * 60 * 1000).toISOString().replace(/\.\d+Z$/, "Z"), spr: "https,http" };
+  const stringToSign = [azuriteAccount, params.sp, params.ss, params.srt, "", params.se, "", params.spr, params.sv, ""].join("\n");
+  const sig = createHmac("sha256", Buffer.from(azuriteKey, "base64")).update(stringToSign, "utf8").digest("base64");
+  return new URLSearchParams({ ...params, sig }).toString();
+}
+
 describe("cloud sqlite", () => {
   let cache: IModelJsNative.CloudCache;
 
@@ -60,4 +75,58 @@ describe("cloud sqlite", () => {
     const c2 = new iModelJsNative.CloudContainer(containerProps);
     expect(c2.isPublic).is.true;
   });
+
+  it("prefetch with hints can be cancelled while the hinted parts are being fetched", async function () {
+    const containerProps: NativeCloudSqlite.ContainerAccessProps = {
+      baseUri: azuriteBaseUri,
+      storageType: "azure",
+      containerId: "prefetch-hints",
+      accessToken: makeAzuriteSasToken(),
+      writeable: true,
+    };
+    const writer = new iModelJsNative.CloudContainer(containerProps);
+    try {
+      writer.initializeContainer({ blockSize: 64 * 1024 });
+    } catch {
+      this.skip(); // needs the Azurite storage emulator
+    }
+
+    writer.connect(cache);
+    writer.acquireWriteLock("prefetch test");
+    const db = new iModelJsNative.SQLiteDb();
+    db.createDb("hints.db", writer);
+    db.executeDdl("CREATE TABLE big(id INTEGER PRIMARY KEY, val TEXT)");
+    const stmt = new iModelJsNative.SqliteStatement();
+    stmt.prepare(db, "WITH RECURSIVE cnt(x) AS (SELECT 1 UNION ALL SELECT x+1 FROM cnt WHERE x<20000) INSERT INTO big SELECT x, printf('%0500d', x) FROM cnt");
+    expect(stmt.step()).equal(DbResult.BE_SQLITE_DONE);
+    stmt.dispose();
+    db.saveChanges();
+    db.closeDb();
+    await writer.uploadChanges();
+    writer.releaseWriteLock();
+    writer.disconnect({ detach: true });
+
+    const hints: NativeCloudSqlite.PrefetchHints = { tables: ["big"], rowIdRanges: [{ table: "big", first: 1, last: 20000 }] };
+    const reader = new iModelJsNative.CloudContainer({ ...containerProps, writeable: false });
+    try {
+      // cancel before, right after, and while the hinted parts are being read. Each must stop the hinted fetch before the promise settles.
+      for (const delay of [-1, 0, 5, 20, 50]) {
+        reader.connect(cache);
+        const prefetch = new iModelJsNative.CloudPrefetch(reader, "hints.db", { hints, nRequests: 1, minRequests: 1, timeout: 1 });
+        if (delay >= 0)
+          await new Promise((resolve) => setTimeout(resolve, delay));
+        prefetch.cancel();
+        await prefetch.promise;
+        reader.disconnect({ detach: true }); // drop what was downloaded so the next iteration starts from scratch
+      }
+
+      // left alone, the same prefetch completes
+      reader.connect(cache);
+      const prefetch = new iModelJsNative.CloudPrefetch(reader, "hints.db", { hints });
+      expect(await prefetch.promise).is.true;
+      expect(reader.queryDatabase("hints.db")?.localBlocks).equal(reader.queryDatabase("hints.db")?.totalBlocks);
+    } finally {
+      reader.disconnect({ detach: true });
+    }
+  });
 });
@@ -493,6 +493,136 @@ describe("basic tests", () => {
       assert.isDefined(elementsWithGraphics[id], `No graphics generated for ${id}`);
   });
 
+  function queryGeometricElement3dIds(): Id64Array {
+    const elementIdArray: Id64Array = [];
+    const statement = new iModelJsNative.ECSqlStatement();
+    statement.prepare(dgndb, "SELECT ECInstanceId FROM bis.GeometricElement3d");
+    while (DbResult.BE_SQLITE_ROW === statement.step())
+      elementIdArray.push(statement.getValue(0).getId());
+    statement.dispose();
+    return elementIdArray;
+  }
+
+  // The meshes handed to onGraphics may refer to native memory that is freed after the callback returns, so copy them out right away.
+  function snapshotGraphics(info: any): string {
+    return JSON.stringify(info, (_key, value) => ArrayBuffer.isView(value) ? Array.from(value as any) : value);
+  }
+
+  it("exportGraphicsStream delivers elements in ordered batches and resolves after the last one", async () => {
+    const elementIdArray = queryGeometricElement3dIds();
+    assert(elementIdArray.length > 0, "No 3D elements in test file");
+
+    let settled = false;
+    const reported: string[] = [];
+    const batchSizes: number[] = [];
+    let elementsInCurrentBatch = new Set<string>();
+    const onGraphics = (info: any) => {
+      assert.isFalse(settled, "onGraphics called after the result settled");
+      elementsInCurrentBatch.add(info.elementId);
+      if (reported.length === 0 || reported[reported.length - 1] !== info.elementId)
+        reported.push(info.elementId);
+    };
+    const onBatch = (count: number) => {
+      assert.isFalse(settled, "onBatch called after the result settled");
+      // every element with graphics reported since the previous batch belongs to this one.
+      assert.isAtMost(elementsInCurrentBatch.size, count);
+      batchSizes.push(count);
+      elementsInCurrentBatch = new Set<string>();
+    };
+
+    const batchSize = 2;
+    await dgndb.exportGraphicsStream({ elementIdArray, onGraphics, onBatch, batchSize, maxPendingBatches: 1 }).result;
+    settled = true;
+
+    // elements are reported once each, in the order of elementIdArray.
+    assert.deepEqual(reported, elementIdArray.filter((id) => reported.includes(id)));
+    for (const id of elementIdArray)
+      assert.include(reported, id, `No graphics generated for ${id}`);
+
+    // every element is delivered in some batch, and a batch holds at most batchSize elements.
+    assert.equal(batchSizes.reduce((sum, count) => sum + count, 0), elementIdArray.length);
+    if (elementIdArray.length > batchSize)
+      assert.isAbove(batchSizes.length, 1);
+    for (const count of batchSizes) {
+      assert.isAbove(count, 0);
+      assert.isAtMost(count, batchSize);
+    }
+  });
+
+  // Micro-benchmark for the mesh conversion behind exportGraphics: 2 million triangles, where most points need two output vertices.
+  it("exportGraphics index unification over a large mesh", () => {
+    const gridSize = 1000;
+    const result = JSON.parse(dgndb.executeTest("benchmarkUnifyIndices", JSON.stringify({ gridSize, iterations: 3 })));
+    assert.equal(result.triangleCount, 2 * gridSize * gridSize);
+    assert.isAbove(result.vertexCount, (gridSize + 1) * (gridSize + 1));
+    assert.isAtMost(result.vertexCount, 3 * result.triangleCount);
+
+    // generous bound; typical timings are tens of milliseconds per stage
+    assert.isBelow(result.convertMs + result.unifyMs, 10 * 1000, `convert ${result.convertMs}ms, unify ${result.unifyMs}ms`);
+  });
+
+  it("exportGraphicsStream produces the same meshes as exportGraphicsAsync", async () => {
+    const elementIdArray = queryGeometricElement3dIds();
+    assert(elementIdArray.length > 0, "No 3D elements in test file");
+
+    const collect = (graphics: Map<string, string[]>) => (info: any) => {
+      const list = graphics.get(info.elementId) ?? [];
+      list.push(snapshotGraphics(info));
+      graphics.set(info.elementId, list);
+    };
+
+    const expected = new Map<string, string[]>();
+    await dgndb.exportGraphicsAsync({ elementIdArray, onGraphics: collect(expected) });
+
+    for (const ordered of [true, false]) {
+      const actual = new Map<string, string[]>();
+      await dgndb.exportGraphicsStream({ elementIdArray, onGraphics: collect(actual), batchSize: 3, ordered }).result;
+      assert.equal(actual.size, expected.size);
+      for (const [elementId, graphics] of expected)
+        assert.deepEqual(actual.get(elementId), graphics, `Graphics of ${elementId} differ (ordered=${ordered})`);
+    }
+  });
+
+  it("exportGraphicsStream can be canceled", async () => {
+    const ids = queryGeometricElement3dIds();
+    assert(ids.length > 0, "No 3D elements in test file");
+
+    // repeat the elements so the worker cannot finish while the first batch is being reported.
+    const elementIdArray: Id64Array = [];
+    for (let i = 0; i < 50; ++i)
+      elementIdArray.push(...ids);
+
+    let calls = 0;
+    let cancel: () => void = () => { };
+    const onGraphics = () => {
+      if (0 === calls++)
+        cancel();
+    };
+
+    const stream = dgndb.exportGraphicsStream({ elementIdArray, onGraphics, batchSize: 1, maxPendingBatches: 1 });
+    cancel = stream.cancel;
+    let error: any;
+    try {
+      await stream.result;
+    } catch (e) {
+      error = e;
+    }
+    assert.isDefined(error, "canceled export must reject");
+    assert.include(error.message, "canceled");
+    assert.isAbove(calls, 0);
+    assert.isBelow(calls, elementIdArray.length, "no batches are reported after cancel");
+
+    // a throwing callback stops the export and rejects with its error.
+    let thrown: any;
+    try {
+      await dgndb.exportGraphicsStream({ elementIdArray, onGraphics: () => { throw new Error("stop export"); }, batchSize: 1 }).result;
+    } catch (e) {
+      thrown = e;
+    }
+    assert.isDefined(thrown);
+    assert.equal(thrown.message, "stop export");
+  });
+
   function createPhysicalElementWithPart() {
     const modelStmt = new iModelJsNative.ECSqlStatement();
     modelStmt.prepare(dgndb, "SELECT ECInstanceId FROM bis.PhysicalModel LIMIT 1");
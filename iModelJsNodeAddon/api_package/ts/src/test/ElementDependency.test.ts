@@ -4,10 +4,10 @@
 *--------------------------------------------------------------------------------------------*/
 
 import { assert } from "chai";
-import { Guid, GuidString, Id64Array, Id64String } from "@itwin/core-bentley";
+import { DbResult, Guid, GuidString, Id64Array, Id64String } from "@itwin/core-bentley";
 import type { ModelGeometryChangesProps, RelatedElementProps, RelationshipProps, SubjectProps } from "@itwin/core-common";
 import { IModelJsNative } from "../NativeLibrary";
-import { copyFile, dbFileName } from "./utils";
+import { copyFile, dbFileName, iModelJsNative } from "./utils";
 import { openDgnDb } from "./index";
 
 /* eslint-disable @typescript-eslint/explicit-member-accessibility */
@@ -139,6 +139,29 @@ function assertRels(list: RelationshipProps[], rels: ElementDrivesElementProps[]
   }
 }
 
+const BE_SQLITE_ERROR_PropagateChangesFailed = (DbResult.BE_SQLITE_ERROR | 2 << 24);
+const EDGESTATUS_Failed = 0x01;
+
+function getEdgeStatus(db1: IModelJsNative.DgnDb, relId: Id64String): number {
+  const stmt = new iModelJsNative.ECSqlStatement();
+  stmt.prepare(db1, "SELECT ECInstanceId, Status FROM BisCore.ElementDrivesElement");
+  let status = -1;
+  while (stmt.step() === DbResult.BE_SQLITE_ROW) {
+    if (stmt.getValue(0).getId() === relId)
+      status = stmt.getValue(1).getInt();
+  }
+  stmt.dispose();
+  return status;
+}
+
+function openTestDb(fileName: string, mockTxn: MockTxn) {
+  const writeDbFileName = copyFile(fileName, dbFileName);
+  db = openDgnDb(writeDbFileName);
+  assert.isTrue(db !== undefined);
+  db.setIModelDb({ txns: mockTxn });
+  db.enableTxnTesting();
+}
+
 describe("elementDependency", () => {
   it("should invokeCallbacks through parents", () => {
     const writeDbFileName = copyFile("elementDependencyThroughParents.bim", dbFileName);
@@ -542,4 +565,156 @@ describe("elementDependency", () => {
     assertRels(mockTxn.dres.rootChanged, [ede_11_2, ede_2_3, ede_3_4]);
     // assertRels(mockTxn.dres.validateOutput, [ede_1_2, ede_21_3]); // this callback is made only on rels that not in the graph but share an output with another rel or have an output that was directly changed
   });
+
+  it("should invokeCallbacks along a long chain", function () {
+    this.timeout(60000);
+    const mockTxn = new MockTxn();
+    openTestDb("elementDependencyLongChain.bim", mockTxn);
+
+    // far deeper than the old recursive scheduler could go without overflowing the stack
+    const chainLength = 5000;
+    const ids: Id64Array = [];
+    for (let i = 0; i < chainLength; ++i)
+      ids.push(db.insertElement(makeSubject(`e${i}`)));
+    db.saveChanges();
+
+    const rels: ElementDrivesElementProps[] = [];
+    for (let i = 1; i < chainLength; ++i) {
+      const rel = makeEDE(ids[i - 1], ids[i]);
+      rel.id = db.insertLinkTableRelationship(rel);
+      rels.push(rel);
+    }
+    assert.equal(db.saveChanges(), DbResult.BE_SQLITE_OK);
+
+    // The full graph:
+    //  e0 --> e1 --> ... --> e4999
+    updateElement(db, ids[0], "change e0");
+
+    mockTxn.resetDependencyResults();
+    assert.equal(db.saveChanges(), DbResult.BE_SQLITE_OK);
+    assert.deepEqual(mockTxn.dres.beforeOutputs, [ids[0]]);
+    assert.deepEqual(mockTxn.dres.allInputsHandled, ids.slice(1));
+    assertRels(mockTxn.dres.rootChanged, rels);
+  });
+
+  it("should invokeCallbacks in dependency order across fan-out and fan-in", () => {
+    const mockTxn = new MockTxn();
+    openTestDb("elementDependencyFanOutFanIn.bim", mockTxn);
+
+    const aid = db.insertElement(makeSubject("a"));
+    const bid = db.insertElement(makeSubject("b"));
+    const cid = db.insertElement(makeSubject("c"));
+    const did = db.insertElement(makeSubject("d"));
+    const eid = db.insertElement(makeSubject("e"));
+    db.saveChanges();
+
+    const ede_a_b = makeEDE(aid, bid);
+    const ede_a_c = makeEDE(aid, cid);
+    const ede_b_d = makeEDE(bid, did);
+    const ede_c_d = makeEDE(cid, did);
+    const ede_d_e = makeEDE(did, eid);
+    const rels = [ede_a_b, ede_a_c, ede_b_d, ede_c_d, ede_d_e];
+    for (const rel of rels)
+      rel.id = db.insertLinkTableRelationship(rel);
+    assert.equal(db.saveChanges(), DbResult.BE_SQLITE_OK);
+
+    // The full graph:
+    //      > b -
+    //     /     \
+    //  a -       > d --> e
+    //     \     /
+    //      > c -
+    updateElement(db, aid, "change a");
+
+    mockTxn.resetDependencyResults();
+    assert.equal(db.saveChanges(), DbResult.BE_SQLITE_OK);
+    assert.deepEqual(mockTxn.dres.beforeOutputs, [aid]);
+
+    // every output is handled exactly once, after all of its inputs
+    const handled = mockTxn.dres.allInputsHandled;
+    assert.sameMembers(handled, [bid, cid, did, eid]);
+    assert.isBelow(handled.indexOf(bid), handled.indexOf(did));
+    assert.isBelow(handled.indexOf(cid), handled.indexOf(did));
+    assert.isBelow(handled.indexOf(did), handled.indexOf(eid));
+
+    // every relationship fires exactly once, after the relationships that drive its source
+    const fired = mockTxn.dres.rootChanged.map((props) => props.id);
+    assert.sameMembers(fired, rels.map((rel) => rel.id));
+    assert.isBelow(fired.indexOf(ede_a_b.id), fired.indexOf(ede_b_d.id));
+    assert.isBelow(fired.indexOf(ede_a_c.id), fired.indexOf(ede_c_d.id));
+    assert.isBelow(fired.indexOf(ede_b_d.id), fired.indexOf(ede_d_e.id));
+    assert.isBelow(fired.indexOf(ede_c_d.id), fired.indexOf(ede_d_e.id));
+  });
+
+  it("should detect and report cycles", () => {
+    const mockTxn = new MockTxn();
+    openTestDb("elementDependencyCycle.bim", mockTxn);
+
+    const e1id = db.insertElement(makeSubject("e1"));
+    const e2id = db.insertElement(makeSubject("e2"));
+    const e3id = db.insertElement(makeSubject("e3"));
+    db.saveChanges();
+
+    const ede_1_2 = makeEDE(e1id, e2id);
+    const ede_2_3 = makeEDE(e2id, e3id);
+    for (const rel of [ede_1_2, ede_2_3])
+      rel.id = db.insertLinkTableRelationship(rel);
+    assert.equal(db.saveChanges(), DbResult.BE_SQLITE_OK);
+
+    // closing the loop makes every edge part of a cycle:
+    //  e1 --> e2 --> e3
+    //   ^             |
+    //   '-------------'
+    const ede_3_1 = makeEDE(e3id, e1id);
+    ede_3_1.id = db.insertLinkTableRelationship(ede_3_1);
+
+    mockTxn.resetDependencyResults();
+    assert.equal(db.saveChanges(), BE_SQLITE_ERROR_PropagateChangesFailed);
+
+    // the walk terminates, no relationship fires twice, and the edge that closed the cycle is marked as failed
+    const fired = mockTxn.dres.rootChanged.map((props) => props.id);
+    assert.isAtMost(fired.length, 3);
+    assert.equal(new Set(fired).size, fired.length);
+    const failed = [ede_1_2, ede_2_3, ede_3_1].filter((rel) => (getEdgeStatus(db, rel.id!) & EDGESTATUS_Failed) !== 0);
+    assert.equal(failed.length, 1);
+  });
+
+  it("should mark the edges whose handlers report errors as failed", () => {
+    let failingRelId: Id64String | undefined;
+    class FailingTxn extends MockTxn {
+      override _onRootChanged(props: RelationshipProps): void {
+        super._onRootChanged(props);
+        if (props.id === failingRelId)
+          db.logTxnError(false);
+      }
+    }
+    const mockTxn = new FailingTxn();
+    openTestDb("elementDependencyFailure.bim", mockTxn);
+
+    const e1id = db.insertElement(makeSubject("e1"));
+    const e2id = db.insertElement(makeSubject("e2"));
+    const e3id = db.insertElement(makeSubject("e3"));
+    db.saveChanges();
+
+    const ede_1_2 = makeEDE(e1id, e2id);
+    const ede_2_3 = makeEDE(e2id, e3id);
+    for (const rel of [ede_1_2, ede_2_3])
+      rel.id = db.insertLinkTableRelationship(rel);
+    assert.equal(db.saveChanges(), DbResult.BE_SQLITE_OK);
+    assert.equal(getEdgeStatus(db, ede_1_2.id!) & EDGESTATUS_Failed, 0);
+
+    // The full graph:
+    //  e1 --> e2 --> e3
+    updateElement(db, e1id, "change e1");
+    failingRelId = ede_1_2.id;
+
+    mockTxn.resetDependencyResults();
+    assert.equal(db.saveChanges(), BE_SQLITE_ERROR_PropagateChangesFailed);
+
+    // a failed edge doesn't stop propagation, but only that edge is marked as failed
+    assert.deepEqual(mockTxn.dres.allInputsHandled, [e2id, e3id]);
+    assertRels(mockTxn.dres.rootChanged, [ede_1_2, ede_2_3]);
+    assert.notEqual(getEdgeStatus(db, ede_1_2.id!) & EDGESTATUS_Failed, 0);
+    assert.equal(getEdgeStatus(db, ede_2_3.id!) & EDGESTATUS_Failed, 0);
+  });
 });
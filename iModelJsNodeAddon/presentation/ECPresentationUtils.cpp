@@ -147,6 +147,12 @@ static ECPresentationManager::Params::CachingParams CreateCachingParams(BeJsCons
         if (cacheConfig.hasMember("disk") && cacheConfig["disk"].isObject())
             ApplyDiskCacheParams(cachingParams, cacheConfig["disk"]);
         }
+    else if (cacheMode.Equals("shared"))
+        {
+        cachingParams.SetCacheMode(ECPresentationManager::Params::CachingParams::Mode::Shared);
+        if (cacheConfig.hasMember("disk") && cacheConfig["disk"].isObject())
+            ApplyDiskCacheParams(cachingParams, cacheConfig["disk"]);
+        }
 
     return cachingParams;
     }
@@ -323,6 +329,10 @@ std::unique_ptr<ECPresentationManager> ECPresentationUtils::CreatePresentationMa
     ECPresentationManager::Params::ContentCachingParams contentCacheParams;
     if (props["contentCacheSize"].isNumeric())
         contentCacheParams.SetPrivateCacheSize((size_t)props["contentCacheSize"].asInt64());
+    if (props["contentCacheMemoryLimit"].isNumeric())
+        contentCacheParams.SetMemoryLimit((size_t)props["contentCacheMemoryLimit"].asInt64());
+    if (props["contentCacheConnectionMemoryLimit"].isNumeric())
+        contentCacheParams.SetConnectionMemoryLimit((size_t)props["contentCacheConnectionMemoryLimit"].asInt64());
 
     ECPresentationManager::Params::MultiThreadingParams threadingParams(CreateTaskAllocationSlotsMap(props["taskAllocationsMap"]));
 